@@ -13,38 +13,55 @@ set(ad_map_access_SOURCES
   ${CMAKE_CURRENT_LIST_DIR}/src/access/AdMapAccess.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/access/Factory.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/access/GeometryStore.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/access/LaneHandleMap.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/access/LaneSpatialIndex.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/access/Logging.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/access/MapContext.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/access/MapPatch.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/access/Operation.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/access/PartitionPager.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/access/Store.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/access/StoreSection.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/access/StoreSerialization.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/access/WorkerPool.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/config/MapConfigFileHandler.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/intersection/Intersection.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/landmark/LandmarkOperation.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/lane/BorderOperation.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/lane/LaneGraph.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/lane/LaneOperation.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/match/AdMapMatching.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/match/MapMatchedOperation.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/match/MapMatchingTracker.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/opendrive/AdMapCache.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/opendrive/AdMapFactory.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/opendrive/DataTypeConversion.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/point/BoundingSphereOperation.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/point/CoordinateTransform.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/point/ECEFOperation.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/point/EdgeSegmentIndex.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/point/ENUOperation.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/point/GeometryOperation.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/point/GeoOperation.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/point/HeadingOperation.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/point/Transform.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/restriction/RestrictionOperation.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/route/AltHeuristic.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/route/ContractionHierarchy.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/route/LaneIntervalOperation.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/route/Planning.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/route/Route.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/route/RouteAStar.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/route/RouteContractionHierarchy.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/route/RouteDijkstra.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/route/RouteOperation.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/route/RoutePrediction.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/serialize/ChecksumCRC32.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/serialize/SerializeGeneratedLaneTypes.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/serialize/Serializer.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/serialize/SerializerBuffer.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/serialize/StorageFile.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/serialize/StorageMemoryMapped.cpp
 )
 
 # specify the include directories of the Generator Managed Library ad_map_access.
@@ -70,7 +87,7 @@ set(ad_map_access_UNIT_TEST_DIR
 # (optional) specify the tools directory of the Generator Managed Library ad_map_access.
 # The directory needs to contain a CMakeLists.txt
 # The tools might be binding-specific.
-#set(ad_map_access_TOOLS_DIR
-#  ${CMAKE_CURRENT_LIST_DIR}/tools
-#)
+set(ad_map_access_TOOLS_DIR
+  ${CMAKE_CURRENT_LIST_DIR}/tools
+)
 
@@ -0,0 +1,134 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <memory>
+
+#include "ad/map/access/Store.hpp"
+#include "ad/map/point/CoordinateTransform.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+/**
+ * @brief Context for map queries independent of the global map access.
+ *
+ * A context bundles a store with its own coordinate transformation. While a context is bound to a thread
+ * by a MapContext::Scope, all map operations executed by this thread (matching, routing, intersection, lane
+ * operations, ...) use the store and the ENU reference point of the context instead of the global ones.
+ * Queries within a context don't acquire the lock of the global map access.
+ *
+ * The context keeps its store alive, even if the global map access is cleaned up or initialized with another
+ * map in the meantime. The store must not be modified while any context is using it.
+ *
+ * The ENU reference point of a context is not synchronized. If a context is shared between threads, its ENU
+ * reference point must not be changed while other threads are using it.
+ */
+class MapContext
+{
+public:                                               // Derived types
+  typedef std::shared_ptr<MapContext> Ptr;            ///< Smart pointer to the context.
+  typedef std::shared_ptr<MapContext const> ConstPtr; ///< Smart pointer to the constant context.
+
+  /**
+   * @brief Binds a context to the calling thread for the lifetime of the scope object.
+   *
+   * Scopes can be nested, the previously bound context becomes active again when the scope ends.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * @brief Constructor. Binds the given context to the calling thread.
+     */
+    explicit Scope(Ptr const &context);
+
+    /**
+     * @brief Constructor. Binds the given context to the calling thread without taking ownership.
+     *
+     * Used to propagate the context of a thread to the worker threads it uses, see getCurrent().
+     * The context must outlive the scope; nullptr binds the global map access.
+     */
+    explicit Scope(MapContext *context);
+
+    /**
+     * @brief Destructor. Restores the context bound before.
+     */
+    ~Scope();
+
+    Scope(Scope const &other) = delete;
+    Scope(Scope &&other) = delete;
+    Scope &operator=(Scope const &other) = delete;
+    Scope &operator=(Scope &&other) = delete;
+
+  private:
+    Ptr context_;          ///< The context bound by this scope, if owned.
+    MapContext *previous_; ///< The context bound before this scope.
+  };
+
+  /**
+   * @brief Constructor.
+   *
+   * The coordinate transformation of the context has no ENU reference point set.
+   *
+   * @param[in] store The store to be queried within the context.
+   */
+  explicit MapContext(Store::Ptr store);
+
+  /**
+   * @brief Constructor.
+   *
+   * @param[in] store The store to be queried within the context.
+   * @param[in] enuReferencePoint The initial ENU reference point of the context.
+   */
+  MapContext(Store::Ptr store, point::GeoPoint const &enuReferencePoint);
+
+  /**
+   * @returns reference to the store of the context
+   */
+  Store &getStore() const
+  {
+    return *store_;
+  }
+
+  /**
+   * @returns the store of the context
+   */
+  Store::Ptr const &getStorePtr() const
+  {
+    return store_;
+  }
+
+  /**
+   * @returns the coordinate transformation of the context
+   */
+  point::CoordinateTransform::Ptr const &getCoordinateTransform() const
+  {
+    return coordinateTransform_;
+  }
+
+  /**
+   * @brief set the ENU reference point of the context
+   */
+  void setENUReferencePoint(point::GeoPoint const &point);
+
+  /**
+   * @returns the context bound to the calling thread, nullptr if there is none
+   */
+  static MapContext *getCurrent();
+
+private:
+  Store::Ptr store_;                                    ///< The store of the context.
+  point::CoordinateTransform::Ptr coordinateTransform_; ///< The coordinate transformation of the context.
+};
+
+} // namespace access
+} // namespace map
+} // namespace ad
@@ -0,0 +1,60 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <map>
+#include "ad/map/access/Types.hpp"
+#include "ad/map/landmark/Types.hpp"
+#include "ad/map/lane/Types.hpp"
+#include "ad/map/serialize/ISerializer.hpp"
+
+/** @brief namespace ad */
+namespace ad {
+/** @brief namespace map */
+namespace map {
+/** @brief namespace access */
+namespace access {
+
+/**
+ * @brief Incremental change of the content of a Store.
+ *
+ * A patch adds, replaces and removes lanes and landmarks. It is applied by Store::createPatched() or
+ * access::applyPatch() as a whole or not at all: each lane and landmark must be mentioned at most once,
+ * added objects must not exist yet and modified or removed objects must exist in the Store.
+ * Modified objects stay in their partitions, added objects are assigned to the partition of the patch.
+ */
+struct MapPatch
+{
+  typedef std::map<lane::LaneId, lane::Lane::Ptr> LaneMap;                     ///< Map LaneId/Lane.
+  typedef std::map<landmark::LandmarkId, landmark::Landmark::Ptr> LandmarkMap; ///< Map LandmarkId/Landmark.
+
+  PartitionId partitionId{0};                ///< Partition receiving the added lanes and landmarks.
+  LaneMap addedLanes;                        ///< Lanes to be added.
+  LaneMap modifiedLanes;                     ///< Lanes replacing the lanes with the same identifier.
+  lane::LaneIdList removedLanes;             ///< Lanes to be removed.
+  LandmarkMap addedLandmarks;                ///< Landmarks to be added.
+  LandmarkMap modifiedLandmarks;             ///< Landmarks replacing the landmarks with the same identifier.
+  landmark::LandmarkIdList removedLandmarks; ///< Landmarks to be removed.
+
+  /**
+   * @returns true if the patch doesn't change anything.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Save or load the patch.
+   * @param[in] serializer Serializer to be used.
+   * @return true if successful.
+   */
+  bool serialize(serialize::ISerializer &serializer);
+};
+
+} // namespace access
+} // namespace map
+} // namespace ad
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <memory>
+#include "ad/map/access/MapContext.hpp"
+#include "ad/map/access/MapPatch.hpp"
 #include "ad/map/access/MapMetaDataValidInputRange.hpp"
 #include "ad/map/access/Store.hpp"
 #include "ad/map/config/PointOfInterest.hpp"
@@ -45,6 +47,8 @@ inline bool isValid(MapMetaData const &metaData, bool const logErrors = true)
 
 /**
  * @brief get the coordinate transformation object
+ *
+ * If a MapContext is bound to the calling thread, the coordinate transformation of the context is returned.
  */
 std::shared_ptr<point::CoordinateTransform> getCoordinateTransform();
 
@@ -78,9 +82,30 @@ bool init(Store::Ptr store);
  */
 void cleanup();
 
+/**
+ * @brief cache the maps converted from OpenDRIVE in the given directory
+ *
+ * Loading the same OpenDRIVE map or content with the same parameters again reads the converted map from the
+ * cache instead of converting it, see opendrive::AdMapCache. The setting is kept on cleanup(). While the map
+ * access is initialized with a configuration file giving an OpenDriveCache, the configured cache is used instead;
+ * after cleanup() the cache given here applies again.
+ *
+ * @param[in] directory the cache directory, created if not existing; an empty directory disables the cache
+ * @param[in] maxSize maximal size of the cached maps in bytes, 0 for unlimited
+ * @returns \c false if the cache directory can't be created
+ */
+bool setOpenDriveCache(std::string const &directory, std::size_t maxSize = 0u);
+
+/**
+ * @brief remove all maps from the OpenDRIVE map cache in use, see setOpenDriveCache()
+ */
+void clearOpenDriveCache();
+
 /**
  * @brief set the current ENU reference point
  *
+ * If a MapContext is bound to the calling thread, the ENU reference point of the context is set.
+ *
  * @param[in] point the geo point defining the reference point
  */
 void setENUReferencePoint(point::GeoPoint const &point);
@@ -139,9 +164,96 @@ bool isRightHandedTraffic();
 
 /**
  * @returns reference to the map store object
+ *
+ * If a MapContext is bound to the calling thread, the store of the context is returned.
+ * Otherwise the store pinned by the innermost QueryScope of the calling thread is returned. Outside of any scope,
+ * the current store is returned and kept alive until the calling thread calls getStore() again, even if patches
+ * are applied in the meantime.
  */
 Store &getStore();
 
+/**
+ * @brief Pins the current store for the queries of the calling thread for the lifetime of the scope.
+ *
+ * Within the scope, getStore() returns the same store, even if patches are applied or the map is cleaned up
+ * by other threads in the meantime. So a query running within the scope sees one map as a whole and the references
+ * it obtains stay valid until the scope ends. The store is released with the last scope or context using it.
+ * The functions of the lane, landmark, intersection, match and route interfaces querying the store several times
+ * open a scope of their own.
+ * Scopes can be nested, nested scopes keep the store of the outer scope. Queries within a MapContext are not affected.
+ * If the pinned store is paged, the outermost scope also defers the eviction of its partitions, see Store::PagingScope.
+ */
+class QueryScope
+{
+public:
+  /**
+   * @brief Constructor. Pins the current store for the calling thread.
+   *
+   * The store is pinned by the first query within the scope, so the map access doesn't need to be initialized yet.
+   */
+  QueryScope();
+
+  /**
+   * @brief Constructor. Pins the given store for the calling thread.
+   *
+   * Used to propagate the pinned store of a thread to the worker threads it uses, see getPinnedStore().
+   * nullptr behaves like the default constructor.
+   */
+  explicit QueryScope(Store::Ptr const &store);
+
+  /**
+   * @brief Destructor. Restores the store pinned before.
+   */
+  ~QueryScope();
+
+  QueryScope(QueryScope const &other) = delete;
+  QueryScope(QueryScope &&other) = delete;
+  QueryScope &operator=(QueryScope const &other) = delete;
+  QueryScope &operator=(QueryScope &&other) = delete;
+
+  /**
+   * @returns the store pinned by the innermost scope of the calling thread
+   *
+   * nullptr is returned outside of any scope and within a MapContext.
+   */
+  static Store::Ptr getPinnedStore();
+
+private:
+  Store::Ptr previous_;          ///< The store pinned before this scope, if replaced by a nested scope.
+  bool restorePrevious_{false}; ///< The scope pinned a store of its own within another scope.
+};
+
+/**
+ * @brief create a context for map queries on the current map
+ *
+ * The context uses the store queried by the calling thread (see getStore()) and is initialized with the current
+ * ENU reference point (if set). Bind the context to a thread by a MapContext::Scope to query the map within the
+ * context.
+ */
+MapContext::Ptr createMapContext();
+
+/**
+ * @brief apply a patch to the current map
+ *
+ * The patch is applied to a copy of the store sharing all untouched lanes and landmarks with the current one.
+ * The patched store replaces the current store atomically. Queries within a MapContext or QueryScope created
+ * before keep using the unpatched store, contexts and scopes created afterwards use the patched one. So threads
+ * querying the map within a context or scope see either the old or the new map as a whole. A replaced store is
+ * kept alive until the last context, scope or store reference provided by getStore() using it is gone.
+ * The lane indices and the lane graph of the patched store are rebuilt on first use, see Store::createPatched().
+ *
+ * @returns \c false if the patch doesn't fit to the current map, which is not changed in this case
+ */
+bool applyPatch(MapPatch const &patch);
+
+/**
+ * @brief apply a patch read from the given file to the current map
+ *
+ * The patch file is written by MapPatch::serialize() with a SerializerFileCRC32.
+ * @see applyPatch(MapPatch const &)
+ */
+bool applyPatch(std::string const &patchFileName);
+
 } // namespace access
 } // namespace map
 } // namespace ad
@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "ad/map/access/Types.hpp"
 #include "ad/map/landmark/Types.hpp"
@@ -19,6 +21,11 @@
 namespace ad {
 namespace map {
 
+namespace lane {
+class LaneGraph;
+struct LaneSegmentIndex;
+}
+
 namespace match {
 class AdMapMatching;
 }
@@ -26,6 +33,10 @@ class AdMapMatching;
 namespace access {
 
 class GeometryStore;
+class LaneHandleMap;
+class LaneSpatialIndex;
+class PartitionPager;
+struct MapPatch;
 
 /**
  * @brief Autonomus Driving Map Store.
@@ -33,11 +44,55 @@ class GeometryStore;
 class Store
 {
   friend class Factory;
+  friend class PartitionPager;
   friend class match::AdMapMatching;
 
 public:                               // Derived types
   typedef std::shared_ptr<Store> Ptr; ///< Smart pointer to the Store.
 
+  /**
+   * @brief Counters of a paged Store.
+   */
+  struct PagingStatistics
+  {
+    std::size_t hits{0u};          ///< Requests of partitions already resident.
+    std::size_t misses{0u};        ///< Requests of partitions not resident.
+    std::size_t loads{0u};         ///< Partitions loaded.
+    std::size_t evictions{0u};     ///< Partitions evicted to meet the memory budget.
+    std::size_t residentBytes{0u}; ///< Serialized size of the resident partitions.
+  };
+
+  /**
+   * @brief Defers the eviction of partitions of a paged Store for the lifetime of the scope object.
+   *
+   * While a scope exists, the partitions of a paged Store are evicted only when the last scope of the Store ends.
+   * Hence, lanes, landmarks, references to them and handles provided by getLaneHandle() stay valid as long as a
+   * scope exists. Without a scope, each request of a partition may evict all other partitions.
+   * Scopes can be nested and opened by several threads at once. For a Store that is not paged, the scope has no
+   * effect.
+   */
+  class PagingScope
+  {
+  public:
+    /**
+     * @brief Constructor. Defers the eviction of partitions of the store.
+     */
+    explicit PagingScope(Store const &store);
+
+    /**
+     * @brief Destructor. Evicts partitions exceeding the memory budget, if this is the last scope of the store.
+     */
+    ~PagingScope();
+
+    PagingScope(PagingScope const &other) = delete;
+    PagingScope(PagingScope &&other) = delete;
+    PagingScope &operator=(PagingScope const &other) = delete;
+    PagingScope &operator=(PagingScope &&other) = delete;
+
+  private:
+    Store const &store_; ///< The store the eviction is deferred for.
+  };
+
   /**
    * @brief Constructor.
    *        Initializes empty Store.
@@ -77,19 +132,86 @@ public: // Main Operations
    * @param[in] use_magic          Use Magic Numbers for consistency during serialization.
    * @param[in] use_embedded_geometry  Save geometry together with objects.
    * @param[in] use_geometry_store Save geometry in separate section of file.
+   * @param[in] geometry_error_bound Maximal deviation of the coordinates in the geometry section from the original
+   *            ones. The coordinates are quantized and delta-encoded if larger than 0. Without embedded geometry,
+   *            the lanes are restored from the geometry section on loading, so the loaded geometry deviates as well.
+   *            Only the file gets smaller, the loaded lanes keep their points as doubles.
    * @return true if successful.
    */
   bool save(serialize::ISerializer &serializer,
             bool use_magic = true,
             bool use_embedded_geometry = true,
-            bool use_geometry_store = false);
+            bool use_geometry_store = false,
+            physics::Distance const &geometry_error_bound = physics::Distance(0.));
 
   /**
    * @brief Load data into the AD Map Data Store.
    * @param[in] serializer Serializer to be used.
+   * @param[in] threadCount Number of threads verifying and decoding the sections of the map in parallel,
+   *                        0 to use the number of hardware threads. Maps without sections are decoded sequentially.
+   * @param[in] load_geometry Load all geometry points of lanes and landmarks. If false, only the topology is
+   *                        loaded: each edge is reduced to its first and last point, but the lanes keep their length,
+   *                        width and bounding sphere, so routing and route prediction keep working. Operations
+   *                        evaluating the geometry in detail, like map matching, only see the straight connection
+   *                        of the end points then. A Store loaded without geometry can't be saved.
+   * @return true if successful.
+   *
+   * All lanes and landmarks are decoded into objects owning their data, also when reading from a memory mapped
+   * file, so loading takes time and memory proportional to the size of the map. Use openPaged() to decode the
+   * partitions of a map on demand.
+   */
+  bool load(serialize::ISerializer &serializer, std::size_t threadCount = 0u, bool load_geometry = true);
+
+  /**
+   * @returns true if all geometry points were loaded, false if only the topology was loaded.
+   */
+  bool hasGeometry() const;
+
+  /**
+   * @brief Enables or disables the segment indices of the lane edges.
+   *
+   * The segment indices speed up finding the nearest point on a lane (e.g. by the map matching) on lanes with many
+   * points, but take memory for the chunk bounds and the accumulated segment lengths of both edges of every lane.
+   * The results are the same with and without the indices. Enabled by default.
+   */
+  void setLaneSegmentIndexEnabled(bool enabled);
+
+  /**
+   * @returns true if the segment indices of the lane edges are used.
+   */
+  bool isLaneSegmentIndexEnabled() const;
+
+  /**
+   * @brief Open a map file for loading its partitions on demand.
+   * @param[in] fileName Map file with sections, as written by save().
+   * @param[in] memoryBudget Serialized size of the partitions to be kept resident in bytes.
    * @return true if successful.
+   *
+   * Only meta data and partition lists are loaded at once; the file stays mapped until the Store is destroyed.
+   * A partition is loaded when a lane or landmark of it is requested, when its lanes are requested or when its
+   * bounding sphere intersects with a spatial lane search. The least recently used partitions exceeding the memory
+   * budget are evicted on each request outside of a PagingScope, keeping only the partition just requested, and
+   * when the last PagingScope of the Store ends. A QueryScope opens a PagingScope on the store it pins, so queries
+   * like route planning or map matching may exceed the memory budget until they end.
+   * References to lanes and landmarks and handles provided by getLaneHandle() become invalid when the partition is
+   * evicted.
+   * Operations covering all lanes without addressing a partition, like getLanes(type_filter, is_hov) or
+   * getLaneGraph(), decode the partitions not resident one after the other without making them resident. The lane
+   * graph doesn't keep the lanes of a paged Store, but pages them in on demand. The sections are verified
+   * individually when loaded, the checksum of the whole file is not checked. Maps using a geometry store can't be
+   * paged, and a paged Store must not be modified by the Factory.
+   */
+  bool openPaged(std::string const &fileName, std::size_t memoryBudget);
+
+  /**
+   * @returns true if the partitions are loaded on demand.
+   */
+  bool isPaged() const;
+
+  /**
+   * @returns Counters of partition paging, all zero if the Store is not paged.
    */
-  bool load(serialize::ISerializer &serializer);
+  PagingStatistics getPagingStatistics() const;
 
   /**
    * @returns true if there are no data in the store.
@@ -116,6 +238,15 @@ public: // Access Operations
    */
   lane::Lane::ConstPtr getLanePtr(lane::LaneId const &id) const;
 
+  /**
+   * @brief Method to be called to retrieve Lane from the Store without reference counting.
+   * @param[in] id Lane identifier.
+   * @returns Non-owning pointer to the Lane with given identifier, nullptr if the Lane does not exist
+   *          in the store. The pointer is valid until the Lane is removed from the store, the lanes
+   *          are compacted or the partition of the Lane is evicted, see PagingScope.
+   */
+  lane::Lane const *getLaneHandle(lane::LaneId const &id) const;
+
   /**
    * @brief Method to be called to retrieve identifiers of all Lanes in the Store.
    * @returns Identifiers of all lanes in the store.
@@ -146,6 +277,27 @@ public: // Access Operations
    */
   lane::LaneIdList getLanes(PartitionId partition_id, std::string const &type_filter, bool is_hov) const;
 
+  /**
+   * @brief Spatial Lane Search.
+   *        Method to be called to retrieve identifiers of all Lanes whose bounding sphere
+   *        intersects with the given sphere.
+   * @param[in] bounding_sphere Search sphere.
+   * @returns Identifiers of the lanes in the order of getLanes().
+   *
+   * The search is performed on a bounding volume hierarchy over the lanes, which is (re-)built
+   * on the first search after the content of the Store has changed.
+   */
+  lane::LaneIdList getLanesNear(point::BoundingSphere const &bounding_sphere) const;
+
+  /**
+   * @brief Provides the routing graph of the lanes in the Store.
+   * @returns Routing graph of the lanes.
+   *
+   * The graph is (re-)built on the first request after the lanes of the Store have changed.
+   * Already provided graphs are not affected by later changes.
+   */
+  std::shared_ptr<lane::LaneGraph const> getLaneGraph() const;
+
   /**
    * @brief Retrieve identifiers of all Landmarks belonging to specific partition.
    * @param[in] partition_id Partition identifier.
@@ -175,6 +327,27 @@ public: // Access Operations
    */
   void removePartition(PartitionId partition_id);
 
+  /**
+   * @brief Creates a Store with the content of this Store changed by a patch.
+   * @param[in] patch Changes to be applied, see MapPatch.
+   * @returns The patched Store, nullptr if the patch doesn't fit to the content of this Store.
+   *
+   * This Store is not modified, so it can be queried concurrently. Lanes and landmarks not touched by the patch
+   * are shared by both Stores, as are the segment indices of the untouched lanes. The spatial index, the lane
+   * handles and the lane graph of the patched Store are not updated incrementally, but rebuilt from scratch on first
+   * use. So even a small patch costs time linear in the number of lanes of the map on the first queries afterwards.
+   * Paged Stores can't be patched.
+   */
+  Ptr createPatched(MapPatch const &patch) const;
+
+  /**
+   * @brief Moves all lanes into one contiguous block of memory.
+   *        Performed automatically after loading. Lanes added afterwards are allocated individually.
+   *        Paged Stores are not compacted, so evicted partitions are released.
+   *        Lane objects still held outside of the store are not touched, but lose their connection to the store.
+   */
+  void compactLanes();
+
   /**
    * @brief   Calculates cumulative length of the all lanes in the store.
    * @returns Cumulative length of all lanes in the store.
@@ -189,7 +362,26 @@ public: // Access Operations
   point::BoundingSphere getBoundingSphere() const;
 
 private:
-  bool serialize(serialize::ISerializer &serializer);
+  bool serialize(serialize::ISerializer &serializer, std::size_t threadCount);
+
+  /**
+   * @brief Write lanes and landmarks in sections, preceded by the table of the sections.
+   *
+   * Each section contains lanes and landmarks of a single partition, large partitions are split into several
+   * sections. Objects not listed in any partition are stored with the first partition.
+   *
+   * @param[in] serializer Serializer to be used.
+   * @returns true if successful.
+   */
+  bool writeSections(serialize::ISerializer &serializer);
+
+  /**
+   * @brief Read the lanes and landmarks written by writeSections().
+   * @param[in] serializer Serializer to be used.
+   * @param[in] threadCount Number of threads verifying and decoding the sections in parallel.
+   * @returns true if successful.
+   */
+  bool readSections(serialize::ISerializer &serializer, std::size_t threadCount);
   /**
    * @brief Store lane geometry to the Geometry Store.
    * @param[in] gs Geometry Store to be used.
@@ -211,21 +403,99 @@ private:
    */
   bool checkGeometry(const GeometryStore &gs);
 
-private:                       // Constructor
-  bool use_magic_;             ///< Use Magic Numbers for consistency during serialization.
-  bool use_embedded_geometry_; ///< Save geometry together with objects.
-  bool use_geometry_store_;    ///< Save geometry in separate section of file.
+  /**
+   * @brief Marks the lane spatial index and lane handle map outdated.
+   *        To be called whenever lanes are added, removed or their geometry is changed.
+   */
+  void invalidateLaneIndex();
+
+  /**
+   * @brief Marks the lane spatial index and lane handle map outdated, but keeps the segment indices of lanes not
+   *        listed. To be called whenever the listed lanes are added, removed or replaced by other objects.
+   * @param[in] lane_ids Identifiers of the changed lanes.
+   */
+  void invalidateLaneIndex(lane::LaneIdList const &lane_ids);
+
+  /**
+   * @brief Adds the listed lanes to an up to date lane handle map.
+   *        To be called by the PartitionPager after loading the lanes of a partition.
+   */
+  void insertLaneHandles(lane::LaneIdList const &lane_ids);
+
+  /**
+   * @brief Removes the listed lanes from the lane handle map and drops their segment indices.
+   *        To be called by the PartitionPager before evicting the lanes of a partition.
+   */
+  void eraseLaneHandles(lane::LaneIdList const &lane_ids);
+
+  /**
+   * @brief Applies a patch to this Store.
+   * @param[in] patch Changes to be applied.
+   * @returns true if successful, false if the patch doesn't fit. The Store is unchanged in that case.
+   */
+  bool applyPatch(MapPatch const &patch);
+
+  /**
+   * @brief Marks the lane graph outdated.
+   *        To be called whenever lanes are changed in a way relevant for routing.
+   *        Implicitly performed by invalidateLaneIndex().
+   */
+  void invalidateLaneGraph();
+
+  /**
+   * @brief Rebuilds the lane spatial and segment indices if outdated.
+   */
+  void updateLaneIndex() const;
+
+  /**
+   * @brief Rebuilds the lane handle map if outdated.
+   */
+  void updateLaneHandles() const;
+
+  /**
+   * @brief Provides the segment index of the edges of a lane.
+   * @param[in] id Lane identifier.
+   * @returns Segment index of the lane, nullptr if the lane is not in the store.
+   */
+  std::shared_ptr<lane::LaneSegmentIndex const> getLaneSegmentIndex(lane::LaneId const &id) const;
+
+  /**
+   * @returns Lock serializing the accesses to a paged Store, not owning any mutex if the Store is not paged.
+   */
+  std::unique_lock<std::recursive_mutex> lockPaging() const;
+
+private:                                   // Constructor
+  bool use_magic_;                         ///< Use Magic Numbers for consistency during serialization.
+  bool use_embedded_geometry_;             ///< Save geometry together with objects.
+  bool use_geometry_store_;                ///< Save geometry in separate section of file.
+  physics::Distance geometry_error_bound_; ///< Maximal deviation of the coordinates in the geometry section.
+  bool load_geometry_;                     ///< Load all geometry points, not only the end points of the edges.
+  bool use_lane_segment_index_;            ///< Build the segment indices of the lane edges.
 
   typedef std::map<lane::LaneId, lane::Lane::Ptr> LaneMap;                     ///< Map LaneId/Lane.
   typedef std::map<landmark::LandmarkId, landmark::Landmark::Ptr> LandmarkMap; ///< Map LandmarkId/Landmark.
   typedef std::map<PartitionId, lane::LaneIdList> PartLaneMap;                 ///< Map PartitionId/LaneIdList.
   typedef std::map<PartitionId, landmark::LandmarkIdList> PartLandmarkMap;     ///< Map PartitionId/LandmarkIdList.
 
+  /**
+   * @brief Map LaneId/LaneSegmentIndex.
+   */
+  typedef std::map<lane::LaneId, std::shared_ptr<lane::LaneSegmentIndex const>> LaneSegmentIndexMap;
+
   MapMetaData meta_data_;             ///< General map meta data
   LaneMap lane_map_;                  ///< All Lane-s currently in the store.
   LandmarkMap landmark_map_;          ///< All Landmark-s currently in the store.
   PartLaneMap part_lane_map_;         ///< Lane identifiers belonging to the tile.
   PartLandmarkMap part_landmark_map_; ///< Landmark identifiers belonging to the tile.
+
+  mutable std::unique_ptr<LaneSpatialIndex> lane_index_;      ///< Spatial index over the lanes.
+  mutable LaneSegmentIndexMap lane_segment_index_map_;        ///< Segment index of the edges of each lane.
+  mutable std::atomic<bool> lane_index_valid_;                ///< Lane spatial and segment indices are up to date.
+  mutable std::unique_ptr<LaneHandleMap> lane_handles_;       ///< Hash table LaneId/Lane.
+  mutable std::atomic<bool> lane_handles_valid_;              ///< Lane handle map is up to date.
+  mutable std::shared_ptr<lane::LaneGraph const> lane_graph_; ///< Routing graph of the lanes.
+  mutable std::mutex lane_index_mutex_;                       ///< Protects rebuilding the lane indices.
+  std::unique_ptr<PartitionPager> pager_;                     ///< Loads partitions on demand, if paged.
 };
 
 } // namespace access
@@ -25,10 +25,11 @@ namespace config {
  * @brief Parse config file that specifies all known maps
  *
  * The config file specifies which maps to use by the AdMapAccess class.
- * It has three sections:
+ * It has four sections:
  * - ADMap
  * - POI
  * - ENUReference
+ * - OpenDriveCache
  *
  * ADMap specifies a map and optional parameters for loading. An entry is given with
  * - map (mandatory): filename of the adm or OpenDrive map file, relative path below in the directory of the config file
@@ -63,6 +64,16 @@ namespace config {
  * [ENUReference]
  * default=49.0192671 8.4421163 0
  *
+ * OpenDRIVE maps are converted on loading. The result of the conversion can be stored in a cache directory to load
+ * the binary map on the next use of the same OpenDRIVE map, see opendrive::AdMapCache. The cache is given by:
+ * - directory (mandatory): the cache directory, relative paths are below the directory of the config file itself
+ * - maxSizeMB (optional): the maximal size of the cached maps in megabytes, unlimited if not given
+ *
+ * Example
+ * [OpenDriveCache]
+ * directory=cache
+ * maxSizeMB=512
+ *
  * When parsing the config file, the existance/correctness of the map file itself will not be checked.
  */
 class MapConfigFileHandler
@@ -105,6 +116,15 @@ public:
   //! @return \c 'true' if the default Enu reference point is existing
   bool defaultEnuReferenceAvailable() const;
 
+  //! @return the directory of the OpenDRIVE map cache, empty if not configured
+  std::string const &openDriveCacheDirectory() const;
+
+  //! @return the maximal size of the OpenDRIVE map cache in bytes, 0 if unlimited
+  std::size_t openDriveCacheMaxSize() const;
+
+  //! @return the memory budget of loading the partitions of the AD map on demand in bytes, 0 if loaded at once
+  std::size_t pagingMemoryBudget() const;
+
   void reset();
 
 private:
@@ -114,6 +134,9 @@ private:
   MapEntry mAdMapEntry;
   std::vector<PointOfInterest> mPointsOfInterest;
   point::GeoPoint mDefaultEnuReference;
+  std::string mOpenDriveCacheDirectory{};
+  std::size_t mOpenDriveCacheMaxSize{0u};
+  std::size_t mPagingMemoryBudget{0u};
 
   void updateFilenameAndPath(std::string const &configFileName);
   bool parseConfigFile(std::string const &configFileName);
@@ -0,0 +1,246 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+#include "ad/map/lane/Types.hpp"
+#include "ad/map/point/Types.hpp"
+#include "ad/physics/Duration.hpp"
+
+/** @brief namespace ad */
+namespace ad {
+/** @brief namespace map */
+namespace map {
+/** @brief namespace lane */
+namespace lane {
+
+/**
+ * @brief Routing graph of the lane network.
+ *
+ * The lanes are the nodes of the graph, the contacts between the lanes are its edges.
+ * The attributes of the lanes required for routing are precomputed; the edges are stored in
+ * compressed sparse row format, grouped by their contact location.
+ *
+ * The graph is a snapshot of the lanes at construction time. The Store provides an up to date instance.
+ * The graph of a paged Store doesn't keep the lanes, but provides them on demand, see getLane().
+ */
+class LaneGraph
+{
+public: // Types
+  typedef std::shared_ptr<LaneGraph const> ConstPtr;
+
+  typedef uint32_t NodeIndex;
+
+  //! provides a lane on demand, see getLane()
+  typedef std::function<Lane::ConstPtr(LaneId const &)> LaneProvider;
+
+  //! index of a node not part of the graph
+  static constexpr NodeIndex cInvalidNodeIndex = std::numeric_limits<NodeIndex>::max();
+
+  /**
+   * @brief Node of the graph.
+   */
+  struct Node
+  {
+    LaneId id;                   ///< Identifier of the lane.
+    Lane::ConstPtr lane;         ///< The lane, nullptr if provided on demand, see getLane().
+    LaneType type;               ///< Type of the lane.
+    LaneDirection direction;     ///< Direction of the lane.
+    bool routeable;              ///< True if the lane can be used in routing, see isRouteable().
+    bool positive;               ///< True if the lane can be driven in positive direction.
+    bool negative;               ///< True if the lane can be driven in negative direction.
+    physics::Distance length;    ///< Length of the lane.
+    physics::Duration duration;  ///< Minimal duration to pass the whole lane, see getDuration().
+    point::ECEFPoint startPoint; ///< Center point of the lane at parametric offset 0.
+    point::ECEFPoint endPoint;   ///< Center point of the lane at parametric offset 1.
+    uint32_t edgeBegin[5];       ///< Index of the first edge of each EdgeGroup; edgeBegin[4] is the end.
+  };
+
+  /**
+   * @brief Edge of the graph.
+   */
+  struct Edge
+  {
+    NodeIndex node;                  ///< Target node, cInvalidNodeIndex if the lane is not part of the graph.
+    LaneId toLane;                   ///< Identifier of the target lane.
+    ContactLocation reverseLocation; ///< Location of the first contact of the target lane back to the source lane.
+  };
+
+  /**
+   * @brief Groups of edges of a node.
+   *        The order of the groups is chosen to allow iterating the lateral contacts in one go.
+   */
+  enum EdgeGroup
+  {
+    SuccessorEdges = 0,
+    PredecessorEdges = 1,
+    RightEdges = 2,
+    LeftEdges = 3
+  };
+
+  /**
+   * @brief Range of edges.
+   */
+  struct EdgeRange
+  {
+    Edge const *first;
+    Edge const *last;
+
+    Edge const *begin() const
+    {
+      return first;
+    }
+    Edge const *end() const
+    {
+      return last;
+    }
+    bool empty() const
+    {
+      return first == last;
+    }
+  };
+
+public: // Constructor/Destructor
+  /**
+   * @brief Constructor. Builds the graph.
+   * @param[in] laneMap The lanes of the graph.
+   */
+  explicit LaneGraph(std::map<LaneId, Lane::Ptr> const &laneMap);
+
+  /**
+   * @brief Constructor. Creates an empty graph to be filled by addLane() and completed by finalize().
+   * @param[in] laneProvider Provides the lanes on demand, see getLane(). The lanes added are not kept by the graph,
+   *            so the graph of a map can be built without having all of its lanes in memory at once.
+   */
+  explicit LaneGraph(LaneProvider const &laneProvider);
+
+  LaneGraph(LaneGraph const &) = delete;
+  LaneGraph &operator=(LaneGraph const &) = delete;
+
+  /**
+   * @brief Destructor.
+   */
+  ~LaneGraph() = default;
+
+public: // Operations
+  /**
+   * @brief Adds a lane to a graph created with a LaneProvider. The lanes may be added in any order.
+   */
+  void addLane(Lane::Ptr const &lane);
+
+  /**
+   * @brief Connects the lanes added by addLane(). To be called once after adding all lanes.
+   */
+  void finalize();
+
+  /**
+   * @returns the lane of the given node, if not kept by the graph the one of the LaneProvider.
+   *          Only required to evaluate the geometry at arbitrary positions.
+   */
+  Lane::ConstPtr getLane(Node const &node) const;
+
+  /**
+   * @returns the number of nodes.
+   */
+  std::size_t size() const
+  {
+    return nodes_.size();
+  }
+
+  /**
+   * @brief Looks up the node of a lane.
+   * @param[in] id Lane identifier.
+   * @returns Index of the node, cInvalidNodeIndex if the lane is not part of the graph.
+   */
+  NodeIndex findNode(LaneId const &id) const;
+
+  /**
+   * @returns the node with the given index.
+   */
+  Node const &getNode(NodeIndex const index) const
+  {
+    return nodes_[index];
+  }
+
+  /**
+   * @brief Looks up the node of a lane.
+   * @param[in] id Lane identifier.
+   * @returns The node of the lane.
+   *          Throws std::invalid_argument if the lane is not part of the graph.
+   */
+  Node const &getNode(LaneId const &id) const;
+
+  /**
+   * @returns the index of the given node of this graph.
+   */
+  NodeIndex getNodeIndex(Node const &node) const
+  {
+    return static_cast<NodeIndex>(&node - nodes_.data());
+  }
+
+  /**
+   * @returns the edges of the given node from edge group \a first up to and including edge group \a last.
+   */
+  EdgeRange getEdges(Node const &node, EdgeGroup const first, EdgeGroup const last) const
+  {
+    return EdgeRange{edges_.data() + node.edgeBegin[first], edges_.data() + node.edgeBegin[last + 1]};
+  }
+
+  /**
+   * @returns the edges of the given node within the given edge group.
+   */
+  EdgeRange getEdges(Node const &node, EdgeGroup const group) const
+  {
+    return getEdges(node, group, group);
+  }
+
+  /**
+   * @brief Provides the direct neighborhood relation between two lanes.
+   *        Equivalent to lane::getDirectNeighborhoodRelation().
+   * @param[in] id Lane identifier.
+   * @param[in] checkId Lane identifier of the lane to check.
+   * @returns OVERLAP if the lanes are identical, LEFT, RIGHT, SUCCESSOR or PREDECESSOR if \a checkId is a
+   *          contact lane of \a id (checked in this order), INVALID otherwise.
+   *          Throws std::invalid_argument if \a id is not part of the graph.
+   */
+  ContactLocation getDirectNeighborhoodRelation(LaneId const &id, LaneId const &checkId) const;
+
+  /**
+   * @brief Provides a fingerprint of the graph.
+   *
+   * The fingerprint covers all node attributes relevant for routing (except the geometry) and all edges.
+   * It allows to check if data derived from a graph and stored in a file is still valid for the current map.
+   *
+   * @returns the fingerprint.
+   */
+  uint64_t getFingerprint() const
+  {
+    return fingerprint_;
+  }
+
+private: // Aux Methods
+  uint64_t calcFingerprint() const;
+
+private:                                                   // Data Members
+  std::vector<Node> nodes_;                                ///< The nodes, sorted by lane identifier.
+  std::vector<Edge> edges_;                                ///< The edges of all nodes.
+  std::vector<LaneId> ids_;                                ///< The lane identifiers of the nodes for lookup.
+  std::vector<std::pair<LaneId, ContactLocation>> contacts_; ///< Contacts of the lanes added, until finalize().
+  LaneProvider laneProvider_;                              ///< Provides the lanes not kept by the graph.
+  uint64_t fingerprint_;                                   ///< Fingerprint of the graph, see getFingerprint().
+};
+
+} // namespace lane
+} // namespace map
+} // namespace ad
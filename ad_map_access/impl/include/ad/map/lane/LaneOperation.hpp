@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "ad/map/lane/LaneGraph.hpp"
 #include "ad/map/lane/LaneIdValidInputRange.hpp"
 #include "ad/map/lane/LaneValidInputRange.hpp"
 #include "ad/map/lane/Types.hpp"
@@ -66,6 +67,12 @@ Lane const &getLane(lane::LaneId const &id);
  */
 LaneIdList getLanes();
 
+/**
+ * @brief Method to be called to retrieve the routing graph of all Lanes in the Store.
+ * @returns Routing graph of the lanes in the store.
+ */
+LaneGraph::ConstPtr getLaneGraph();
+
 /**
 * @return lane heading at a mapMatchedPosition
 */
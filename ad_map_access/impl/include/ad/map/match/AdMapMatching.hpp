@@ -9,7 +9,11 @@
 #pragma once
 
 #include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
+#include "ad/map/lane/LaneIdSet.hpp"
 #include "ad/map/match/Types.hpp"
 #include "ad/map/point/Operation.hpp"
 #include "ad/map/route/Types.hpp"
@@ -18,9 +22,28 @@
 namespace ad {
 /* @brief namespace map */
 namespace map {
+/* @brief namespace lane */
+namespace lane {
+struct LaneSegmentIndex;
+} // namespace lane
 /* @brief namespace match */
 namespace match {
 
+/**
+ * @brief the way AdMapMatching::getMapMatchedBoundingBox() determines the lane regions covered by an object
+ */
+enum class BoundingBoxMatchingMode
+{
+  /**
+   * @brief intersect the footprint of the object with the lane geometry
+   */
+  Footprint,
+  /**
+   * @brief map match sampling points within the footprint of the object
+   */
+  Sampling
+};
+
 /**
  * @class AdMapMatching
  * @brief performs map matching of a given point to the map
@@ -77,6 +100,22 @@ public:
     return mRouteHintFactor;
   }
 
+  /**
+   * @brief set the way getMapMatchedBoundingBox() determines the lane regions covered by an object
+   */
+  void setBoundingBoxMatchingMode(BoundingBoxMatchingMode const boundingBoxMatchingMode)
+  {
+    mBoundingBoxMatchingMode = boundingBoxMatchingMode;
+  }
+
+  /**
+   * @brief get the way getMapMatchedBoundingBox() determines the lane regions covered by an object
+   */
+  BoundingBoxMatchingMode getBoundingBoxMatchingMode() const
+  {
+    return mBoundingBoxMatchingMode;
+  }
+
   /**
    * @brief add a hint for the heading of the vehicle/object
    *
@@ -122,10 +161,18 @@ public:
    *
    * @param[in] routeHint the route hint to consider
    */
-  void addRouteHint(route::FullRoute const &routeHint)
-  {
-    mRouteHints.push_back(routeHint);
-  }
+  void addRouteHint(route::FullRoute const &routeHint);
+
+  /**
+   * @brief shorten the route hints to start at the current position of the vehicle/object
+   *
+   * Each route hint is shortened like route::shortenRoute(); route hints becoming empty are removed.
+   * This is meant to follow the route of the vehicle each cycle: in contrast to clearing and adding the shortened
+   * route again, only the lanes of the leading road segments are updated.
+   *
+   * @param[in] currentPositions the positions which should mark the start of the route hints after shortening
+   */
+  void shortenRouteHints(point::ParaPointList const &currentPositions);
 
   /**
    * @brief clears the list of route hints
@@ -133,6 +180,7 @@ public:
   void clearRouteHints()
   {
     mRouteHints.clear();
+    mRouteHintLanes.clear();
   }
 
   /**
@@ -157,6 +205,35 @@ public:
                                                           physics::Distance const &distance,
                                                           physics::Probability const &minProbability);
 
+  /**
+   * @brief get the map matched positions
+   *
+   * Calculate the map matched positions and return these.
+   *
+   * @param[in] ecefPoint position to match against the map in ECEF coordinate frame
+   * @param[in] distance search radius around ecefPoint to select a lane as a match
+   * @param[in] minProbabilty A probability threshold to be considered for the results.
+   */
+  MapMatchedPositionConfidenceList getMapMatchedPositions(point::ECEFPoint const &ecefPoint,
+                                                          physics::Distance const &distance,
+                                                          physics::Probability const &minProbability);
+
+  /**
+   * @brief get the map matched positions within the given lanes
+   *
+   * Like getMapMatchedPositions(point::ECEFPoint const &, ...), but only the given lanes are considered instead of
+   * the lanes provided by the spatial search of the map.
+   *
+   * @param[in] laneIds the lanes to consider
+   * @param[in] ecefPoint position to match against the map in ECEF coordinate frame
+   * @param[in] distance search radius around ecefPoint to select a lane as a match
+   * @param[in] minProbabilty A probability threshold to be considered for the results.
+   */
+  MapMatchedPositionConfidenceList getMapMatchedPositions(lane::LaneIdList const &laneIds,
+                                                          point::ECEFPoint const &ecefPoint,
+                                                          physics::Distance const &distance,
+                                                          physics::Probability const &minProbability);
+
   /**
    * @brief get the map matched positions
    *
@@ -211,15 +288,23 @@ public:
    *
    * Calculate the map matched bounding box.
    * This will calculate the map matched positions of all the corner points and the center point
-   * In addition it will calculate all lane regions that are covered by the bounding box by sampling
-   * the objects geometry in between with the provided \c samplingDistance
+   * In addition it will calculate all lane regions that are covered by the bounding box:
+   * With BoundingBoxMatchingMode::Sampling (default) the objects geometry in between is sampled with the provided
+   * \c samplingDistance; with BoundingBoxMatchingMode::Footprint the footprint of the object is intersected with the
+   * lane geometry
+   *
+   * In BoundingBoxMatchingMode::Footprint, \c distance, \c minProbability and the map matching hints only apply to
+   * the map matched positions of the five reference points (and the lane regions derived from them). The footprint
+   * regions contain every lane the footprint intersects, independent of these parameters.
    *
    * @param[in] enuObjectPosition object position, orientation, dimensions and ENRReferencePoint
    *  to match against the map in ENU coordinate frame
-   * @param[in] distance search radius around geoPoint to select a lane as a match
-   * @param[in] minProbabilty A probability threshold to be considered for the results.
+   * @param[in] distance search radius around geoPoint to select a lane as a match; in
+   *   BoundingBoxMatchingMode::Footprint only used for the reference points
+   * @param[in] minProbabilty A probability threshold to be considered for the results; in
+   *   BoundingBoxMatchingMode::Footprint only used for the reference points
    * @param[in] samplingDistance The step size to be used to perform map matching in between the vehicle boundaries
-   *   This parameter is heavily influencing the performance of this function:
+   *   in BoundingBoxMatchingMode::Sampling. This parameter is heavily influencing the performance of this function:
    *   A samplingDistance of 0.1 at a car (3x5m) means 150x map matching. With a distance of 1. we get only 15x map
    * matching.
    *
@@ -231,26 +316,54 @@ public:
                                                        physics::Distance const &samplingDistance
                                                        = physics::Distance(1.));
 
+  /**
+   * @brief get the map matched bounding boxes of a list of objects
+   *
+   * Calculates getMapMatchedBoundingBox() for all entries of the list. The objects are independent of each other
+   * and are distributed over \a threadCount threads. The map matching hints must not be changed meanwhile.
+   *
+   * @param[in] enuObjectPositionList list of ENUObjectPosition entries
+   * @param[in] distance search radius around geoPoint to select a lane as a match; in
+   *   BoundingBoxMatchingMode::Footprint only used for the reference points, see getMapMatchedBoundingBox()
+   * @param[in] minProbabilty A probability threshold to be considered for the results; in
+   *   BoundingBoxMatchingMode::Footprint only used for the reference points, see getMapMatchedBoundingBox()
+   * @param[in] samplingDistance The step size to be used in BoundingBoxMatchingMode::Sampling.
+   * @param[in] threadCount Number of threads to be used.
+   *
+   * @returns the map matched bounding boxes in the order of the objects, independent of \a threadCount
+   */
+  std::vector<MapMatchedObjectBoundingBox>
+  getMapMatchedBoundingBoxes(ENUObjectPositionList const &enuObjectPositionList,
+                             physics::Distance const &distance,
+                             physics::Probability const &minProbability,
+                             physics::Distance const &samplingDistance = physics::Distance(1.),
+                             std::size_t const threadCount = 1u);
+
   /**
    * @brief get the lane occupied regions from a list of ENUObjectPositionList
    *
-   * Merge the lane occupied regions of the getMapMatchedBoundingBox() results of all
+   * Merge the lane occupied regions of the getMapMatchedBoundingBoxes() results of all
    * position entries. See getMapMatchedBoundingBox() for a detailed description.
+   * The regions are ordered by the first object occupying the lane.
    *
    * @param[in] enuObjectPositionList list of ENUObjectPosition entries
-   * @param[in] distance search radius around geoPoint to select a lane as a match
-   * @param[in] minProbabilty A probability threshold to be considered for the results.
+   * @param[in] distance search radius around geoPoint to select a lane as a match; in
+   *   BoundingBoxMatchingMode::Footprint only used for the reference points, see getMapMatchedBoundingBox()
+   * @param[in] minProbabilty A probability threshold to be considered for the results; in
+   *   BoundingBoxMatchingMode::Footprint only used for the reference points, see getMapMatchedBoundingBox()
    * @param[in] samplingDistance The step size to be used to perform map matching in between the vehicle boundaries
-   *   This parameter is heavily influencing the performance of this function:
+   *   in BoundingBoxMatchingMode::Sampling. This parameter is heavily influencing the performance of this function:
    *   A samplingDistance of 0.1 at a car (3x5m) means 150x map matching. With a distance of 1. we get only 15x map
    * matching.
+   * @param[in] threadCount Number of threads matching the objects, see getMapMatchedBoundingBoxes().
    *
-   * @returns the map matched bounding box of the object
+   * @returns the lane occupied regions of all objects
    */
-  LaneOccupiedRegionList getLaneOccupiedRegions(ENUObjectPositionList enuObjectPositionList,
+  LaneOccupiedRegionList getLaneOccupiedRegions(ENUObjectPositionList const &enuObjectPositionList,
                                                 physics::Distance const &distance,
                                                 physics::Probability const &minProbability,
-                                                physics::Distance const &samplingDistance = physics::Distance(1.));
+                                                physics::Distance const &samplingDistance = physics::Distance(1.),
+                                                std::size_t const threadCount = 1u);
 
   /**
    * @brief Method to be called to retrieve the lane heading at a mapMatchedPosition
@@ -291,9 +404,40 @@ private:
   AdMapMatching &operator=(AdMapMatching &&) = delete;
   AdMapMatching &operator=(AdMapMatching const &) = delete;
 
+  /**
+   * @brief the segment indices of lanes near a position, searched once for all points of an object
+   */
+  typedef std::vector<std::shared_ptr<lane::LaneSegmentIndex const>> LaneCandidateList;
+
+  static LaneCandidateList getLaneCandidates(point::BoundingSphere const &boundingSphere);
+
+  static MapMatchedPositionConfidenceList findLanes(LaneCandidateList const &laneCandidates,
+                                                    point::ECEFPoint const &ecefPoint,
+                                                    physics::Distance const &distance);
+
   static match::MapMatchedPositionConfidenceList findLanesInputChecked(point::ECEFPoint const &ecefPoint,
                                                                        physics::Distance const &distance);
 
+  static match::MapMatchedPositionConfidenceList findLanesInputChecked(LaneCandidateList const &laneCandidates,
+                                                                       point::ECEFPoint const &ecefPoint,
+                                                                       physics::Distance const &distance);
+
+  MapMatchedPositionConfidenceList getMapMatchedPositions(LaneCandidateList const &laneCandidates,
+                                                          point::ECEFPoint const &ecefPoint,
+                                                          physics::Distance const &distance,
+                                                          physics::Probability const &minProbability);
+
+  /**
+   * @brief calculate the regions of the lanes covered by the footprint of the object
+   *
+   * The footprint is intersected with the polygons spanned by the lane borders. The parametric ranges are derived
+   * from points sampled densely along the border of each intersection, so the result doesn't depend on the
+   * \c samplingDistance of getMapMatchedBoundingBox().
+   */
+  static LaneOccupiedRegionList getFootprintLaneRegions(LaneCandidateList const &laneCandidates,
+                                                        ENUObjectPosition const &enuObjectPosition,
+                                                        point::CoordinateTransform const &coordinateTransform);
+
   /**
    * @brief extract the mapMatchedPositions and write them into a map of occuppied regions
    *
@@ -308,13 +452,17 @@ private:
 
   MapMatchedPositionConfidenceList considerMapMatchingHints(MapMatchedPositionConfidenceList const &mapMatchedPositions,
                                                             physics::Probability const &minProbability);
+  void addRouteHintLanes(route::RoadSegmentList::const_iterator begin, route::RoadSegmentList::const_iterator end);
+  void removeRouteHintLanes(route::RoadSegmentList::const_iterator begin, route::RoadSegmentList::const_iterator end);
   bool isLanePartOfRouteHints(lane::LaneId const &laneId);
   double getHeadingFactor(MapMatchedPosition const &matchedPosition);
 
   std::list<point::ECEFHeading> mHeadingHints;
   double mHeadingHintFactor{2.};
   std::list<route::FullRoute> mRouteHints;
+  std::unordered_map<lane::LaneId, std::size_t, lane::LaneIdHash> mRouteHintLanes; ///< lane segments per lane
   double mRouteHintFactor{10.};
+  BoundingBoxMatchingMode mBoundingBoxMatchingMode{BoundingBoxMatchingMode::Sampling};
 };
 
 } // namespace match
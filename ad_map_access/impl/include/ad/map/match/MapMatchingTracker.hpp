@@ -0,0 +1,177 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "ad/map/access/Store.hpp"
+#include "ad/map/match/AdMapMatching.hpp"
+#include "ad/map/point/BoundingSphere.hpp"
+
+/* @brief namespace admap */
+namespace ad {
+/* @brief namespace map */
+namespace map {
+/* @brief namespace match */
+namespace match {
+
+/**
+ * @class MapMatchingTracker
+ * @brief performs map matching of tracked objects, reusing the lanes found in the previous frames
+ *
+ * A tracked object moves only a small distance between two frames. Therefore, the spatial search of the map is
+ * performed with the search distance enlarged by a margin and the lanes found are remembered per object. As long as
+ * the object stays within the margin around the position of that search, the remembered lanes contain all lanes
+ * the spatial search would return and the object is matched against these directly.
+ * The results are the same as the ones of AdMapMatching::getMapMatchedPositions().
+ * The remembered lanes belong to the store they were found in. If a query sees another store, e.g. because a patch
+ * was applied or the map was cleaned up and initialized again, the lanes of all objects are forgotten.
+ */
+class MapMatchingTracker
+{
+public:
+  /**
+   * @brief identifier of a tracked object
+   */
+  typedef uint64_t ObjectId;
+
+  /**
+   * @brief Counters of the tracker.
+   */
+  struct TrackingStatistics
+  {
+    std::size_t localHits{0u};      ///< Matches answered by the remembered lanes.
+    std::size_t localMisses{0u};    ///< Matches where the object left the margin of the remembered lanes.
+    std::size_t globalSearches{0u}; ///< Spatial searches of the map, including the ones of new objects.
+  };
+
+  /**
+   * @brief constructor
+   *
+   * @param[in] searchMargin distance added to the search distance of the spatial searches.
+   *   A larger margin causes less spatial searches, but more lanes to check per match.
+   */
+  explicit MapMatchingTracker(physics::Distance const &searchMargin = physics::Distance(5.))
+    : mSearchMargin(searchMargin)
+  {
+  }
+
+  /**
+   * @brief destructor
+   */
+  ~MapMatchingTracker() = default;
+
+  /**
+   * @returns the map matching used for the searches, e.g. to set map matching hints
+   */
+  AdMapMatching &getMapMatching()
+  {
+    return mMapMatching;
+  }
+
+  /**
+   * @brief get the map matched positions of a tracked object
+   *
+   * @param[in] objectId identifier of the object
+   * @param[in] ecefPoint position of the object
+   * @param[in] distance search radius around ecefPoint to select a lane as a match
+   * @param[in] minProbabilty A probability threshold to be considered for the results.
+   *
+   * The lanes near the object are remembered for the next calls with the same \c objectId.
+   */
+  MapMatchedPositionConfidenceList getMapMatchedPositions(ObjectId const objectId,
+                                                          point::ECEFPoint const &ecefPoint,
+                                                          physics::Distance const &distance,
+                                                          physics::Probability const &minProbability);
+
+  /**
+   * @brief get the map matched positions of a tracked object
+   *
+   * @param[in] objectId identifier of the object
+   * @param[in] enuObjectPosition object position, orientation and ENUReferencePoint
+   * @param[in] distance search radius around the object center to select a lane as a match
+   * @param[in] minProbabilty A probability threshold to be considered for the results.
+   *
+   * Like AdMapMatching::getMapMatchedPositions(ENUObjectPosition const &, ...), the orientation of the object is
+   * considered as heading hint.
+   */
+  MapMatchedPositionConfidenceList getMapMatchedPositions(ObjectId const objectId,
+                                                          ENUObjectPosition const &enuObjectPosition,
+                                                          physics::Distance const &distance,
+                                                          physics::Probability const &minProbability);
+
+  /**
+   * @brief forget the lanes of an object, e.g. if its track is lost
+   */
+  void removeObject(ObjectId const objectId);
+
+  /**
+   * @brief forget the lanes of all objects
+   *
+   * Not required if the map changes, this is detected by the tracker itself.
+   */
+  void clear();
+
+  /**
+   * @returns the number of tracked objects
+   */
+  std::size_t size() const
+  {
+    return mObjectLanes.size();
+  }
+
+  /**
+   * @returns the counters of the tracker
+   */
+  TrackingStatistics const &getStatistics() const
+  {
+    return mStatistics;
+  }
+
+  /**
+   * @returns the share of matches answered by the remembered lanes, 0 if nothing was matched yet
+   */
+  double getHitRate() const;
+
+  /**
+   * @brief reset the counters of the tracker
+   */
+  void resetStatistics()
+  {
+    mStatistics = TrackingStatistics();
+  }
+
+private:
+  // Copy operators and constructors are deleted to avoid accidental copies
+  MapMatchingTracker(MapMatchingTracker const &) = delete;
+  MapMatchingTracker(MapMatchingTracker &&) = delete;
+  MapMatchingTracker &operator=(MapMatchingTracker &&) = delete;
+  MapMatchingTracker &operator=(MapMatchingTracker const &) = delete;
+
+  /**
+   * @brief the lanes found by the last spatial search for an object
+   */
+  struct ObjectLanes
+  {
+    point::BoundingSphere searchSphere; ///< The sphere of the spatial search.
+    lane::LaneIdList laneIds;           ///< The lanes within the sphere.
+  };
+
+  AdMapMatching mMapMatching;
+  physics::Distance mSearchMargin;
+  // the store the lanes were found in, not kept alive by the tracker
+  std::weak_ptr<access::Store> mStore;
+  std::unordered_map<ObjectId, ObjectLanes> mObjectLanes;
+  TrackingStatistics mStatistics;
+};
+
+} // namespace match
+} // namespace map
+} // namespace ad
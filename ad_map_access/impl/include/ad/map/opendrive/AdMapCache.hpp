@@ -0,0 +1,139 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <string>
+#include "ad/map/access/Store.hpp"
+#include "ad/map/intersection/IntersectionType.hpp"
+
+/** @brief namespace ad */
+namespace ad {
+/** @brief namespace map */
+namespace map {
+/** @brief namespace opendrive */
+namespace opendrive {
+
+/**
+ * @class AdMapCache
+ * @brief On-disk cache of AdMaps converted from OpenDRIVE content
+ *
+ * Converting OpenDRIVE content parses the xml, generates the lane geometry and creates the AdMap via the
+ * AdMapFactory. The cache stores the resulting Store as adm file, so identical content converted with identical
+ * parameters is loaded from the binary map afterwards.
+ *
+ * An entry is named by a hash of the OpenDRIVE content, the overlap margin, the default intersection type, the
+ * ENU reference point the conversion starts with and the map file version. Changing any of these invalidates
+ * the entry. If the entries exceed the size limit, the least recently used ones are removed.
+ * Several processes may share the cache directory: an entry is written to a temporary file which is renamed
+ * when complete.
+ */
+class AdMapCache
+{
+public:
+  /**
+   * @brief Version of the entries, to be increased if the conversion creates different maps.
+   */
+  static constexpr uint32_t VERSION = 1u;
+
+  /**
+   * @brief Create a disabled cache.
+   */
+  AdMapCache() = default;
+
+  /**
+   * @brief Create a cache within the given directory.
+   * @param[in] directory The cache directory, created if not existing. An empty directory disables the cache.
+   * @param[in] maxSize Maximal size of all entries in bytes, 0 for unlimited.
+   */
+  explicit AdMapCache(std::string const &directory, std::size_t maxSize = 0u);
+
+  /**
+   * @returns true if a cache directory is given.
+   */
+  bool isEnabled() const;
+
+  /**
+   * @returns the cache directory.
+   */
+  std::string const &directory() const;
+
+  /**
+   * @returns the maximal size of all entries in bytes, 0 if unlimited.
+   */
+  std::size_t maxSize() const;
+
+  /**
+   * @brief Load the map from the cache or read and convert the OpenDRIVE map file and add the result to the cache.
+   * @see createAdMapFromString()
+   */
+  access::Store::Ptr createAdMap(std::string const &mapFilePath,
+                                 double const overlapMargin,
+                                 intersection::IntersectionType const defaultIntersectionType);
+
+  /**
+   * @brief Load the map from the cache or convert the OpenDRIVE content and add the result to the cache.
+   *
+   * Like AdMapFactory::createAdMapFromString(), the ENU reference point is set to the one of the map.
+   * If the cache is disabled, the content is just converted.
+   *
+   * @param[in] mapContent The OpenDRIVE content.
+   * @param[in] overlapMargin margin the lanes are narrowed when calculating overlaps.
+   * @param[in] defaultIntersectionType default type of intersections to be used
+   * @returns the Store with the map, nullptr if the content can't be converted.
+   */
+  access::Store::Ptr createAdMapFromString(std::string const &mapContent,
+                                           double const overlapMargin,
+                                           intersection::IntersectionType const defaultIntersectionType);
+
+  /**
+   * @brief Get the name of the entry of the given OpenDRIVE content and conversion parameters.
+   *
+   * The name depends on the current ENU reference point, which is used for conversion if the content doesn't
+   * provide one, so it has to be determined right before the conversion.
+   */
+  std::string getEntryName(std::string const &mapContent,
+                           double const overlapMargin,
+                           intersection::IntersectionType const defaultIntersectionType) const;
+
+  /**
+   * @brief Load the Store of the given entry and set the ENU reference point stored with it.
+   * @param[in] entryName The name of the entry.
+   * @returns the loaded Store, nullptr if the entry doesn't exist or can't be read.
+   */
+  access::Store::Ptr load(std::string const &entryName) const;
+
+  /**
+   * @brief Save the Store and the current ENU reference point as given entry and apply the size limit.
+   * @param[in] entryName The name of the entry.
+   * @param[in] store The converted Store.
+   * @returns \c true if the entry was written.
+   */
+  bool save(std::string const &entryName, access::Store &store);
+
+  /**
+   * @brief Remove all entries.
+   */
+  void clear();
+
+  /**
+   * @returns the size of all entries in bytes.
+   */
+  std::size_t size() const;
+
+private:
+  std::string getEntryFileName(std::string const &entryName) const;
+  void limitSize(std::string const &keptEntryName);
+
+  std::string mDirectory{}; //!< the cache directory, empty if disabled
+  std::size_t mMaxSize{0u}; //!< the maximal size of all entries in bytes, 0 if unlimited
+};
+
+} // namespace opendrive
+} // namespace map
+} // namespace ad
@@ -121,6 +121,16 @@ public: // ECEF/ENU Conversions
    */
   ENUPoint ECEF2ENU(const ECEFPoint &pt) const;
 
+  /**
+   * @brief Convert all points of an edge between coordinate systems.
+   *
+   * The ENU reference point is checked once for the whole edge. The points themselves are not checked, so the
+   * edge must be valid (e.g. the edge of a valid Geometry).
+   * @param[in] edge Source edge.
+   * @returns Edge in the target coordinate system.
+   */
+  ENUEdge ECEF2ENU(const ECEFEdge &edge) const;
+
 public: // Useful methods
   /**
    * @brief Calculates Earth Radius at specific latitude.
@@ -40,16 +40,24 @@ inline bool isValid(Geometry const &geometry)
 Geometry createGeometry(const ECEFEdge &points, bool closed);
 
 /**
- * @brief get the cached ENUEdge for a geometry
+ * @brief get the ENUEdge for a geometry
  * @param[in] geometry the geometry to work on
  * @returns Polyline that defines this Geometry in the ENU frame.
  * \note    Prior to the method call, valid coordinate transformation object must
  *          be set using SetCoordinateTransform().
- *          ENU geometry will be calculated on-the-fly if
- *          - it was not previously calculated, or
- *          - ENU reference point has been changed.
+ *          ENU geometry is calculated on-the-fly w.r.t. the current ENU reference point.
+ *          The geometry is not modified, so the function can be called from several threads concurrently.
  */
-ENUEdge getCachedENUEdge(Geometry const &geometry);
+ENUEdge getENUEdge(Geometry const &geometry);
+
+/**
+ * @brief get the ENUEdge for a geometry
+ * @deprecated The ENU edge isn't cached anymore, use getENUEdge() instead.
+ */
+inline ENUEdge getCachedENUEdge(Geometry const &geometry)
+{
+  return getENUEdge(geometry);
+}
 
 /**
  * @brief Checks if Geometry is longitudinally connected with another Geometry at the end.
@@ -116,7 +124,7 @@ void getParametricRange(Geometry const &geometry,
 
 /**
  * @brief Generates sub-geometry for given range.
- * This overloaded member internally makes use of the getCachedENUEdge() feature of the geometry.
+ * Only the points of the requested range are transformed into the ENU frame.
  *
  * @param[in] geometry source geometry.
  * @param[in] trange Specifies parametric range.
@@ -20,6 +20,8 @@ namespace ad {
 namespace map {
 namespace point {
 
+class CoordinateTransform;
+
 /**
  * @brief create a heading in ECEF as a directional vector
  *
@@ -40,6 +42,16 @@ ECEFHeading createECEFHeading(ECEFPoint const &start, ECEFPoint const &end);
  */
 ECEFHeading createECEFHeading(ENUHeading const &yaw, GeoPoint const &enuReferencePoint);
 
+/**
+ * @brief create a heading in ECEF as a directional vector
+ *
+ * @param[in] yaw ENUHeading the heading in ENU coordinate frame
+ * @param[in] coordinateTransform the coordinate transform with the ENU reference point set
+ *
+ * @returns heading in ECEF as directional vector
+ */
+ECEFHeading createECEFHeading(ENUHeading const &yaw, CoordinateTransform const &coordinateTransform);
+
 /**
  * @brief create a ENUHeading from yaw angle in radians
  *
@@ -0,0 +1,158 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ad/map/lane/LaneGraph.hpp"
+#include "ad/map/serialize/ISerializer.hpp"
+
+/* @brief namespace ad */
+namespace ad {
+/* @brief namespace map */
+namespace map {
+/* @brief namespace route */
+namespace route {
+/**
+ * @namespace planning
+ * @brief provides route planning capabilities on the road network of the map
+ */
+namespace planning {
+
+/**
+ * @brief Lower bounds of the routing cost based on landmarks and the triangle inequality (ALT).
+ *
+ * For a small set of landmark points, the routing cost to all points at the start and end of the lanes is
+ * precomputed. The costs are calculated on a relaxed version of the routing graph of RouteAstar, which ignores the
+ * lane directions and the lane types. As lateral lane changes are possible at any parametric offset, the length of
+ * each lane is reduced to the length of the shortest lane connected to it by lateral contacts. Therefore,
+ * |cost(landmark, a) - cost(landmark, b)| is a lower bound of the routing cost from a to b.
+ *
+ * The tables only depend on the map and can be stored alongside the map file, see getFileName().
+ * The bounds are used by the unidirectional search of RouteAstar only, there is no bidirectional variant. They
+ * tighten the estimate only at lane borders, so the number of expanded points drops moderately on city-sized maps;
+ * the routing_benchmark tool reports the numbers for a given map.
+ */
+class AltHeuristic
+{
+public: // Types
+  typedef std::shared_ptr<AltHeuristic const> ConstPtr;
+
+public: // Constructor/Destructor
+  /**
+   * @brief Default constructor.
+   *        Creates an invalid instance.
+   */
+  AltHeuristic() = default;
+
+  /**
+   * @brief Destructor.
+   */
+  ~AltHeuristic() = default;
+
+public: // Operations
+  /**
+   * @brief Calculates the landmark tables.
+   * @param[in] laneGraph     The lane graph to calculate the tables for.
+   * @param[in] landmarkCount The number of landmarks to select.
+   * @returns true if successful.
+   */
+  bool build(lane::LaneGraph const &laneGraph, std::size_t const landmarkCount = 8u);
+
+  /**
+   * @brief Stores the landmark tables in a file.
+   * @param[in] fileName Name of the file.
+   * @returns true if successful.
+   */
+  bool save(std::string const &fileName);
+
+  /**
+   * @brief Reads the landmark tables from a file.
+   * @param[in] fileName Name of the file.
+   * @returns true if successful.
+   */
+  bool load(std::string const &fileName);
+
+  /**
+   * @returns the name of the file to store the landmark tables of the given map file in.
+   */
+  static std::string getFileName(std::string const &mapFileName);
+
+  /**
+   * @returns true if landmark tables are present.
+   */
+  bool isValid() const
+  {
+    return landmarkCount_ > 0u;
+  }
+
+  /**
+   * @returns true if the landmark tables were calculated on a lane graph identical to the given one.
+   */
+  bool isValidFor(lane::LaneGraph const &laneGraph) const;
+
+  /**
+   * @returns the number of landmarks.
+   */
+  std::size_t getLandmarkCount() const
+  {
+    return landmarkCount_;
+  }
+
+  /**
+   * @brief Calculates the routing costs between the landmarks and a destination.
+   * @param[in] laneGraph   The lane graph, isValidFor() has to be true.
+   * @param[in] destination The destination point.
+   * @returns The costs to be passed to getLowerBound().
+   */
+  std::vector<double> getDestinationCosts(lane::LaneGraph const &laneGraph, point::ParaPoint const &destination) const;
+
+  /**
+   * @brief Provides a lower bound of the routing cost from a point at the start or end of a lane to the destination.
+   * @param[in] node             Index of the node of the lane.
+   * @param[in] atLaneEnd        true for the end of the lane, false for the start.
+   * @param[in] destinationCosts The result of getDestinationCosts().
+   * @returns The lower bound.
+   */
+  double getLowerBound(lane::LaneGraph::NodeIndex const node,
+                       bool const atLaneEnd,
+                       std::vector<double> const &destinationCosts) const
+  {
+    double lowerBound = 0.;
+    auto const costs = costs_.data() + (2u * node + (atLaneEnd ? 1u : 0u)) * landmarkCount_;
+    for (std::size_t i = 0u; i < landmarkCount_; ++i)
+    {
+      // skip landmarks not connected to both points
+      if ((costs[i] >= 0.) && (destinationCosts[i] >= 0.))
+      {
+        lowerBound = std::max(lowerBound, std::fabs(costs[i] - destinationCosts[i]));
+      }
+    }
+    return lowerBound;
+  }
+
+private: // Aux Methods
+  bool serialize(serialize::ISerializer &serializer);
+
+private:                            // Data Members
+  std::size_t landmarkCount_{0u};   ///< Number of landmarks.
+  uint64_t fingerprint_{0u};        ///< Fingerprint of the lane graph the tables were calculated on.
+  std::vector<uint64_t> landmarks_; ///< Border point index (2 * node index + at lane end) of each landmark.
+  std::vector<double> costs_;       ///< Cost of each border point to each landmark, -1 if not connected.
+  std::vector<double> lengths_;     ///< Relaxed length of each lane, -1 if not available.
+};
+
+} // namespace planning
+} // namespace route
+} // namespace map
+} // namespace ad
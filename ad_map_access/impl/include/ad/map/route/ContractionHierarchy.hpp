@@ -0,0 +1,211 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ad/map/lane/LaneGraph.hpp"
+#include "ad/map/route/Routing.hpp"
+#include "ad/map/serialize/ISerializer.hpp"
+
+/* @brief namespace ad */
+namespace ad {
+/* @brief namespace map */
+namespace map {
+/* @brief namespace route */
+namespace route {
+/**
+ * @namespace planning
+ * @brief provides route planning capabilities on the road network of the map
+ */
+namespace planning {
+
+/**
+ * @brief Contraction hierarchy of the routing graph of RouteAstar for routes of type Route::Type::SHORTEST.
+ *
+ * The nodes of the hierarchy are the routing points at the start and end of the lanes for each routing direction.
+ * Its edges are the transitions RouteAstar performs between them, with the same costs. The nodes are contracted
+ * one after the other, adding shortcut edges where required to preserve the shortest paths between the remaining
+ * nodes. A query then only has to follow edges towards nodes contracted later, which keeps the search space small.
+ *
+ * The hierarchy only depends on the map and can be precomputed and stored alongside the map file, see
+ * getFileName(). Use RouteContractionHierarchy to calculate routes.
+ */
+class ContractionHierarchy
+{
+public: // Types
+  typedef std::shared_ptr<ContractionHierarchy const> ConstPtr;
+
+  typedef uint32_t NodeIndex;
+
+  //! index of an invalid node
+  static constexpr NodeIndex cInvalidNodeIndex = std::numeric_limits<NodeIndex>::max();
+
+  /**
+   * @brief Edge of the hierarchy.
+   */
+  struct Edge
+  {
+    NodeIndex node;   ///< The other node of the edge, i.e. the target of an upward and the source of a downward edge.
+    NodeIndex middle; ///< The contracted node bridged by a shortcut, cInvalidNodeIndex for original edges.
+    double cost;      ///< Routing cost of the edge.
+  };
+
+  /**
+   * @brief Start or end node of a search with its initial cost.
+   */
+  struct SearchSeed
+  {
+    NodeIndex node;
+    double cost;
+  };
+
+public: // Constructor/Destructor
+  /**
+   * @brief Default constructor.
+   *        Creates an invalid instance.
+   */
+  ContractionHierarchy() = default;
+
+  /**
+   * @brief Destructor.
+   */
+  ~ContractionHierarchy() = default;
+
+public: // Operations
+  /**
+   * @brief Calculates the hierarchy.
+   * @param[in] laneGraph The lane graph to calculate the hierarchy for.
+   * @returns true if successful.
+   */
+  bool build(lane::LaneGraph const &laneGraph);
+
+  /**
+   * @brief Stores the hierarchy in a file.
+   * @param[in] fileName Name of the file.
+   * @returns true if successful.
+   */
+  bool save(std::string const &fileName);
+
+  /**
+   * @brief Reads the hierarchy from a file.
+   * @param[in] fileName Name of the file.
+   * @returns true if successful.
+   */
+  bool load(std::string const &fileName);
+
+  /**
+   * @returns the name of the file to store the hierarchy of the given map file in.
+   */
+  static std::string getFileName(std::string const &mapFileName);
+
+  /**
+   * @returns true if the hierarchy is present.
+   */
+  bool isValid() const
+  {
+    return !upwardEdgeBegin_.empty();
+  }
+
+  /**
+   * @returns true if the hierarchy was calculated on a lane graph identical to the given one.
+   */
+  bool isValidFor(lane::LaneGraph const &laneGraph) const;
+
+  /**
+   * @returns the number of nodes.
+   */
+  std::size_t size() const
+  {
+    return rank_.size();
+  }
+
+  /**
+   * @returns the number of edges including the shortcuts.
+   */
+  std::size_t getEdgeCount() const
+  {
+    return upwardEdges_.size() + downwardEdges_.size();
+  }
+
+  /**
+   * @returns the node of the routing point at the start or end of a lane.
+   * @param[in] lane      Index of the lane within the lane graph.
+   * @param[in] atLaneEnd true for the end of the lane, false for the start.
+   * @param[in] direction The routing direction.
+   */
+  static NodeIndex getNodeIndex(lane::LaneGraph::NodeIndex const lane,
+                                bool const atLaneEnd,
+                                RoutingDirection const direction)
+  {
+    return 6u * lane + (atLaneEnd ? 3u : 0u) + static_cast<NodeIndex>(direction);
+  }
+
+  /**
+   * @returns the index of the lane within the lane graph of the given node.
+   */
+  static lane::LaneGraph::NodeIndex getLaneIndex(NodeIndex const node)
+  {
+    return node / 6u;
+  }
+
+  /**
+   * @returns true if the given node is located at the end of its lane.
+   */
+  static bool isAtLaneEnd(NodeIndex const node)
+  {
+    return (node % 6u) >= 3u;
+  }
+
+  /**
+   * @returns the routing direction of the given node.
+   */
+  static RoutingDirection getRoutingDirection(NodeIndex const node)
+  {
+    return static_cast<RoutingDirection>(node % 3u);
+  }
+
+  /**
+   * @brief Searches the cheapest path from one of the sources to one of the targets.
+   *
+   * @param[in] sources      The start nodes of the path with their initial cost.
+   * @param[in] targets      The end nodes of the path with the cost to be added when reaching them.
+   * @param[in] maximumCost  Only paths cheaper than this are searched for.
+   * @param[out] path        The nodes of the path, including all nodes bridged by shortcuts.
+   * @returns The cost of the path including the costs of its source and target,
+   *          infinity if there is no path cheaper than \a maximumCost.
+   */
+  double findPath(std::vector<SearchSeed> const &sources,
+                  std::vector<SearchSeed> const &targets,
+                  double const maximumCost,
+                  std::vector<NodeIndex> &path) const;
+
+private: // Aux Methods
+  bool serialize(serialize::ISerializer &serializer);
+
+  Edge const &findEdge(NodeIndex const source, NodeIndex const target) const;
+
+  void unpackEdge(NodeIndex const source, NodeIndex const target, std::vector<NodeIndex> &path) const;
+
+private:                                    // Data Members
+  uint64_t fingerprint_{0u};                ///< Fingerprint of the lane graph the hierarchy was calculated on.
+  std::vector<uint32_t> rank_;              ///< Contraction order of each node.
+  std::vector<uint32_t> upwardEdgeBegin_;   ///< Index of the first upward edge of each node, plus the end.
+  std::vector<Edge> upwardEdges_;           ///< Edges to nodes of higher rank, grouped by their source.
+  std::vector<uint32_t> downwardEdgeBegin_; ///< Index of the first downward edge of each node, plus the end.
+  std::vector<Edge> downwardEdges_;         ///< Edges from nodes of higher rank, grouped by their target.
+};
+
+} // namespace planning
+} // namespace route
+} // namespace map
+} // namespace ad
@@ -0,0 +1,242 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+/* @brief namespace ad */
+namespace ad {
+/* @brief namespace map */
+namespace map {
+/* @brief namespace route */
+namespace route {
+/**
+ * @namespace planning
+ * @brief provides route planning capabilities on the road network of the map
+ */
+namespace planning {
+
+/**
+ * @brief Priority queue with unique keys supporting the update of the priority of its elements.
+ *
+ * The elements are stored in a map ordered by their keys. In addition, a binary heap ordered by the values
+ * refers to the map entries and each entry keeps its position within the heap.
+ * This way, insertion, removal and update of an element take O(log n), while access to the element with
+ * the smallest value takes O(1).
+ *
+ * The Less comparator has to define a strict weak ordering on the values.
+ */
+template <class Key, class Value, class Less> class IndexedPriorityQueue
+{
+public:
+  /**
+   * @brief entry of the queue
+   */
+  struct Element
+  {
+    Value value;
+    std::size_t heapIndex; ///< Position of the element within the heap; managed by the queue.
+  };
+
+  typedef std::map<Key, Element> ElementMap;
+  typedef typename ElementMap::iterator iterator;
+  typedef typename ElementMap::const_iterator const_iterator;
+
+  /**
+   * @brief Inserts an element, if there is no element with the same key yet.
+   * @param[in] key   Key of the element.
+   * @param[in] value Value of the element.
+   * @returns pair of the iterator to the element with the given key and a flag
+   *          indicating if the insertion took place.
+   */
+  std::pair<iterator, bool> insert(Key const &key, Value const &value)
+  {
+    auto insertResult = mElements.insert({key, Element{value, mHeap.size()}});
+    if (insertResult.second)
+    {
+      mHeap.push_back(insertResult.first);
+      siftUp(mHeap.size() - 1u);
+    }
+    return insertResult;
+  }
+
+  /**
+   * @brief Restores the heap order after the value of the given element was changed.
+   */
+  void update(iterator element)
+  {
+    siftDown(siftUp(element->second.heapIndex));
+  }
+
+  /**
+   * @brief Removes the given element.
+   */
+  void erase(iterator element)
+  {
+    auto const heapIndex = element->second.heapIndex;
+    auto const lastIndex = mHeap.size() - 1u;
+    if (heapIndex != lastIndex)
+    {
+      swap(heapIndex, lastIndex);
+    }
+    mHeap.pop_back();
+    mElements.erase(element);
+    if (heapIndex < mHeap.size())
+    {
+      siftDown(siftUp(heapIndex));
+    }
+  }
+
+  /**
+   * @returns the element with the smallest value. The queue must not be empty.
+   */
+  iterator top() const
+  {
+    return mHeap.front();
+  }
+
+  /**
+   * @brief Visits the elements with a value accepted by the given predicate.
+   *
+   * The predicate has to be monotonic with respect to the ordering: if it rejects a value, it has to reject all
+   * larger values as well. This allows to skip whole sub-trees of the heap. The elements are visited in heap order.
+   *
+   * @param[in] predicate Predicate taking a value.
+   * @param[in] visitor   Function taking an iterator of the element.
+   */
+  template <class Predicate, class Visitor> void visit(Predicate predicate, Visitor visitor) const
+  {
+    if (mHeap.empty())
+    {
+      return;
+    }
+    std::vector<std::size_t> heapIndices{0u};
+    while (!heapIndices.empty())
+    {
+      auto const heapIndex = heapIndices.back();
+      heapIndices.pop_back();
+      if (predicate(mHeap[heapIndex]->second.value))
+      {
+        visitor(mHeap[heapIndex]);
+        for (auto child = 2u * heapIndex + 1u; (child <= 2u * heapIndex + 2u) && (child < mHeap.size()); ++child)
+        {
+          heapIndices.push_back(child);
+        }
+      }
+    }
+  }
+
+  //! @returns iterator to the element with the smallest key
+  iterator begin()
+  {
+    return mElements.begin();
+  }
+
+  //! @returns iterator past the element with the largest key
+  iterator end()
+  {
+    return mElements.end();
+  }
+
+  //! @returns iterator to the element with the smallest key
+  const_iterator begin() const
+  {
+    return mElements.begin();
+  }
+
+  //! @returns iterator past the element with the largest key
+  const_iterator end() const
+  {
+    return mElements.end();
+  }
+
+  //! @returns true if the queue is empty
+  bool empty() const
+  {
+    return mElements.empty();
+  }
+
+  //! @returns the number of elements in the queue
+  std::size_t size() const
+  {
+    return mElements.size();
+  }
+
+  //! removes all elements
+  void clear()
+  {
+    mHeap.clear();
+    mElements.clear();
+  }
+
+private:
+  bool less(std::size_t left, std::size_t right) const
+  {
+    return mLess(mHeap[left]->second.value, mHeap[right]->second.value);
+  }
+
+  void swap(std::size_t left, std::size_t right)
+  {
+    std::swap(mHeap[left], mHeap[right]);
+    mHeap[left]->second.heapIndex = left;
+    mHeap[right]->second.heapIndex = right;
+  }
+
+  std::size_t siftUp(std::size_t heapIndex)
+  {
+    while (heapIndex > 0u)
+    {
+      auto const parent = (heapIndex - 1u) / 2u;
+      if (!less(heapIndex, parent))
+      {
+        break;
+      }
+      swap(heapIndex, parent);
+      heapIndex = parent;
+    }
+    return heapIndex;
+  }
+
+  std::size_t siftDown(std::size_t heapIndex)
+  {
+    for (;;)
+    {
+      auto smallest = heapIndex;
+      auto const left = 2u * heapIndex + 1u;
+      auto const right = left + 1u;
+      if ((left < mHeap.size()) && less(left, smallest))
+      {
+        smallest = left;
+      }
+      if ((right < mHeap.size()) && less(right, smallest))
+      {
+        smallest = right;
+      }
+      if (smallest == heapIndex)
+      {
+        break;
+      }
+      swap(heapIndex, smallest);
+      heapIndex = smallest;
+    }
+    return heapIndex;
+  }
+
+  ElementMap mElements;
+  std::vector<iterator> mHeap;
+  Less mLess;
+};
+
+} // namespace planning
+} // namespace route
+} // namespace map
+} // namespace ad
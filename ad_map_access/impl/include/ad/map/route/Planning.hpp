@@ -10,6 +10,8 @@
 
 #include "ad/map/config/PointOfInterest.hpp"
 #include "ad/map/match/MapMatchedObjectBoundingBox.hpp"
+#include "ad/map/route/AltHeuristic.hpp"
+#include "ad/map/route/ContractionHierarchy.hpp"
 #include "ad/map/route/Routing.hpp"
 #include "ad/map/route/Types.hpp"
 
@@ -79,6 +81,26 @@ RoutingParaPoint createRoutingPoint(match::LaneOccupiedRegion const &occupiedReg
 */
 route::FullRoute planRoute(const RoutingParaPoint &start, const RoutingParaPoint &dest);
 
+/** @brief Calculates route between two points using landmark tables to speed up the search.
+* The resulting route is as short as the one provided by planRoute() without landmark tables.
+* @param[in] start Start point as RoutingParaPoint (Be aware: routing direction in respect to lane orientation!).
+* @param[in] dest  Destination point as RoutingParaPoint (Be aware: routing direction in respect to lane orientation!).
+* @param[in] altHeuristic The landmark tables, see planning::AltHeuristic.
+*/
+route::FullRoute planRoute(const RoutingParaPoint &start,
+                           const RoutingParaPoint &dest,
+                           AltHeuristic::ConstPtr const &altHeuristic);
+
+/** @brief Calculates route between two points using a precomputed contraction hierarchy.
+* The resulting route is as short as the one provided by planRoute() without the hierarchy.
+* @param[in] start Start point as RoutingParaPoint (Be aware: routing direction in respect to lane orientation!).
+* @param[in] dest  Destination point as RoutingParaPoint (Be aware: routing direction in respect to lane orientation!).
+* @param[in] contractionHierarchy The contraction hierarchy, see planning::ContractionHierarchy.
+*/
+route::FullRoute planRoute(const RoutingParaPoint &start,
+                           const RoutingParaPoint &dest,
+                           ContractionHierarchy::ConstPtr const &contractionHierarchy);
+
 /** @brief Calculates route between two points.
  *
  * Orientation at start/dest are not considered.
@@ -185,6 +207,49 @@ inline route::FullRoute planRoute(const point::ParaPoint &start,
   return planRoute(createRoutingPoint(start, startHeading), dest);
 }
 
+/**
+ * @brief Calculates the routes from one start point to several destination points by a single search.
+ *
+ * Each route is at least as short as the one provided by planRoute() for the respective destination.
+ *
+ * @param[in] start Start point.
+ * @param[in] dest  Vector with the destination points.
+ *
+ * @return vector with the route to each destination point, the route is empty if the destination is not reachable.
+ */
+std::vector<route::FullRoute> planRoutes(const RoutingParaPoint &start, std::vector<RoutingParaPoint> const &dest);
+
+/**
+ * @brief Entry of a RouteDistanceMatrix
+ */
+struct RouteDistance
+{
+  bool routeFound{false};              ///< true if the destination is reachable from the start.
+  physics::Distance routeLength{0.};   ///< Length of the route, see calcLength(FullRoute const &).
+  physics::Duration routeDuration{0.}; ///< Duration of the route, see calcDuration(FullRoute const &).
+};
+
+/**
+ * @brief Matrix of the routes between several start and destination points, indexed by [start][dest]
+ */
+typedef std::vector<std::vector<RouteDistance>> RouteDistanceMatrix;
+
+/**
+ * @brief Calculates the routes between each of the start points and each of the destination points.
+ *
+ * A single search per start point is performed, see planRoutes(). The searches of the different start points are
+ * independent of each other and are distributed over \a threadCount threads.
+ *
+ * @param[in] start       Vector with the start points.
+ * @param[in] dest        Vector with the destination points.
+ * @param[in] threadCount Number of threads to be used.
+ *
+ * @return the matrix of the routes from each start to each destination point.
+ */
+RouteDistanceMatrix calculateRouteDistanceMatrix(std::vector<RoutingParaPoint> const &start,
+                                                 std::vector<RoutingParaPoint> const &dest,
+                                                 std::size_t const threadCount = 1u);
+
 /**
  * @brief perform route based prediction restricted by the prediction duration.
  *
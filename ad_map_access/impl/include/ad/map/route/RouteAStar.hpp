@@ -10,6 +10,8 @@
 
 #include <map>
 
+#include "ad/map/route/AltHeuristic.hpp"
+#include "ad/map/route/IndexedPriorityQueue.hpp"
 #include "ad/map/route/RouteExpander.hpp"
 
 /* @brief namespace ad */
@@ -33,6 +35,17 @@ struct RouteAstarScore
   physics::Distance f_score{0.};
 };
 
+/**
+ * @brief orders cost data by the raw value of the f_score (without considering the precision of physics::Distance)
+ */
+struct RouteAstarScoreLess
+{
+  bool operator()(RouteAstarScore const &left, RouteAstarScore const &right) const
+  {
+    return static_cast<double>(left.f_score) < static_cast<double>(right.f_score);
+  }
+};
+
 /**
  * @brief Implements routing on the lane network.
  */
@@ -49,39 +62,107 @@ public:
    */
   RouteAstar(const RoutingParaPoint &start, const RoutingParaPoint &dest, Type typ);
 
+  /**
+   * @brief Constructor. Calculates route between two points using landmark based lower bounds.
+   *
+   * The landmark tables tighten the cost estimate and therefore reduce the number of points to be expanded.
+   * The resulting route has the same cost as without the landmark tables. Only if there are several routes of
+   * equal cost, another one of them might be selected.
+   * If the landmark tables don't match the current lane graph, they are ignored.
+   *
+   * @param[in] start        Start point.
+   * @param[in] dest         Destination point.
+   * @param[in] typ          Type of the route to be calculated.
+   * @param[in] altHeuristic The landmark tables.
+   */
+  RouteAstar(const RoutingParaPoint &start,
+             const RoutingParaPoint &dest,
+             Type typ,
+             AltHeuristic::ConstPtr const &altHeuristic);
+
   /**
    * @brief Calculates the route using A* algorithm.
    * @returns true if route is found.
    */
   bool calculate() override;
 
+  /**
+   * @returns the number of points expanded by the last call to calculate().
+   */
+  std::size_t getExpandedPointCount() const
+  {
+    return mExpandedPointCount;
+  }
+
 private:
   /**
    * @brief Reimplemented from RouteExpander::AddNeighbor()
    */
-  void addNeighbor(lane::Lane::ConstPtr originLane,
+  void addNeighbor(lane::LaneGraph::Node const &originLane,
                    RoutingPoint const &origin,
-                   lane::Lane::ConstPtr neighborLane,
+                   lane::LaneGraph::Node const &neighborLane,
                    RoutingParaPoint const &neighbor,
                    ExpandReason const &expandReason) override;
   /**
    * @brief (under-)estimate the cost until the destination; required for A* search criteria
    */
-  physics::Distance costEstimate(lane::Lane::ConstPtr neighborLane, point::ParaPoint const &neighbor);
+  physics::Distance costEstimate(lane::LaneGraph::Node const &neighborLane, point::ParaPoint const &neighbor);
+
+  /**
+   * @brief (under-)estimate the cost until the destination for a neighbor point at the start or end of its lane
+   */
+  physics::Distance costEstimateAtLaneBorder(lane::LaneGraph::Node const &neighborLane,
+                                             point::ParaPoint const &neighbor);
+
+  /**
+   * @brief tighten the cost estimate of a neighbor point at the start or end of its lane by the landmark tables
+   */
+  physics::Distance landmarkCostEstimate(lane::LaneGraph::Node const &neighborLane,
+                                         point::ParaPoint const &neighbor,
+                                         physics::Distance const &estimate) const;
 
   /**
    * @brief reconstruct the path after search finished
    */
   void reconstructPath(RoutingParaPoint const &dest);
 
+  /**
+   * @brief queue holding the elements beeing processed
+   */
+  typedef IndexedPriorityQueue<RoutingParaPoint, RouteAstarScore, RouteAstarScoreLess> RoutingParaPointCostQueue;
+
+  /**
+   * @brief select the element to be processed next
+   *
+   * This is the first element in order of the routing points having the smallest f_score.
+   */
+  RoutingParaPointCostQueue::iterator getMinimumCostElement();
+
   /**
    * @brief the destination lane
    */
-  lane::Lane::ConstPtr mDestLane;
+  lane::LaneGraph::Node const *mDestLane;
   /**
    * @brief the start lane
    */
-  lane::Lane::ConstPtr mStartLane;
+  lane::LaneGraph::Node const *mStartLane;
+  /**
+   * @brief the destination point used to estimate the cost
+   */
+  point::ECEFPoint mDestPoint;
+
+  /**
+   * @brief the landmark tables, nullptr if not used
+   */
+  AltHeuristic::ConstPtr mAltHeuristic;
+  /**
+   * @brief the costs between the landmarks and the destination point
+   */
+  std::vector<double> mDestLandmarkCosts;
+  /**
+   * @brief the number of points expanded by the last calculation
+   */
+  std::size_t mExpandedPointCount{0u};
 
   /**
    * @brief the already processed points (only process a point once)
@@ -89,10 +170,9 @@ private:
   RoutingParaPointSet mProcessedPoints;
 
   /**
-   * @brief map holding the elements beeing processed
+   * @brief the elements beeing processed
    */
-  typedef std::map<RoutingParaPoint, RouteAstarScore> RoutingParaPointCostMap;
-  RoutingParaPointCostMap mProcessingMap;
+  RoutingParaPointCostQueue mProcessingMap;
 
   /**
    * @brief map a point to its predecessor having least cost
@@ -0,0 +1,113 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <deque>
+#include <map>
+
+#include "ad/map/route/ContractionHierarchy.hpp"
+#include "ad/map/route/RouteExpander.hpp"
+
+/* @brief namespace ad */
+namespace ad {
+/* @brief namespace map */
+namespace map {
+/* @brief namespace route */
+namespace route {
+/**
+ * @namespace planning
+ * @brief provides route planning capabilities on the road network of the map
+ */
+namespace planning {
+
+/**
+ * @brief Implements routing on the lane network using a contraction hierarchy.
+ *
+ * Calculates routes of type Route::Type::SHORTEST having the same cost as the ones of RouteAstar. If there are
+ * several routes of equal cost, another one of them might be selected.
+ *
+ * The routing points at the start and end of the lanes are covered by the hierarchy. The points in between, which
+ * can be reached from the start by lateral lane changes, are expanded locally before the search in the hierarchy.
+ */
+class RouteContractionHierarchy : public RouteExpander<double>
+{
+public:
+  using RouteExpander::RoutingPoint;
+
+  /**
+   * @brief Constructor. Calculates route between two points.
+   *
+   * If the contraction hierarchy doesn't match the current lane graph, the route is calculated by RouteAstar.
+   *
+   * @param[in] start                Start point.
+   * @param[in] dest                 Destination point.
+   * @param[in] contractionHierarchy The contraction hierarchy of the map.
+   */
+  RouteContractionHierarchy(const RoutingParaPoint &start,
+                            const RoutingParaPoint &dest,
+                            ContractionHierarchy::ConstPtr const &contractionHierarchy);
+
+  /**
+   * @brief Calculates the route.
+   * @returns true if route is found.
+   */
+  bool calculate() override;
+
+private:
+  /**
+   * @brief Reimplemented from RouteExpander::AddNeighbor()
+   *
+   * Collects the nodes of the contraction hierarchy reachable from the start.
+   */
+  void addNeighbor(lane::LaneGraph::Node const &originLane,
+                   RoutingPoint const &origin,
+                   lane::LaneGraph::Node const &neighborLane,
+                   RoutingParaPoint const &neighbor,
+                   ExpandReason const &expandReason) override;
+
+  /**
+   * @brief collect the nodes of the contraction hierarchy from which the destination can be reached
+   */
+  std::vector<ContractionHierarchy::SearchSeed> getTargets();
+
+  /**
+   * @brief create the raw route
+   */
+  void createRawRoute(RoutingParaPoint const &origin, std::vector<ContractionHierarchy::NodeIndex> const &path);
+
+  /**
+   * @brief the contraction hierarchy, nullptr if not matching the lane graph
+   */
+  ContractionHierarchy::ConstPtr mContractionHierarchy;
+
+  /**
+   * @brief the points reachable from the start by lateral lane changes, waiting for expansion
+   */
+  std::deque<RoutingPoint> mLocalQueue;
+
+  /**
+   * @brief map a point reachable from the start by lateral lane changes to its predecessor
+   */
+  std::map<RoutingParaPoint, RoutingParaPoint> mLocalCameFrom;
+
+  /**
+   * @brief the nodes of the contraction hierarchy reachable from the start with their cost and predecessor
+   */
+  std::map<ContractionHierarchy::NodeIndex, RoutingPoint> mSources;
+
+  /**
+   * @brief the cost and predecessor of the destination if reachable without passing any node of the hierarchy
+   */
+  RoutingPoint mDirectDest;
+};
+
+} // namespace planning
+} // namespace route
+} // namespace map
+} // namespace ad
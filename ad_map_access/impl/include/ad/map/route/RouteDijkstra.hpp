@@ -0,0 +1,174 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <queue>
+#include <vector>
+
+#include "ad/map/route/IndexedPriorityQueue.hpp"
+#include "ad/map/route/RouteExpander.hpp"
+
+/* @brief namespace ad */
+namespace ad {
+/* @brief namespace map */
+namespace map {
+/* @brief namespace route */
+namespace route {
+/**
+ * @namespace planning
+ * @brief provides route planning capabilities on the road network of the map
+ */
+namespace planning {
+
+/**
+ * @brief orders routing costs by their raw value (without considering the precision of physics::Distance)
+ */
+struct RouteDijkstraCostLess
+{
+  bool operator()(physics::Distance const &left, physics::Distance const &right) const
+  {
+    return static_cast<double>(left) < static_cast<double>(right);
+  }
+};
+
+/**
+ * @brief Implements one-to-many routing on the lane network.
+ *
+ * A single Dijkstra search from the start calculates the routes to all destination points. The routing costs
+ * are the ones of RouteAstar, so each route is as short as the one calculated by RouteAstar for the respective
+ * destination. As the search doesn't rely on a cost estimate, it might even find a shorter one on maps where the
+ * distance estimate of RouteAstar is too optimistic. If there are several routes of equal cost, another one of
+ * them might be selected.
+ *
+ * The raw route to the destination with index i is provided by getRawRoute(i). It is empty if the destination
+ * is not reachable.
+ */
+class RouteDijkstra : public RouteExpander<physics::Distance>
+{
+public:
+  using RouteExpander::RoutingPoint;
+
+  /**
+   * @brief Constructor. Calculates the routes from the start to each of the destination points.
+   * @param[in] start Start point.
+   * @param[in] dest  Destination points.
+   * @param[in] typ   Type of the routes to be calculated.
+   */
+  RouteDijkstra(const RoutingParaPoint &start, std::vector<RoutingParaPoint> const &dest, Type typ);
+
+  /**
+   * @brief Calculates the routes.
+   * @returns true if at least one of the destinations is reachable.
+   */
+  bool calculate() override;
+
+  /**
+   * @returns the number of destination points.
+   */
+  std::size_t getDestinationCount() const
+  {
+    return mDestinations.size();
+  }
+
+  /**
+   * @returns true if a route to the destination with the given index was found.
+   */
+  bool isDestinationReached(std::size_t const destIndex) const
+  {
+    return !getRawRoute(destIndex).empty();
+  }
+
+  /**
+   * @returns the routing cost of the route to the destination with the given index.
+   *          Only valid if isDestinationReached().
+   */
+  physics::Distance getRoutingCost(std::size_t const destIndex) const
+  {
+    return mDestinationCosts[destIndex];
+  }
+
+private:
+  /**
+   * @brief Reimplemented from RouteExpander::AddNeighbor()
+   */
+  void addNeighbor(lane::LaneGraph::Node const &originLane,
+                   RoutingPoint const &origin,
+                   lane::LaneGraph::Node const &neighborLane,
+                   RoutingParaPoint const &neighbor,
+                   ExpandReason const &expandReason) override;
+
+  /**
+   * @brief update the costs of the destinations reachable from the given point
+   *
+   * Like RouteAstar does, the destinations are reached from points on their lane if the movement on the lane
+   * allows and from points located exactly at the destination point.
+   */
+  void addDestinations(RoutingPoint const &origin);
+
+  /**
+   * @brief reconstruct the path to the destination with the given index after search finished
+   */
+  void reconstructPath(std::size_t const destIndex);
+
+  /**
+   * @brief the destination points
+   */
+  std::vector<RoutingParaPoint> mDestinations;
+
+  /**
+   * @brief map a lane to the indices of the destinations located on it
+   */
+  std::multimap<lane::LaneId, std::size_t> mDestinationsOnLane;
+
+  /**
+   * @brief the best routing cost found so far for each destination
+   */
+  std::vector<physics::Distance> mDestinationCosts;
+
+  /**
+   * @brief the point each destination is reached from with the cost in mDestinationCosts
+   */
+  std::vector<RoutingParaPoint> mDestinationPredecessors;
+
+  /**
+   * @brief the destinations in order of the routing cost found so far (outdated entries are skipped)
+   */
+  typedef std::pair<double, std::size_t> DestinationEntry;
+  typedef std::priority_queue<DestinationEntry, std::vector<DestinationEntry>, std::greater<DestinationEntry>>
+    DestinationQueue;
+  DestinationQueue mDestinationQueue;
+
+  /**
+   * @brief the already processed points (only process a point once)
+   */
+  RoutingParaPointSet mProcessedPoints;
+
+  /**
+   * @brief queue holding the elements beeing processed
+   */
+  typedef IndexedPriorityQueue<RoutingParaPoint, physics::Distance, RouteDijkstraCostLess> RoutingParaPointCostQueue;
+
+  /**
+   * @brief the elements beeing processed
+   */
+  RoutingParaPointCostQueue mProcessingMap;
+
+  /**
+   * @brief map a point to its predecessor having least cost
+   */
+  typedef std::map<RoutingParaPoint, RoutingParaPoint> RoutingChainMap;
+  RoutingChainMap mCameFrom;
+};
+
+} // namespace planning
+} // namespace route
+} // namespace map
+} // namespace ad
@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include <stdexcept>
 #include <utility>
 
+#include "ad/map/lane/LaneGraph.hpp"
 #include "ad/map/lane/LaneOperation.hpp"
 #include "ad/map/route/Route.hpp"
 
@@ -30,6 +32,7 @@ namespace planning {
  *
  * This class is used to expand a route by its reachable neighbors.
  * The routing cost data is defined by a template type to be defined by the actual routing class.
+ * The expansion is performed on the lane graph of the Store present at construction time.
  */
 template <class RoutingCostData> class RouteExpander : public Route
 {
@@ -46,6 +49,7 @@ public:
    */
   RouteExpander(const RoutingParaPoint &start, const RoutingParaPoint &dest, Type const &routingType)
     : Route(start, dest, routingType)
+    , mLaneGraph(lane::getLaneGraph())
   {
   }
 
@@ -81,15 +85,15 @@ protected:
    *
    * Override this function in the derived class to get notified on expanded neighbors.
    *
-   * @param[in] originLane the lane object of the \a origin point
+   * @param[in] originLane the lane graph node of the \a origin point
    * @param[in] origin the origin RoutingPoint provided to the ExpandNeighbors() function
-   * @param[in] neighborLane the lane object of the \a neighbor point
+   * @param[in] neighborLane the lane graph node of the \a neighbor point
    * @param[in] neighbor the neighbor point which is added
    * @param[in] expandReason the reason why the origin was expanded to this neighbor
    */
-  virtual void addNeighbor(lane::Lane::ConstPtr originLane,
+  virtual void addNeighbor(lane::LaneGraph::Node const &originLane,
                            RoutingPoint const &origin,
-                           lane::Lane::ConstPtr neighborLane,
+                           lane::LaneGraph::Node const &neighborLane,
                            RoutingParaPoint const &neighbor,
                            ExpandReason const &expandReason)
     = 0;
@@ -107,52 +111,53 @@ protected:
   }
 
   //! @returns \c true if the given origin point on the given lane defines a positive movement
-  bool isPositiveMovement(lane::Lane::ConstPtr lane, RoutingPoint const &origin)
+  bool isPositiveMovement(lane::LaneGraph::Node const &lane, RoutingPoint const &origin)
   {
-    return (laneDirectionIsIgnored() || isLaneDirectionPositive(*lane))
+    return (laneDirectionIsIgnored() || lane.positive)
       && (origin.first.direction != RoutingDirection::NEGATIVE);
   }
 
   //! @returns \c true if the given origin point on the given lane defines a negative movement
-  bool isNegativeMovement(lane::Lane::ConstPtr lane, RoutingPoint const &origin)
+  bool isNegativeMovement(lane::LaneGraph::Node const &lane, RoutingPoint const &origin)
   {
-    return (laneDirectionIsIgnored() || isLaneDirectionNegative(*lane))
+    return (laneDirectionIsIgnored() || lane.negative)
       && (origin.first.direction != RoutingDirection::POSITIVE);
   }
 
   //! perform the expansion of the neighbor points on the same lane
-  void expandSameLaneNeighbors(lane::Lane::ConstPtr lane, RoutingPoint const &origin);
+  void expandSameLaneNeighbors(lane::LaneGraph::Node const &lane, RoutingPoint const &origin);
   //! perform the expansion of the neighbor points in longitudinal (contacts: successor/predecessor) lane direction
-  void expandLongitudinalNeighbors(lane::Lane::ConstPtr lane, RoutingPoint const &origin);
+  void expandLongitudinalNeighbors(lane::LaneGraph::Node const &lane, RoutingPoint const &origin);
   //! perform the expansion of the neighbor points in lateral (contacts: left/right) lane direction
-  void expandLateralNeighbors(lane::Lane::ConstPtr lane, RoutingPoint const &origin);
+  void expandLateralNeighbors(lane::LaneGraph::Node const &lane, RoutingPoint const &origin);
+
+  //! the lane graph the expansion is performed on
+  lane::LaneGraph::ConstPtr mLaneGraph;
 };
 
 template <class RoutingCostData>
 void RouteExpander<RoutingCostData>::expandNeighbors(
   typename RouteExpander<RoutingCostData>::RoutingPoint const &origin)
 {
-  lane::Lane::ConstPtr lane = lane::getLanePtr(origin.first.point.laneId);
-  if (lane)
+  auto const laneIndex = mLaneGraph->findNode(origin.first.point.laneId);
+  if (laneIndex == lane::LaneGraph::cInvalidNodeIndex)
   {
-    if (isRouteable(*lane))
-    {
-      expandSameLaneNeighbors(lane, origin);
-      expandLongitudinalNeighbors(lane, origin);
-      expandLateralNeighbors(lane, origin);
-    }
+    throw std::runtime_error("RouteExpander::ExpandNeighbors No lane!");
   }
-  else
+  auto const &lane = mLaneGraph->getNode(laneIndex);
+  if (lane.routeable)
   {
-    throw std::runtime_error("RouteExpander::ExpandNeighbors No lane!");
+    expandSameLaneNeighbors(lane, origin);
+    expandLongitudinalNeighbors(lane, origin);
+    expandLateralNeighbors(lane, origin);
   }
 }
 
 template <class RoutingCostData>
 void RouteExpander<RoutingCostData>::expandSameLaneNeighbors(
-  lane::Lane::ConstPtr lane, typename RouteExpander<RoutingCostData>::RoutingPoint const &origin)
+  lane::LaneGraph::Node const &lane, typename RouteExpander<RoutingCostData>::RoutingPoint const &origin)
 {
-  if ((lane->id == getDest().laneId)
+  if ((lane.id == getDest().laneId)
       && ((isPositiveMovement(lane, origin) && (origin.first.point.parametricOffset <= getDest().parametricOffset))
           || (isNegativeMovement(lane, origin) && (origin.first.point.parametricOffset >= getDest().parametricOffset))))
   {
@@ -164,7 +169,7 @@ void RouteExpander<RoutingCostData>::expandSameLaneNeighbors(
     addNeighbor(lane,
                 origin,
                 lane,
-                createRoutingParaPoint(lane->id, physics::ParametricValue(1.), origin.first.direction),
+                createRoutingParaPoint(lane.id, physics::ParametricValue(1.), origin.first.direction),
                 ExpandReason::SameLaneNeighbor);
   }
   if (isNegativeMovement(lane, origin) && !isStart(origin))
@@ -172,33 +177,32 @@ void RouteExpander<RoutingCostData>::expandSameLaneNeighbors(
     addNeighbor(lane,
                 origin,
                 lane,
-                createRoutingParaPoint(lane->id, physics::ParametricValue(0.), origin.first.direction),
+                createRoutingParaPoint(lane.id, physics::ParametricValue(0.), origin.first.direction),
                 ExpandReason::SameLaneNeighbor);
   }
 }
 
 template <class RoutingCostData>
 void RouteExpander<RoutingCostData>::expandLongitudinalNeighbors(
-  lane::Lane::ConstPtr lane, typename RouteExpander<RoutingCostData>::RoutingPoint const &origin)
+  lane::LaneGraph::Node const &lane, typename RouteExpander<RoutingCostData>::RoutingPoint const &origin)
 {
-  lane::ContactLaneList contact_lanes;
+  lane::LaneGraph::EdgeRange contact_lanes{nullptr, nullptr};
   if (isEnd(origin) && isPositiveMovement(lane, origin))
   {
-    contact_lanes = getContactLanes(*lane, lane::ContactLocation::SUCCESSOR);
+    contact_lanes = mLaneGraph->getEdges(lane, lane::LaneGraph::SuccessorEdges);
   }
   else if (isStart(origin) && isNegativeMovement(lane, origin))
   {
-    contact_lanes = getContactLanes(*lane, lane::ContactLocation::PREDECESSOR);
+    contact_lanes = mLaneGraph->getEdges(lane, lane::LaneGraph::PredecessorEdges);
   }
-  for (auto contact_lane : contact_lanes)
+  for (auto const &contact_lane : contact_lanes)
   {
-    lane::Lane::ConstPtr other_lane = lane::getLanePtr(contact_lane.toLane);
-    if (other_lane)
+    if (contact_lane.node != lane::LaneGraph::cInvalidNodeIndex)
     {
-      if (isRouteable(*other_lane))
+      auto const &other_lane = mLaneGraph->getNode(contact_lane.node);
+      if (other_lane.routeable)
       {
-        lane::ContactLocation other_to_lane = getContactLocation(*other_lane, lane->id);
-        if (other_to_lane == lane::ContactLocation::SUCCESSOR)
+        if (contact_lane.reverseLocation == lane::ContactLocation::SUCCESSOR)
         {
           auto routingDirection = RoutingDirection::NEGATIVE;
           if (origin.first.direction == RoutingDirection::DONT_CARE)
@@ -208,10 +212,10 @@ void RouteExpander<RoutingCostData>::expandLongitudinalNeighbors(
           addNeighbor(lane,
                       origin,
                       other_lane,
-                      createRoutingParaPoint(other_lane->id, physics::ParametricValue(1.), routingDirection),
+                      createRoutingParaPoint(other_lane.id, physics::ParametricValue(1.), routingDirection),
                       ExpandReason::LongitudinalNeighbor);
         }
-        else if (other_to_lane == lane::ContactLocation::PREDECESSOR)
+        else if (contact_lane.reverseLocation == lane::ContactLocation::PREDECESSOR)
         {
           auto routingDirection = RoutingDirection::POSITIVE;
           if (origin.first.direction == RoutingDirection::DONT_CARE)
@@ -221,7 +225,7 @@ void RouteExpander<RoutingCostData>::expandLongitudinalNeighbors(
           addNeighbor(lane,
                       origin,
                       other_lane,
-                      createRoutingParaPoint(other_lane->id, physics::ParametricValue(0.), routingDirection),
+                      createRoutingParaPoint(other_lane.id, physics::ParametricValue(0.), routingDirection),
                       ExpandReason::LongitudinalNeighbor);
         }
         else
@@ -239,24 +243,24 @@ void RouteExpander<RoutingCostData>::expandLongitudinalNeighbors(
 
 template <class RoutingCostData>
 void RouteExpander<RoutingCostData>::expandLateralNeighbors(
-  lane::Lane::ConstPtr lane, typename RouteExpander<RoutingCostData>::RoutingPoint const &origin)
+  lane::LaneGraph::Node const &lane, typename RouteExpander<RoutingCostData>::RoutingPoint const &origin)
 {
-  if (lane->type != lane::LaneType::INTERSECTION)
+  if (lane.type != lane::LaneType::INTERSECTION)
   {
-    for (auto const &contact_lane : getContactLanes(*lane, {lane::ContactLocation::LEFT, lane::ContactLocation::RIGHT}))
+    for (auto const &contact_lane : mLaneGraph->getEdges(lane, lane::LaneGraph::RightEdges, lane::LaneGraph::LeftEdges))
     {
-      lane::Lane::ConstPtr other_lane = lane::getLanePtr(contact_lane.toLane);
-      if (other_lane)
+      if (contact_lane.node != lane::LaneGraph::cInvalidNodeIndex)
       {
-        if (isRouteable(*other_lane))
+        auto const &other_lane = mLaneGraph->getNode(contact_lane.node);
+        if (other_lane.routeable)
         {
-          if (laneDirectionIsIgnored() || (lane->direction == other_lane->direction))
+          if (laneDirectionIsIgnored() || (lane.direction == other_lane.direction))
           {
             addNeighbor(
               lane,
               origin,
               other_lane,
-              createRoutingParaPoint(other_lane->id, origin.first.point.parametricOffset, origin.first.direction),
+              createRoutingParaPoint(other_lane.id, origin.first.point.parametricOffset, origin.first.direction),
               ExpandReason::LateralNeighbor);
           }
         }
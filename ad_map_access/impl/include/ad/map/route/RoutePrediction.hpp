@@ -85,9 +85,9 @@ private:
   /**
    * @brief Reimplemented from RouteExpander::AddNeighbor()
    */
-  void addNeighbor(lane::Lane::ConstPtr originLane,
+  void addNeighbor(lane::LaneGraph::Node const &originLane,
                    RoutingPoint const &origin,
-                   lane::Lane::ConstPtr neighborLane,
+                   lane::LaneGraph::Node const &neighborLane,
                    RoutingParaPoint const &neighbor,
                    ExpandReason const &expandReason) override;
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include "ad/map/serialize/IChecksum.hpp"
@@ -22,9 +23,49 @@ namespace serialize {
 
 /**
  * @brief Checksum CRC32 calculation implementation
+ *
+ * The checksum is calculated eight bytes at a time or, if the CPU supports carry-less multiplication, by folding
+ * 64 bytes at a time. The implementation is selected at runtime; all of them deliver the same checksum.
  */
 class ChecksumCRC32 : virtual public IChecksum, virtual public IStorage
 {
+public: // Constants
+  static constexpr size_t PARALLEL_CHUNK_BYTES = 1u << 20; ///< Minimum size of a chunk checksummed by its own thread.
+
+public: // Operations
+  /**
+   * @brief Calculate the CRC-32 of a buffer
+   *
+   * @param[in] crc CRC-32 of the data preceding the buffer, 0 at the start
+   * @param[in] x the buffer
+   * @param[in] bytes size of the buffer
+   *
+   * @returns the CRC-32 of the preceding data followed by the buffer
+   */
+  static uint32_t calculate(uint32_t crc, const void *x, size_t bytes);
+
+  /**
+   * @brief Calculate the CRC-32 of a buffer, splitting large buffers into chunks checksummed in parallel
+   *
+   * Buffers smaller than two chunks of PARALLEL_CHUNK_BYTES are checksummed by the calling thread. The chunks are
+   * checksummed by the calling thread and the worker threads the library keeps for all of its parallel operations.
+   * The result is the same as calculate().
+   *
+   * @param[in] maxThreads maximum number of threads to use, 0 to use the number of hardware threads
+   */
+  static uint32_t calculateParallel(uint32_t crc, const void *x, size_t bytes, size_t maxThreads = 0u);
+
+  /**
+   * @brief Combine the CRC-32 of two consecutive blocks
+   *
+   * @param[in] crc1 CRC-32 of the first block
+   * @param[in] crc2 CRC-32 of the second block
+   * @param[in] bytes2 size of the second block
+   *
+   * @returns the CRC-32 of the first block followed by the second one
+   */
+  static uint32_t combine(uint32_t crc1, uint32_t crc2, size_t bytes2);
+
 protected: // Constructor/Destructor
   ChecksumCRC32();
   virtual ~ChecksumCRC32();
@@ -8,10 +8,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <map>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -30,11 +32,16 @@ namespace serialize {
  */
 class ISerializer
 {
+public:                                            // Constants
+  static constexpr size_t MAX_BLOCK_BYTES = 65536; ///< Maximal number of bytes of a vector read at once.
+
 public: // Constructor/Destructor
   explicit ISerializer(bool store)
     : mIsStoring(store)
     , mUseMagic(true)
     , mUseEmbeddedPoints(true)
+    , mUseSections(true)
+    , mSkipInnerPoints(false)
   {
   }
 
@@ -176,6 +183,26 @@ private: // Operations
   template <typename T> bool readVector(std::vector<T> &x);
   template <typename T> bool writeVector(std::vector<T> &x);
 
+  /**
+   * @brief Types written as their raw bytes, so a vector of them is a contiguous block within the stream
+   *
+   * Enums and bool are converted on serialization and therefore serialized element by element.
+   */
+  template <typename T>
+  using IsBlockSerializeable = std::integral_constant<bool,
+                                                      std::is_trivially_copyable<T>::value && !std::is_enum<T>::value
+                                                        && !std::is_same<T, bool>::value>;
+
+  template <typename T> bool readElements(std::vector<T> &x, size_t n, std::true_type);
+  template <typename T> bool readElements(std::vector<T> &x, size_t n, std::false_type);
+  template <typename T> bool writeElements(std::vector<T> const &x, std::true_type);
+  template <typename T> bool writeElements(std::vector<T> const &x, std::false_type);
+
+  /**
+   * @brief reserve space for n more elements, but not more than one block as n is read from the stream
+   */
+  template <typename T> void reserve(std::vector<T> &x, size_t n);
+
   template <typename T>
   bool readObjectVector(std::vector<T> &x, SerializeableMagic const &magic = SerializeableMagic::ObjectVectorType);
   template <typename T>
@@ -194,6 +221,41 @@ public: // Aux Methods
   virtual bool write(const void *x, size_t bytes) = 0;
   virtual bool read(void *x, size_t bytes) = 0;
 
+  /**
+   * @brief Read without copying the data, if supported by the underlying storage.
+   * @returns pointer to the data, valid until the serializer is closed.
+   *          nullptr if not supported or not enough data available, then nothing is read.
+   */
+  virtual uint8_t const *readInPlace(size_t bytes)
+  {
+    (void)bytes;
+    return nullptr;
+  }
+
+  /**
+   * @brief Skip data on deserialization.
+   * @param[in] bytes Number of bytes to be skipped.
+   * @returns true if successful, false if not enough data is available.
+   */
+  bool skip(size_t bytes)
+  {
+    if ((bytes == 0u) || (readInPlace(bytes) != nullptr))
+    {
+      return true;
+    }
+    uint8_t buffer[4096];
+    while (bytes > 0u)
+    {
+      size_t const count = std::min(bytes, sizeof(buffer));
+      if (!read(buffer, count))
+      {
+        return false;
+      }
+      bytes -= count;
+    }
+    return true;
+  }
+
   /**
    * @brief Specifies if the every serialized block will be/is prefixed with object-specific
    *        magic number. This is application-wide setting.
@@ -212,6 +274,14 @@ public: // Aux Methods
     return old_magic;
   }
 
+  /**
+   * @brief returns the setting if the magic numbers are used or not on serialization
+   */
+  bool useMagic() const
+  {
+    return mUseMagic;
+  }
+
   /**
    * @brief Specifies if the geometry points should be embedded within the objects or handled separately.
    *
@@ -237,6 +307,56 @@ public: // Aux Methods
     return mUseEmbeddedPoints;
   }
 
+  /**
+   * @brief Specifies if the lanes and landmarks of a Store are serialized in independent sections.
+   *
+   * Sections are preceded by a table of their sizes and checksums, so they can be verified and decoded in parallel.
+   * Maps of version 0.4 and older don't have sections, which is set by the Serializer when such a map is opened.
+   *
+   * @param[in] useSections Set to true if sections are used.
+   *
+   * @return Old value of the flag.
+   */
+  bool setUseSections(bool useSections)
+  {
+    bool oldUseSections = mUseSections;
+    mUseSections = useSections;
+    return oldUseSections;
+  }
+
+  /**
+   * @brief returns the setting if sections are used or not on serialization
+   */
+  bool useSections() const
+  {
+    return mUseSections;
+  }
+
+  /**
+   * @brief Specifies if the inner points of geometries are skipped on deserialization.
+   *
+   * Only the first and the last point of each edge are read. Geometries keep their length and validity.
+   * Has no effect on serialization.
+   *
+   * @param[in] skipInnerPoints Set to true if the inner geometry points should be skipped.
+   *
+   * @return Old value of the flag.
+   */
+  bool setSkipInnerPoints(bool skipInnerPoints)
+  {
+    bool oldSkipInnerPoints = mSkipInnerPoints;
+    mSkipInnerPoints = skipInnerPoints;
+    return oldSkipInnerPoints;
+  }
+
+  /**
+   * @brief returns the setting if the inner geometry points are skipped on deserialization
+   */
+  bool skipInnerPoints() const
+  {
+    return mSkipInnerPoints;
+  }
+
   /**
    * @Todo will delete this after preparing new map without connector
    */
@@ -269,6 +389,8 @@ private:                                 // Data Members
   bool mIsStoring;                       ///< If true, this is Serialization process, false means De-Serialization.
   bool mUseMagic;                        ///< If true, the SerializeableMagic is used within serialization
   bool mUseEmbeddedPoints;               ///< If true, the geometry points are saved together with objects
+  bool mUseSections;                     ///< If true, the Store content is saved in independent sections
+  bool mSkipInnerPoints;                 ///< If true, inner geometry points are skipped on deserialization
 private:                                 // Special types
   typedef uint8_t EnumSerializationType; ///< Use 8 bits for enum serializations.
 };
@@ -377,14 +499,7 @@ template <typename T> inline bool ISerializer::writeVector(std::vector<T> &x)
     size_t n = x.size();
     if (write(n))
     {
-      for (size_t i = 0; i < n; i++)
-      {
-        if (!write(x[i]))
-        {
-          return false;
-        }
-      }
-      return true;
+      return writeElements(x, IsBlockSerializeable<T>());
     }
   }
   return false;
@@ -397,21 +512,67 @@ template <typename T> inline bool ISerializer::readVector(std::vector<T> &x)
     size_t n;
     if (read(n))
     {
-      for (size_t i = 0; i < n; i++)
-      {
-        T xi;
-        if (!read(xi))
-        {
-          return false;
-        }
-        x.push_back(xi);
-      }
-      return true;
+      return readElements(x, n, IsBlockSerializeable<T>());
     }
   }
   return false;
 }
 
+template <typename T> inline bool ISerializer::writeElements(std::vector<T> const &x, std::true_type)
+{
+  return x.empty() || write(x.data(), x.size() * sizeof(T));
+}
+
+template <typename T> inline bool ISerializer::writeElements(std::vector<T> const &x, std::false_type)
+{
+  for (size_t i = 0; i < x.size(); i++)
+  {
+    if (!write(x[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T> inline bool ISerializer::readElements(std::vector<T> &x, size_t n, std::true_type)
+{
+  // the vector grows block by block, so a corrupt length fails at the end of the data instead of allocating it
+  size_t const blockSize = std::max<size_t>(1u, MAX_BLOCK_BYTES / sizeof(T));
+  while (n > 0u)
+  {
+    size_t const count = std::min(n, blockSize);
+    size_t const offset = x.size();
+    x.resize(offset + count);
+    if (!read(&x[offset], count * sizeof(T)))
+    {
+      return false;
+    }
+    n -= count;
+  }
+  return true;
+}
+
+template <typename T> inline bool ISerializer::readElements(std::vector<T> &x, size_t n, std::false_type)
+{
+  reserve(x, n);
+  for (size_t i = 0; i < n; i++)
+  {
+    T xi;
+    if (!read(xi))
+    {
+      return false;
+    }
+    x.push_back(xi);
+  }
+  return true;
+}
+
+template <typename T> inline void ISerializer::reserve(std::vector<T> &x, size_t n)
+{
+  x.reserve(x.size() + std::min(n, std::max<size_t>(1u, MAX_BLOCK_BYTES / sizeof(T))));
+}
+
 template <typename T> inline bool ISerializer::writeObjectVector(std::vector<T> &x, SerializeableMagic const &magic)
 {
   if (serialize(magic))
@@ -439,6 +600,7 @@ template <typename T> inline bool ISerializer::readObjectVector(std::vector<T> &
     size_t n;
     if (read(n))
     {
+      reserve(x, n);
       for (size_t i = 0; i < n; i++)
       {
         T xi;
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 /** @brief namespace ad */
@@ -36,6 +37,18 @@ protected: // To be implemented
   virtual bool doCloseForWrite() = 0;
   virtual bool doWrite(const void *x, std::size_t bytes) = 0;
   virtual bool doRead(void *x, std::size_t bytes) = 0;
+
+protected: // Optional
+  /**
+   * @brief Read without copying the data.
+   * @returns pointer to the data within the storage, valid until the storage is closed.
+   *          nullptr if the storage doesn't support this, then nothing is read.
+   */
+  virtual uint8_t const *doReadInPlace(std::size_t bytes)
+  {
+    (void)bytes;
+    return nullptr;
+  }
 };
 
 } // namespace serialize
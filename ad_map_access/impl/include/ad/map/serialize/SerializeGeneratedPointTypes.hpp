@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include "ad/map/point/Altitude.hpp"
 #include "ad/map/point/BoundingSphere.hpp"
 #include "ad/map/point/ECEFCoordinate.hpp"
@@ -97,6 +100,101 @@ template <> inline bool doSerialize(ISerializer &serializer, point::ECEFPoint &e
     && doSerialize(serializer, ecefPoint.y) && doSerialize(serializer, ecefPoint.z);
 }
 
+/**
+ * @brief Serializer for point::ECEFEdge
+ *
+ * Same format as serializeObjectVector() of the points, but the points are converted in memory and serialized
+ * block-wise instead of value by value.
+ */
+template <> inline bool doSerialize(ISerializer &serializer, point::ECEFEdge &edge)
+{
+  // a point consists of the magic of the point, followed by the magic and the value of each coordinate
+  size_t const magicSize = serializer.useMagic() ? sizeof(uint16_t) : 0u;
+  size_t const pointSize = magicSize + 3u * (magicSize + sizeof(double));
+  uint16_t const magic = static_cast<uint16_t>(SerializeableMagic::ECEFCoordinate);
+
+  size_t n = edge.size();
+  if (!serializer.serialize(SerializeableMagic::ObjectVectorType) || !serializer.serialize(n))
+  {
+    return false;
+  }
+  std::vector<uint8_t> buffer;
+  if (serializer.isStoring())
+  {
+    buffer.resize(n * pointSize);
+    uint8_t *data = buffer.data();
+    auto append = [&data](void const *value, size_t bytes) {
+      std::memcpy(data, value, bytes);
+      data += bytes;
+    };
+    for (auto const &ecefPoint : edge)
+    {
+      append(&magic, magicSize);
+      for (auto const &coordinate : {ecefPoint.x, ecefPoint.y, ecefPoint.z})
+      {
+        double const value = static_cast<double>(coordinate);
+        append(&magic, magicSize);
+        append(&value, sizeof(value));
+      }
+    }
+    return buffer.empty() || serializer.write(buffer.data(), buffer.size());
+  }
+
+  // the edge grows block by block, so a corrupt length fails at the end of the data instead of allocating it
+  size_t const blockSize = std::max<size_t>(1u, ISerializer::MAX_BLOCK_BYTES / pointSize);
+  auto readPoints = [&serializer, &edge, &buffer, blockSize, pointSize, magicSize, magic](size_t pointCount) {
+    edge.reserve(edge.size() + std::min(pointCount, blockSize));
+    while (pointCount > 0u)
+    {
+      size_t const count = std::min(pointCount, blockSize);
+      buffer.resize(count * pointSize);
+      if (!serializer.read(buffer.data(), buffer.size()))
+      {
+        return false;
+      }
+      uint8_t const *data = buffer.data();
+      auto extractMagic = [&data, magicSize, magic]() {
+        uint16_t magicRead = magic;
+        std::memcpy(&magicRead, data, magicSize);
+        data += magicSize;
+        return magicRead == magic;
+      };
+      auto extractValue = [&data]() {
+        double value;
+        std::memcpy(&value, data, sizeof(value));
+        data += sizeof(value);
+        return point::ECEFCoordinate(value);
+      };
+      for (size_t i = 0u; i < count; i++)
+      {
+        point::ECEFPoint ecefPoint;
+        bool ok = extractMagic();
+        ok = extractMagic() && ok;
+        ecefPoint.x = extractValue();
+        ok = extractMagic() && ok;
+        ecefPoint.y = extractValue();
+        ok = extractMagic() && ok;
+        ecefPoint.z = extractValue();
+        if (!ok)
+        {
+          return false;
+        }
+        edge.push_back(ecefPoint);
+      }
+      pointCount -= count;
+    }
+    return true;
+  };
+
+  if (serializer.skipInnerPoints() && (n > 2u))
+  {
+    size_t const innerPoints = n - 2u;
+    return readPoints(1u) && (innerPoints <= std::numeric_limits<size_t>::max() / pointSize)
+      && serializer.skip(innerPoints * pointSize) && readPoints(1u);
+  }
+  return readPoints(n);
+}
+
 /**
  * @brief Serializer for point::GeoPoint
  */
@@ -133,17 +231,17 @@ template <> inline bool doSerialize(ISerializer &serializer, point::Geometry &ge
   {
     if (serializer.useEmbeddedPoints())
     {
-      ok = ok && serializer.serializeObjectVector(geometry.ecefEdge);
+      ok = ok && doSerialize(serializer, geometry.ecefEdge);
     }
     else
     {
       static point::ECEFEdge empty;
-      ok = ok && serializer.serializeObjectVector(empty);
+      ok = ok && doSerialize(serializer, empty);
     }
   }
   else
   {
-    ok = ok && serializer.serializeObjectVector(geometry.ecefEdge);
+    ok = ok && doSerialize(serializer, geometry.ecefEdge);
   }
   return ok;
 }
@@ -61,6 +61,9 @@ enum class SerializeableMagic : uint16_t
   GeometryStoreItem = Base + 212,
   // Connector = Base + 213,  <-not required, the connector is not used any more
   MapMetaData = Base + 214,
+  StoreSectionTable = Base + 215,
+  MapPatch = Base + 216,
+  AdMapCacheEntry = Base + 217,
 
   GeoPoint = Base + 300,
   Longitude = Base + 301,
@@ -73,6 +76,9 @@ enum class SerializeableMagic : uint16_t
 
   Landmark = Base + 500,
 
+  AltHeuristic = Base + 600,
+  ContractionHierarchy = Base + 601,
+
   // special magic values
   VectorType = 0xF016,
   ObjectVectorType = 0xF227,
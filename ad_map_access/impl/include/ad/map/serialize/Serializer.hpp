@@ -30,6 +30,7 @@ class Serializer : public ISerializer, virtual public IChecksum
 public: // Constants
   static size_t VERSION_MAJOR;
   static size_t VERSION_MINOR;
+  static size_t VERSION_MINOR_UNSECTIONED; ///< Minor version of maps without sections, which can still be read.
 
 private: // Constants
   static size_t MAGIC;
@@ -50,6 +51,7 @@ private: // Aux Methods
 
   bool write(const void *x, size_t bytes) override;
   bool read(void *x, size_t bytes) override;
+  uint8_t const *readInPlace(size_t bytes) override;
 
 private: // Data Members
   bool open_;
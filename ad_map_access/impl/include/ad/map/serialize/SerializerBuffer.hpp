@@ -0,0 +1,79 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ad/map/serialize/ISerializer.hpp"
+
+/** @brief namespace ad */
+namespace ad {
+/** @brief namespace map */
+namespace map {
+/** @brief namespace serialize */
+namespace serialize {
+
+/**
+ * @brief Serializer working on a buffer in memory
+ *
+ * Used for independent parts of a stream, e.g. the sections of a Store. There is neither a header nor a checksum,
+ * the enclosing stream is responsible for them.
+ */
+class SerializerBuffer : public ISerializer
+{
+public: // Constructor/Destructor
+  /**
+   * @brief Constructor for serialization into an internal buffer.
+   */
+  SerializerBuffer();
+
+  /**
+   * @brief Constructor for deserialization from external memory.
+   *
+   * @param[in] data start of the data, has to stay valid during the lifetime of the serializer
+   * @param[in] bytes size of the data
+   */
+  SerializerBuffer(uint8_t const *data, size_t bytes);
+
+  virtual ~SerializerBuffer() = default;
+
+public: // Operations
+  /**
+   * @returns the data serialized so far
+   */
+  std::vector<uint8_t> const &getBuffer() const
+  {
+    return buffer_;
+  }
+
+  /**
+   * @returns true if all data has been deserialized
+   */
+  bool atEnd() const
+  {
+    return position_ == size_;
+  }
+
+public: // Aux Methods
+  bool write(const void *x, size_t bytes) override;
+  bool read(void *x, size_t bytes) override;
+  uint8_t const *readInPlace(size_t bytes) override;
+
+private:                        // Data Members
+  std::vector<uint8_t> buffer_; ///< Serialized data.
+  uint8_t const *data_;         ///< Data to be deserialized.
+  size_t size_;                 ///< Size of the data to be deserialized.
+  size_t position_;             ///< Read position within the data.
+};
+
+} // namespace serialize
+} // namespace map
+} // namespace ad
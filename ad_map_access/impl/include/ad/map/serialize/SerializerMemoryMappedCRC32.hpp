@@ -0,0 +1,54 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include "ad/map/serialize/ChecksumCRC32.hpp"
+#include "ad/map/serialize/Serializer.hpp"
+#include "ad/map/serialize/StorageMemoryMapped.hpp"
+
+/** @brief namespace ad */
+namespace ad {
+/** @brief namespace map */
+namespace map {
+/** @brief namespace serialize */
+namespace serialize {
+
+/**
+ * @brief Read-only serializer for memory mapped files with CRC32
+ *
+ * Instead of updating the checksum with every single read, all data read is checksummed at once when the
+ * checksum is checked. As the data is contiguous in the mapping, large maps are checksummed in parallel.
+ */
+class SerializerMemoryMappedCRC32 : virtual public Serializer,
+                                    virtual public StorageMemoryMapped,
+                                    virtual public ChecksumCRC32
+{
+public: // Constructor/Destructor
+  SerializerMemoryMappedCRC32()
+    : Serializer(false, true)
+  {
+  }
+
+  virtual ~SerializerMemoryMappedCRC32() = default;
+
+protected: // Overriden IChecksum
+  void updateChecksum(const void *, size_t) override
+  {
+  }
+
+  bool checksumOK() override
+  {
+    ChecksumCRC32::updateChecksum(getMappedData(), getReadPosition());
+    return ChecksumCRC32::checksumOK();
+  }
+};
+
+} // namespace serialize
+} // namespace map
+} // namespace ad
@@ -0,0 +1,79 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "ad/map/serialize/IStorage.hpp"
+
+/** @brief namespace ad */
+namespace ad {
+/** @brief namespace map */
+namespace map {
+/** @brief namespace serialize */
+namespace serialize {
+
+/**
+ * @brief Read-only storage implementation on top of a memory mapped file
+ *
+ * The file is mapped read-only and shared, so several processes loading the same map share the pages of the
+ * file in the page cache. Reading copies directly out of the mapping without any system call per read.
+ * Writing is not supported.
+ *
+ * The objects read are not views into the mapping: the generated types own their data, so every lane and landmark
+ * read is copied to the heap. Only raw blocks like the sections of a map are provided in place, see
+ * access::Store::openPaged(), which decodes a partition when it is first accessed.
+ */
+class StorageMemoryMapped : protected virtual IStorage
+{
+protected: // Constructor/Destructor
+  StorageMemoryMapped();
+  virtual ~StorageMemoryMapped();
+
+public: // IStorage Implementation
+  const char *getStorageType() override
+  {
+    return "MemoryMapped";
+  }
+
+protected: // IStorage Implementation
+  bool doOpenForRead(std::string const &config) override;
+  bool doOpenForWrite(std::string const &config) override;
+  bool doCloseForRead() override;
+  bool doCloseForWrite() override;
+  bool doWrite(const void *x, size_t bytes) override;
+  bool doRead(void *x, size_t bytes) override;
+  uint8_t const *doReadInPlace(size_t bytes) override;
+
+protected: // Operations
+  /**
+   * @returns start of the mapping, nullptr if no file is open
+   */
+  uint8_t const *getMappedData() const
+  {
+    return data_;
+  }
+
+  /**
+   * @returns the number of bytes read so far
+   */
+  std::size_t getReadPosition() const
+  {
+    return position_;
+  }
+
+private:                 // Data Members
+  uint8_t const *data_;  ///< Start of the mapping, nullptr if no file is open.
+  std::size_t size_;     ///< Size of the mapping in bytes.
+  std::size_t position_; ///< Read position within the mapping.
+};
+
+} // namespace serialize
+} // namespace map
+} // namespace ad
@@ -11,7 +11,7 @@
 #include "AdMapAccess.hpp"
 #include "ad/map/opendrive/AdMapFactory.hpp"
 #include "ad/map/point/Operation.hpp"
-#include "ad/map/serialize/SerializerFileCRC32.hpp"
+#include "ad/map/serialize/SerializerMemoryMappedCRC32.hpp"
 
 namespace ad {
 namespace map {
@@ -108,10 +108,8 @@ bool AdMapAccess::initializeFromOpenDriveContent(std::string const &openDriveCon
     return false;
   }
 
-  auto store = std::make_shared<Store>();
-  opendrive::AdMapFactory factory(*store);
-
-  bool result = factory.createAdMapFromString(openDriveContent, overlapMargin, defaultIntersectionType);
+  auto store = mOpenDriveCache.createAdMapFromString(openDriveContent, overlapMargin, defaultIntersectionType);
+  bool result = static_cast<bool>(store);
   if (result)
   {
     mInitializedFromStore = true;
@@ -172,6 +170,47 @@ void AdMapAccess::reset()
   mCoordinateTransform = std::make_shared<point::CoordinateTransform>();
 }
 
+bool AdMapAccess::applyPatch(MapPatch const &patch)
+{
+  LockGuard guard(mMutex);
+  auto patchedStore = mStore->createPatched(patch);
+  if (!patchedStore)
+  {
+    mLogger->error("AdMapAccess::applyPatch() failed; patch doesn't fit to the map");
+    return false;
+  }
+  // readers access the store without holding the mutex
+  std::atomic_store(&mStore, patchedStore);
+  mLogger->info("AdMapAccess::applyPatch() applied patch with {} added, {} modified and {} removed lanes",
+                patch.addedLanes.size(),
+                patch.modifiedLanes.size(),
+                patch.removedLanes.size());
+  return true;
+}
+
+bool AdMapAccess::setOpenDriveCache(std::string const &directory, std::size_t maxSize)
+{
+  LockGuard guard(mMutex);
+  mOpenDriveCache = opendrive::AdMapCache(directory, maxSize);
+  return mOpenDriveCache.isEnabled() == !directory.empty();
+}
+
+void AdMapAccess::clearOpenDriveCache()
+{
+  LockGuard guard(mMutex);
+  getOpenDriveCache().clear();
+}
+
+opendrive::AdMapCache AdMapAccess::getOpenDriveCache() const
+{
+  if (!mConfigFileHandler.openDriveCacheDirectory().empty())
+  {
+    return opendrive::AdMapCache(mConfigFileHandler.openDriveCacheDirectory(),
+                                 mConfigFileHandler.openDriveCacheMaxSize());
+  }
+  return mOpenDriveCache;
+}
+
 bool AdMapAccess::readMap(std::string const &mapName)
 {
   if (ad::map::opendrive::AdMapFactory::isOpenDriveMap(mapName))
@@ -186,15 +225,30 @@ bool AdMapAccess::readMap(std::string const &mapName)
 
 bool AdMapAccess::readOpenDriveMap(std::string const &mapName)
 {
-  opendrive::AdMapFactory factory(*mStore);
-  return factory.createAdMap(mapName,
-                             static_cast<double>(mConfigFileHandler.adMapEntry().openDriveOverlapMargin),
-                             mConfigFileHandler.adMapEntry().openDriveDefaultIntersectionType);
+  auto const &adMapEntry = mConfigFileHandler.adMapEntry();
+  auto store = getOpenDriveCache().createAdMap(
+    mapName, static_cast<double>(adMapEntry.openDriveOverlapMargin), adMapEntry.openDriveDefaultIntersectionType);
+  if (!store)
+  {
+    return false;
+  }
+  mStore = store;
+  return true;
 }
 
 bool AdMapAccess::readAdMap(std::string const &mapName)
 {
-  serialize::SerializerFileCRC32 serializer(false);
+  if (mConfigFileHandler.pagingMemoryBudget() > 0u)
+  {
+    if (!mStore->openPaged(mapName, mConfigFileHandler.pagingMemoryBudget()))
+    {
+      mLogger->warn("Unable to open map for paging {}", mapName);
+      return false;
+    }
+    mLogger->info("Opened map {} for paging", mapName);
+    return true;
+  }
+  serialize::SerializerMemoryMappedCRC32 serializer;
   size_t version_major = 0;
   size_t version_minor = 0;
   if (!serializer.open(mapName.c_str(), version_major, version_minor))
@@ -12,8 +12,10 @@
 #include <spdlog/spdlog.h>
 #include <string>
 #include <unordered_set>
+#include "ad/map/access/MapPatch.hpp"
 #include "ad/map/access/Store.hpp"
 #include "ad/map/config/MapConfigFileHandler.hpp"
+#include "ad/map/opendrive/AdMapCache.hpp"
 #include "ad/map/point/CoordinateTransform.hpp"
 
 /** @brief namespace ad */
@@ -78,6 +80,26 @@ public:
    */
   void reset();
 
+  /**
+   * @brief replace the store by a copy with the given patch applied
+   *
+   * The store is replaced atomically. The replaced store is kept alive by the contexts and query scopes using it.
+   */
+  bool applyPatch(MapPatch const &patch);
+
+  /**
+   * @brief use the given directory as cache of maps converted from OpenDRIVE
+   *
+   * The cache is kept on reset(). While initialized with a configuration file giving a cache, that one is used
+   * instead; the configured cache is dropped by reset().
+   */
+  bool setOpenDriveCache(std::string const &directory, std::size_t maxSize);
+
+  /**
+   * @brief remove all maps from the OpenDRIVE map cache in use
+   */
+  void clearOpenDriveCache();
+
   /**
    * @brief a coordinate transform object
    *
@@ -98,6 +120,12 @@ public:
   //! the store object
   Store::Ptr mStore;
 
+  //! the cache of maps converted from OpenDRIVE given by setOpenDriveCache()
+  opendrive::AdMapCache mOpenDriveCache;
+
+  //! the cache given by the configuration file if any, otherwise the one given by setOpenDriveCache()
+  opendrive::AdMapCache getOpenDriveCache() const;
+
   //! actually read the given map
   bool readMap(std::string const &mapName);
 
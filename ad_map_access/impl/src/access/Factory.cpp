@@ -31,6 +31,11 @@ bool Factory::add(PartitionId part_id, const lane::LaneId &id, lane::LaneType ty
     lanePtr = std::make_shared<lane::Lane>();
     lanePtr->id = id;
     mStore.part_lane_map_[part_id].push_back(id);
+    mStore.invalidateLaneIndex();
+  }
+  else
+  {
+    mStore.invalidateLaneGraph();
   }
   lanePtr->type = type;
   lanePtr->direction = dir;
@@ -187,6 +192,7 @@ bool Factory::add(const lane::LaneId &id, const lane::ContactLane &contact_lane)
         }
       }
       lane->contactLanes.push_back(contact_lane);
+      mStore.invalidateLaneGraph();
       return true;
     }
   }
@@ -220,6 +226,7 @@ bool Factory::add(const lane::LaneId &id, const restriction::SpeedLimit &speedLi
         access::getLogger()->warn("Lane para-speed overlaps existing value!? {}, {}", id, speedLimit);
       }
       restriction::insertRangeAttribute(lane->speedLimits, speedLimit);
+      mStore.invalidateLaneGraph();
       return true;
     }
   }
@@ -339,6 +346,7 @@ bool Factory::set(const lane::LaneId &id, lane::LaneDirection direction)
     if (lane)
     {
       lane->direction = direction;
+      mStore.invalidateLaneGraph();
       return true;
     }
   }
@@ -355,6 +363,7 @@ bool Factory::set(const lane::LaneId &id, lane::LaneType type)
     if (lane)
     {
       lane->type = type;
+      mStore.invalidateLaneGraph();
       return true;
     }
   }
@@ -390,6 +399,7 @@ bool Factory::set(const lane::LaneId &id, const point::Geometry &edge_left, cons
       lane->edgeRight = edge_right;
       lane->boundingSphere = point::calcBoundingSphere(edge_left, edge_right);
       lane::updateLaneLengths(*lane);
+      mStore.invalidateLaneIndex();
       return true;
     }
   }
@@ -411,6 +421,7 @@ bool Factory::set(const lane::LaneId &id, const physics::Speed &maxSpeed)
       speedLimit.lanePiece.maximum = physics::ParametricValue(1.);
       speedLimit.speedLimit = maxSpeed;
       lane->speedLimits.push_back(speedLimit);
+      mStore.invalidateLaneGraph();
       return true;
     }
   }
@@ -474,8 +485,9 @@ bool Factory::deleteLane(lane::LaneId id)
     auto const erased = mStore.lane_map_.erase(id);
     if (erased > 0u)
     {
+      mStore.invalidateLaneIndex();
       bool removed_from_part_map = false;
-      for (auto part_id_and_lane_ids : mStore.part_lane_map_)
+      for (auto &part_id_and_lane_ids : mStore.part_lane_map_)
       {
         auto const removeIter = std::remove(part_id_and_lane_ids.second.begin(), part_id_and_lane_ids.second.end(), id);
         if (removeIter != part_id_and_lane_ids.second.end())
@@ -516,6 +528,7 @@ bool Factory::deleteContacts(lane::LaneId id, lane::LaneId to_id)
         lane::ContactLaneList &cls = lane->contactLanes;
         cls.erase(
           std::remove_if(cls.begin(), cls.end(), [to_id](const lane::ContactLane &cl) { return cl.toLane == to_id; }));
+        mStore.invalidateLaneGraph();
         return true;
       }
     }
@@ -7,6 +7,8 @@
 // ----------------- END LICENSE BLOCK -----------------------------------
 
 #include "GeometryStore.hpp"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include "ad/map/access/Logging.hpp"
 #include "ad/map/access/Store.hpp"
@@ -17,11 +19,12 @@ namespace ad {
 namespace map {
 namespace access {
 
-GeometryStore::GeometryStore()
+GeometryStore::GeometryStore(physics::Distance const &maxError)
 {
   store_ = nullptr;
   points3d_ = 0;
   capacity3d_ = 0;
+  resolution_ = std::max(static_cast<double>(maxError), 0.);
 }
 
 GeometryStore::~GeometryStore()
@@ -125,7 +128,7 @@ bool GeometryStore::check(lane::Lane::ConstPtr lane) const
         point::ECEFEdge right;
         if (restore(right, item.rightEdgeOffset, item.rightEdgePoints))
         {
-          if (lane->edgeLeft.ecefEdge == left && lane->edgeRight.ecefEdge == right)
+          if (isSameEdge(lane->edgeLeft.ecefEdge, left) && isSameEdge(lane->edgeRight.ecefEdge, right))
           {
             return true;
           }
@@ -258,12 +261,14 @@ bool GeometryStore::expand()
   }
   else
   {
-    size_t bytes = (capacity3d_ + SIZE_INCREMENT) * 3 * sizeof(double);
+    // grow geometrically, so storing n points copies O(n) points in total
+    uint32_t increment = std::max(SIZE_INCREMENT, capacity3d_);
+    size_t bytes = (capacity3d_ + increment) * 3 * sizeof(double);
     double *store = static_cast<double *>(std::realloc(store_, bytes));
     if (store != nullptr)
     {
       store_ = store;
-      capacity3d_ += SIZE_INCREMENT;
+      capacity3d_ += increment;
       return true;
     }
     else
@@ -292,17 +297,122 @@ bool GeometryStore::create(uint32_t capacity3d)
   }
 }
 
+bool GeometryStore::encode(std::vector<uint8_t> &encoded) const
+{
+  encoded.clear();
+  encoded.reserve(points3d_ * 3u * 3u);
+  int64_t previous[3] = {0, 0, 0};
+  for (uint32_t index = 0; index < points3d_ * 3; index += 3)
+  {
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+      double const quantized = std::round(store_[index + axis] / resolution_);
+      if (!(std::fabs(quantized) < 1e18))
+      {
+        access::getLogger()->error("GeometryStore: Unable to quantize coordinate {}", store_[index + axis]);
+        return false;
+      }
+      auto const value = static_cast<int64_t>(quantized);
+      auto const delta = value - previous[axis];
+      previous[axis] = value;
+      // zigzag encoding, so small negative deltas get small as well
+      auto zigzag = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+      while (zigzag >= 0x80u)
+      {
+        encoded.push_back(static_cast<uint8_t>(zigzag | 0x80u));
+        zigzag >>= 7;
+      }
+      encoded.push_back(static_cast<uint8_t>(zigzag));
+    }
+  }
+  return true;
+}
+
+bool GeometryStore::decode(std::vector<uint8_t> const &encoded)
+{
+  if (!create(points3d_))
+  {
+    return false;
+  }
+  points3d_ = capacity3d_;
+  uint8_t const *position = encoded.data();
+  uint8_t const *const end = position + encoded.size();
+  int64_t previous[3] = {0, 0, 0};
+  for (uint32_t index = 0; index < points3d_ * 3; index += 3)
+  {
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+      uint64_t zigzag = 0;
+      for (uint32_t shift = 0;; shift += 7)
+      {
+        if ((position == end) || (shift > 63))
+        {
+          access::getLogger()->error("GeometryStore: Invalid encoded points.");
+          return false;
+        }
+        uint8_t const byte = *position++;
+        zigzag |= static_cast<uint64_t>(byte & 0x7fu) << shift;
+        if ((byte & 0x80u) == 0)
+        {
+          break;
+        }
+      }
+      previous[axis] += static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1u);
+      store_[index + axis] = static_cast<double>(previous[axis]) * resolution_;
+    }
+  }
+  return position == end;
+}
+
+bool GeometryStore::isSameEdge(point::ECEFEdge const &edge, point::ECEFEdge const &other) const
+{
+  if (resolution_ <= 0.)
+  {
+    return edge == other;
+  }
+  if (edge.size() != other.size())
+  {
+    return false;
+  }
+  // quantization deviates by half a step at most, allow for the rounding of the coordinates
+  double const tolerance = 0.5 * resolution_ + 1e-6;
+  for (size_t i = 0; i < edge.size(); ++i)
+  {
+    if ((std::fabs(static_cast<double>(edge[i].x) - static_cast<double>(other[i].x)) > tolerance)
+        || (std::fabs(static_cast<double>(edge[i].y) - static_cast<double>(other[i].y)) > tolerance)
+        || (std::fabs(static_cast<double>(edge[i].z) - static_cast<double>(other[i].z)) > tolerance))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool GeometryStore::serialize(serialize::ISerializer &serializer)
 {
   bool ok = serializer.serialize(serialize::SerializeableMagic::GeometryStore)
     && serializer.serializeObjectMap(lane_items_) && serializer.serialize(points3d_);
 
-  /*Todo the two lines below will be deleted after the map are generated again without use_zfp_*/
-  bool use_zfp_ = false;
-  ok = ok && serializer.serialize(use_zfp_);
+  // formerly reserved for zfp compression, now set if the points are quantized and delta-encoded
+  bool quantized = (resolution_ > 0.);
+  ok = ok && serializer.serialize(quantized);
 
-  if (ok)
+  if (ok && quantized)
+  {
+    std::vector<uint8_t> encoded;
+    ok = serializer.serialize(resolution_);
+    if (serializer.isStoring())
+    {
+      ok = ok && encode(encoded) && serializer.serializeVector(encoded);
+    }
+    else
+    {
+      ok = ok && (resolution_ > 0.) && serializer.serializeVector(encoded) && decode(encoded);
+    }
+  }
+  else if (ok)
   {
+    resolution_ = 0.;
     if (!serializer.isStoring())
     {
       if (create(points3d_))
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include "ad/map/access/GeometryStoreItem.hpp"
 #include "ad/map/lane/Lane.hpp"
 #include "ad/map/serialize/ISerializer.hpp"
@@ -19,15 +20,25 @@ namespace access {
 
 /**
  * @brief Geometries container for serialization.
+ *
+ * The points are either serialized losslessly as doubles or, if an error bound is given, quantized to multiples
+ * of the error bound. Quantized coordinates are delta-encoded against the preceding point of the store and written
+ * as zigzag variable length integers, so neighbouring points mostly take two or three bytes per coordinate.
+ *
+ * The quantization only reduces the size of the map file. The store exists while the map is saved or loaded;
+ * afterwards the lanes hold their geometry as double precision ECEF edges, so the memory of a loaded map is the
+ * same with and without quantization.
  */
 class GeometryStore
 {
 public: // Constructor/Destructor
   /**
-   * @brief Default constructor.
+   * @brief Constructor.
    *        Creates empty store.
+   * @param[in] maxError Maximal deviation of the serialized coordinates from the original ones.
+   *            0 to serialize the coordinates losslessly.
    */
-  explicit GeometryStore();
+  explicit GeometryStore(physics::Distance const &maxError = physics::Distance(0.));
 
   /**
    * @brief Constructor.
@@ -102,11 +113,31 @@ private: // Aux Methods
    */
   bool create(uint32_t capacity3d);
 
+  /**
+   * @brief Quantizes and delta-encodes the points of the store.
+   * @param[out] encoded The encoded points.
+   * @returns true if successful.
+   */
+  bool encode(std::vector<uint8_t> &encoded) const;
+
+  /**
+   * @brief Creates the store from encoded points.
+   * @param[in] encoded The encoded points.
+   * @returns true if successful.
+   */
+  bool decode(std::vector<uint8_t> const &encoded);
+
+  /**
+   * @brief Compares the edges within the quantization error of the store.
+   * @returns true if the edges are equal.
+   */
+  bool isSameEdge(point::ECEFEdge const &edge, point::ECEFEdge const &other) const;
+
 public:
   bool serialize(serialize::ISerializer &serializer);
 
 private:                                           // Constants
-  static constexpr uint32_t SIZE_INCREMENT = 1024; ///< Number of points to be added each time
+  static constexpr uint32_t SIZE_INCREMENT = 1024; ///< Minimal number of points to be added each time
                                                    ///< store_ needs to be expaned.
 
 private: // Data Members
@@ -133,6 +164,7 @@ private: // Data Members
   double_t *store_;                                      ///< Memory block containing data.
   uint32_t points3d_;                                    ///< Number of 3D points in the store.
   uint32_t capacity3d_;                                  ///< Size of the store in 3D points.
+  double resolution_;                                    ///< Quantization step in m, 0 if not quantized.
   std::map<lane::LaneId, GeometryStoreItem> lane_items_; ///< Description of lane items in the store.
 };
 
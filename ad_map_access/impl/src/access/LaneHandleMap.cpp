@@ -0,0 +1,109 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "LaneHandleMap.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+void LaneHandleMap::build(std::map<lane::LaneId, lane::Lane::Ptr> const &laneMap)
+{
+  slots_.clear();
+  mask_ = 0u;
+  count_ = 0u;
+  reserve(laneMap.size());
+  for (auto const &id_and_lane : laneMap)
+  {
+    insert(id_and_lane.first, id_and_lane.second);
+  }
+}
+
+void LaneHandleMap::insert(lane::LaneId const &id, lane::Lane::Ptr const &lane)
+{
+  reserve(count_ + 1u);
+  auto const key = static_cast<uint64_t>(id);
+  auto index = hash(key) & mask_;
+  while ((slots_[index].lane != nullptr) && (slots_[index].key != key))
+  {
+    index = (index + 1u) & mask_;
+  }
+  if (slots_[index].lane == nullptr)
+  {
+    ++count_;
+  }
+  slots_[index].key = key;
+  slots_[index].lane = &lane;
+}
+
+void LaneHandleMap::erase(lane::LaneId const &id)
+{
+  if (slots_.empty())
+  {
+    return;
+  }
+  auto const key = static_cast<uint64_t>(id);
+  auto index = hash(key) & mask_;
+  while (slots_[index].key != key)
+  {
+    if (slots_[index].lane == nullptr)
+    {
+      return;
+    }
+    index = (index + 1u) & mask_;
+  }
+
+  // shift the following entries of the probe sequence back, so no tombstones are required
+  auto hole = index;
+  for (auto next = (index + 1u) & mask_; slots_[next].lane != nullptr; next = (next + 1u) & mask_)
+  {
+    auto const home = hash(slots_[next].key) & mask_;
+    // the entry may fill the hole if its home slot is not within (hole, next]
+    if (((next - home) & mask_) >= ((next - hole) & mask_))
+    {
+      slots_[hole] = slots_[next];
+      hole = next;
+    }
+  }
+  slots_[hole] = Slot{0u, nullptr};
+  --count_;
+}
+
+void LaneHandleMap::reserve(std::size_t count)
+{
+  if ((count == 0u) || (2u * count <= slots_.size()))
+  {
+    return;
+  }
+
+  // keep the load factor below 0.5
+  std::size_t size = 2u;
+  while (size < 2u * count)
+  {
+    size *= 2u;
+  }
+  std::vector<Slot> slots(size, Slot{0u, nullptr});
+  slots_.swap(slots);
+  mask_ = size - 1u;
+  for (auto const &slot : slots)
+  {
+    if (slot.lane != nullptr)
+    {
+      auto index = hash(slot.key) & mask_;
+      while (slots_[index].lane != nullptr)
+      {
+        index = (index + 1u) & mask_;
+      }
+      slots_[index] = slot;
+    }
+  }
+}
+
+} // namespace access
+} // namespace map
+} // namespace ad
@@ -0,0 +1,121 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "ad/map/lane/Types.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+/**
+ * @brief Open addressing hash table LaneId -> Lane.
+ *
+ * The table refers to the entries of the lane map of the Store it was built from.
+ * Therefore, it has to be rebuilt or updated by insert() and erase() whenever lanes are added to or removed from
+ * that map.
+ */
+class LaneHandleMap
+{
+public: // Constructor/Destructor
+  /**
+   * @brief Default constructor.
+   *        Creates empty table.
+   */
+  LaneHandleMap() = default;
+
+  /**
+   * @brief Destructor.
+   */
+  ~LaneHandleMap() = default;
+
+public: // Operations
+  /**
+   * @brief Builds the table from scratch.
+   * @param[in] laneMap The lane map of the Store.
+   */
+  void build(std::map<lane::LaneId, lane::Lane::Ptr> const &laneMap);
+
+  /**
+   * @brief Adds a lane to the table or updates its entry.
+   * @param[in] id Lane identifier.
+   * @param[in] lane The lane map entry of the lane.
+   */
+  void insert(lane::LaneId const &id, lane::Lane::Ptr const &lane);
+
+  /**
+   * @brief Removes a lane from the table.
+   * @param[in] id Lane identifier.
+   */
+  void erase(lane::LaneId const &id);
+
+  /**
+   * @brief Looks up a lane.
+   * @param[in] id Lane identifier.
+   * @returns Pointer to the lane map entry of the lane, nullptr if not found.
+   */
+  lane::Lane::Ptr const *find(lane::LaneId const &id) const
+  {
+    if (slots_.empty())
+    {
+      return nullptr;
+    }
+    auto const key = static_cast<uint64_t>(id);
+    for (auto index = hash(key) & mask_;; index = (index + 1u) & mask_)
+    {
+      auto const &slot = slots_[index];
+      if (slot.lane == nullptr)
+      {
+        return nullptr;
+      }
+      if (slot.key == key)
+      {
+        return slot.lane;
+      }
+    }
+  }
+
+private: // Types
+  /**
+   * @brief Entry of the table.
+   */
+  struct Slot
+  {
+    uint64_t key;
+    lane::Lane::Ptr const *lane; ///< nullptr marks an empty slot.
+  };
+
+private: // Aux Methods
+  /**
+   * @brief Resizes the table to keep the load factor below 0.5 for the given number of lanes.
+   */
+  void reserve(std::size_t count);
+
+  static uint64_t hash(uint64_t key)
+  {
+    key ^= key >> 33u;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33u;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33u;
+    return key;
+  }
+
+private:                    // Data Members
+  std::vector<Slot> slots_; ///< The slots of the table, the size is a power of two.
+  uint64_t mask_{0u};       ///< Size of the table - 1.
+  std::size_t count_{0u};   ///< Number of occupied slots.
+};
+
+} // namespace access
+} // namespace map
+} // namespace ad
@@ -0,0 +1,209 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "LaneSpatialIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "ad/map/point/BoundingSphereOperation.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+namespace {
+
+double squaredDistanceToBox(double const point[3], double const min[3], double const max[3])
+{
+  double squaredDistance = 0.;
+  for (auto axis = 0u; axis < 3u; ++axis)
+  {
+    double delta = 0.;
+    if (point[axis] < min[axis])
+    {
+      delta = min[axis] - point[axis];
+    }
+    else if (point[axis] > max[axis])
+    {
+      delta = point[axis] - max[axis];
+    }
+    squaredDistance += delta * delta;
+  }
+  return squaredDistance;
+}
+
+bool isFinite(point::BoundingSphere const &boundingSphere)
+{
+  return std::isfinite(static_cast<double>(boundingSphere.center.x))
+    && std::isfinite(static_cast<double>(boundingSphere.center.y))
+    && std::isfinite(static_cast<double>(boundingSphere.center.z))
+    && std::isfinite(static_cast<double>(boundingSphere.radius));
+}
+
+} // namespace
+
+void LaneSpatialIndex::build(std::vector<Entry> const &entries)
+{
+  clear();
+  entries_.reserve(entries.size());
+  for (std::size_t i = 0u; i < entries.size(); ++i)
+  {
+    auto const &entry = entries[i];
+    if (!isFinite(entry.boundingSphere))
+    {
+      continue;
+    }
+    IndexedEntry indexedEntry;
+    indexedEntry.entry = entry;
+    indexedEntry.centroid[0] = static_cast<double>(entry.boundingSphere.center.x);
+    indexedEntry.centroid[1] = static_cast<double>(entry.boundingSphere.center.y);
+    indexedEntry.centroid[2] = static_cast<double>(entry.boundingSphere.center.z);
+    double const radius = static_cast<double>(entry.boundingSphere.radius);
+    for (auto axis = 0u; axis < 3u; ++axis)
+    {
+      indexedEntry.box.min[axis] = indexedEntry.centroid[axis] - radius;
+      indexedEntry.box.max[axis] = indexedEntry.centroid[axis] + radius;
+    }
+    indexedEntry.order = static_cast<uint32_t>(i);
+    entries_.push_back(indexedEntry);
+  }
+
+  if (!entries_.empty())
+  {
+    nodes_.reserve(2u * entries_.size() / MAX_LEAF_SIZE + 1u);
+    buildNode(0u, static_cast<uint32_t>(entries_.size()));
+  }
+}
+
+void LaneSpatialIndex::clear()
+{
+  entries_.clear();
+  nodes_.clear();
+}
+
+uint32_t LaneSpatialIndex::buildNode(uint32_t begin, uint32_t end)
+{
+  uint32_t const nodeIndex = static_cast<uint32_t>(nodes_.size());
+  nodes_.push_back(Node());
+
+  Box box;
+  double centroidMin[3];
+  double centroidMax[3];
+  for (auto axis = 0u; axis < 3u; ++axis)
+  {
+    box.min[axis] = std::numeric_limits<double>::max();
+    box.max[axis] = std::numeric_limits<double>::lowest();
+    centroidMin[axis] = std::numeric_limits<double>::max();
+    centroidMax[axis] = std::numeric_limits<double>::lowest();
+  }
+  for (auto i = begin; i < end; ++i)
+  {
+    auto const &indexedEntry = entries_[i];
+    for (auto axis = 0u; axis < 3u; ++axis)
+    {
+      box.min[axis] = std::min(box.min[axis], indexedEntry.box.min[axis]);
+      box.max[axis] = std::max(box.max[axis], indexedEntry.box.max[axis]);
+      centroidMin[axis] = std::min(centroidMin[axis], indexedEntry.centroid[axis]);
+      centroidMax[axis] = std::max(centroidMax[axis], indexedEntry.centroid[axis]);
+    }
+  }
+  nodes_[nodeIndex].box = box;
+
+  if (end - begin <= MAX_LEAF_SIZE)
+  {
+    nodes_[nodeIndex].isLeaf = true;
+    nodes_[nodeIndex].first = begin;
+    nodes_[nodeIndex].second = end;
+    return nodeIndex;
+  }
+
+  // split at the median of the centroids along the axis with the largest extent
+  auto splitAxis = 0u;
+  for (auto axis = 1u; axis < 3u; ++axis)
+  {
+    if (centroidMax[axis] - centroidMin[axis] > centroidMax[splitAxis] - centroidMin[splitAxis])
+    {
+      splitAxis = axis;
+    }
+  }
+  uint32_t const middle = begin + (end - begin) / 2u;
+  std::nth_element(entries_.begin() + begin,
+                   entries_.begin() + middle,
+                   entries_.begin() + end,
+                   [splitAxis](IndexedEntry const &left, IndexedEntry const &right) {
+                     return left.centroid[splitAxis] < right.centroid[splitAxis];
+                   });
+
+  uint32_t const leftChild = buildNode(begin, middle);
+  uint32_t const rightChild = buildNode(middle, end);
+  nodes_[nodeIndex].isLeaf = false;
+  nodes_[nodeIndex].first = leftChild;
+  nodes_[nodeIndex].second = rightChild;
+  return nodeIndex;
+}
+
+lane::LaneIdList LaneSpatialIndex::findLanes(point::BoundingSphere const &boundingSphere) const
+{
+  lane::LaneIdList result;
+  if (nodes_.empty() || !isFinite(boundingSphere))
+  {
+    return result;
+  }
+
+  double const center[3] = {static_cast<double>(boundingSphere.center.x),
+                            static_cast<double>(boundingSphere.center.y),
+                            static_cast<double>(boundingSphere.center.z)};
+  // the boxes are only used for pruning, the final decision is taken by the exact sphere test below
+  // therefore, the search radius is enlarged by the precision of the distance comparison
+  double const searchRadius
+    = static_cast<double>(boundingSphere.radius) + 2. * static_cast<double>(physics::Distance::getPrecision());
+  double const squaredSearchRadius = searchRadius * searchRadius;
+
+  std::vector<uint32_t> matchingEntries;
+  std::vector<uint32_t> nodeStack;
+  nodeStack.push_back(0u);
+  while (!nodeStack.empty())
+  {
+    Node const &node = nodes_[nodeStack.back()];
+    nodeStack.pop_back();
+    if (squaredDistanceToBox(center, node.box.min, node.box.max) > squaredSearchRadius)
+    {
+      continue;
+    }
+    if (node.isLeaf)
+    {
+      for (auto i = node.first; i < node.second; ++i)
+      {
+        if (point::distance(entries_[i].entry.boundingSphere, boundingSphere) == physics::Distance(0.))
+        {
+          matchingEntries.push_back(i);
+        }
+      }
+    }
+    else
+    {
+      nodeStack.push_back(node.second);
+      nodeStack.push_back(node.first);
+    }
+  }
+
+  std::sort(matchingEntries.begin(), matchingEntries.end(), [this](uint32_t const left, uint32_t const right) {
+    return entries_[left].order < entries_[right].order;
+  });
+  result.reserve(matchingEntries.size());
+  for (auto const index : matchingEntries)
+  {
+    result.push_back(entries_[index].entry.laneId);
+  }
+  return result;
+}
+
+} // namespace access
+} // namespace map
+} // namespace ad
@@ -0,0 +1,131 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "ad/map/lane/Types.hpp"
+#include "ad/map/point/Types.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+/**
+ * @brief Bounding volume hierarchy over the bounding spheres of lanes.
+ *
+ * The hierarchy is built at once from a list of lanes. Afterwards it provides all lanes whose bounding sphere
+ * intersects with a query sphere in O(log n). The nodes of the hierarchy are axis aligned boxes in ECEF
+ * coordinates enclosing the bounding spheres of the lanes below.
+ */
+class LaneSpatialIndex
+{
+public: // Types
+  /**
+   * @brief An entry of the index.
+   */
+  struct Entry
+  {
+    lane::LaneId laneId;                 ///< Identifier of the lane.
+    point::BoundingSphere boundingSphere; ///< Bounding sphere of the lane.
+  };
+
+public: // Constructor/Destructor
+  /**
+   * @brief Default constructor.
+   *        Creates empty index.
+   */
+  LaneSpatialIndex() = default;
+
+  /**
+   * @brief Destructor.
+   */
+  ~LaneSpatialIndex() = default;
+
+public: // Operations
+  /**
+   * @brief Builds the hierarchy from scratch.
+   * @param[in] entries Lanes to be indexed. Entries with invalid bounding sphere are ignored.
+   *            The order of the entries defines the order of the search results.
+   */
+  void build(std::vector<Entry> const &entries);
+
+  /**
+   * @brief Removes all entries from the index.
+   */
+  void clear();
+
+  /**
+   * @returns Number of lanes in the index.
+   */
+  std::size_t size() const
+  {
+    return entries_.size();
+  }
+
+  /**
+   * @brief Spatial search.
+   * @param[in] boundingSphere Search sphere.
+   * @returns Identifiers of all lanes whose bounding sphere intersects with the search sphere.
+   *          The identifiers are ordered as the entries provided to build().
+   */
+  lane::LaneIdList findLanes(point::BoundingSphere const &boundingSphere) const;
+
+private: // Types
+  /**
+   * @brief Axis aligned box in ECEF coordinates.
+   */
+  struct Box
+  {
+    double min[3];
+    double max[3];
+  };
+
+  /**
+   * @brief Node of the hierarchy.
+   *
+   * Inner nodes refer to their two children, leaf nodes to a range of entries_.
+   */
+  struct Node
+  {
+    Box box;
+    uint32_t first;  ///< Inner node: index of the left child; leaf: index of the first entry.
+    uint32_t second; ///< Inner node: index of the right child; leaf: index behind the last entry.
+    bool isLeaf;
+  };
+
+  /**
+   * @brief Internal representation of an entry.
+   */
+  struct IndexedEntry
+  {
+    Entry entry;
+    Box box;
+    double centroid[3];
+    uint32_t order; ///< Position of the entry in the list provided to build().
+  };
+
+private: // Aux Methods
+  /**
+   * @brief Recursively builds the nodes for the entries [begin, end).
+   * @returns Index of the created node.
+   */
+  uint32_t buildNode(uint32_t begin, uint32_t end);
+
+private:                                    // Constants
+  static constexpr uint32_t MAX_LEAF_SIZE = 4; ///< Maximum number of entries within a leaf node.
+
+private:                              // Data Members
+  std::vector<IndexedEntry> entries_; ///< The indexed lanes, ordered by the hierarchy.
+  std::vector<Node> nodes_;           ///< The nodes of the hierarchy, the first one is the root.
+};
+
+} // namespace access
+} // namespace map
+} // namespace ad
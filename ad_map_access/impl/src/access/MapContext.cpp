@@ -0,0 +1,69 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/access/MapContext.hpp"
+
+#include <stdexcept>
+
+namespace ad {
+namespace map {
+namespace access {
+
+// the context bound to the current thread, owned by the innermost MapContext::Scope
+static thread_local MapContext *currentContext = nullptr;
+
+MapContext::Scope::Scope(Ptr const &context)
+  : context_(context)
+  , previous_(currentContext)
+{
+  currentContext = context_.get();
+}
+
+MapContext::Scope::Scope(MapContext *context)
+  : previous_(currentContext)
+{
+  currentContext = context;
+}
+
+MapContext::Scope::~Scope()
+{
+  currentContext = previous_;
+}
+
+MapContext::MapContext(Store::Ptr store)
+  : store_(store)
+  , coordinateTransform_(std::make_shared<point::CoordinateTransform>())
+{
+  if (!store_)
+  {
+    throw std::invalid_argument("MapContext: store is empty");
+  }
+}
+
+MapContext::MapContext(Store::Ptr store, point::GeoPoint const &enuReferencePoint)
+  : MapContext(store)
+{
+  setENUReferencePoint(enuReferencePoint);
+}
+
+void MapContext::setENUReferencePoint(point::GeoPoint const &point)
+{
+  if (!coordinateTransform_->isENUValid() || (coordinateTransform_->getENUReferencePoint() != point))
+  {
+    coordinateTransform_->setENUReferencePoint(point);
+  }
+}
+
+MapContext *MapContext::getCurrent()
+{
+  return currentContext;
+}
+
+} // namespace access
+} // namespace map
+} // namespace ad
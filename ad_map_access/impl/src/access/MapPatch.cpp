@@ -0,0 +1,40 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/access/MapPatch.hpp"
+#include "ad/map/serialize/SerializeGeneratedTypes.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+bool MapPatch::empty() const
+{
+  return addedLanes.empty() && modifiedLanes.empty() && removedLanes.empty() && addedLandmarks.empty()
+    && modifiedLandmarks.empty() && removedLandmarks.empty();
+}
+
+bool MapPatch::serialize(serialize::ISerializer &serializer)
+{
+  bool old_magic = serializer.setUseMagic(true);
+  bool old_use_embedded_points = serializer.setUseEmbeddedPoints(true);
+
+  bool ok = serializer.serialize(serialize::SerializeableMagic::MapPatch)
+    && serialize::doSerialize(serializer, partitionId) && serializer.serializeObjectPtrMap(addedLanes)
+    && serializer.serializeObjectPtrMap(modifiedLanes) && serializer.serializeObjectVector(removedLanes)
+    && serializer.serializeObjectPtrMap(addedLandmarks) && serializer.serializeObjectPtrMap(modifiedLandmarks)
+    && serializer.serializeObjectVector(removedLandmarks);
+
+  serializer.setUseMagic(old_magic);
+  serializer.setUseEmbeddedPoints(old_use_embedded_points);
+  return ok;
+}
+
+} // namespace access
+} // namespace map
+} // namespace ad
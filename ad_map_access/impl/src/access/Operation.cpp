@@ -11,6 +11,7 @@
 #include <boost/filesystem/path.hpp>
 
 #include "AdMapAccess.hpp"
+#include "ad/map/access/Logging.hpp"
 #include "ad/map/config/MapConfigFileHandler.hpp"
 #include "ad/map/opendrive/AdMapFactory.hpp"
 #include "ad/map/point/Operation.hpp"
@@ -33,6 +34,11 @@ void setENUReferencePoint(point::GeoPoint const &point)
 
 std::shared_ptr<point::CoordinateTransform> getCoordinateTransform()
 {
+  auto const context = MapContext::getCurrent();
+  if (context != nullptr)
+  {
+    return context->getCoordinateTransform();
+  }
   // coordinate transform (at least without ENURefPoint) can actually used before initialization
   // therefore, return the transform without initialization check
   return AdMapAccess::getAdMapAccessInstance().mCoordinateTransform;
@@ -40,12 +46,12 @@ std::shared_ptr<point::CoordinateTransform> getCoordinateTransform()
 
 point::GeoPoint getENUReferencePoint()
 {
-  return AdMapAccess::getAdMapAccessInstance().mCoordinateTransform->getENUReferencePoint();
+  return getCoordinateTransform()->getENUReferencePoint();
 }
 
 bool isENUReferencePointSet()
 {
-  return AdMapAccess::getAdMapAccessInstance().mCoordinateTransform->isENUValid();
+  return getCoordinateTransform()->isENUValid();
 }
 
 std::vector<config::PointOfInterest> getPointsOfInterest(point::GeoPoint const &geoPoint,
@@ -109,6 +115,16 @@ void cleanup()
   AdMapAccess::getAdMapAccessInstance().reset();
 }
 
+bool setOpenDriveCache(std::string const &directory, std::size_t maxSize)
+{
+  return AdMapAccess::getAdMapAccessInstance().setOpenDriveCache(directory, maxSize);
+}
+
+void clearOpenDriveCache()
+{
+  AdMapAccess::getAdMapAccessInstance().clearOpenDriveCache();
+}
+
 bool isLeftHandedTraffic()
 {
   return getStore().getMetaData().trafficType == TrafficType::LEFT_HAND_TRAFFIC;
@@ -119,9 +135,125 @@ bool isRightHandedTraffic()
   return getStore().getMetaData().trafficType == TrafficType::RIGHT_HAND_TRAFFIC;
 }
 
+// the store pinned for the calling thread by the innermost QueryScope or, outside of any scope, by getStore()
+static thread_local Store::Ptr pinnedStore;
+static thread_local std::size_t queryScopeDepth = 0u;
+// defers the eviction of the partitions of the store pinned by the outermost scope, if paged
+static thread_local std::unique_ptr<Store::PagingScope> pagingScope;
+
+// the store is pinned on first use, so opening a scope doesn't require an initialized map access
+static Store::Ptr const &getPinnedOrCurrentStore()
+{
+  if ((queryScopeDepth == 0u) || !pinnedStore)
+  {
+    pinnedStore = std::atomic_load(&AdMapAccess::getInitializedInstance().mStore);
+    if ((queryScopeDepth > 0u) && !pagingScope && pinnedStore)
+    {
+      pagingScope.reset(new Store::PagingScope(*pinnedStore));
+    }
+  }
+  return pinnedStore;
+}
+
+QueryScope::QueryScope()
+  : QueryScope(nullptr)
+{
+}
+
+QueryScope::QueryScope(Store::Ptr const &store)
+{
+  if (store)
+  {
+    if (queryScopeDepth > 0u)
+    {
+      previous_ = pinnedStore;
+      restorePrevious_ = true;
+    }
+    pinnedStore = store;
+    if (!pagingScope)
+    {
+      pagingScope.reset(new Store::PagingScope(*pinnedStore));
+    }
+  }
+  else if (queryScopeDepth == 0u)
+  {
+    // the store pinned by getStore() outside of any scope is released
+    pinnedStore.reset();
+  }
+  // nested scopes without a store of their own only count the depth, so they are cheap
+  queryScopeDepth++;
+}
+
+QueryScope::~QueryScope()
+{
+  queryScopeDepth--;
+  if (queryScopeDepth == 0u)
+  {
+    // the pinned store is still alive when ending the paging scope
+    pagingScope.reset();
+    pinnedStore.reset();
+  }
+  else if (restorePrevious_)
+  {
+    pinnedStore = std::move(previous_);
+  }
+}
+
+Store::Ptr QueryScope::getPinnedStore()
+{
+  if ((queryScopeDepth == 0u) || (MapContext::getCurrent() != nullptr))
+  {
+    return nullptr;
+  }
+  return getPinnedOrCurrentStore();
+}
+
 Store &getStore()
 {
-  return *AdMapAccess::getInitializedInstance().mStore;
+  auto const context = MapContext::getCurrent();
+  if (context != nullptr)
+  {
+    // queries within a context don't touch the global map access
+    return context->getStore();
+  }
+  return *getPinnedOrCurrentStore();
+}
+
+MapContext::Ptr createMapContext()
+{
+  auto const currentContext = MapContext::getCurrent();
+  auto const store = (currentContext != nullptr) ? currentContext->getStorePtr() : getPinnedOrCurrentStore();
+  auto context = std::make_shared<MapContext>(store);
+  if (isENUReferencePointSet())
+  {
+    context->setENUReferencePoint(getENUReferencePoint());
+  }
+  return context;
+}
+
+bool applyPatch(MapPatch const &patch)
+{
+  return AdMapAccess::getInitializedInstance().applyPatch(patch);
+}
+
+bool applyPatch(std::string const &patchFileName)
+{
+  serialize::SerializerFileCRC32 serializer(false);
+  size_t versionMajor = 0;
+  size_t versionMinor = 0;
+  if (!serializer.open(patchFileName, versionMajor, versionMinor))
+  {
+    access::getLogger()->warn("Unable to open map patch for reading {}", patchFileName);
+    return false;
+  }
+  MapPatch patch;
+  bool const ok = patch.serialize(serializer);
+  if (!serializer.close() || !ok)
+  {
+    access::getLogger()->warn("Map patch is corrupt {}", patchFileName);
+    return false;
+  }
+  return applyPatch(patch);
 }
 
 } // namespace access
@@ -0,0 +1,78 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include "WorkerPool.hpp"
+#include "ad/map/access/MapContext.hpp"
+#include "ad/map/access/Operation.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+/**
+ * @brief Calls fn(index) for each index in [0, count) using up to threadCount threads.
+ *
+ * The calling thread takes part in the work, supported by up to threadCount - 1 threads of the WorkerPool.
+ * The indices are handed out one by one, so fn has to be safe to be called concurrently for different indices.
+ * The MapContext bound to the calling thread and the store pinned by its QueryScope are bound to the worker threads
+ * as well.
+ * After the first exception thrown by fn, the remaining indices are skipped and the exception is rethrown once
+ * all threads are finished.
+ */
+template <typename Function> void parallelFor(std::size_t const count, std::size_t const threadCount, Function fn)
+{
+  std::atomic<std::size_t> nextIndex{0u};
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+  auto const context = MapContext::getCurrent();
+  auto const pinnedStore = QueryScope::getPinnedStore();
+
+  auto worker = [&]() {
+    MapContext::Scope scope(context);
+    std::unique_ptr<QueryScope> queryScope;
+    if (pinnedStore)
+    {
+      queryScope.reset(new QueryScope(pinnedStore));
+    }
+    try
+    {
+      for (auto index = nextIndex++; index < count; index = nextIndex++)
+      {
+        fn(index);
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> guard(exceptionMutex);
+      if (!exception)
+      {
+        exception = std::current_exception();
+      }
+      nextIndex = count;
+    }
+  };
+
+  auto const helperCount = std::min(threadCount, count);
+  WorkerPool::getInstance().run(helperCount > 0u ? helperCount - 1u : 0u, worker);
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+} // namespace access
+} // namespace map
+} // namespace ad
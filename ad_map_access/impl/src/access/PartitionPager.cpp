@@ -0,0 +1,408 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "PartitionPager.hpp"
+
+#include "ad/map/access/Logging.hpp"
+#include "ad/map/point/BoundingSphereOperation.hpp"
+#include "ad/map/serialize/ChecksumCRC32.hpp"
+#include "ad/map/serialize/StorageMemoryMapped.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+/**
+ * @brief Memory mapped serializer without checksum.
+ *
+ * Checking the checksum of the whole file would read all partitions, instead each section is verified when it
+ * is loaded.
+ */
+class PagingSerializer : virtual public serialize::Serializer,
+                         virtual public serialize::StorageMemoryMapped,
+                         virtual public serialize::ChecksumCRC32
+{
+public:
+  PagingSerializer()
+    : serialize::Serializer(false, false)
+  {
+  }
+};
+
+static std::size_t toPartitionIndex(lane::LaneId const &id)
+{
+  return static_cast<std::size_t>(static_cast<uint64_t>(id));
+}
+
+PartitionPager::PartitionPager(Store &store, std::size_t memoryBudget)
+  : store_(store)
+  , memory_budget_(memoryBudget)
+{
+}
+
+PartitionPager::~PartitionPager()
+{
+  if (serializer_)
+  {
+    serializer_->close();
+  }
+}
+
+serialize::ISerializer *PartitionPager::open(std::string const &fileName)
+{
+  std::unique_ptr<serialize::Serializer> serializer(new PagingSerializer());
+  std::size_t versionMajor = 0u;
+  std::size_t versionMinor = 0u;
+  if (!serializer->open(fileName, versionMajor, versionMinor))
+  {
+    return nullptr;
+  }
+  if (!serializer->useSections())
+  {
+    access::getLogger()->error("PartitionPager: Map {} has no sections and can't be paged.", fileName);
+    serializer->close();
+    return nullptr;
+  }
+  serializer_ = std::move(serializer);
+  return serializer_.get();
+}
+
+void PartitionPager::addSections(std::vector<StoreSection> &&sections)
+{
+  for (auto &section : sections)
+  {
+    auto const partitionIndex = partition_indices_.insert({section.partitionId, partitions_.size()});
+    if (partitionIndex.second)
+    {
+      partitions_.emplace_back();
+      partitions_.back().partitionId = section.partitionId;
+      partitions_.back().boundingSphere = section.boundingSphere;
+    }
+    auto &partition = partitions_[partitionIndex.first->second];
+    if (section.boundingSphere.radius > physics::Distance(0.))
+    {
+      if (partition.boundingSphere.radius > physics::Distance(0.))
+      {
+        partition.boundingSphere = partition.boundingSphere + section.boundingSphere;
+      }
+      else
+      {
+        partition.boundingSphere = section.boundingSphere;
+      }
+    }
+    partition.bytes += section.bytes;
+    partition.sections.push_back(std::move(section));
+  }
+}
+
+void PartitionPager::buildIndex()
+{
+  std::vector<LaneSpatialIndex::Entry> entries;
+  for (std::size_t i = 0u; i < partitions_.size(); ++i)
+  {
+    if (!partitions_[i].sections.empty() && (partitions_[i].boundingSphere.radius > physics::Distance(0.)))
+    {
+      entries.push_back({lane::LaneId(static_cast<uint64_t>(i)), partitions_[i].boundingSphere});
+    }
+  }
+  partition_index_.build(entries);
+
+  // as on writing the sections, objects belong to the first partition listing them
+  if (lane_partitions_.empty() && landmark_partitions_.empty())
+  {
+    for (auto const &partition_id_and_ids : store_.part_lane_map_)
+    {
+      auto const partitionIndex = partition_indices_.find(partition_id_and_ids.first);
+      if (partitionIndex != partition_indices_.end())
+      {
+        for (auto const &laneId : partition_id_and_ids.second)
+        {
+          lane_partitions_.insert({laneId, partitionIndex->second});
+        }
+      }
+    }
+    for (auto const &partition_id_and_ids : store_.part_landmark_map_)
+    {
+      auto const partitionIndex = partition_indices_.find(partition_id_and_ids.first);
+      if (partitionIndex != partition_indices_.end())
+      {
+        for (auto const &landmarkId : partition_id_and_ids.second)
+        {
+          landmark_partitions_.insert({landmarkId, partitionIndex->second});
+        }
+      }
+    }
+  }
+}
+
+void PartitionPager::enterScope()
+{
+  auto const guard = lock();
+  ++scope_count_;
+}
+
+void PartitionPager::leaveScope()
+{
+  auto const guard = lock();
+  // a scope opened before the Store became paged is not counted
+  if (scope_count_ > 0u)
+  {
+    --scope_count_;
+  }
+  if (scope_count_ == 0u)
+  {
+    evict(false);
+  }
+}
+
+lane::LaneIdList PartitionPager::findLanes(point::BoundingSphere const &boundingSphere)
+{
+  auto const guard = lock();
+  // all partitions touched have to stay resident until their lanes are collected
+  enterScope();
+  auto const partitionIds = partition_index_.findLanes(boundingSphere);
+  for (auto const &id : partitionIds)
+  {
+    request(toPartitionIndex(id));
+  }
+  lane::LaneIdList laneIds;
+  for (auto const &id : partitionIds)
+  {
+    auto const partitionLaneIds = partitions_[toPartitionIndex(id)].laneIndex.findLanes(boundingSphere);
+    laneIds.insert(laneIds.end(), partitionLaneIds.begin(), partitionLaneIds.end());
+  }
+  leaveScope();
+  return laneIds;
+}
+
+void PartitionPager::forEachLane(std::function<void(lane::Lane::Ptr const &)> const &visitor)
+{
+  auto const guard = lock();
+  for (auto &partition : partitions_)
+  {
+    if (partition.resident)
+    {
+      for (auto const &laneId : partition.lanes)
+      {
+        visitor(store_.lane_map_.at(laneId));
+      }
+      continue;
+    }
+    for (auto &section : partition.sections)
+    {
+      if (decodeSection(store_.use_magic_, store_.use_embedded_geometry_, false, section))
+      {
+        for (auto const &lane : section.lanes)
+        {
+          visitor(lane.second);
+        }
+      }
+      section.lanes.clear();
+      section.landmarks.clear();
+    }
+  }
+}
+
+void PartitionPager::requestLane(lane::LaneId const &id)
+{
+  auto const lanePartition = lane_partitions_.find(id);
+  if (lanePartition != lane_partitions_.end())
+  {
+    request(lanePartition->second);
+  }
+}
+
+void PartitionPager::requestLandmark(landmark::LandmarkId const &id)
+{
+  auto const landmarkPartition = landmark_partitions_.find(id);
+  if (landmarkPartition != landmark_partitions_.end())
+  {
+    request(landmarkPartition->second);
+  }
+}
+
+void PartitionPager::requestPartition(PartitionId const &id)
+{
+  auto const partitionIndex = partition_indices_.find(id);
+  if (partitionIndex != partition_indices_.end())
+  {
+    request(partitionIndex->second);
+  }
+}
+
+void PartitionPager::removePartition(PartitionId const &id)
+{
+  auto const partitionIndex = partition_indices_.find(id);
+  if (partitionIndex == partition_indices_.end())
+  {
+    return;
+  }
+  auto const index = partitionIndex->second;
+  auto &partition = partitions_[index];
+  if (partition.resident)
+  {
+    unload(partition);
+  }
+  partition.sections.clear();
+  partition.bytes = 0u;
+  partition_indices_.erase(partitionIndex);
+  for (auto lanePartition = lane_partitions_.begin(); lanePartition != lane_partitions_.end();)
+  {
+    lanePartition = (lanePartition->second == index) ? lane_partitions_.erase(lanePartition) : ++lanePartition;
+  }
+  for (auto landmarkPartition = landmark_partitions_.begin(); landmarkPartition != landmark_partitions_.end();)
+  {
+    landmarkPartition
+      = (landmarkPartition->second == index) ? landmark_partitions_.erase(landmarkPartition) : ++landmarkPartition;
+  }
+  buildIndex();
+}
+
+point::BoundingSphere PartitionPager::getBoundingSphere() const
+{
+  point::BoundingSphere boundingSphere;
+  bool first = true;
+  for (auto const &partition : partitions_)
+  {
+    if (!partition.sections.empty() && (partition.boundingSphere.radius > physics::Distance(0.)))
+    {
+      boundingSphere = first ? partition.boundingSphere : boundingSphere + partition.boundingSphere;
+      first = false;
+    }
+  }
+  return boundingSphere;
+}
+
+Store::PagingStatistics PartitionPager::getStatistics() const
+{
+  return statistics_;
+}
+
+void PartitionPager::request(std::size_t index)
+{
+  auto &partition = partitions_[index];
+  if (partition.resident)
+  {
+    ++statistics_.hits;
+    lru_.splice(lru_.begin(), lru_, partition.lruItem);
+  }
+  else
+  {
+    ++statistics_.misses;
+    if (!load(partition))
+    {
+      return;
+    }
+    ++statistics_.loads;
+    partition.resident = true;
+    lru_.push_front(index);
+    partition.lruItem = lru_.begin();
+    statistics_.residentBytes += partition.bytes;
+  }
+  if (scope_count_ == 0u)
+  {
+    evict(true);
+  }
+}
+
+bool PartitionPager::load(Partition &partition)
+{
+  auto const index = partition_indices_.at(partition.partitionId);
+  bool ok = true;
+  for (auto &section : partition.sections)
+  {
+    ok = ok && decodeSection(store_.use_magic_, store_.use_embedded_geometry_, false, section);
+  }
+  for (auto &section : partition.sections)
+  {
+    if (ok)
+    {
+      for (auto &lane : section.lanes)
+      {
+        if (store_.lane_map_.insert(lane).second)
+        {
+          partition.lanes.push_back(lane.first);
+          lane_partitions_.insert({lane.first, index});
+        }
+        else
+        {
+          access::getLogger()->error("PartitionPager: Lane {} is contained in several partitions", lane.first);
+        }
+      }
+      for (auto &landmark : section.landmarks)
+      {
+        if (store_.landmark_map_.insert(landmark).second)
+        {
+          partition.landmarks.push_back(landmark.first);
+          landmark_partitions_.insert({landmark.first, index});
+        }
+        else
+        {
+          access::getLogger()->error("PartitionPager: Landmark {} is contained in several partitions",
+                                     landmark.first);
+        }
+      }
+    }
+    section.lanes.clear();
+    section.landmarks.clear();
+  }
+  if (ok)
+  {
+    // only the lanes of this partition are indexed, the indices of the other partitions stay untouched
+    store_.insertLaneHandles(partition.lanes);
+    std::vector<LaneSpatialIndex::Entry> entries;
+    entries.reserve(partition.lanes.size());
+    auto const partitionLanes = store_.part_lane_map_.find(partition.partitionId);
+    if (partitionLanes != store_.part_lane_map_.end())
+    {
+      for (auto const &laneId : partitionLanes->second)
+      {
+        auto const lane = store_.lane_map_.find(laneId);
+        if ((lane != store_.lane_map_.end()) && (lane_partitions_.at(laneId) == index))
+        {
+          entries.push_back({laneId, lane->second->boundingSphere});
+        }
+      }
+    }
+    partition.laneIndex.build(entries);
+  }
+  return ok;
+}
+
+void PartitionPager::unload(Partition &partition)
+{
+  store_.eraseLaneHandles(partition.lanes);
+  for (auto const &laneId : partition.lanes)
+  {
+    store_.lane_map_.erase(laneId);
+  }
+  for (auto const &landmarkId : partition.landmarks)
+  {
+    store_.landmark_map_.erase(landmarkId);
+  }
+  partition.laneIndex.clear();
+  partition.lanes.clear();
+  partition.landmarks.clear();
+  partition.resident = false;
+  lru_.erase(partition.lruItem);
+  statistics_.residentBytes -= partition.bytes;
+}
+
+void PartitionPager::evict(bool keepMostRecent)
+{
+  std::size_t const keepCount = keepMostRecent ? 1u : 0u;
+  while ((statistics_.residentBytes > memory_budget_) && (lru_.size() > keepCount))
+  {
+    unload(partitions_[lru_.back()]);
+    ++statistics_.evictions;
+  }
+}
+
+} // namespace access
+} // namespace map
+} // namespace ad
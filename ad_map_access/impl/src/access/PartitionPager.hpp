@@ -0,0 +1,193 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "LaneSpatialIndex.hpp"
+#include "StoreSection.hpp"
+#include "ad/map/access/Store.hpp"
+#include "ad/map/serialize/Serializer.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+/**
+ * @brief Loads the partitions of a paged Store on demand.
+ *
+ * The map file stays open for the lifetime of the pager. Only the table of sections is read when opening the map,
+ * the sections of a partition are verified and decoded the first time a query touches the partition. Each resident
+ * partition has its own spatial lane index, so loading or evicting a partition doesn't touch the other ones.
+ * Partitions not used recently are evicted from the Store when the serialized size of all resident partitions
+ * exceeds the memory budget: while a PagingScope is open, eviction is deferred until the last scope ends, outside
+ * of any scope it takes place on each request, but keeps the partition just requested. So a single query within a
+ * scope may exceed the budget.
+ */
+class PartitionPager
+{
+public: // Constructor/Destructor
+  /**
+   * @brief Constructor.
+   * @param[in] store The Store the partitions are loaded into.
+   * @param[in] memoryBudget Maximal serialized size of the resident partitions in bytes.
+   */
+  PartitionPager(Store &store, std::size_t memoryBudget);
+
+  /**
+   * @brief Destructor.
+   *        Closes the map file.
+   */
+  ~PartitionPager();
+
+  PartitionPager(PartitionPager const &) = delete;
+  PartitionPager &operator=(PartitionPager const &) = delete;
+
+public: // Operations
+  /**
+   * @brief Opens the map file.
+   * @returns Serializer positioned behind the file header, nullptr if the file can't be opened or has no sections.
+   */
+  serialize::ISerializer *open(std::string const &fileName);
+
+  /**
+   * @brief Takes over the sections read from the map file.
+   */
+  void addSections(std::vector<StoreSection> &&sections);
+
+  /**
+   * @brief Builds the partition index and assigns lanes and landmarks to the partitions.
+   *        To be called once the partition lists of the Store are read.
+   */
+  void buildIndex();
+
+  /**
+   * @returns Lock serializing all accesses to the paged Store.
+   */
+  std::unique_lock<std::recursive_mutex> lock() const
+  {
+    return std::unique_lock<std::recursive_mutex>(mutex_);
+  }
+
+  /**
+   * @brief Defers the eviction of partitions until the matching leaveScope().
+   */
+  void enterScope();
+
+  /**
+   * @brief Ends a scope opened by enterScope() and evicts partitions, if this was the last scope.
+   */
+  void leaveScope();
+
+  /**
+   * @brief Spatial lane search, loading all partitions intersecting with the bounding sphere.
+   * @returns Identifiers of all resident lanes whose bounding sphere intersects with the search sphere.
+   */
+  lane::LaneIdList findLanes(point::BoundingSphere const &boundingSphere);
+
+  /**
+   * @brief Visits all lanes of all partitions without making the partitions resident.
+   *
+   * The lanes of partitions not resident are decoded one partition at a time and dropped again after visiting
+   * them, so the lanes must not be kept by the visitor.
+   */
+  void forEachLane(std::function<void(lane::Lane::Ptr const &)> const &visitor);
+
+  /**
+   * @brief Makes sure the partition containing the lane is resident.
+   */
+  void requestLane(lane::LaneId const &id);
+
+  /**
+   * @brief Makes sure the partition containing the landmark is resident.
+   */
+  void requestLandmark(landmark::LandmarkId const &id);
+
+  /**
+   * @brief Makes sure the partition is resident.
+   */
+  void requestPartition(PartitionId const &id);
+
+  /**
+   * @brief Drops the partition from the Store and from paging.
+   */
+  void removePartition(PartitionId const &id);
+
+  /**
+   * @returns Bounding sphere over all partitions.
+   */
+  point::BoundingSphere getBoundingSphere() const;
+
+  /**
+   * @returns Paging statistics.
+   */
+  Store::PagingStatistics getStatistics() const;
+
+private: // Types
+  /**
+   * @brief A pageable partition.
+   */
+  struct Partition
+  {
+    PartitionId partitionId;                  ///< Identifier of the partition.
+    point::BoundingSphere boundingSphere;     ///< Bounding sphere of the lanes of the partition.
+    std::vector<StoreSection> sections;       ///< The serialized sections of the partition.
+    std::size_t bytes{0u};                    ///< Serialized size of the sections.
+    bool resident{false};                     ///< The partition is loaded into the Store.
+    lane::LaneIdList lanes;                   ///< Lanes loaded from the partition.
+    landmark::LandmarkIdList landmarks;       ///< Landmarks loaded from the partition.
+    std::list<std::size_t>::iterator lruItem; ///< Position within the LRU list, if resident.
+    LaneSpatialIndex laneIndex;               ///< Spatial index over the lanes, if resident.
+  };
+
+private: // Aux Methods
+  /**
+   * @brief Marks the partition as most recently used and loads it if required.
+   */
+  void request(std::size_t index);
+
+  /**
+   * @brief Decodes the sections of the partition into the Store.
+   */
+  bool load(Partition &partition);
+
+  /**
+   * @brief Removes the content of the partition from the Store.
+   */
+  void unload(Partition &partition);
+
+  /**
+   * @brief Evicts least recently used partitions until the budget is met.
+   * @param[in] keepMostRecent Keep the most recently used partition, even if exceeding the budget.
+   */
+  void evict(bool keepMostRecent);
+
+private:                                                            // Data Members
+  Store &store_;                                                    ///< The paged Store.
+  std::size_t memory_budget_;                                       ///< Maximal serialized size of resident partitions.
+  std::unique_ptr<serialize::Serializer> serializer_;               ///< The open map file.
+  std::vector<Partition> partitions_;                               ///< The partitions.
+  std::map<PartitionId, std::size_t> partition_indices_;            ///< Map PartitionId/index of partition.
+  std::map<lane::LaneId, std::size_t> lane_partitions_;             ///< Map LaneId/index of partition.
+  std::map<landmark::LandmarkId, std::size_t> landmark_partitions_; ///< Map LandmarkId/index of partition.
+  LaneSpatialIndex partition_index_;                                ///< Spatial index over the partitions.
+  std::list<std::size_t> lru_;                                      ///< Resident partitions, most recently used first.
+  Store::PagingStatistics statistics_;                              ///< Paging statistics.
+  std::size_t scope_count_{0u};                                     ///< Number of open PagingScopes.
+  mutable std::recursive_mutex mutex_;                              ///< Serializes the accesses to the Store.
+};
+
+} // namespace access
+} // namespace map
+} // namespace ad
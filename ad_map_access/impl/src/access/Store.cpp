@@ -7,10 +7,17 @@
 // ----------------- END LICENSE BLOCK -----------------------------------
 
 #include "ad/map/access/Store.hpp"
+#include "../lane/LaneOperationPrivate.hpp"
+#include "LaneHandleMap.hpp"
+#include "LaneSpatialIndex.hpp"
+#include "PartitionPager.hpp"
 #include "ad/map/access/Logging.hpp"
+#include "ad/map/access/MapPatch.hpp"
+#include "ad/map/lane/LaneGraph.hpp"
 
 #include <algorithm>
 #include <cstring>
+#include <set>
 #include <string>
 #include "ad/map/lane/LaneOperation.hpp"
 #include "ad/map/point/BoundingSphereOperation.hpp"
@@ -19,11 +26,35 @@ namespace ad {
 namespace map {
 namespace access {
 
+Store::PagingScope::PagingScope(Store const &store)
+  : store_(store)
+{
+  if (store_.pager_)
+  {
+    store_.pager_->enterScope();
+  }
+}
+
+Store::PagingScope::~PagingScope()
+{
+  if (store_.pager_)
+  {
+    store_.pager_->leaveScope();
+  }
+}
+
 Store::Store()
+  : lane_index_(new LaneSpatialIndex())
+  , lane_index_valid_(false)
+  , lane_handles_(new LaneHandleMap())
+  , lane_handles_valid_(false)
 {
   use_magic_ = false;
   use_embedded_geometry_ = true;
   use_geometry_store_ = false;
+  geometry_error_bound_ = physics::Distance(0.);
+  load_geometry_ = true;
+  use_lane_segment_index_ = true;
 }
 
 Store::~Store()
@@ -32,7 +63,45 @@ Store::~Store()
 
 bool Store::empty() const
 {
-  return lane_map_.empty() && landmark_map_.empty();
+  return !pager_ && lane_map_.empty() && landmark_map_.empty();
+}
+
+bool Store::hasGeometry() const
+{
+  return load_geometry_;
+}
+
+void Store::setLaneSegmentIndexEnabled(bool enabled)
+{
+  auto paging_lock = lockPaging();
+  std::lock_guard<std::mutex> guard(lane_index_mutex_);
+  if (use_lane_segment_index_ != enabled)
+  {
+    use_lane_segment_index_ = enabled;
+    lane_segment_index_map_.clear();
+    lane_index_valid_ = false;
+  }
+}
+
+bool Store::isLaneSegmentIndexEnabled() const
+{
+  std::lock_guard<std::mutex> guard(lane_index_mutex_);
+  return use_lane_segment_index_;
+}
+
+bool Store::isPaged() const
+{
+  return static_cast<bool>(pager_);
+}
+
+Store::PagingStatistics Store::getPagingStatistics() const
+{
+  auto paging_lock = lockPaging();
+  if (pager_)
+  {
+    return pager_->getStatistics();
+  }
+  return PagingStatistics();
 }
 
 ////////////////////
@@ -62,10 +131,16 @@ PartitionIdList Store::getPartitions() const
 lane::Lane::ConstPtr Store::getLanePtr(lane::LaneId const &id) const
 {
   lane::Lane::ConstPtr lane_ptr;
-  auto id_and_lane = lane_map_.find(id);
-  if (id_and_lane != lane_map_.end())
+  auto paging_lock = lockPaging();
+  if (pager_)
+  {
+    pager_->requestLane(id);
+  }
+  updateLaneHandles();
+  auto lane_entry = lane_handles_->find(id);
+  if (lane_entry != nullptr)
   {
-    lane_ptr = id_and_lane->second;
+    lane_ptr = *lane_entry;
   }
   else
   {
@@ -74,6 +149,23 @@ lane::Lane::ConstPtr Store::getLanePtr(lane::LaneId const &id) const
   return lane_ptr;
 }
 
+lane::Lane const *Store::getLaneHandle(lane::LaneId const &id) const
+{
+  auto paging_lock = lockPaging();
+  if (pager_)
+  {
+    pager_->requestLane(id);
+  }
+  updateLaneHandles();
+  auto lane_entry = lane_handles_->find(id);
+  if (lane_entry != nullptr)
+  {
+    return lane_entry->get();
+  }
+  access::getLogger()->warn("Lane not in the Store. ID: {}", id);
+  return nullptr;
+}
+
 lane::LaneIdList Store::getLanes() const
 {
   lane::LaneIdList ids;
@@ -98,6 +190,18 @@ lane::LaneIdList Store::getLanes(PartitionId const &partition_id) const
 lane::LaneIdList Store::getLanes(std::string const &type_filter, bool is_hov) const
 {
   lane::LaneIdList ids;
+  auto paging_lock = lockPaging();
+  if (pager_)
+  {
+    pager_->forEachLane([&ids, &type_filter, is_hov](lane::Lane::Ptr const &lane) {
+      if (lane::satisfiesFilter(*lane, type_filter, is_hov))
+      {
+        ids.push_back(lane->id);
+      }
+    });
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  }
   for (auto id_and_lane : lane_map_)
   {
     lane::Lane::Ptr lane = id_and_lane.second;
@@ -112,6 +216,11 @@ lane::LaneIdList Store::getLanes(std::string const &type_filter, bool is_hov) co
 lane::LaneIdList Store::getLanes(PartitionId partition_id, std::string const &type_filter, bool is_hov) const
 {
   lane::LaneIdList ids;
+  auto paging_lock = lockPaging();
+  if (pager_)
+  {
+    pager_->requestPartition(partition_id);
+  }
   auto partition_and_ids = part_lane_map_.find(partition_id);
   if (partition_and_ids != part_lane_map_.end())
   {
@@ -130,6 +239,40 @@ lane::LaneIdList Store::getLanes(PartitionId partition_id, std::string const &ty
   return ids;
 }
 
+lane::LaneIdList Store::getLanesNear(point::BoundingSphere const &bounding_sphere) const
+{
+  auto paging_lock = lockPaging();
+  if (pager_)
+  {
+    return pager_->findLanes(bounding_sphere);
+  }
+  updateLaneIndex();
+  return lane_index_->findLanes(bounding_sphere);
+}
+
+std::shared_ptr<lane::LaneGraph const> Store::getLaneGraph() const
+{
+  auto paging_lock = lockPaging();
+  std::lock_guard<std::mutex> guard(lane_index_mutex_);
+  if (!lane_graph_)
+  {
+    if (pager_)
+    {
+      // the graph covers all partitions, the lanes are paged in on demand
+      auto lane_graph
+        = std::make_shared<lane::LaneGraph>([this](lane::LaneId const &id) { return getLanePtr(id); });
+      pager_->forEachLane([&lane_graph](lane::Lane::Ptr const &lane) { lane_graph->addLane(lane); });
+      lane_graph->finalize();
+      lane_graph_ = lane_graph;
+    }
+    else
+    {
+      lane_graph_ = std::make_shared<lane::LaneGraph>(lane_map_);
+    }
+  }
+  return lane_graph_;
+}
+
 landmark::LandmarkIdList Store::getLandmarks(PartitionId partition_id) const
 {
   auto partition_and_landmark = part_landmark_map_.find(partition_id);
@@ -143,6 +286,11 @@ landmark::LandmarkIdList Store::getLandmarks(PartitionId partition_id) const
 landmark::Landmark::ConstPtr Store::getLandmarkPtr(landmark::LandmarkId id) const
 {
   landmark::Landmark::ConstPtr landmark_ptr;
+  auto paging_lock = lockPaging();
+  if (pager_)
+  {
+    pager_->requestLandmark(id);
+  }
   auto id_and_landmark = landmark_map_.find(id);
   if (id_and_landmark != landmark_map_.end())
   {
@@ -158,6 +306,7 @@ landmark::Landmark::ConstPtr Store::getLandmarkPtr(landmark::LandmarkId id) cons
 landmark::LandmarkIdList Store::getLandmarks() const
 {
   landmark::LandmarkIdList ids;
+  auto paging_lock = lockPaging();
   for (auto id_and_landmark : landmark_map_)
   {
     ids.push_back(id_and_landmark.first);
@@ -167,6 +316,11 @@ landmark::LandmarkIdList Store::getLandmarks() const
 
 void Store::removePartition(PartitionId partition_id)
 {
+  auto paging_lock = lockPaging();
+  if (pager_)
+  {
+    pager_->removePartition(partition_id);
+  }
   {
     // remove lanes
     auto findLanesResult = part_lane_map_.find(partition_id);
@@ -177,6 +331,7 @@ void Store::removePartition(PartitionId partition_id)
         lane_map_.erase(lane_id);
       }
       part_lane_map_.erase(findLanesResult);
+      invalidateLaneIndex();
     }
   }
 
@@ -194,6 +349,372 @@ void Store::removePartition(PartitionId partition_id)
   }
 }
 
+Store::Ptr Store::createPatched(MapPatch const &patch) const
+{
+  if (pager_)
+  {
+    access::getLogger()->error("Store: Cannot patch paged Store.");
+    return nullptr;
+  }
+  auto store = std::make_shared<Store>();
+  store->use_magic_ = use_magic_;
+  store->use_embedded_geometry_ = use_embedded_geometry_;
+  store->use_geometry_store_ = use_geometry_store_;
+  store->geometry_error_bound_ = geometry_error_bound_;
+  store->load_geometry_ = load_geometry_;
+  store->use_lane_segment_index_ = use_lane_segment_index_;
+  store->meta_data_ = meta_data_;
+  store->lane_map_ = lane_map_;
+  store->landmark_map_ = landmark_map_;
+  store->part_lane_map_ = part_lane_map_;
+  store->part_landmark_map_ = part_landmark_map_;
+  {
+    std::lock_guard<std::mutex> guard(lane_index_mutex_);
+    store->lane_segment_index_map_ = lane_segment_index_map_;
+  }
+  if (!store->applyPatch(patch))
+  {
+    return nullptr;
+  }
+  return store;
+}
+
+template <typename Id, typename ObjectMap>
+static bool isPatchApplicable(ObjectMap const &objects,
+                              ObjectMap const &added,
+                              ObjectMap const &modified,
+                              std::vector<Id> const &removed,
+                              char const *objectType)
+{
+  std::set<Id> patched;
+  for (auto const &id_and_object : added)
+  {
+    if (!id_and_object.second || (id_and_object.second->id != id_and_object.first)
+        || (objects.find(id_and_object.first) != objects.end()) || !patched.insert(id_and_object.first).second)
+    {
+      access::getLogger()->error("Store: Patch adds invalid or existing {} {}", objectType, id_and_object.first);
+      return false;
+    }
+  }
+  for (auto const &id_and_object : modified)
+  {
+    if (!id_and_object.second || (id_and_object.second->id != id_and_object.first)
+        || (objects.find(id_and_object.first) == objects.end()) || !patched.insert(id_and_object.first).second)
+    {
+      access::getLogger()->error("Store: Patch modifies invalid or missing {} {}", objectType, id_and_object.first);
+      return false;
+    }
+  }
+  for (auto const &id : removed)
+  {
+    if ((objects.find(id) == objects.end()) || !patched.insert(id).second)
+    {
+      access::getLogger()->error("Store: Patch removes missing {} {}", objectType, id);
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Id, typename ObjectMap, typename PartitionMap>
+static void applyPatchedObjects(ObjectMap &objects,
+                                PartitionMap &partitions,
+                                PartitionId const &partition_id,
+                                ObjectMap const &added,
+                                ObjectMap const &modified,
+                                std::vector<Id> const &removed)
+{
+  std::set<Id> const removed_ids(removed.begin(), removed.end());
+  for (auto &partition : partitions)
+  {
+    auto &ids = partition.second;
+    ids.erase(
+      std::remove_if(ids.begin(), ids.end(), [&removed_ids](Id const &id) { return removed_ids.count(id) > 0; }),
+      ids.end());
+  }
+  for (auto const &id : removed)
+  {
+    objects.erase(id);
+  }
+  for (auto const &id_and_object : modified)
+  {
+    objects[id_and_object.first] = id_and_object.second;
+  }
+  for (auto const &id_and_object : added)
+  {
+    objects.insert(id_and_object);
+    partitions[partition_id].push_back(id_and_object.first);
+  }
+}
+
+bool Store::applyPatch(MapPatch const &patch)
+{
+  if (!isPatchApplicable(lane_map_, patch.addedLanes, patch.modifiedLanes, patch.removedLanes, "lane")
+      || !isPatchApplicable(
+           landmark_map_, patch.addedLandmarks, patch.modifiedLandmarks, patch.removedLandmarks, "landmark"))
+  {
+    return false;
+  }
+  for (auto const lanes : {&patch.addedLanes, &patch.modifiedLanes})
+  {
+    for (auto const &id_and_lane : *lanes)
+    {
+      if (!lane::isValid(*id_and_lane.second, false))
+      {
+        access::getLogger()->error("Store: Patch contains invalid lane {}", id_and_lane.first);
+        return false;
+      }
+    }
+  }
+  if (!patch.removedLanes.empty())
+  {
+    // the remaining lanes must not refer to removed ones
+    std::set<lane::LaneId> const removed_lanes(patch.removedLanes.begin(), patch.removedLanes.end());
+    auto const refersToRemovedLane = [&removed_lanes](LaneMap::value_type const &id_and_lane) {
+      for (auto const &contact_lane : id_and_lane.second->contactLanes)
+      {
+        if (removed_lanes.count(contact_lane.toLane) > 0)
+        {
+          access::getLogger()->error(
+            "Store: Patch removes lane {} still referenced by lane {}", contact_lane.toLane, id_and_lane.first);
+          return true;
+        }
+      }
+      return false;
+    };
+    for (auto const &id_and_lane : lane_map_)
+    {
+      if (id_and_lane.second && (removed_lanes.count(id_and_lane.first) == 0)
+          && (patch.modifiedLanes.find(id_and_lane.first) == patch.modifiedLanes.end())
+          && refersToRemovedLane(id_and_lane))
+      {
+        return false;
+      }
+    }
+    for (auto const lanes : {&patch.addedLanes, &patch.modifiedLanes})
+    {
+      if (std::any_of(lanes->begin(), lanes->end(), refersToRemovedLane))
+      {
+        return false;
+      }
+    }
+  }
+
+  applyPatchedObjects(lane_map_,
+                      part_lane_map_,
+                      patch.partitionId,
+                      patch.addedLanes,
+                      patch.modifiedLanes,
+                      patch.removedLanes);
+  applyPatchedObjects(landmark_map_,
+                      part_landmark_map_,
+                      patch.partitionId,
+                      patch.addedLandmarks,
+                      patch.modifiedLandmarks,
+                      patch.removedLandmarks);
+
+  lane::LaneIdList changed_lanes = patch.removedLanes;
+  for (auto const &id_and_lane : patch.modifiedLanes)
+  {
+    changed_lanes.push_back(id_and_lane.first);
+  }
+  invalidateLaneIndex(changed_lanes);
+  return true;
+}
+
+void Store::compactLanes()
+{
+  if (pager_)
+  {
+    return;
+  }
+  // drop references to the lanes held by the outdated segment indices and lane graph
+  lane_segment_index_map_.clear();
+  invalidateLaneGraph();
+  auto arena = std::make_shared<std::vector<lane::Lane>>();
+  arena->reserve(lane_map_.size());
+  for (auto const &id_and_lane : lane_map_)
+  {
+    if (id_and_lane.second)
+    {
+      if (id_and_lane.second.use_count() == 1)
+      {
+        arena->push_back(std::move(*id_and_lane.second));
+      }
+      else
+      {
+        arena->push_back(*id_and_lane.second);
+      }
+    }
+  }
+  // the lanes share the ownership of the arena, which never reallocates after this point
+  auto arena_lane = arena->begin();
+  for (auto &id_and_lane : lane_map_)
+  {
+    if (id_and_lane.second)
+    {
+      id_and_lane.second = lane::Lane::Ptr(arena, &(*arena_lane));
+      ++arena_lane;
+    }
+  }
+  invalidateLaneIndex();
+}
+
+void Store::invalidateLaneIndex()
+{
+  {
+    std::lock_guard<std::mutex> guard(lane_index_mutex_);
+    // lanes might have been modified in place, so none of the segment indices can be reused
+    lane_segment_index_map_.clear();
+  }
+  lane_index_valid_ = false;
+  lane_handles_valid_ = false;
+  invalidateLaneGraph();
+}
+
+void Store::invalidateLaneIndex(lane::LaneIdList const &lane_ids)
+{
+  {
+    std::lock_guard<std::mutex> guard(lane_index_mutex_);
+    for (auto const &lane_id : lane_ids)
+    {
+      lane_segment_index_map_.erase(lane_id);
+    }
+  }
+  lane_index_valid_ = false;
+  lane_handles_valid_ = false;
+  invalidateLaneGraph();
+}
+
+void Store::insertLaneHandles(lane::LaneIdList const &lane_ids)
+{
+  std::lock_guard<std::mutex> guard(lane_index_mutex_);
+  // an outdated handle map is rebuilt on next use anyway
+  if (lane_handles_valid_)
+  {
+    for (auto const &lane_id : lane_ids)
+    {
+      auto id_and_lane = lane_map_.find(lane_id);
+      if (id_and_lane != lane_map_.end())
+      {
+        lane_handles_->insert(lane_id, id_and_lane->second);
+      }
+    }
+  }
+}
+
+void Store::eraseLaneHandles(lane::LaneIdList const &lane_ids)
+{
+  std::lock_guard<std::mutex> guard(lane_index_mutex_);
+  for (auto const &lane_id : lane_ids)
+  {
+    lane_segment_index_map_.erase(lane_id);
+    if (lane_handles_valid_)
+    {
+      lane_handles_->erase(lane_id);
+    }
+  }
+}
+
+void Store::invalidateLaneGraph()
+{
+  std::lock_guard<std::mutex> guard(lane_index_mutex_);
+  lane_graph_.reset();
+}
+
+void Store::updateLaneHandles() const
+{
+  if (lane_handles_valid_)
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(lane_index_mutex_);
+  if (!lane_handles_valid_)
+  {
+    lane_handles_->build(lane_map_);
+    lane_handles_valid_ = true;
+  }
+}
+
+void Store::updateLaneIndex() const
+{
+  if (lane_index_valid_)
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(lane_index_mutex_);
+  if (!lane_index_valid_)
+  {
+    std::vector<LaneSpatialIndex::Entry> entries;
+    entries.reserve(lane_map_.size());
+    // segment indices still present refer to unchanged lanes and are reused
+    LaneSegmentIndexMap segment_index_map;
+    for (auto const &partition_id_and_ids : part_lane_map_)
+    {
+      for (auto const &lane_id : partition_id_and_ids.second)
+      {
+        auto id_and_lane = lane_map_.find(lane_id);
+        if ((id_and_lane != lane_map_.end()) && id_and_lane->second)
+        {
+          entries.push_back({lane_id, id_and_lane->second->boundingSphere});
+          auto id_and_index = lane_segment_index_map_.find(lane_id);
+          if ((id_and_index != lane_segment_index_map_.end()) && (id_and_index->second->lane == id_and_lane->second))
+          {
+            segment_index_map[lane_id] = id_and_index->second;
+          }
+          else
+          {
+            segment_index_map[lane_id]
+              = std::make_shared<lane::LaneSegmentIndex>(id_and_lane->second, use_lane_segment_index_);
+          }
+        }
+      }
+    }
+    lane_segment_index_map_.swap(segment_index_map);
+    lane_index_->build(entries);
+    lane_index_valid_ = true;
+  }
+}
+
+std::shared_ptr<lane::LaneSegmentIndex const> Store::getLaneSegmentIndex(lane::LaneId const &id) const
+{
+  auto paging_lock = lockPaging();
+  if (pager_)
+  {
+    // the segment indices of a paged Store are created on demand and dropped with their partition
+    std::lock_guard<std::mutex> guard(lane_index_mutex_);
+    auto id_and_index = lane_segment_index_map_.find(id);
+    if (id_and_index == lane_segment_index_map_.end())
+    {
+      auto id_and_lane = lane_map_.find(id);
+      if ((id_and_lane == lane_map_.end()) || !id_and_lane->second)
+      {
+        return nullptr;
+      }
+      auto const lane_segment_index
+        = std::make_shared<lane::LaneSegmentIndex>(id_and_lane->second, use_lane_segment_index_);
+      id_and_index = lane_segment_index_map_.insert({id, lane_segment_index}).first;
+    }
+    return id_and_index->second;
+  }
+  updateLaneIndex();
+  auto id_and_index = lane_segment_index_map_.find(id);
+  if (id_and_index != lane_segment_index_map_.end())
+  {
+    return id_and_index->second;
+  }
+  return nullptr;
+}
+
+std::unique_lock<std::recursive_mutex> Store::lockPaging() const
+{
+  if (pager_)
+  {
+    return pager_->lock();
+  }
+  return std::unique_lock<std::recursive_mutex>();
+}
+
 /////////////
 // Statistics
 
@@ -215,6 +736,11 @@ physics::Distance Store::getCumulativeLaneLength() const
 point::BoundingSphere Store::getBoundingSphere() const
 {
   point::BoundingSphere boundingSphere;
+  auto paging_lock = lockPaging();
+  if (pager_)
+  {
+    return pager_->getBoundingSphere();
+  }
   if (lane_map_.empty())
   {
     return boundingSphere;
@@ -0,0 +1,116 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "StoreSection.hpp"
+
+#include <algorithm>
+#include "ad/map/access/Logging.hpp"
+#include "ad/map/point/BoundingSphereOperation.hpp"
+#include "ad/map/point/ECEFOperation.hpp"
+#include "ad/map/serialize/ChecksumCRC32.hpp"
+#include "ad/map/serialize/SerializeGeneratedTypes.hpp"
+#include "ad/map/serialize/SerializerBuffer.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+static bool serializeSectionContent(bool useMagic,
+                                    bool useEmbeddedPoints,
+                                    serialize::ISerializer &buffer,
+                                    StoreSection &section)
+{
+  buffer.setUseMagic(useMagic);
+  buffer.setUseEmbeddedPoints(useEmbeddedPoints);
+  return buffer.serializeObjectPtrMap(section.lanes) && buffer.serializeObjectPtrMap(section.landmarks);
+}
+
+bool encodeSection(bool useMagic, bool useEmbeddedPoints, StoreSection &section)
+{
+  serialize::SerializerBuffer buffer;
+  if (!serializeSectionContent(useMagic, useEmbeddedPoints, buffer, section))
+  {
+    access::getLogger()->error("Store: Unable to serialize section of partition {}", section.partitionId);
+    return false;
+  }
+  section.buffer = buffer.getBuffer();
+  section.data = section.buffer.data();
+  section.bytes = section.buffer.size();
+  section.crc = serialize::ChecksumCRC32::calculate(0u, section.data, section.bytes);
+
+  // as for lanes, a sphere at the origin with radius 0 marks a missing bounding sphere
+  section.boundingSphere.center = point::createECEFPoint(0., 0., 0.);
+  section.boundingSphere.radius = physics::Distance(0.);
+  for (auto const &lane : section.lanes)
+  {
+    if (section.boundingSphere.radius == physics::Distance(0.))
+    {
+      section.boundingSphere = lane.second->boundingSphere;
+    }
+    else
+    {
+      section.boundingSphere = section.boundingSphere + lane.second->boundingSphere;
+    }
+  }
+  return true;
+}
+
+bool decodeSection(bool useMagic, bool useEmbeddedPoints, bool skipInnerPoints, StoreSection &section)
+{
+  if (serialize::ChecksumCRC32::calculate(0u, section.data, section.bytes) != section.crc)
+  {
+    access::getLogger()->error("Store: Checksum mismatch in section of partition {}", section.partitionId);
+    return false;
+  }
+  serialize::SerializerBuffer buffer(section.data, section.bytes);
+  buffer.setSkipInnerPoints(skipInnerPoints);
+  if (!serializeSectionContent(useMagic, useEmbeddedPoints, buffer, section) || !buffer.atEnd())
+  {
+    access::getLogger()->error("Store: Invalid section of partition {}", section.partitionId);
+    return false;
+  }
+  return true;
+}
+
+bool serializeSectionEntry(serialize::ISerializer &serializer, StoreSection &section)
+{
+  return serialize::doSerialize(serializer, section.partitionId)
+    && serialize::doSerialize(serializer, section.boundingSphere) && serializer.serialize(section.bytes)
+    && serializer.serialize(section.crc);
+}
+
+bool serializeSectionData(serialize::ISerializer &serializer, StoreSection &section)
+{
+  if (serializer.isStoring())
+  {
+    return serializer.write(section.data, section.bytes);
+  }
+  section.data = serializer.readInPlace(section.bytes);
+  if (section.data != nullptr)
+  {
+    return true;
+  }
+  // the size is read from the stream, so allocate block by block as the data is actually present
+  section.buffer.clear();
+  while (section.buffer.size() < section.bytes)
+  {
+    auto const offset = section.buffer.size();
+    auto const blockBytes = std::min(section.bytes - offset, serialize::ISerializer::MAX_BLOCK_BYTES);
+    section.buffer.resize(offset + blockBytes);
+    if (!serializer.read(section.buffer.data() + offset, blockBytes))
+    {
+      return false;
+    }
+  }
+  section.data = section.buffer.data();
+  return true;
+}
+
+} // namespace access
+} // namespace map
+} // namespace ad
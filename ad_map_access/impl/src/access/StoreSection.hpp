@@ -0,0 +1,75 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "ad/map/access/Types.hpp"
+#include "ad/map/landmark/Types.hpp"
+#include "ad/map/lane/Types.hpp"
+#include "ad/map/serialize/ISerializer.hpp"
+
+namespace ad {
+namespace map {
+namespace access {
+
+/**
+ * @brief Independently serialized part of the lanes and landmarks of a Store.
+ *
+ * A section contains lanes and landmarks of a single partition. The table of sections within the map file lists
+ * partition, bounding sphere, size and checksum of each section, so sections can be verified and decoded
+ * independently of each other.
+ */
+struct StoreSection
+{
+  PartitionId partitionId;                                           ///< Partition the content belongs to.
+  point::BoundingSphere boundingSphere;                              ///< Bounding sphere of the lanes.
+  std::size_t bytes{0u};                                             ///< Size of the serialized section.
+  uint32_t crc{0u};                                                  ///< CRC-32 of the serialized section.
+  uint8_t const *data{nullptr};                                      ///< The serialized section.
+  std::vector<uint8_t> buffer;                                       ///< Storage of data, if not read in place.
+  std::map<lane::LaneId, lane::Lane::Ptr> lanes;                     ///< Lanes of the section.
+  std::map<landmark::LandmarkId, landmark::Landmark::Ptr> landmarks; ///< Landmarks of the section.
+};
+
+/**
+ * @brief Serialize lanes and landmarks of the section into its buffer and calculate size, checksum and bounding
+ *        sphere.
+ * @param[in] useMagic Use Magic Numbers for consistency during serialization.
+ * @param[in] useEmbeddedPoints Save geometry together with objects.
+ * @param[in,out] section The section.
+ * @returns true if successful.
+ */
+bool encodeSection(bool useMagic, bool useEmbeddedPoints, StoreSection &section);
+
+/**
+ * @brief Verify the checksum of the serialized section and deserialize its lanes and landmarks.
+ * @param[in] useMagic Use Magic Numbers for consistency during serialization.
+ * @param[in] useEmbeddedPoints Save geometry together with objects.
+ * @param[in] skipInnerPoints Read only the first and the last point of each edge.
+ * @param[in,out] section The section.
+ * @returns true if successful.
+ */
+bool decodeSection(bool useMagic, bool useEmbeddedPoints, bool skipInnerPoints, StoreSection &section);
+
+/**
+ * @brief Serialize the entry of the section within the table of sections.
+ */
+bool serializeSectionEntry(serialize::ISerializer &serializer, StoreSection &section);
+
+/**
+ * @brief Serialize the data of the section.
+ *        On deserialization, the data is referenced in place if supported by the serializer.
+ */
+bool serializeSectionData(serialize::ISerializer &serializer, StoreSection &section);
+
+} // namespace access
+} // namespace map
+} // namespace ad
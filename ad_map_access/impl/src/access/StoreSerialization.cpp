@@ -7,6 +7,9 @@
 // ----------------- END LICENSE BLOCK -----------------------------------
 
 #include "GeometryStore.hpp"
+#include "ParallelFor.hpp"
+#include "PartitionPager.hpp"
+#include "StoreSection.hpp"
 #include "ad/map/access/Factory.hpp"
 #include "ad/map/access/Logging.hpp"
 #include "ad/map/access/Operation.hpp"
@@ -14,7 +17,10 @@
 #include "ad/map/lane/LaneOperation.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <set>
 #include <string>
+#include <thread>
 
 namespace ad {
 namespace map {
@@ -23,14 +29,24 @@ namespace access {
 bool Store::save(serialize::ISerializer &serializer,
                  bool use_magic,
                  bool use_embedded_geometry,
-                 bool use_geometry_store)
+                 bool use_geometry_store,
+                 physics::Distance const &geometry_error_bound)
 {
-  if (serializer.isStoring())
+  if (pager_)
+  {
+    access::getLogger()->error("Cannot save paged Store.");
+  }
+  else if (!load_geometry_)
+  {
+    access::getLogger()->error("Cannot save Store loaded without geometry.");
+  }
+  else if (serializer.isStoring())
   {
     use_magic_ = use_magic;
     use_embedded_geometry_ = use_embedded_geometry;
     use_geometry_store_ = use_geometry_store;
-    return serialize(serializer);
+    geometry_error_bound_ = geometry_error_bound;
+    return serialize(serializer, 1u);
   }
   else
   {
@@ -39,12 +55,22 @@ bool Store::save(serialize::ISerializer &serializer,
   return false;
 }
 
-bool Store::load(serialize::ISerializer &serializer)
+bool Store::load(serialize::ISerializer &serializer, std::size_t threadCount, bool load_geometry)
 {
   bool ok = false;
-  if (!serializer.isStoring())
+  if (pager_)
   {
-    ok = serialize(serializer);
+    access::getLogger()->error("Cannot load into paged Store.");
+  }
+  else if (!serializer.isStoring())
+  {
+    if (threadCount == 0u)
+    {
+      threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    load_geometry_ = load_geometry;
+    ok = serialize(serializer, threadCount);
+    compactLanes();
   }
   else
   {
@@ -53,11 +79,45 @@ bool Store::load(serialize::ISerializer &serializer)
   return ok;
 }
 
+bool Store::openPaged(std::string const &fileName, std::size_t memoryBudget)
+{
+  if (!empty())
+  {
+    access::getLogger()->error("Store: Paging requires an empty Store.");
+    return false;
+  }
+  load_geometry_ = true;
+  pager_.reset(new PartitionPager(*this, memoryBudget));
+  auto serializer = pager_->open(fileName);
+  bool ok = (serializer != nullptr) && serialize(*serializer, 1u);
+  if (ok && use_geometry_store_)
+  {
+    access::getLogger()->error("Store: Map {} uses a geometry store and can't be paged.", fileName);
+    ok = false;
+  }
+  if (ok)
+  {
+    pager_->buildIndex();
+  }
+  else
+  {
+    pager_.reset();
+    meta_data_ = MapMetaData();
+    lane_map_.clear();
+    landmark_map_.clear();
+    part_lane_map_.clear();
+    part_landmark_map_.clear();
+    invalidateLaneIndex();
+  }
+  return ok;
+}
+
 ////////////////////////////////
 // ISerializeable implementation
 
 bool Store::isValid() const
 {
+  auto paging_lock = lockPaging();
   if (!access::isValid(meta_data_, false))
   {
     return false;
@@ -76,7 +136,8 @@ bool Store::isValid() const
     const lane::LaneIdList &lane_ids = partition_id_and_ids.second;
     for (auto lane_id : lane_ids)
     {
-      if (lane_map_.find(lane_id) == lane_map_.end())
+      // lanes of a paged Store are only present while their partition is resident
+      if (!pager_ && (lane_map_.find(lane_id) == lane_map_.end()))
       {
         return false;
       }
@@ -87,7 +148,7 @@ bool Store::isValid() const
     const landmark::LandmarkIdList &landmark_ids = partition_id_and_ids.second;
     for (auto landmark_id : landmark_ids)
     {
-      if (landmark_map_.find(landmark_id) == landmark_map_.end())
+      if (!pager_ && (landmark_map_.find(landmark_id) == landmark_map_.end()))
       {
         return false;
       }
@@ -96,10 +157,23 @@ bool Store::isValid() const
   return true;
 }
 
-bool Store::serialize(serialize::ISerializer &serializer)
+/**
+ * @brief Reduce the edge to its first and last point, as read if the inner points are skipped.
+ */
+static void reduceToEndPoints(point::ECEFEdge &edge)
+{
+  if (edge.size() > 2u)
+  {
+    edge.erase(edge.begin() + 1, edge.end() - 1);
+    edge.shrink_to_fit();
+  }
+}
+
+bool Store::serialize(serialize::ISerializer &serializer, std::size_t threadCount)
 {
   bool old_magic = serializer.setUseMagic(true);
   bool old_use_embedded_points = serializer.setUseEmbeddedPoints(true);
+  bool old_skip_inner_points = serializer.setSkipInnerPoints(!serializer.isStoring() && !load_geometry_);
 
   bool ok = serializer.serialize(serialize::SerializeableMagic::Store) && serializer.serialize(use_magic_)
     && serializer.serialize(use_embedded_geometry_) && serializer.serialize(use_geometry_store_);
@@ -111,8 +185,22 @@ bool Store::serialize(serialize::ISerializer &serializer)
   serializer.setUseMagic(use_magic_);
   serializer.setUseEmbeddedPoints(use_embedded_geometry_);
   ok = ok && doSerialize(serializer, meta_data_);
-  ok = ok && serializer.serializeObjectPtrMap(lane_map_);
-  ok = ok && serializer.serializeObjectPtrMap(landmark_map_);
+  if (serializer.useSections())
+  {
+    if (serializer.isStoring())
+    {
+      ok = ok && writeSections(serializer);
+    }
+    else
+    {
+      ok = ok && readSections(serializer, threadCount);
+    }
+  }
+  else
+  {
+    ok = ok && serializer.serializeObjectPtrMap(lane_map_);
+    ok = ok && serializer.serializeObjectPtrMap(landmark_map_);
+  }
   if (ok)
   {
     ok = serializer.serializeObjectVecMap(part_lane_map_);
@@ -133,7 +221,7 @@ bool Store::serialize(serialize::ISerializer &serializer)
   {
     if (use_geometry_store_)
     {
-      GeometryStore gs;
+      GeometryStore gs(geometry_error_bound_);
       if (serializer.isStoring())
       {
         ok = storeGeometry(gs);
@@ -145,11 +233,20 @@ bool Store::serialize(serialize::ISerializer &serializer)
         {
           if (use_embedded_geometry_)
           {
-            ok = checkGeometry(gs);
+            // the embedded edges are reduced to their end points if the geometry is not loaded
+            ok = !load_geometry_ || checkGeometry(gs);
           }
           else
           {
             ok = restoreGeometry(gs);
+            if (ok && !load_geometry_)
+            {
+              for (auto const &id_and_lane : lane_map_)
+              {
+                reduceToEndPoints(id_and_lane.second->edgeLeft.ecefEdge);
+                reduceToEndPoints(id_and_lane.second->edgeRight.ecefEdge);
+              }
+            }
           }
         }
       }
@@ -157,9 +254,177 @@ bool Store::serialize(serialize::ISerializer &serializer)
   }
   serializer.setUseMagic(old_magic);
   serializer.setUseEmbeddedPoints(old_use_embedded_points);
+  serializer.setSkipInnerPoints(old_skip_inner_points);
+  return ok;
+}
+
+/////////////
+// Sections
+
+// maximal number of lanes and of landmarks within one section
+static constexpr std::size_t MAX_SECTION_OBJECTS = 64u;
+
+bool Store::writeSections(serialize::ISerializer &serializer)
+{
+  std::set<PartitionId> partitionIds;
+  for (auto const &partition : part_lane_map_)
+  {
+    partitionIds.insert(partition.first);
+  }
+  for (auto const &partition : part_landmark_map_)
+  {
+    partitionIds.insert(partition.first);
+  }
+  if (partitionIds.empty())
+  {
+    partitionIds.insert(PartitionId(0));
+  }
+
+  // assign each object to the first partition listing it
+  std::map<PartitionId, StoreSection> partitions;
+  LaneMap remainingLanes = lane_map_;
+  LandmarkMap remainingLandmarks = landmark_map_;
+  for (auto const &partitionId : partitionIds)
+  {
+    auto &partition = partitions[partitionId];
+    partition.partitionId = partitionId;
+    auto const partLanes = part_lane_map_.find(partitionId);
+    if (partLanes != part_lane_map_.end())
+    {
+      for (auto const &laneId : partLanes->second)
+      {
+        auto const lane = remainingLanes.find(laneId);
+        if (lane != remainingLanes.end())
+        {
+          partition.lanes.insert(*lane);
+          remainingLanes.erase(lane);
+        }
+      }
+    }
+    auto const partLandmarks = part_landmark_map_.find(partitionId);
+    if (partLandmarks != part_landmark_map_.end())
+    {
+      for (auto const &landmarkId : partLandmarks->second)
+      {
+        auto const landmark = remainingLandmarks.find(landmarkId);
+        if (landmark != remainingLandmarks.end())
+        {
+          partition.landmarks.insert(*landmark);
+          remainingLandmarks.erase(landmark);
+        }
+      }
+    }
+  }
+  partitions.begin()->second.lanes.insert(remainingLanes.begin(), remainingLanes.end());
+  partitions.begin()->second.landmarks.insert(remainingLandmarks.begin(), remainingLandmarks.end());
+
+  // split the partitions into sections
+  std::vector<StoreSection> sections;
+  for (auto const &partition : partitions)
+  {
+    auto lane = partition.second.lanes.begin();
+    auto landmark = partition.second.landmarks.begin();
+    do
+    {
+      StoreSection section;
+      section.partitionId = partition.first;
+      for (; (lane != partition.second.lanes.end()) && (section.lanes.size() < MAX_SECTION_OBJECTS); ++lane)
+      {
+        section.lanes.insert(*lane);
+      }
+      for (; (landmark != partition.second.landmarks.end()) && (section.landmarks.size() < MAX_SECTION_OBJECTS);
+           ++landmark)
+      {
+        section.landmarks.insert(*landmark);
+      }
+      if (!encodeSection(use_magic_, use_embedded_geometry_, section))
+      {
+        return false;
+      }
+      sections.push_back(std::move(section));
+    } while ((lane != partition.second.lanes.end()) || (landmark != partition.second.landmarks.end()));
+  }
+
+  std::size_t sectionCount = sections.size();
+  bool ok
+    = serializer.serialize(serialize::SerializeableMagic::StoreSectionTable) && serializer.serialize(sectionCount);
+  for (auto &section : sections)
+  {
+    ok = ok && serializeSectionEntry(serializer, section);
+  }
+  for (auto &section : sections)
+  {
+    ok = ok && serializeSectionData(serializer, section);
+  }
   return ok;
 }
 
+bool Store::readSections(serialize::ISerializer &serializer, std::size_t threadCount)
+{
+  std::size_t sectionCount = 0u;
+  if (!serializer.serialize(serialize::SerializeableMagic::StoreSectionTable) || !serializer.serialize(sectionCount))
+  {
+    return false;
+  }
+  std::vector<StoreSection> sections;
+  for (std::size_t i = 0u; i < sectionCount; ++i)
+  {
+    StoreSection section;
+    if (!serializeSectionEntry(serializer, section))
+    {
+      return false;
+    }
+    sections.push_back(std::move(section));
+  }
+  for (auto &section : sections)
+  {
+    if (!serializeSectionData(serializer, section))
+    {
+      return false;
+    }
+  }
+  if (pager_)
+  {
+    // the sections are decoded on demand
+    pager_->addSections(std::move(sections));
+    return true;
+  }
+
+  std::atomic<bool> ok{true};
+  parallelFor(sections.size(), threadCount, [&](std::size_t const i) {
+    if (ok && !decodeSection(use_magic_, use_embedded_geometry_, !load_geometry_, sections[i]))
+    {
+      ok = false;
+    }
+    sections[i].buffer = std::vector<uint8_t>();
+  });
+  if (!ok)
+  {
+    return false;
+  }
+
+  for (auto &section : sections)
+  {
+    for (auto &lane : section.lanes)
+    {
+      if (!lane_map_.insert(lane).second)
+      {
+        access::getLogger()->error("Store: Lane {} is contained in several sections", lane.first);
+        return false;
+      }
+    }
+    for (auto &landmark : section.landmarks)
+    {
+      if (!landmark_map_.insert(landmark).second)
+      {
+        access::getLogger()->error("Store: Landmark {} is contained in several sections", landmark.first);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 bool Store::storeGeometry(GeometryStore &gs)
 {
   for (auto lane : lane_map_)
@@ -0,0 +1,101 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+namespace ad {
+namespace map {
+namespace access {
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stop_ = true;
+  }
+  workAvailable_.notify_all();
+  for (auto &thread : threads_)
+  {
+    thread.join();
+  }
+}
+
+WorkerPool &WorkerPool::getInstance()
+{
+  static WorkerPool workerPool;
+  return workerPool;
+}
+
+std::size_t WorkerPool::size()
+{
+  std::lock_guard<std::mutex> guard(mutex_);
+  return threads_.size();
+}
+
+void WorkerPool::run(std::size_t const helperCount, std::function<void()> const &task)
+{
+  if (helperCount == 0u)
+  {
+    task();
+    return;
+  }
+
+  Job job{&task, helperCount, 0u};
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    while (threads_.size() < helperCount)
+    {
+      threads_.emplace_back(&WorkerPool::work, this);
+    }
+    jobs_.push_back(&job);
+  }
+  workAvailable_.notify_all();
+
+  task();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (job.unclaimed > 0u)
+  {
+    // the remaining work is done already, so the calls not started yet are dropped
+    jobs_.erase(std::find(jobs_.begin(), jobs_.end(), &job));
+    job.unclaimed = 0u;
+  }
+  jobFinished_.wait(lock, [&job]() { return job.active == 0u; });
+}
+
+void WorkerPool::work()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true)
+  {
+    workAvailable_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+    if (stop_)
+    {
+      return;
+    }
+    auto job = jobs_.front();
+    if (--job->unclaimed == 0u)
+    {
+      jobs_.pop_front();
+    }
+    ++job->active;
+    lock.unlock();
+    (*job->task)();
+    lock.lock();
+    if (--job->active == 0u)
+    {
+      jobFinished_.notify_all();
+    }
+  }
+}
+
+} // namespace access
+} // namespace map
+} // namespace ad
@@ -0,0 +1,90 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ad {
+namespace map {
+namespace access {
+
+/**
+ * @brief Threads shared by all parallel operations of the library.
+ *
+ * The pool starts threads when more helpers are requested than it has and keeps them until the end of the process,
+ * so parallel operations don't pay for starting threads on each call.
+ */
+class WorkerPool
+{
+public: // Constructor/Destructor
+  WorkerPool(WorkerPool const &) = delete;
+  WorkerPool &operator=(WorkerPool const &) = delete;
+
+  /**
+   * @brief Destructor.
+   *        Stops and joins the threads.
+   */
+  ~WorkerPool();
+
+public: // Operations
+  /**
+   * @returns the pool of the process.
+   */
+  static WorkerPool &getInstance();
+
+  /**
+   * @returns the number of threads of the pool, the largest number of helpers requested so far.
+   */
+  std::size_t size();
+
+  /**
+   * @brief Calls task on the calling thread and on up to helperCount threads of the pool concurrently.
+   *        The pool is grown to helperCount threads if it has less.
+   *
+   * Returns when all calls have returned. The calls the pool didn't start until the call on the calling thread
+   * returned are skipped. Therefore, task has to fetch its work items from a shared counter or the like until none
+   * are left, so the calling thread alone completes the work if the pool is busy. This also allows nested use of the
+   * pool, e.g. from within a task. task must not throw.
+   */
+  void run(std::size_t const helperCount, std::function<void()> const &task);
+
+private: // Types
+  /**
+   * @brief A task to be called by the pool.
+   */
+  struct Job
+  {
+    std::function<void()> const *task; ///< The task.
+    std::size_t unclaimed;             ///< Number of calls not started yet.
+    std::size_t active;                ///< Number of calls running.
+  };
+
+private: // Aux Methods
+  WorkerPool() = default;
+
+  void work();
+
+private:                                  // Data Members
+  std::mutex mutex_;                      ///< Protects the jobs and the threads.
+  std::condition_variable workAvailable_; ///< Signals new jobs or stopping to the threads.
+  std::condition_variable jobFinished_;   ///< Signals the end of a call of a job.
+  std::deque<Job *> jobs_;                ///< Jobs with unclaimed calls, in order of submission.
+  bool stop_{false};                      ///< True if the threads have to stop.
+  std::vector<std::thread> threads_;      ///< The threads of the pool.
+};
+
+} // namespace access
+} // namespace map
+} // namespace ad
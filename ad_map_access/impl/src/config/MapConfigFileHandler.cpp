@@ -113,8 +113,11 @@ bool MapConfigFileHandler::parseConfigFile(std::string const &configFileName)
   options.add_options()("ADMap.map", po::value<std::string>(), "AD map")
                        ("ADMap.openDriveOverlapMargin", po::value<std::string>(), "OpenDrive Map reader margin for overlap calculation")
                        ("ADMap.openDriveDefaultIntersectionType", po::value<std::string>(), "OpenDrive Map default intersection type")
+                       ("ADMap.pagingMemoryBudgetMB", po::value<std::size_t>(), "Load the partitions of the AD map on demand within this budget")
                        ("POI.poi", po::value<std::vector<std::string>>(), "Points of interest")
-                       ("ENUReference.default", po::value<std::string>(), "Default ENU reference point");
+                       ("ENUReference.default", po::value<std::string>(), "Default ENU reference point")
+                       ("OpenDriveCache.directory", po::value<std::string>(), "Cache directory of converted OpenDrive maps")
+                       ("OpenDriveCache.maxSizeMB", po::value<std::size_t>(), "Maximal size of the OpenDrive map cache");
   // clang-format on
 
   try
@@ -174,6 +177,11 @@ bool MapConfigFileHandler::parseConfigFile(std::string const &configFileName)
       mapEntry.openDriveDefaultIntersectionType = openDriveDefaultIntersectionType;
 
       mAdMapEntry = mapEntry;
+
+      if (vm.count("ADMap.pagingMemoryBudgetMB"))
+      {
+        mPagingMemoryBudget = vm["ADMap.pagingMemoryBudgetMB"].as<std::size_t>() * 1024u * 1024u;
+      }
     }
 
     if (vm.count("POI.poi"))
@@ -199,6 +207,20 @@ bool MapConfigFileHandler::parseConfigFile(std::string const &configFileName)
         return false;
       }
     }
+
+    if (vm.count("OpenDriveCache.directory"))
+    {
+      boost::filesystem::path path(vm["OpenDriveCache.directory"].as<std::string>());
+      if (path.is_relative())
+      {
+        path = boost::filesystem::path(mBaseDir) / path;
+      }
+      mOpenDriveCacheDirectory = path.string();
+      if (vm.count("OpenDriveCache.maxSizeMB"))
+      {
+        mOpenDriveCacheMaxSize = vm["OpenDriveCache.maxSizeMB"].as<std::size_t>() * 1024u * 1024u;
+      }
+    }
   }
   catch (std::exception const &e)
   {
@@ -278,12 +300,30 @@ MapEntry const &MapConfigFileHandler::adMapEntry() const
   return mAdMapEntry;
 }
 
+std::string const &MapConfigFileHandler::openDriveCacheDirectory() const
+{
+  return mOpenDriveCacheDirectory;
+}
+
+std::size_t MapConfigFileHandler::openDriveCacheMaxSize() const
+{
+  return mOpenDriveCacheMaxSize;
+}
+
+std::size_t MapConfigFileHandler::pagingMemoryBudget() const
+{
+  return mPagingMemoryBudget;
+}
+
 void MapConfigFileHandler::reset()
 {
   mConfigFileName = "";
   mAdMapEntry = MapEntry();
   mPointsOfInterest.clear();
   mDefaultEnuReference = point::GeoPoint();
+  mOpenDriveCacheDirectory.clear();
+  mOpenDriveCacheMaxSize = 0u;
+  mPagingMemoryBudget = 0u;
   mBaseDir.clear();
 }
 
@@ -27,7 +27,8 @@ namespace intersection {
 std::pair<lane::LaneIdSet, lane::LaneIdSet>
 Intersection::getDirectSuccessorsInLaneDirection(lane::LaneId const laneId) const
 {
-  auto lane = lane::getLane(laneId);
+  access::QueryScope queryScope;
+  auto const &lane = lane::getLane(laneId);
   auto location = lane::ContactLocation::SUCCESSOR;
   if (lane.direction == lane::LaneDirection::NEGATIVE)
   {
@@ -95,7 +96,8 @@ lane::LaneIdSet Intersection::getAllReachableOutgoingLanes(lane::LaneId const la
 
 bool Intersection::isLanePartOfAnIntersection(lane::LaneId const laneId)
 {
-  auto lane = lane::getLane(laneId);
+  access::QueryScope queryScope;
+  auto const &lane = lane::getLane(laneId);
   return (lane.type == lane::LaneType::INTERSECTION);
 }
 
@@ -158,6 +160,7 @@ IntersectionType fromContactTypes(lane::ContactTypeList const &types)
 
 IntersectionType getRightOfWayForTransition(lane::LaneId fromLaneId, lane::LaneId toLaneId, bool useSuccessor)
 {
+  access::QueryScope queryScope;
   auto fromLane = lane::getLanePtr(fromLaneId);
   auto location = lane::ContactLocation::PREDECESSOR;
   if (useSuccessor)
@@ -504,6 +507,7 @@ bool Intersection::laneIsPartOfIntersection(lane::LaneId const laneId) const
 
 void Intersection::extractLanesOfIntersection(lane::LaneId const laneId)
 {
+  access::QueryScope queryScope;
   if (laneIsPartOfIntersection(laneId))
   {
     return;
@@ -610,7 +614,8 @@ void Intersection::insertOutgoingLane(lane::LaneId const laneId)
 // this function return the directional angle of laneId
 point::ENUHeading getLaneDirectionalAngle(lane::LaneId laneId)
 {
-  auto lane = lane::getLane(laneId);
+  access::QueryScope queryScope;
+  auto const &lane = lane::getLane(laneId);
 
   // Collect the parapoint of the lane
   physics::ParametricValue laneParapoint
@@ -1203,6 +1208,7 @@ physics::Distance Intersection::objectDistanceToIntersection(match::Object const
 
 physics::Distance Intersection::objectInterpenetrationDistanceWithIntersection(match::Object const &object) const
 {
+  access::QueryScope queryScope;
   physics::Distance maxDistance(0.);
   TurnDirection coveredIntersectionArms = TurnDirection::Unknown;
   for (auto const &occupiedLane : object.mapMatchedBoundingBox.laneOccupiedRegions)
@@ -1321,8 +1327,9 @@ bool Intersection::objectRouteCrossesLanesWithHigherPriority(route::FullRoute co
 
 void Intersection::collectTrafficLights(lane::LaneId fromLaneId, lane::LaneId toLaneId, bool useSuccessor)
 {
+  access::QueryScope queryScope;
   // keep the first match, we just need any match
-  auto fromLane = lane::getLane(fromLaneId);
+  auto const &fromLane = lane::getLane(fromLaneId);
   auto location = lane::ContactLocation::PREDECESSOR;
   if (useSuccessor)
   {
@@ -1367,6 +1374,7 @@ void Intersection::calculateSpeedLimit()
 
 landmark::TrafficLightType Intersection::extractTrafficLightType(landmark::LandmarkId trafficLightId)
 {
+  access::QueryScope queryScope;
   auto trafficLight = landmark::getLandmark(trafficLightId);
   return trafficLight.trafficLightType;
 }
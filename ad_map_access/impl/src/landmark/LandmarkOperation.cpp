@@ -48,6 +48,7 @@ landmark::LandmarkIdList getLandmarks()
 
 ENULandmark getENULandmark(LandmarkId const &id)
 {
+  access::QueryScope queryScope;
   auto const landmarkPtr = getLandmarkPtr(id);
   ENULandmark landmark;
   landmark.id = landmarkPtr->id;
@@ -61,6 +62,7 @@ ENULandmark getENULandmark(LandmarkId const &id)
 
 LandmarkIdList getVisibleLandmarks(lane::LaneId const &laneId)
 {
+  access::QueryScope queryScope;
   LandmarkIdList landmarks;
   auto const lanePtr = lane::getLanePtr(laneId);
   if (!bool(lanePtr))
@@ -72,6 +74,7 @@ LandmarkIdList getVisibleLandmarks(lane::LaneId const &laneId)
 
 LandmarkIdList getVisibleLandmarks(LandmarkType const &landmarkType, lane::LaneId const &laneId)
 {
+  access::QueryScope queryScope;
   LandmarkIdList landmarks;
   auto const visibleLandmarkIds = getVisibleLandmarks(laneId);
   for (const auto &landmarkId : visibleLandmarkIds)
@@ -88,6 +91,7 @@ LandmarkIdList getVisibleLandmarks(LandmarkType const &landmarkType, lane::LaneI
 
 LandmarkId uniqueLandmarkId(point::GeoPoint const &geoPoint)
 {
+  access::QueryScope queryScope;
   LandmarkIdList landmarksIds;
   LandmarkId id;
 
@@ -0,0 +1,227 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/lane/LaneGraph.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "ad/map/lane/LaneOperation.hpp"
+
+namespace ad {
+namespace map {
+namespace lane {
+
+constexpr LaneGraph::NodeIndex LaneGraph::cInvalidNodeIndex;
+
+// the contact locations of the edge groups
+static ContactLocation const EDGE_GROUP_LOCATIONS[4]
+  = {ContactLocation::SUCCESSOR, ContactLocation::PREDECESSOR, ContactLocation::RIGHT, ContactLocation::LEFT};
+
+LaneGraph::LaneGraph(std::map<LaneId, Lane::Ptr> const &laneMap)
+{
+  nodes_.reserve(laneMap.size());
+  for (auto const &id_and_lane : laneMap)
+  {
+    if (id_and_lane.second)
+    {
+      addLane(id_and_lane.second);
+    }
+  }
+  finalize();
+}
+
+LaneGraph::LaneGraph(LaneProvider const &laneProvider)
+  : laneProvider_(laneProvider)
+  , fingerprint_(0u)
+{
+}
+
+void LaneGraph::addLane(Lane::Ptr const &lanePtr)
+{
+  physics::ParametricRange fullRange;
+  fullRange.minimum = physics::ParametricValue(0.);
+  fullRange.maximum = physics::ParametricValue(1.);
+
+  auto const &lane = *lanePtr;
+  Node node;
+  node.id = lane.id;
+  if (!laneProvider_)
+  {
+    node.lane = lanePtr;
+  }
+  node.type = lane.type;
+  node.direction = lane.direction;
+  node.routeable = isRouteable(lane);
+  node.positive = isLaneDirectionPositive(lane);
+  node.negative = isLaneDirectionNegative(lane);
+  node.length = lane.length;
+  if (lane.length.isValid())
+  {
+    // lanes still under construction might not have a geometry yet
+    node.duration = getDuration(lane, fullRange);
+    node.startPoint = getParametricPoint(lane, physics::ParametricValue(0.), physics::ParametricValue(0.5));
+    node.endPoint = getParametricPoint(lane, physics::ParametricValue(1.), physics::ParametricValue(0.5));
+  }
+  // until finalize(), the first two entries of edgeBegin refer to the contacts of the lane
+  node.edgeBegin[0] = static_cast<uint32_t>(contacts_.size());
+  for (auto const &contactLane : lane.contactLanes)
+  {
+    contacts_.push_back({contactLane.toLane, contactLane.location});
+  }
+  node.edgeBegin[1] = static_cast<uint32_t>(contacts_.size());
+  nodes_.push_back(node);
+}
+
+void LaneGraph::finalize()
+{
+  auto const lessId = [](Node const &left, Node const &right) { return left.id < right.id; };
+  // lanes provided by a lane map are sorted already
+  if (!std::is_sorted(nodes_.begin(), nodes_.end(), lessId))
+  {
+    std::sort(nodes_.begin(), nodes_.end(), lessId);
+  }
+  ids_.clear();
+  ids_.reserve(nodes_.size());
+  std::vector<std::pair<uint32_t, uint32_t>> contactRanges;
+  contactRanges.reserve(nodes_.size());
+  for (auto const &node : nodes_)
+  {
+    ids_.push_back(node.id);
+    contactRanges.push_back({node.edgeBegin[0], node.edgeBegin[1]});
+  }
+
+  for (std::size_t index = 0u; index < nodes_.size(); ++index)
+  {
+    auto &node = nodes_[index];
+    for (auto group = 0u; group < 4u; ++group)
+    {
+      node.edgeBegin[group] = static_cast<uint32_t>(edges_.size());
+      for (auto contact = contactRanges[index].first; contact < contactRanges[index].second; ++contact)
+      {
+        if (contacts_[contact].second == EDGE_GROUP_LOCATIONS[group])
+        {
+          Edge edge;
+          edge.node = findNode(contacts_[contact].first);
+          edge.toLane = contacts_[contact].first;
+          // the first contact of the target lane back to this lane, as getContactLocation()
+          edge.reverseLocation = ContactLocation::INVALID;
+          if ((edge.node != cInvalidNodeIndex) && isValid(node.id))
+          {
+            for (auto reverse = contactRanges[edge.node].first; reverse < contactRanges[edge.node].second; ++reverse)
+            {
+              if (contacts_[reverse].first == node.id)
+              {
+                edge.reverseLocation = contacts_[reverse].second;
+                break;
+              }
+            }
+          }
+          edges_.push_back(edge);
+        }
+      }
+    }
+    node.edgeBegin[4] = static_cast<uint32_t>(edges_.size());
+  }
+  contacts_.clear();
+  contacts_.shrink_to_fit();
+
+  fingerprint_ = calcFingerprint();
+}
+
+Lane::ConstPtr LaneGraph::getLane(Node const &node) const
+{
+  if (node.lane || !laneProvider_)
+  {
+    return node.lane;
+  }
+  return laneProvider_(node.id);
+}
+
+uint64_t LaneGraph::calcFingerprint() const
+{
+  // FNV-1a hash
+  uint64_t fingerprint = 0xcbf29ce484222325ull;
+  auto const add = [&fingerprint](uint64_t value) {
+    for (auto i = 0u; i < 8u; ++i)
+    {
+      fingerprint ^= (value & 0xffu);
+      fingerprint *= 0x100000001b3ull;
+      value >>= 8u;
+    }
+  };
+  add(nodes_.size());
+  for (auto const &node : nodes_)
+  {
+    add(static_cast<uint64_t>(node.id));
+    add(static_cast<uint64_t>(node.type));
+    add(static_cast<uint64_t>(node.direction));
+    add((node.routeable ? 1u : 0u) | (node.positive ? 2u : 0u) | (node.negative ? 4u : 0u));
+    uint64_t lengthBits = 0u;
+    if (node.length.isValid())
+    {
+      double const length = static_cast<double>(node.length);
+      std::memcpy(&lengthBits, &length, sizeof(lengthBits));
+    }
+    add(lengthBits);
+    for (auto group = 0u; group < 4u; ++group)
+    {
+      add(node.edgeBegin[group + 1] - node.edgeBegin[group]);
+    }
+  }
+  for (auto const &edge : edges_)
+  {
+    add(static_cast<uint64_t>(edge.toLane));
+    add(static_cast<uint64_t>(edge.reverseLocation));
+  }
+  return fingerprint;
+}
+
+LaneGraph::NodeIndex LaneGraph::findNode(LaneId const &id) const
+{
+  auto const findResult = std::lower_bound(ids_.begin(), ids_.end(), id);
+  if ((findResult != ids_.end()) && (*findResult == id))
+  {
+    return static_cast<NodeIndex>(findResult - ids_.begin());
+  }
+  return cInvalidNodeIndex;
+}
+
+LaneGraph::Node const &LaneGraph::getNode(LaneId const &id) const
+{
+  auto const index = findNode(id);
+  if (index == cInvalidNodeIndex)
+  {
+    throw std::invalid_argument("ad::map::lane::LaneGraph::getNode: LaneId not found in lane graph");
+  }
+  return nodes_[index];
+}
+
+ContactLocation LaneGraph::getDirectNeighborhoodRelation(LaneId const &id, LaneId const &checkId) const
+{
+  if (id == checkId)
+  {
+    return ContactLocation::OVERLAP;
+  }
+  auto const &node = getNode(id);
+  for (auto group : {LeftEdges, RightEdges, SuccessorEdges, PredecessorEdges})
+  {
+    for (auto const &edge : getEdges(node, group))
+    {
+      if (edge.toLane == checkId)
+      {
+        return EDGE_GROUP_LOCATIONS[group];
+      }
+    }
+  }
+  return ContactLocation::INVALID;
+}
+
+} // namespace lane
+} // namespace map
+} // namespace ad
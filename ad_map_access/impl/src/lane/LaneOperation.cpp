@@ -33,7 +33,13 @@ Lane::ConstPtr getLanePtr(LaneId const &id)
 
 Lane const &getLane(LaneId const &id)
 {
-  return *getLanePtr(id);
+  auto const lane = access::getStore().getLaneHandle(id);
+
+  if (lane == nullptr)
+  {
+    throw std::invalid_argument("ad::map::lane::getLane: LaneId not found in store");
+  }
+  return *lane;
 }
 
 LaneIdList getLanes()
@@ -41,6 +47,11 @@ LaneIdList getLanes()
   return access::getStore().getLanes();
 }
 
+LaneGraph::ConstPtr getLaneGraph()
+{
+  return access::getStore().getLaneGraph();
+}
+
 point::ECEFHeading getLaneECEFDirection(Lane const &lane, point::ParaPoint const &paraPoint)
 {
   physics::ParametricValue longTStart;
@@ -73,7 +84,8 @@ point::ECEFHeading getLaneECEFHeading(match::MapMatchedPosition const &mapMatche
 
 point::ECEFHeading getLaneECEFHeading(point::ParaPoint const &paraPoint)
 {
-  auto lane = getLane(paraPoint.laneId);
+  access::QueryScope queryScope;
+  auto const &lane = getLane(paraPoint.laneId);
 
   point::ECEFHeading laneDrivingDirection = getLaneECEFDirection(lane, paraPoint);
   if (!isLaneDirectionPositive(lane))
@@ -477,12 +489,14 @@ bool isHeadingInLaneDirection(point::ParaPoint const &position, point::ENUHeadin
 
 bool isLaneDirectionPositive(LaneId const &laneId)
 {
+  access::QueryScope queryScope;
   auto const lane = getLane(laneId);
   return isLaneDirectionPositive(lane);
 }
 
 bool isLaneDirectionNegative(LaneId const &laneId)
 {
+  access::QueryScope queryScope;
   auto const lane = getLane(laneId);
   return isLaneDirectionNegative(lane);
 }
@@ -491,6 +505,7 @@ bool projectPositionToLaneInHeadingDirection(point::ParaPoint const &position,
                                              point::ENUHeading const &heading,
                                              point::ParaPoint &projectedPosition)
 {
+  access::QueryScope queryScope;
   projectedPosition = position;
   if (isHeadingInLaneDirection(position, heading))
   {
@@ -535,6 +550,48 @@ bool projectPositionToLaneInHeadingDirection(point::ParaPoint const &position,
   return false;
 }
 
+static void calcMapMatchedPosition(Lane const &lane,
+                                   point::ECEFPoint const &pt,
+                                   physics::ParametricValue const &long_t_left,
+                                   physics::ParametricValue const &long_t_right,
+                                   point::ECEFPoint const &pt_left,
+                                   point::ECEFPoint const &pt_right,
+                                   match::MapMatchedPosition &mmpos)
+{
+  mmpos.lanePoint.paraPoint.laneId = lane.id;
+  mmpos.lanePoint.lateralT = point::findNearestPointOnEdge(pt, pt_left, pt_right);
+  physics::ParametricValue nearestT;
+  if (mmpos.lanePoint.lateralT < physics::RatioValue(0.))
+  {
+    nearestT = physics::ParametricValue(0.);
+    mmpos.type = match::MapMatchedPositionType::LANE_LEFT;
+    mmpos.probability = std::max(physics::Probability(0.1),
+                                 physics::Probability(0.5 + static_cast<double>(mmpos.lanePoint.lateralT) / 10.));
+  }
+  else if (mmpos.lanePoint.lateralT > physics::RatioValue(1.))
+  {
+    nearestT = physics::ParametricValue(1.);
+    mmpos.type = match::MapMatchedPositionType::LANE_RIGHT;
+    mmpos.probability
+      = std::max(physics::Probability(0.1),
+                 physics::Probability(0.5 - (static_cast<double>(mmpos.lanePoint.lateralT) - 1.) / 10.));
+  }
+  else
+  {
+    nearestT = physics::ParametricValue(static_cast<double>(mmpos.lanePoint.lateralT));
+    mmpos.type = match::MapMatchedPositionType::LANE_IN;
+    mmpos.probability = physics::Probability(1.)
+      - std::min(physics::Probability(0.5),
+                 physics::Probability(fabs(0.5 - static_cast<double>(mmpos.lanePoint.lateralT))));
+  }
+  mmpos.matchedPoint = point::vectorInterpolate(pt_left, pt_right, nearestT);
+  mmpos.lanePoint.paraPoint.parametricOffset
+    = nearestT * long_t_left + (physics::ParametricValue(1.) - nearestT) * long_t_right;
+  mmpos.lanePoint.laneLength = lane.length;
+  mmpos.lanePoint.laneWidth = point::distance(pt_left, pt_right);
+  mmpos.queryPoint = pt;
+}
+
 bool findNearestPointOnLane(Lane const &lane, point::ECEFPoint const &pt, match::MapMatchedPosition &mmpos)
 {
   auto const long_t_left = findNearestPointOnEdge(lane.edgeLeft, pt);
@@ -545,39 +602,35 @@ bool findNearestPointOnLane(Lane const &lane, point::ECEFPoint const &pt, match:
     {
       point::ECEFPoint const pt_left = point::getParametricPoint(lane.edgeLeft, long_t_left);
       point::ECEFPoint const pt_right = point::getParametricPoint(lane.edgeRight, long_t_right);
+      calcMapMatchedPosition(lane, pt, long_t_left, long_t_right, pt_left, pt_right, mmpos);
+      return true;
+    }
+  }
+  return false;
+}
 
-      mmpos.lanePoint.paraPoint.laneId = lane.id;
-      mmpos.lanePoint.lateralT = point::findNearestPointOnEdge(pt, pt_left, pt_right);
-      physics::ParametricValue nearestT;
-      if (mmpos.lanePoint.lateralT < physics::RatioValue(0.))
-      {
-        nearestT = physics::ParametricValue(0.);
-        mmpos.type = match::MapMatchedPositionType::LANE_LEFT;
-        mmpos.probability = std::max(physics::Probability(0.1),
-                                     physics::Probability(0.5 + static_cast<double>(mmpos.lanePoint.lateralT) / 10.));
-      }
-      else if (mmpos.lanePoint.lateralT > physics::RatioValue(1.))
-      {
-        nearestT = physics::ParametricValue(1.);
-        mmpos.type = match::MapMatchedPositionType::LANE_RIGHT;
-        mmpos.probability
-          = std::max(physics::Probability(0.1),
-                     physics::Probability(0.5 - (static_cast<double>(mmpos.lanePoint.lateralT) - 1.) / 10.));
-      }
-      else
-      {
-        nearestT = physics::ParametricValue(static_cast<double>(mmpos.lanePoint.lateralT));
-        mmpos.type = match::MapMatchedPositionType::LANE_IN;
-        mmpos.probability = physics::Probability(1.)
-          - std::min(physics::Probability(0.5),
-                     physics::Probability(fabs(0.5 - static_cast<double>(mmpos.lanePoint.lateralT))));
-      }
-      mmpos.matchedPoint = point::vectorInterpolate(pt_left, pt_right, nearestT);
-      mmpos.lanePoint.paraPoint.parametricOffset
-        = nearestT * long_t_left + (physics::ParametricValue(1.) - nearestT) * long_t_right;
-      mmpos.lanePoint.laneLength = lane.length;
-      mmpos.lanePoint.laneWidth = point::distance(pt_left, pt_right);
-      mmpos.queryPoint = pt;
+bool findNearestPointOnLane(LaneSegmentIndex const &laneSegmentIndex,
+                            point::ECEFPoint const &pt,
+                            match::MapMatchedPosition &mmpos)
+{
+  auto const &lane = *laneSegmentIndex.lane;
+  if (!laneSegmentIndex.edgeLeft || !laneSegmentIndex.edgeRight)
+  {
+    return findNearestPointOnLane(lane, pt, mmpos);
+  }
+  auto const long_t_left
+    = laneSegmentIndex.edgeLeft->findNearestPointOnEdge(lane.edgeLeft.ecefEdge, lane.edgeLeft.length, pt);
+  if (long_t_left.isValid())
+  {
+    auto const long_t_right
+      = laneSegmentIndex.edgeRight->findNearestPointOnEdge(lane.edgeRight.ecefEdge, lane.edgeRight.length, pt);
+    if (long_t_right.isValid())
+    {
+      point::ECEFPoint const pt_left
+        = laneSegmentIndex.edgeLeft->getParametricPoint(lane.edgeLeft.ecefEdge, lane.edgeLeft.length, long_t_left);
+      point::ECEFPoint const pt_right = laneSegmentIndex.edgeRight->getParametricPoint(
+        lane.edgeRight.ecefEdge, lane.edgeRight.length, long_t_right);
+      calcMapMatchedPosition(lane, pt, long_t_left, long_t_right, pt_left, pt_right, mmpos);
       return true;
     }
   }
@@ -586,6 +639,7 @@ bool findNearestPointOnLane(Lane const &lane, point::ECEFPoint const &pt, match:
 
 physics::Distance getDistanceToLane(LaneId laneId, match::Object const &object)
 {
+  access::QueryScope queryScope;
   // prefer fast checks first
   for (auto const &occupiedLane : object.mapMatchedBoundingBox.laneOccupiedRegions)
   {
@@ -635,6 +689,7 @@ physics::Distance getDistanceToLane(LaneId laneId, match::Object const &object)
 
 physics::Distance calcLength(LaneId const &laneId)
 {
+  access::QueryScope queryScope;
   const auto lane = getLanePtr(laneId);
   return lane->length;
 }
@@ -646,6 +701,7 @@ physics::Distance calcWidth(point::ParaPoint const &paraPoint)
 
 physics::Distance calcWidth(LaneId const &laneId, physics::ParametricValue const &longOffset)
 {
+  access::QueryScope queryScope;
   const auto lane = getLanePtr(laneId);
   return getWidth(*lane, longOffset);
 }
@@ -665,6 +721,7 @@ physics::Distance calcWidth(point::ENUPoint const &enuPoint)
 
 ContactLocation getDirectNeighborhoodRelation(LaneId const laneId, LaneId const checkLaneId)
 {
+  access::QueryScope queryScope;
   if (laneId == checkLaneId)
   {
     return ContactLocation::OVERLAP;
@@ -701,6 +758,7 @@ bool isSameOrDirectNeighbor(LaneId const laneId, LaneId const checkLaneId)
 
 point::ENUPoint getENULanePoint(point::ParaPoint const parametricPoint, physics::ParametricValue const &lateralOffset)
 {
+  access::QueryScope queryScope;
   // perform map matching
   auto lane = getLane(parametricPoint.laneId);
   auto ecefPoint = getParametricPoint(lane, parametricPoint.parametricOffset, lateralOffset);
@@ -8,7 +8,10 @@
 
 #pragma once
 
+#include <memory>
+#include "../point/EdgeSegmentIndex.hpp"
 #include "ad/map/lane/Types.hpp"
+#include "ad/map/match/Types.hpp"
 
 namespace ad {
 namespace map {
@@ -26,6 +29,36 @@ struct IndexPairs
 IndexPairs getIndexPairs(point::ENUEdge const &leftEdge, point::ENUEdge const &rightEdge);
 void updateLaneLengths(Lane &lane);
 
+/*!
+ * @brief segment index of the edges of a lane to speed up the map matching
+ *
+ * Without the edge indices, only the lane is provided and the generic implementations are used.
+ */
+struct LaneSegmentIndex
+{
+  explicit LaneSegmentIndex(Lane::ConstPtr const &lanePtr, bool const withEdgeIndices = true)
+    : lane(lanePtr)
+  {
+    if (withEdgeIndices)
+    {
+      edgeLeft.reset(new point::EdgeSegmentIndex(lanePtr->edgeLeft.ecefEdge));
+      edgeRight.reset(new point::EdgeSegmentIndex(lanePtr->edgeRight.ecefEdge));
+    }
+  }
+
+  Lane::ConstPtr lane;
+  std::unique_ptr<point::EdgeSegmentIndex const> edgeLeft;
+  std::unique_ptr<point::EdgeSegmentIndex const> edgeRight;
+};
+
+/*!
+ * @brief same as findNearestPointOnLane(Lane const &, point::ECEFPoint const &, match::MapMatchedPosition &)
+ *        but makes use of the segment index of the lane
+ */
+bool findNearestPointOnLane(LaneSegmentIndex const &laneSegmentIndex,
+                            point::ECEFPoint const &pt,
+                            match::MapMatchedPosition &mmpos);
+
 } // namespace lane
 } // namespace map
 } // namespace ad
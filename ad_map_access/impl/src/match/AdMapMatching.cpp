@@ -9,43 +9,319 @@
 #include "ad/map/match/AdMapMatching.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <iterator>
+#include <unordered_map>
+#include "../access/ParallelFor.hpp"
+#include "../lane/LaneOperationPrivate.hpp"
 #include "ad/map/access/Logging.hpp"
 #include "ad/map/access/Operation.hpp"
+#include "ad/map/lane/LaneIdSet.hpp"
 #include "ad/map/lane/LaneOperation.hpp"
 #include "ad/map/match/MapMatchedOperation.hpp"
+#include "ad/map/point/CoordinateTransform.hpp"
+#include "ad/map/point/HeadingOperation.hpp"
 #include "ad/map/point/Transform.hpp"
+#include "ad/map/route/RouteOperation.hpp"
 #include "ad/physics/RangeOperation.hpp"
 
 namespace ad {
 namespace map {
 namespace match {
 
+/**
+ * @brief a point within the footprint coordinate frame of an object
+ *
+ * u is the coordinate along the heading of the object, v the one along the width.
+ */
+struct FootprintPoint
+{
+  double u;
+  double v;
+};
+
+/**
+ * @brief the rectangular footprint of an object given in ECEF coordinates
+ *
+ * The axes span the ENU plane of the object, so the footprint frame is just a rotated and shifted ENU frame.
+ */
+struct ObjectFootprint
+{
+  double center[3];
+  double lengthAxis[3];
+  double widthAxis[3];
+  double halfLength;
+  double halfWidth;
+
+  FootprintPoint toFootprint(point::ECEFPoint const &ecefPoint) const
+  {
+    double const delta[3] = {static_cast<double>(ecefPoint.x) - center[0],
+                             static_cast<double>(ecefPoint.y) - center[1],
+                             static_cast<double>(ecefPoint.z) - center[2]};
+    return {delta[0] * lengthAxis[0] + delta[1] * lengthAxis[1] + delta[2] * lengthAxis[2],
+            delta[0] * widthAxis[0] + delta[1] * widthAxis[1] + delta[2] * widthAxis[2]};
+  }
+
+  point::ECEFPoint toECEF(FootprintPoint const &footprintPoint) const
+  {
+    return point::createECEFPoint(center[0] + footprintPoint.u * lengthAxis[0] + footprintPoint.v * widthAxis[0],
+                                  center[1] + footprintPoint.u * lengthAxis[1] + footprintPoint.v * widthAxis[1],
+                                  center[2] + footprintPoint.u * lengthAxis[2] + footprintPoint.v * widthAxis[2]);
+  }
+};
+
+static ObjectFootprint createObjectFootprint(ENUObjectPosition const &enuObjectPosition,
+                                             point::CoordinateTransform const &coordinateTransform)
+{
+  point::ENUPoint directionalVector;
+  point::ENUPoint orthogonalVector;
+  point::getDirectionVectorsZPlane(enuObjectPosition.heading, directionalVector, orthogonalVector);
+
+  auto const center = coordinateTransform.ENU2ECEF(enuObjectPosition.centerPoint);
+  auto const front = coordinateTransform.ENU2ECEF(enuObjectPosition.centerPoint + directionalVector);
+  auto const left = coordinateTransform.ENU2ECEF(enuObjectPosition.centerPoint + orthogonalVector);
+
+  ObjectFootprint footprint;
+  footprint.center[0] = static_cast<double>(center.x);
+  footprint.center[1] = static_cast<double>(center.y);
+  footprint.center[2] = static_cast<double>(center.z);
+  footprint.lengthAxis[0] = static_cast<double>(front.x) - footprint.center[0];
+  footprint.lengthAxis[1] = static_cast<double>(front.y) - footprint.center[1];
+  footprint.lengthAxis[2] = static_cast<double>(front.z) - footprint.center[2];
+  footprint.widthAxis[0] = static_cast<double>(left.x) - footprint.center[0];
+  footprint.widthAxis[1] = static_cast<double>(left.y) - footprint.center[1];
+  footprint.widthAxis[2] = static_cast<double>(left.z) - footprint.center[2];
+  footprint.halfLength = 0.5 * static_cast<double>(enuObjectPosition.dimension.length);
+  footprint.halfWidth = 0.5 * static_cast<double>(enuObjectPosition.dimension.width);
+  return footprint;
+}
+
+/**
+ * @brief clip the segment [start, end] to the footprint (Liang-Barsky)
+ *
+ * @returns \c false if the segment doesn't intersect the footprint
+ */
+static bool clipSegment(ObjectFootprint const &footprint, FootprintPoint &start, FootprintPoint &end)
+{
+  double const deltaU = end.u - start.u;
+  double const deltaV = end.v - start.v;
+  double const p[4] = {-deltaU, deltaU, -deltaV, deltaV};
+  double const q[4] = {start.u + footprint.halfLength,
+                       footprint.halfLength - start.u,
+                       start.v + footprint.halfWidth,
+                       footprint.halfWidth - start.v};
+  double tMin = 0.;
+  double tMax = 1.;
+  for (std::size_t i = 0u; i < 4u; ++i)
+  {
+    if (p[i] < 0.)
+    {
+      tMin = std::max(tMin, q[i] / p[i]);
+    }
+    else if (p[i] > 0.)
+    {
+      tMax = std::min(tMax, q[i] / p[i]);
+    }
+    else if (q[i] < 0.)
+    {
+      return false;
+    }
+  }
+  if (tMin > tMax)
+  {
+    return false;
+  }
+  end = {start.u + tMax * deltaU, start.v + tMax * deltaV};
+  start = {start.u + tMin * deltaU, start.v + tMin * deltaV};
+  return true;
+}
+
+static bool isInsidePolygon(std::vector<FootprintPoint> const &polygon, FootprintPoint const &point)
+{
+  bool inside = false;
+  for (std::size_t i = 0u, j = polygon.size() - 1u; i < polygon.size(); j = i++)
+  {
+    if ((polygon[i].v > point.v) != (polygon[j].v > point.v))
+    {
+      double const u = polygon[j].u
+        + (point.v - polygon[j].v) * (polygon[i].u - polygon[j].u) / (polygon[i].v - polygon[j].v);
+      if (point.u < u)
+      {
+        inside = !inside;
+      }
+    }
+  }
+  return inside;
+}
+
+/**
+ * @brief distance of the points sampled along the border of the intersection of footprint and lane
+ */
+static constexpr double cFootprintBorderSamplingDistance = 0.2;
+
+/**
+ * @brief add points along the segment [start, end] with cFootprintBorderSamplingDistance, including both ends
+ */
+static void sampleSegment(FootprintPoint const &start, FootprintPoint const &end, std::vector<FootprintPoint> &points)
+{
+  auto const length = std::sqrt((end.u - start.u) * (end.u - start.u) + (end.v - start.v) * (end.v - start.v));
+  auto const steps = std::max(1., std::ceil(length / cFootprintBorderSamplingDistance));
+  for (double step = 0.; step <= steps; step += 1.)
+  {
+    points.push_back({start.u + (end.u - start.u) * step / steps, start.v + (end.v - start.v) * step / steps});
+  }
+}
+
+/**
+ * @returns points along the border of the intersection of the footprint with the lane polygon
+ *
+ * These are the parts of the lane borders within the footprint and the parts of the footprint border within the lane.
+ * The lane parametrisation is not linear in between the border points of curved lanes, so the border is sampled
+ * instead of using its vertices only.
+ */
+static std::vector<FootprintPoint> getIntersectionBorderPoints(ObjectFootprint const &footprint,
+                                                               std::vector<FootprintPoint> const &lanePolygon)
+{
+  std::vector<FootprintPoint> points;
+  for (std::size_t i = 0u, j = lanePolygon.size() - 1u; i < lanePolygon.size(); j = i++)
+  {
+    auto start = lanePolygon[j];
+    auto end = lanePolygon[i];
+    if (clipSegment(footprint, start, end))
+    {
+      sampleSegment(start, end, points);
+    }
+  }
+  FootprintPoint const corners[4] = {{footprint.halfLength, footprint.halfWidth},
+                                     {footprint.halfLength, -footprint.halfWidth},
+                                     {-footprint.halfLength, -footprint.halfWidth},
+                                     {-footprint.halfLength, footprint.halfWidth}};
+  std::vector<FootprintPoint> footprintBorder;
+  for (std::size_t i = 0u, j = 3u; i < 4u; j = i++)
+  {
+    sampleSegment(corners[j], corners[i], footprintBorder);
+  }
+  // the crossings with the lane borders are already part of the clipped lane border segments
+  std::copy_if(footprintBorder.begin(),
+               footprintBorder.end(),
+               std::back_inserter(points),
+               [&lanePolygon](FootprintPoint const &point) { return isInsidePolygon(lanePolygon, point); });
+  return points;
+}
+
+LaneOccupiedRegionList AdMapMatching::getFootprintLaneRegions(LaneCandidateList const &laneCandidates,
+                                                              ENUObjectPosition const &enuObjectPosition,
+                                                              point::CoordinateTransform const &coordinateTransform)
+{
+  auto const footprint = createObjectFootprint(enuObjectPosition, coordinateTransform);
+  LaneOccupiedRegionList laneOccupiedRegions;
+  point::BoundingSphere footprintSphere;
+  footprintSphere.center = footprint.toECEF({0., 0.});
+  footprintSphere.radius = physics::Distance(std::sqrt(footprint.halfLength * footprint.halfLength
+                                                       + footprint.halfWidth * footprint.halfWidth));
+  std::vector<FootprintPoint> lanePolygon;
+  for (auto const &laneSegmentIndex : laneCandidates)
+  {
+    auto const &lane = *laneSegmentIndex->lane;
+    if (!isNear(lane, footprintSphere) || lane.edgeLeft.ecefEdge.empty() || lane.edgeRight.ecefEdge.empty())
+    {
+      continue;
+    }
+
+    lanePolygon.clear();
+    for (auto const &ecefPoint : lane.edgeLeft.ecefEdge)
+    {
+      lanePolygon.push_back(footprint.toFootprint(ecefPoint));
+    }
+    for (auto it = lane.edgeRight.ecefEdge.rbegin(); it != lane.edgeRight.ecefEdge.rend(); ++it)
+    {
+      lanePolygon.push_back(footprint.toFootprint(*it));
+    }
+
+    bool regionFound = false;
+    LaneOccupiedRegion laneRegion;
+    laneRegion.laneId = lane.id;
+    for (auto const &borderPoint : getIntersectionBorderPoints(footprint, lanePolygon))
+    {
+      MapMatchedPosition mmpt;
+      if (!lane::findNearestPointOnLane(*laneSegmentIndex, footprint.toECEF(borderPoint), mmpt))
+      {
+        continue;
+      }
+      // the border points are within the lane, deviations are numerical only
+      physics::ParametricValue const lateralOffset(
+        std::max(0., std::min(1., static_cast<double>(mmpt.lanePoint.lateralT))));
+      if (regionFound)
+      {
+        unionRangeWith(laneRegion.longitudinalRange, mmpt.lanePoint.paraPoint.parametricOffset);
+        unionRangeWith(laneRegion.lateralRange, lateralOffset);
+      }
+      else
+      {
+        regionFound = true;
+        laneRegion.longitudinalRange.minimum = mmpt.lanePoint.paraPoint.parametricOffset;
+        laneRegion.longitudinalRange.maximum = mmpt.lanePoint.paraPoint.parametricOffset;
+        laneRegion.lateralRange.minimum = lateralOffset;
+        laneRegion.lateralRange.maximum = lateralOffset;
+      }
+    }
+    if (regionFound)
+    {
+      laneOccupiedRegions.push_back(laneRegion);
+    }
+  }
+  return laneOccupiedRegions;
+}
+
+AdMapMatching::LaneCandidateList AdMapMatching::getLaneCandidates(point::BoundingSphere const &boundingSphere)
+{
+  access::QueryScope queryScope;
+  LaneCandidateList laneCandidates;
+  auto const &store = access::getStore();
+  for (auto laneId : store.getLanesNear(boundingSphere))
+  {
+    auto laneSegmentIndex = store.getLaneSegmentIndex(laneId);
+    if (laneSegmentIndex)
+    {
+      laneCandidates.push_back(laneSegmentIndex);
+    }
+  }
+  return laneCandidates;
+}
+
 match::MapMatchedPositionConfidenceList AdMapMatching::findLanesInputChecked(point::ECEFPoint const &ecefPoint,
                                                                              physics::Distance const &distance)
+{
+  point::BoundingSphere matchingSphere;
+  matchingSphere.center = ecefPoint;
+  matchingSphere.radius = distance;
+  return findLanesInputChecked(getLaneCandidates(matchingSphere), ecefPoint, distance);
+}
+
+match::MapMatchedPositionConfidenceList AdMapMatching::findLanesInputChecked(LaneCandidateList const &laneCandidates,
+                                                                             point::ECEFPoint const &ecefPoint,
+                                                                             physics::Distance const &distance)
 {
   match::MapMatchedPositionConfidenceList mapMatchingResults;
   point::BoundingSphere matchingSphere;
   matchingSphere.center = ecefPoint;
   matchingSphere.radius = distance;
   physics::Probability probabilitySum(0.);
-  for (auto laneId : access::getStore().getLanes())
+  for (auto const &laneSegmentIndex : laneCandidates)
   {
-    auto lane = access::getStore().getLanePtr(laneId);
-
-    if (lane)
+    // same check as the spatial search of the store, the candidates might be searched with a larger sphere
+    if (!isNear(*laneSegmentIndex->lane, matchingSphere))
+    {
+      continue;
+    }
+    MapMatchedPosition mmpt;
+    if (lane::findNearestPointOnLane(*laneSegmentIndex, ecefPoint, mmpt))
     {
-      if (lane::isNear(*lane, matchingSphere))
+      if (point::distance(mmpt.matchedPoint, ecefPoint) <= distance)
       {
-        MapMatchedPosition mmpt;
-        if (lane::findNearestPointOnLane(*lane, ecefPoint, mmpt))
-        {
-          if (point::distance(mmpt.matchedPoint, ecefPoint) <= distance)
-          {
-            mapMatchingResults.push_back(mmpt);
-            probabilitySum += mmpt.probability;
-          }
-        }
+        mapMatchingResults.push_back(mmpt);
+        probabilitySum += mmpt.probability;
       }
     }
   }
@@ -72,6 +348,7 @@ match::MapMatchedPositionConfidenceList AdMapMatching::findLanesInputChecked(poi
 match::MapMatchedPositionConfidenceList AdMapMatching::findLanes(point::GeoPoint const &geoPoint,
                                                                  physics::Distance const &distance)
 {
+  access::QueryScope queryScope;
   if (!isValid(geoPoint))
   {
     access::getLogger()->error("Invalid Geo Point passed to AdMapMatching::findLanes(): {}", geoPoint);
@@ -88,6 +365,7 @@ match::MapMatchedPositionConfidenceList AdMapMatching::findLanes(point::GeoPoint
 match::MapMatchedPositionConfidenceList AdMapMatching::findLanes(point::ECEFPoint const &ecefPoint,
                                                                  physics::Distance const &distance)
 {
+  access::QueryScope queryScope;
   if (!isValid(ecefPoint))
   {
     access::getLogger()->error("Invalid ECEF Point passed to AdMapMatching::findLanes(): {}", ecefPoint);
@@ -101,6 +379,24 @@ match::MapMatchedPositionConfidenceList AdMapMatching::findLanes(point::ECEFPoin
   return findLanesInputChecked(ecefPoint, distance);
 }
 
+match::MapMatchedPositionConfidenceList AdMapMatching::findLanes(LaneCandidateList const &laneCandidates,
+                                                                 point::ECEFPoint const &ecefPoint,
+                                                                 physics::Distance const &distance)
+{
+  access::QueryScope queryScope;
+  if (!isValid(ecefPoint))
+  {
+    access::getLogger()->error("Invalid ECEF Point passed to AdMapMatching::findLanes(): {}", ecefPoint);
+    return MapMatchedPositionConfidenceList();
+  }
+  if (!distance.isValid())
+  {
+    access::getLogger()->error("Invalid radius passed to AdMapMatching::findLanes(): {}", distance);
+    return MapMatchedPositionConfidenceList();
+  }
+  return findLanesInputChecked(laneCandidates, ecefPoint, distance);
+}
+
 AdMapMatching::AdMapMatching()
 {
 }
@@ -110,22 +406,77 @@ point::ENUHeading AdMapMatching::getLaneENUHeading(MapMatchedPosition const &map
   return lane::getLaneENUHeading(mapMatchedPosition);
 }
 
-bool AdMapMatching::isLanePartOfRouteHints(lane::LaneId const &laneId)
+void AdMapMatching::addRouteHint(route::FullRoute const &routeHint)
+{
+  mRouteHints.push_back(routeHint);
+  addRouteHintLanes(routeHint.roadSegments.begin(), routeHint.roadSegments.end());
+}
+
+void AdMapMatching::shortenRouteHints(point::ParaPointList const &currentPositions)
+{
+  for (auto routeHint = mRouteHints.begin(); routeHint != mRouteHints.end();)
+  {
+    // shortening only removes leading road segments and the lanes of the first remaining one are kept
+    // therefore, the lanes are removed up to the road segment of the current position and the kept ones added again
+    auto const findWaypointResult = route::findNearestWaypoint(currentPositions, *routeHint);
+    auto const affectedRoadSegmentCount = findWaypointResult.isValid()
+      ? static_cast<std::size_t>(
+          std::distance(routeHint->roadSegments.cbegin(), findWaypointResult.roadSegmentIterator) + 1)
+      : routeHint->roadSegments.size();
+    auto const roadSegmentCount = routeHint->roadSegments.size();
+    removeRouteHintLanes(routeHint->roadSegments.cbegin(),
+                         routeHint->roadSegments.cbegin() + static_cast<std::ptrdiff_t>(affectedRoadSegmentCount));
+
+    route::shortenRoute(currentPositions, *routeHint);
+
+    auto const keptRoadSegmentCount = affectedRoadSegmentCount - (roadSegmentCount - routeHint->roadSegments.size());
+    addRouteHintLanes(routeHint->roadSegments.cbegin(),
+                      routeHint->roadSegments.cbegin() + static_cast<std::ptrdiff_t>(keptRoadSegmentCount));
+    if (routeHint->roadSegments.empty())
+    {
+      routeHint = mRouteHints.erase(routeHint);
+    }
+    else
+    {
+      ++routeHint;
+    }
+  }
+}
+
+void AdMapMatching::addRouteHintLanes(route::RoadSegmentList::const_iterator begin,
+                                      route::RoadSegmentList::const_iterator end)
 {
-  for (auto const &route : mRouteHints)
+  for (auto roadSegment = begin; roadSegment != end; ++roadSegment)
   {
-    for (auto const &roadSegment : route.roadSegments)
+    for (auto const &laneSegment : roadSegment->drivableLaneSegments)
     {
-      for (auto const &laneSegment : roadSegment.drivableLaneSegments)
+      mRouteHintLanes[laneSegment.laneInterval.laneId]++;
+    }
+  }
+}
+
+void AdMapMatching::removeRouteHintLanes(route::RoadSegmentList::const_iterator begin,
+                                         route::RoadSegmentList::const_iterator end)
+{
+  for (auto roadSegment = begin; roadSegment != end; ++roadSegment)
+  {
+    for (auto const &laneSegment : roadSegment->drivableLaneSegments)
+    {
+      auto routeHintLane = mRouteHintLanes.find(laneSegment.laneInterval.laneId);
+      if (routeHintLane != mRouteHintLanes.end())
       {
-        if (laneSegment.laneInterval.laneId == laneId)
+        if (--routeHintLane->second == 0u)
         {
-          return true;
+          mRouteHintLanes.erase(routeHintLane);
         }
       }
     }
   }
-  return false;
+}
+
+bool AdMapMatching::isLanePartOfRouteHints(lane::LaneId const &laneId)
+{
+  return mRouteHintLanes.find(laneId) != mRouteHintLanes.end();
 }
 
 double AdMapMatching::getHeadingFactor(MapMatchedPosition const &matchedPosition)
@@ -154,17 +505,62 @@ MapMatchedPositionConfidenceList AdMapMatching::getMapMatchedPositions(point::Ge
                                                                        physics::Distance const &distance,
                                                                        physics::Probability const &minProbability)
 {
+  access::QueryScope queryScope;
   auto mapMatchingResult = findLanes(geoPoint, distance);
   mapMatchingResult = considerMapMatchingHints(mapMatchingResult, minProbability);
   access::getLogger()->trace("MapMatching result {}", mapMatchingResult);
   return mapMatchingResult;
 }
 
+MapMatchedPositionConfidenceList AdMapMatching::getMapMatchedPositions(point::ECEFPoint const &ecefPoint,
+                                                                       physics::Distance const &distance,
+                                                                       physics::Probability const &minProbability)
+{
+  access::QueryScope queryScope;
+  auto mapMatchingResult = findLanes(ecefPoint, distance);
+  mapMatchingResult = considerMapMatchingHints(mapMatchingResult, minProbability);
+  access::getLogger()->trace("MapMatching result {}", mapMatchingResult);
+  return mapMatchingResult;
+}
+
+MapMatchedPositionConfidenceList AdMapMatching::getMapMatchedPositions(lane::LaneIdList const &laneIds,
+                                                                       point::ECEFPoint const &ecefPoint,
+                                                                       physics::Distance const &distance,
+                                                                       physics::Probability const &minProbability)
+{
+  access::QueryScope queryScope;
+  LaneCandidateList laneCandidates;
+  laneCandidates.reserve(laneIds.size());
+  auto const &store = access::getStore();
+  for (auto const &laneId : laneIds)
+  {
+    auto laneSegmentIndex = store.getLaneSegmentIndex(laneId);
+    if (laneSegmentIndex)
+    {
+      laneCandidates.push_back(laneSegmentIndex);
+    }
+  }
+  return getMapMatchedPositions(laneCandidates, ecefPoint, distance, minProbability);
+}
+
+MapMatchedPositionConfidenceList AdMapMatching::getMapMatchedPositions(LaneCandidateList const &laneCandidates,
+                                                                       point::ECEFPoint const &ecefPoint,
+                                                                       physics::Distance const &distance,
+                                                                       physics::Probability const &minProbability)
+{
+  access::QueryScope queryScope;
+  auto mapMatchingResult = findLanes(laneCandidates, ecefPoint, distance);
+  mapMatchingResult = considerMapMatchingHints(mapMatchingResult, minProbability);
+  access::getLogger()->trace("MapMatching result {}", mapMatchingResult);
+  return mapMatchingResult;
+}
+
 MapMatchedPositionConfidenceList AdMapMatching::getMapMatchedPositions(point::ENUPoint const &enuPoint,
                                                                        physics::Distance const &distance,
                                                                        physics::Probability const &minProbability)
 {
-  return getMapMatchedPositions(point::toGeo(enuPoint), distance, minProbability);
+  access::QueryScope queryScope;
+  return getMapMatchedPositions(point::toECEF(enuPoint), distance, minProbability);
 }
 
 MapMatchedPositionConfidenceList AdMapMatching::getMapMatchedPositions(point::ENUPoint const &enuPoint,
@@ -172,16 +568,20 @@ MapMatchedPositionConfidenceList AdMapMatching::getMapMatchedPositions(point::EN
                                                                        physics::Distance const &distance,
                                                                        physics::Probability const &minProbability)
 {
-  return getMapMatchedPositions(point::toGeo(enuPoint, enuReferencePoint), distance, minProbability);
+  access::QueryScope queryScope;
+  return getMapMatchedPositions(point::toECEF(enuPoint, enuReferencePoint), distance, minProbability);
 }
 
 MapMatchedPositionConfidenceList AdMapMatching::getMapMatchedPositions(ENUObjectPosition const &enuObjectPosition,
                                                                        physics::Distance const &distance,
                                                                        physics::Probability const &minProbability)
 {
-  addHeadingHint(enuObjectPosition.heading, enuObjectPosition.enuReferencePoint);
+  access::QueryScope queryScope;
+  point::CoordinateTransform coordinateTransform;
+  coordinateTransform.setENUReferencePoint(enuObjectPosition.enuReferencePoint);
+  addHeadingHint(point::createECEFHeading(enuObjectPosition.heading, coordinateTransform));
   auto mapMatchedPositions = getMapMatchedPositions(
-    enuObjectPosition.centerPoint, enuObjectPosition.enuReferencePoint, distance, minProbability);
+    coordinateTransform.ENU2ECEF(enuObjectPosition.centerPoint), distance, minProbability);
   clearHeadingHints();
   return mapMatchedPositions;
 }
@@ -264,8 +664,13 @@ MapMatchedObjectBoundingBox AdMapMatching::getMapMatchedBoundingBox(ENUObjectPos
                                                                     physics::Probability const &minProbability,
                                                                     physics::Distance const &samplingDistance)
 {
+  access::QueryScope queryScope;
   MapMatchedObjectBoundingBox mapMatchedObjectBoundingBox;
 
+  // all points share the ENU reference point, so the transformation is set up only once
+  point::CoordinateTransform coordinateTransform;
+  coordinateTransform.setENUReferencePoint(enuObjectPosition.enuReferencePoint);
+
   point::ENUPoint directionalVector;
   point::ENUPoint orthogonalVector;
   point::getDirectionVectorsZPlane(enuObjectPosition.heading, directionalVector, orthogonalVector);
@@ -286,53 +691,108 @@ MapMatchedObjectBoundingBox AdMapMatching::getMapMatchedBoundingBox(ENUObjectPos
   referencePoints[int32_t(ObjectReferencePoints::RearRight)]
     = (enuObjectPosition.centerPoint - directionalLength) - directionalWidth;
 
+  // all points of the object are within this sphere, so a single spatial search provides the lanes for all of them
+  // (an invalid distance is reported by the map matching of the points)
+  auto const halfLength = 0.5 * static_cast<double>(enuObjectPosition.dimension.length);
+  auto const halfWidth = 0.5 * static_cast<double>(enuObjectPosition.dimension.width);
+  point::BoundingSphere objectSphere;
+  objectSphere.center = coordinateTransform.ENU2ECEF(enuObjectPosition.centerPoint);
+  objectSphere.radius = physics::Distance(std::sqrt(halfLength * halfLength + halfWidth * halfWidth));
+  if (distance.isValid())
+  {
+    objectSphere.radius += distance;
+  }
+  auto const laneCandidates = getLaneCandidates(objectSphere);
+
   mapMatchedObjectBoundingBox.referencePointPositions.resize(size_t(ObjectReferencePoints::NumPoints));
 
   for (size_t i = 0; i < size_t(ObjectReferencePoints::NumPoints); i++)
   {
-    mapMatchedObjectBoundingBox.referencePointPositions[i]
-      = getMapMatchedPositions(referencePoints[i], enuObjectPosition.enuReferencePoint, distance, minProbability);
+    mapMatchedObjectBoundingBox.referencePointPositions[i] = getMapMatchedPositions(
+      laneCandidates, coordinateTransform.ENU2ECEF(referencePoints[i]), distance, minProbability);
 
     addLaneRegions(mapMatchedObjectBoundingBox.laneOccupiedRegions,
                    mapMatchedObjectBoundingBox.referencePointPositions[i]);
   }
 
-  physics::Distance const stride = std::max(samplingDistance, physics::Distance(0.1));
+  if (mBoundingBoxMatchingMode == BoundingBoxMatchingMode::Footprint)
+  {
+    addLaneRegions(mapMatchedObjectBoundingBox.laneOccupiedRegions,
+                   getFootprintLaneRegions(laneCandidates, enuObjectPosition, coordinateTransform));
+  }
+  else
+  {
+    physics::Distance const stride = std::max(samplingDistance, physics::Distance(0.1));
 
-  point::ENUPoint const lengthStrideVector = directionalVector * stride;
-  point::ENUPoint const widthStrideVector = orthogonalVector * stride;
+    point::ENUPoint const lengthStrideVector = directionalVector * stride;
+    point::ENUPoint const widthStrideVector = orthogonalVector * stride;
 
-  point::ENUPoint widthStartPos = referencePoints[int32_t(ObjectReferencePoints::FrontLeft)];
+    point::ENUPoint widthStartPos = referencePoints[int32_t(ObjectReferencePoints::FrontLeft)];
 
-  for (auto j = stride; j < enuObjectPosition.dimension.width; j += stride)
-  {
-    point::ENUPoint currentPoint = widthStartPos;
-    for (auto i = stride; i < enuObjectPosition.dimension.length; i += stride)
+    for (auto j = stride; j < enuObjectPosition.dimension.width; j += stride)
     {
-      currentPoint = currentPoint - lengthStrideVector;
+      point::ENUPoint currentPoint = widthStartPos;
+      for (auto i = stride; i < enuObjectPosition.dimension.length; i += stride)
+      {
+        currentPoint = currentPoint - lengthStrideVector;
 
-      MapMatchedPositionConfidenceList mapMatchedPositions
-        = getMapMatchedPositions(currentPoint, enuObjectPosition.enuReferencePoint, distance, minProbability);
-      addLaneRegions(mapMatchedObjectBoundingBox.laneOccupiedRegions, mapMatchedPositions);
+        MapMatchedPositionConfidenceList mapMatchedPositions = getMapMatchedPositions(
+          laneCandidates, coordinateTransform.ENU2ECEF(currentPoint), distance, minProbability);
+        addLaneRegions(mapMatchedObjectBoundingBox.laneOccupiedRegions, mapMatchedPositions);
+      }
+      widthStartPos = widthStartPos - widthStrideVector;
     }
-    widthStartPos = widthStartPos - widthStrideVector;
   }
 
   return mapMatchedObjectBoundingBox;
 }
 
-LaneOccupiedRegionList AdMapMatching::getLaneOccupiedRegions(std::vector<ENUObjectPosition> enuObjectPositions,
+std::vector<MapMatchedObjectBoundingBox>
+AdMapMatching::getMapMatchedBoundingBoxes(ENUObjectPositionList const &enuObjectPositionList,
+                                          physics::Distance const &distance,
+                                          physics::Probability const &minProbability,
+                                          physics::Distance const &samplingDistance,
+                                          std::size_t const threadCount)
+{
+  access::QueryScope queryScope;
+  std::vector<MapMatchedObjectBoundingBox> boundingBoxes(enuObjectPositionList.size());
+
+  // each object is written to its own entry, so the result doesn't depend on the distribution over the threads
+  access::parallelFor(enuObjectPositionList.size(), threadCount, [&](std::size_t const objectIndex) {
+    boundingBoxes[objectIndex] = getMapMatchedBoundingBox(
+      enuObjectPositionList[objectIndex], distance, minProbability, samplingDistance);
+  });
+  return boundingBoxes;
+}
+
+LaneOccupiedRegionList AdMapMatching::getLaneOccupiedRegions(ENUObjectPositionList const &enuObjectPositionList,
                                                              physics::Distance const &distance,
                                                              physics::Probability const &minProbability,
-                                                             physics::Distance const &samplingDistance)
+                                                             physics::Distance const &samplingDistance,
+                                                             std::size_t const threadCount)
 {
+  access::QueryScope queryScope;
   LaneOccupiedRegionList laneOccupiedRegions;
+  std::unordered_map<lane::LaneId, std::size_t, lane::LaneIdHash> regionIndices;
 
-  for (auto const &objectPosition : enuObjectPositions)
+  auto const boundingBoxes
+    = getMapMatchedBoundingBoxes(enuObjectPositionList, distance, minProbability, samplingDistance, threadCount);
+  for (auto const &boundingBox : boundingBoxes)
   {
-    auto const mapMatchedBoundingBox
-      = getMapMatchedBoundingBox(objectPosition, distance, minProbability, samplingDistance);
-    addLaneRegions(laneOccupiedRegions, mapMatchedBoundingBox.laneOccupiedRegions);
+    for (auto const &region : boundingBox.laneOccupiedRegions)
+    {
+      auto const insertResult = regionIndices.insert({region.laneId, laneOccupiedRegions.size()});
+      if (insertResult.second)
+      {
+        laneOccupiedRegions.push_back(region);
+      }
+      else
+      {
+        auto &mergedRegion = laneOccupiedRegions[insertResult.first->second];
+        unionRangeWith(mergedRegion.longitudinalRange, region.longitudinalRange);
+        unionRangeWith(mergedRegion.lateralRange, region.lateralRange);
+      }
+    }
   }
   return laneOccupiedRegions;
 }
@@ -0,0 +1,107 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/match/MapMatchingTracker.hpp"
+
+#include "ad/map/access/MapContext.hpp"
+#include "ad/map/access/Operation.hpp"
+#include "ad/map/point/CoordinateTransform.hpp"
+#include "ad/map/point/ECEFOperation.hpp"
+#include "ad/map/point/HeadingOperation.hpp"
+
+namespace ad {
+namespace map {
+namespace match {
+
+// the store queried by the calling thread, which is pinned by a QueryScope outside of a MapContext
+static access::Store::Ptr getQueriedStore()
+{
+  auto const context = access::MapContext::getCurrent();
+  if (context != nullptr)
+  {
+    return context->getStorePtr();
+  }
+  return access::QueryScope::getPinnedStore();
+}
+
+MapMatchedPositionConfidenceList MapMatchingTracker::getMapMatchedPositions(ObjectId const objectId,
+                                                                            point::ECEFPoint const &ecefPoint,
+                                                                            physics::Distance const &distance,
+                                                                            physics::Probability const &minProbability)
+{
+  access::QueryScope queryScope;
+  auto const store = getQueriedStore();
+  // an expired store is never equal to the queried one, even if the new store reuses its address
+  if (mStore.lock() != store)
+  {
+    mObjectLanes.clear();
+    mStore = store;
+  }
+
+  auto objectLanes = mObjectLanes.find(objectId);
+  if (objectLanes != mObjectLanes.end())
+  {
+    auto const &searchSphere = objectLanes->second.searchSphere;
+    // the search sphere of the object has to enclose the current one
+    if (point::distance(ecefPoint, searchSphere.center) + distance <= searchSphere.radius)
+    {
+      mStatistics.localHits++;
+      return mMapMatching.getMapMatchedPositions(objectLanes->second.laneIds, ecefPoint, distance, minProbability);
+    }
+    mStatistics.localMisses++;
+  }
+  else
+  {
+    objectLanes = mObjectLanes.emplace(objectId, ObjectLanes()).first;
+  }
+
+  mStatistics.globalSearches++;
+  auto &searchSphere = objectLanes->second.searchSphere;
+  searchSphere.center = ecefPoint;
+  searchSphere.radius = distance + mSearchMargin;
+  objectLanes->second.laneIds = access::getStore().getLanesNear(searchSphere);
+  return mMapMatching.getMapMatchedPositions(objectLanes->second.laneIds, ecefPoint, distance, minProbability);
+}
+
+MapMatchedPositionConfidenceList MapMatchingTracker::getMapMatchedPositions(ObjectId const objectId,
+                                                                            ENUObjectPosition const &enuObjectPosition,
+                                                                            physics::Distance const &distance,
+                                                                            physics::Probability const &minProbability)
+{
+  point::CoordinateTransform coordinateTransform;
+  coordinateTransform.setENUReferencePoint(enuObjectPosition.enuReferencePoint);
+  mMapMatching.addHeadingHint(point::createECEFHeading(enuObjectPosition.heading, coordinateTransform));
+  auto mapMatchedPositions = getMapMatchedPositions(
+    objectId, coordinateTransform.ENU2ECEF(enuObjectPosition.centerPoint), distance, minProbability);
+  mMapMatching.clearHeadingHints();
+  return mapMatchedPositions;
+}
+
+void MapMatchingTracker::removeObject(ObjectId const objectId)
+{
+  mObjectLanes.erase(objectId);
+}
+
+void MapMatchingTracker::clear()
+{
+  mObjectLanes.clear();
+}
+
+double MapMatchingTracker::getHitRate() const
+{
+  auto const matchCount = mStatistics.localHits + mStatistics.globalSearches;
+  if (matchCount == 0u)
+  {
+    return 0.;
+  }
+  return static_cast<double>(mStatistics.localHits) / static_cast<double>(matchCount);
+}
+
+} // namespace match
+} // namespace map
+} // namespace ad
@@ -0,0 +1,370 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/opendrive/AdMapCache.hpp"
+
+#include <algorithm>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <vector>
+#include "ad/map/access/Logging.hpp"
+#include "ad/map/access/Operation.hpp"
+#include "ad/map/opendrive/AdMapFactory.hpp"
+#include "ad/map/serialize/ChecksumCRC32.hpp"
+#include "ad/map/serialize/SerializeGeneratedTypes.hpp"
+#include "ad/map/serialize/SerializerFileCRC32.hpp"
+#include "ad/map/serialize/SerializerMemoryMappedCRC32.hpp"
+
+namespace ad {
+namespace map {
+namespace opendrive {
+
+constexpr uint32_t AdMapCache::VERSION;
+
+static char const *const ENTRY_EXTENSION = ".adm";
+static uint64_t const HASH_OFFSET_BASIS = 14695981039346656037ull;
+
+/**
+ * @brief 64 bit FNV-1a hash of the given data.
+ */
+static uint64_t hash(void const *data, std::size_t bytes, uint64_t value = HASH_OFFSET_BASIS)
+{
+  auto const *byte = static_cast<uint8_t const *>(data);
+  for (std::size_t i = 0u; i < bytes; ++i)
+  {
+    value = (value ^ byte[i]) * 1099511628211ull;
+  }
+  return value;
+}
+
+template <typename T> static uint64_t hashValue(T const &x, uint64_t value)
+{
+  return hash(&x, sizeof(x), value);
+}
+
+static bool isEntry(boost::filesystem::directory_entry const &entry)
+{
+  boost::system::error_code error;
+  return boost::filesystem::is_regular_file(entry.status(error)) && (entry.path().extension() == ENTRY_EXTENSION);
+}
+
+AdMapCache::AdMapCache(std::string const &directory, std::size_t maxSize)
+  : mDirectory(directory)
+  , mMaxSize(maxSize)
+{
+  if (!mDirectory.empty())
+  {
+    boost::system::error_code error;
+    boost::filesystem::create_directories(mDirectory, error);
+    if (!boost::filesystem::is_directory(mDirectory, error))
+    {
+      access::getLogger()->error("AdMapCache: Cannot create cache directory {}, caching disabled.", mDirectory);
+      mDirectory.clear();
+    }
+  }
+}
+
+bool AdMapCache::isEnabled() const
+{
+  return !mDirectory.empty();
+}
+
+std::string const &AdMapCache::directory() const
+{
+  return mDirectory;
+}
+
+std::size_t AdMapCache::maxSize() const
+{
+  return mMaxSize;
+}
+
+access::Store::Ptr AdMapCache::createAdMap(std::string const &mapFilePath,
+                                           double const overlapMargin,
+                                           intersection::IntersectionType const defaultIntersectionType)
+{
+  if (!isEnabled())
+  {
+    auto store = std::make_shared<access::Store>();
+    AdMapFactory factory(*store);
+    if (!factory.createAdMap(mapFilePath, overlapMargin, defaultIntersectionType))
+    {
+      return nullptr;
+    }
+    return store;
+  }
+
+  std::ifstream mapFile(mapFilePath, std::ios::binary);
+  std::stringstream mapContent;
+  if (!mapFile.is_open() || !(mapContent << mapFile.rdbuf()))
+  {
+    access::getLogger()->warn("Unable to open opendrive map for reading {}", mapFilePath);
+    return nullptr;
+  }
+  return createAdMapFromString(mapContent.str(), overlapMargin, defaultIntersectionType);
+}
+
+access::Store::Ptr AdMapCache::createAdMapFromString(std::string const &mapContent,
+                                                     double const overlapMargin,
+                                                     intersection::IntersectionType const defaultIntersectionType)
+{
+  std::string entryName;
+  if (isEnabled())
+  {
+    entryName = getEntryName(mapContent, overlapMargin, defaultIntersectionType);
+    auto cachedStore = load(entryName);
+    if (cachedStore)
+    {
+      access::getLogger()->info("AdMapCache: Loaded converted map {}", entryName);
+      return cachedStore;
+    }
+  }
+
+  auto store = std::make_shared<access::Store>();
+  AdMapFactory factory(*store);
+  if (!factory.createAdMapFromString(mapContent, overlapMargin, defaultIntersectionType))
+  {
+    return nullptr;
+  }
+  if (isEnabled() && !save(entryName, *store))
+  {
+    access::getLogger()->warn("AdMapCache: Unable to store converted map {}", entryName);
+  }
+  return store;
+}
+
+std::string AdMapCache::getEntryName(std::string const &mapContent,
+                                     double const overlapMargin,
+                                     intersection::IntersectionType const defaultIntersectionType) const
+{
+  uint64_t const contentHash = hash(mapContent.data(), mapContent.size());
+  uint32_t const contentCrc = serialize::ChecksumCRC32::calculateParallel(0u, mapContent.data(), mapContent.size());
+
+  uint64_t parameterHash = hashValue(mapContent.size(), HASH_OFFSET_BASIS);
+  parameterHash = hashValue(overlapMargin, parameterHash);
+  parameterHash = hashValue(static_cast<int32_t>(defaultIntersectionType), parameterHash);
+  uint32_t const version = VERSION;
+  parameterHash = hashValue(version, parameterHash);
+  parameterHash = hashValue(serialize::SerializerFileCRC32::VERSION_MAJOR, parameterHash);
+  parameterHash = hashValue(serialize::SerializerFileCRC32::VERSION_MINOR, parameterHash);
+  if (access::isENUReferencePointSet())
+  {
+    auto const enuReferencePoint = access::getENUReferencePoint();
+    parameterHash = hashValue(static_cast<double>(enuReferencePoint.latitude), parameterHash);
+    parameterHash = hashValue(static_cast<double>(enuReferencePoint.longitude), parameterHash);
+    parameterHash = hashValue(static_cast<double>(enuReferencePoint.altitude), parameterHash);
+  }
+
+  char entryName[41];
+  std::snprintf(entryName,
+                sizeof(entryName),
+                "%016llx%08x%016llx",
+                static_cast<unsigned long long>(contentHash),
+                static_cast<unsigned int>(contentCrc),
+                static_cast<unsigned long long>(parameterHash));
+  return entryName;
+}
+
+std::string AdMapCache::getEntryFileName(std::string const &entryName) const
+{
+  return (boost::filesystem::path(mDirectory) / (entryName + ENTRY_EXTENSION)).string();
+}
+
+access::Store::Ptr AdMapCache::load(std::string const &entryName) const
+{
+  auto const fileName = getEntryFileName(entryName);
+  boost::system::error_code error;
+  if (!isEnabled() || !boost::filesystem::exists(fileName, error))
+  {
+    return nullptr;
+  }
+
+  auto store = std::make_shared<access::Store>();
+  std::string storedEntryName;
+  bool enuReferencePointSet = false;
+  point::GeoPoint enuReferencePoint;
+  bool ok = false;
+  try
+  {
+    serialize::SerializerMemoryMappedCRC32 serializer;
+    size_t versionMajor = 0u;
+    size_t versionMinor = 0u;
+    if (serializer.open(fileName, versionMajor, versionMinor))
+    {
+      ok = serializer.serialize(serialize::SerializeableMagic::AdMapCacheEntry)
+        && serializer.serialize(storedEntryName) && (storedEntryName == entryName)
+        && serializer.serialize(enuReferencePointSet)
+        && (!enuReferencePointSet || serialize::doSerialize(serializer, enuReferencePoint)) && store->load(serializer);
+      ok = serializer.close() && ok;
+    }
+  }
+  catch (std::exception const &e)
+  {
+    access::getLogger()->warn("AdMapCache: Error reading {}: {}", fileName, e.what());
+    ok = false;
+  }
+  if (!ok)
+  {
+    access::getLogger()->warn("AdMapCache: Ignoring invalid entry {}", fileName);
+    return nullptr;
+  }
+
+  if (enuReferencePointSet)
+  {
+    access::setENUReferencePoint(enuReferencePoint);
+  }
+  // the modification time tracks the last use of the entry
+  boost::filesystem::last_write_time(fileName, std::time(nullptr), error);
+  return store;
+}
+
+bool AdMapCache::save(std::string const &entryName, access::Store &store)
+{
+  if (!isEnabled())
+  {
+    return false;
+  }
+
+  auto const fileName = getEntryFileName(entryName);
+  boost::system::error_code error;
+  auto const temporaryFileName
+    = boost::filesystem::unique_path(fileName + ".%%%%-%%%%-%%%%-%%%%.tmp", error).string();
+  bool enuReferencePointSet = access::isENUReferencePointSet();
+  point::GeoPoint enuReferencePoint;
+  if (enuReferencePointSet)
+  {
+    enuReferencePoint = access::getENUReferencePoint();
+  }
+  std::string storedEntryName = entryName;
+  bool ok = false;
+  try
+  {
+    serialize::SerializerFileCRC32 serializer(true);
+    size_t versionMajor = serialize::SerializerFileCRC32::VERSION_MAJOR;
+    size_t versionMinor = serialize::SerializerFileCRC32::VERSION_MINOR;
+    if (!error && serializer.open(temporaryFileName, versionMajor, versionMinor))
+    {
+      ok = serializer.serialize(serialize::SerializeableMagic::AdMapCacheEntry)
+        && serializer.serialize(storedEntryName) && serializer.serialize(enuReferencePointSet)
+        && (!enuReferencePointSet || serialize::doSerialize(serializer, enuReferencePoint)) && store.save(serializer);
+      ok = serializer.close() && ok;
+    }
+  }
+  catch (std::exception const &e)
+  {
+    access::getLogger()->warn("AdMapCache: Error writing {}: {}", temporaryFileName, e.what());
+    ok = false;
+  }
+  if (ok)
+  {
+    // readers of other processes only see complete entries
+    boost::filesystem::rename(temporaryFileName, fileName, error);
+    ok = !error;
+  }
+  if (!ok)
+  {
+    boost::filesystem::remove(temporaryFileName, error);
+    return false;
+  }
+  limitSize(entryName);
+  return true;
+}
+
+void AdMapCache::clear()
+{
+  if (!isEnabled())
+  {
+    return;
+  }
+  boost::system::error_code error;
+  std::vector<boost::filesystem::path> entries;
+  for (boost::filesystem::directory_iterator it(mDirectory, error), end; !error && (it != end); it.increment(error))
+  {
+    if (isEntry(*it))
+    {
+      entries.push_back(it->path());
+    }
+  }
+  for (auto const &entry : entries)
+  {
+    boost::filesystem::remove(entry, error);
+  }
+}
+
+std::size_t AdMapCache::size() const
+{
+  std::size_t totalSize = 0u;
+  if (!isEnabled())
+  {
+    return totalSize;
+  }
+  boost::system::error_code error;
+  for (boost::filesystem::directory_iterator it(mDirectory, error), end; !error && (it != end); it.increment(error))
+  {
+    if (isEntry(*it))
+    {
+      auto const fileSize = boost::filesystem::file_size(it->path(), error);
+      totalSize += error ? 0u : static_cast<std::size_t>(fileSize);
+    }
+  }
+  return totalSize;
+}
+
+void AdMapCache::limitSize(std::string const &keptEntryName)
+{
+  if (mMaxSize == 0u)
+  {
+    return;
+  }
+
+  boost::system::error_code error;
+  auto const keptFileName = boost::filesystem::path(getEntryFileName(keptEntryName)).filename();
+  // last use, size and path of the entries
+  std::vector<std::tuple<std::time_t, std::size_t, boost::filesystem::path>> entries;
+  std::size_t totalSize = 0u;
+  for (boost::filesystem::directory_iterator it(mDirectory, error), end; !error && (it != end); it.increment(error))
+  {
+    if (isEntry(*it))
+    {
+      boost::system::error_code entryError;
+      auto const fileSize = static_cast<std::size_t>(boost::filesystem::file_size(it->path(), entryError));
+      auto const lastUse = boost::filesystem::last_write_time(it->path(), entryError);
+      if (!entryError)
+      {
+        totalSize += fileSize;
+        if (it->path().filename() != keptFileName)
+        {
+          entries.emplace_back(lastUse, fileSize, it->path());
+        }
+      }
+    }
+  }
+
+  std::sort(entries.begin(), entries.end());
+  for (auto const &entry : entries)
+  {
+    if (totalSize <= mMaxSize)
+    {
+      break;
+    }
+    if (boost::filesystem::remove(std::get<2>(entry), error))
+    {
+      access::getLogger()->info("AdMapCache: Removed least recently used entry {}", std::get<2>(entry).string());
+      totalSize -= std::get<1>(entry);
+    }
+  }
+}
+
+} // namespace opendrive
+} // namespace map
+} // namespace ad
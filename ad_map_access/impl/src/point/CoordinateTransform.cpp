@@ -296,6 +296,31 @@ ENUPoint CoordinateTransform::ECEF2ENU(const ECEFPoint &pt) const
   }
 }
 
+ENUEdge CoordinateTransform::ECEF2ENU(const ECEFEdge &edge) const
+{
+  if (!isENUValid())
+  {
+    access::getLogger()->error("Cannot convert from ECEF to ENU: ENU Reference Point invalid.");
+    throw std::invalid_argument("Cannot convert from ECEF to ENU: ENU Reference Point invalid.");
+  }
+  double const ref_x = static_cast<double>(ecef_ref_point_.x);
+  double const ref_y = static_cast<double>(ecef_ref_point_.y);
+  double const ref_z = static_cast<double>(ecef_ref_point_.z);
+  ENUEdge enu_edge;
+  enu_edge.reserve(edge.size());
+  for (auto const &pt : edge)
+  {
+    double x = static_cast<double>(pt.x) - ref_x;
+    double y = static_cast<double>(pt.y) - ref_y;
+    double z = static_cast<double>(pt.z) - ref_z;
+    double enu_x = ecef_enu_[0] * x + ecef_enu_[1] * y;
+    double enu_y = ecef_enu_[3] * x + ecef_enu_[4] * y + ecef_enu_[5] * z;
+    double enu_z = ecef_enu_[6] * x + ecef_enu_[7] * y + ecef_enu_[8] * z;
+    enu_edge.push_back(createENUPoint(enu_x, enu_y, enu_z));
+  }
+  return enu_edge;
+}
+
 /////////////////
 // Useful methods
 
@@ -0,0 +1,225 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "EdgeSegmentIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "ad/map/point/Operation.hpp"
+
+namespace ad {
+namespace map {
+namespace point {
+
+static bool isFinite(ECEFPoint const &pt)
+{
+  return std::isfinite(static_cast<double>(pt.x)) && std::isfinite(static_cast<double>(pt.y))
+    && std::isfinite(static_cast<double>(pt.z));
+}
+
+static double distanceToCenter(ECEFPoint const &pt, double const center[3])
+{
+  double const dx = static_cast<double>(pt.x) - center[0];
+  double const dy = static_cast<double>(pt.y) - center[1];
+  double const dz = static_cast<double>(pt.z) - center[2];
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+EdgeSegmentIndex::EdgeSegmentIndex(ECEFEdge const &edge)
+  : valid_(std::all_of(edge.begin(), edge.end(), isFinite))
+  , point_count_(edge.size())
+{
+  if (!valid_ || (edge.size() < 2u))
+  {
+    return;
+  }
+
+  // offsets accumulated exactly as done by findNearestPointOnEdge()
+  running_offset_.resize(edge.size() - 1u, physics::Distance(0.));
+  physics::Distance runningOffset(0.);
+  for (std::size_t i = 1u; i + 1u < edge.size(); ++i)
+  {
+    runningOffset += distance(edge[i - 1u], edge[i]);
+    running_offset_[i] = runningOffset;
+  }
+
+  // lengths accumulated exactly as done by getParametricPoint()
+  physics::Distance length(0.);
+  for (std::size_t i = 0u; i + 1u < edge.size(); ++i)
+  {
+    auto d = distance(edge[i], edge[i + 1u]);
+    if (d != physics::Distance(0.))
+    {
+      para_segments_.push_back(i);
+      para_start_.push_back(length);
+      length = length + d;
+      para_end_.push_back(length);
+      para_length_.push_back(d);
+    }
+  }
+
+  for (std::size_t firstSegment = 0u; firstSegment + 1u < edge.size(); firstSegment += SEGMENTS_PER_CHUNK)
+  {
+    Chunk chunk;
+    chunk.firstSegment = firstSegment;
+    chunk.endSegment = std::min(firstSegment + SEGMENTS_PER_CHUNK, edge.size() - 1u);
+    double minValues[3]
+      = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    double maxValues[3] = {std::numeric_limits<double>::lowest(),
+                           std::numeric_limits<double>::lowest(),
+                           std::numeric_limits<double>::lowest()};
+    for (auto i = chunk.firstSegment; i <= chunk.endSegment; ++i)
+    {
+      double const values[3]
+        = {static_cast<double>(edge[i].x), static_cast<double>(edge[i].y), static_cast<double>(edge[i].z)};
+      for (auto axis = 0u; axis < 3u; ++axis)
+      {
+        minValues[axis] = std::min(minValues[axis], values[axis]);
+        maxValues[axis] = std::max(maxValues[axis], values[axis]);
+      }
+    }
+    for (auto axis = 0u; axis < 3u; ++axis)
+    {
+      chunk.center[axis] = 0.5 * (minValues[axis] + maxValues[axis]);
+    }
+    chunk.radius = 0.;
+    for (auto i = chunk.firstSegment; i <= chunk.endSegment; ++i)
+    {
+      chunk.radius = std::max(chunk.radius, distanceToCenter(edge[i], chunk.center));
+    }
+    chunks_.push_back(chunk);
+  }
+}
+
+bool EdgeSegmentIndex::isIndexOf(ECEFEdge const &edge) const
+{
+  return valid_ && (edge.size() == point_count_);
+}
+
+physics::ParametricValue EdgeSegmentIndex::findNearestPointOnEdge(ECEFEdge const &edge,
+                                                                  physics::Distance const &edgeLength,
+                                                                  ECEFPoint const &pt) const
+{
+  if (!isIndexOf(edge))
+  {
+    return point::findNearestPointOnEdge(edge, edgeLength, pt);
+  }
+  if (!isValid(pt))
+  {
+    return physics::ParametricValue();
+  }
+  if (edge.size() == 0)
+  {
+    return physics::ParametricValue();
+  }
+  if ((edge.size() == 1) || (edgeLength == physics::Distance(0.)))
+  {
+    return physics::ParametricValue(0);
+  }
+
+  // The generic implementation takes the first segment as initial result and visits the segments in order,
+  // replacing the result whenever a segment is nearer. Since the comparison of distances considers the
+  // precision of physics::Distance, the result depends on the visiting order of the segments in the vicinity of
+  // the minimal distance. Segments with a distance larger than (minimal distance + 4 * precision) never affect
+  // the outcome, if no segment has a distance within (minimal distance + [2, 4] * precision).
+  // Therefore, first the chunks near to the point are collected and then the generic loop runs on their segments.
+  double const precision = static_cast<double>(physics::Distance::getPrecision());
+
+  std::vector<double> chunkDistance(chunks_.size());
+  std::vector<std::size_t> chunkOrder(chunks_.size());
+  for (std::size_t i = 0u; i < chunks_.size(); ++i)
+  {
+    chunkDistance[i] = std::max(0., distanceToCenter(pt, chunks_[i].center) - chunks_[i].radius);
+    chunkOrder[i] = i;
+  }
+  std::sort(chunkOrder.begin(), chunkOrder.end(), [&chunkDistance](std::size_t const left, std::size_t const right) {
+    return chunkDistance[left] < chunkDistance[right];
+  });
+
+  physics::ParametricValue t_one = findNearestPointOnSegment(pt, edge[0], edge[1]);
+  ECEFPoint pt_nearest = vectorInterpolate(edge[0], edge[1], t_one);
+  physics::Distance d_nearest = distance(pt, pt_nearest);
+  physics::Distance offset_nearest = distance(pt_nearest, edge[0]);
+
+  double minDistance = static_cast<double>(d_nearest);
+  std::vector<SegmentCandidate> candidates;
+  for (auto const chunkIndex : chunkOrder)
+  {
+    if (chunkDistance[chunkIndex] >= minDistance + 5. * precision)
+    {
+      break;
+    }
+    auto const &chunk = chunks_[chunkIndex];
+    for (auto i = std::max(chunk.firstSegment, std::size_t(1u)); i < chunk.endSegment; ++i)
+    {
+      physics::ParametricValue t = findNearestPointOnSegment(pt, edge[i], edge[i + 1]);
+      ECEFPoint pt_candidate = vectorInterpolate(edge[i], edge[i + 1], t);
+      physics::Distance d = distance(pt_candidate, pt);
+      candidates.push_back({i, pt_candidate, d});
+      minDistance = std::min(minDistance, static_cast<double>(d));
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [](SegmentCandidate const &left, SegmentCandidate const &right) {
+    return left.segment < right.segment;
+  });
+
+  double const relevantDistance = minDistance + 2. * precision;
+  for (auto const &candidate : candidates)
+  {
+    double const candidateDistance = static_cast<double>(candidate.distance);
+    if (candidateDistance >= relevantDistance)
+    {
+      if (candidateDistance < relevantDistance + 2. * precision)
+      {
+        // order of the segments might matter
+        return point::findNearestPointOnEdge(edge, edgeLength, pt);
+      }
+      continue;
+    }
+    if (candidate.distance < d_nearest)
+    {
+      pt_nearest = candidate.point;
+      d_nearest = candidate.distance;
+      offset_nearest = running_offset_[candidate.segment] + distance(pt_nearest, edge[candidate.segment]);
+    }
+  }
+  return physics::ParametricValue(offset_nearest / edgeLength);
+}
+
+ECEFPoint EdgeSegmentIndex::getParametricPoint(ECEFEdge const &edge,
+                                               physics::Distance const &edgeLength,
+                                               physics::ParametricValue const &t) const
+{
+  if (!isIndexOf(edge) || edge.empty())
+  {
+    return point::getParametricPoint(edge, edgeLength, t);
+  }
+
+  physics::Distance length_t = edgeLength * t;
+  // the accumulated lengths are increasing, so the first segment reaching length_t can be searched in log(n)
+  auto const endIter = std::lower_bound(para_end_.begin(),
+                                        para_end_.end(),
+                                        length_t,
+                                        [](physics::Distance const &length_1, physics::Distance const &value) {
+                                          return !(length_1 >= value);
+                                        });
+  if (endIter != para_end_.end())
+  {
+    auto const index = static_cast<std::size_t>(endIter - para_end_.begin());
+    auto const segment = para_segments_[index];
+    auto d_t = length_t - para_start_[index];
+    physics::ParametricValue tt(d_t / para_length_[index]);
+    return vectorInterpolate(edge[segment], edge[segment + 1], tt);
+  }
+  return edge.back();
+}
+
+} // namespace point
+} // namespace map
+} // namespace ad
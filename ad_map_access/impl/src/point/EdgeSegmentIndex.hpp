@@ -0,0 +1,104 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "ad/map/point/Types.hpp"
+
+namespace ad {
+namespace map {
+namespace point {
+
+/**
+ * @brief Acceleration structure for the parametric operations on an ECEF edge.
+ *
+ * The segments of the edge are grouped into chunks of consecutive segments with a bounding sphere each.
+ * Together with the cached lengths of the segments this allows answering the queries by touching only
+ * the segments close to the point of interest.
+ * The results are bit-identical to the ones of the generic implementations in EdgeOperation.hpp.
+ */
+class EdgeSegmentIndex
+{
+public: // Constructor/Destructor
+  /**
+   * @brief Constructor.
+   *        Builds the index for the given edge.
+   */
+  explicit EdgeSegmentIndex(ECEFEdge const &edge);
+
+  /**
+   * @brief Destructor.
+   */
+  ~EdgeSegmentIndex() = default;
+
+public: // Operations
+  /**
+   * @brief Finds point on the edge nearest to given point.
+   * @param[in] edge The edge the index was built for.
+   * @param[in] edgeLength The length of the edge.
+   * @param[in] pt Point of interest.
+   * @returns The same as findNearestPointOnEdge(edge, edgeLength, pt).
+   */
+  physics::ParametricValue
+  findNearestPointOnEdge(ECEFEdge const &edge, physics::Distance const &edgeLength, ECEFPoint const &pt) const;
+
+  /**
+   * @brief Calculates parametric point on the edge.
+   * @param[in] edge The edge the index was built for.
+   * @param[in] edgeLength The length of the edge.
+   * @param[in] t Parameter. 0 will return first point, and 1 last point on the edge.
+   * @returns The same as getParametricPoint(edge, edgeLength, t).
+   */
+  ECEFPoint getParametricPoint(ECEFEdge const &edge,
+                               physics::Distance const &edgeLength,
+                               physics::ParametricValue const &t) const;
+
+private: // Types
+  /**
+   * @brief Consecutive segments with their bounding sphere.
+   */
+  struct Chunk
+  {
+    double center[3];
+    double radius;
+    std::size_t firstSegment;
+    std::size_t endSegment;
+  };
+
+  /**
+   * @brief Nearest point of a single segment.
+   */
+  struct SegmentCandidate
+  {
+    std::size_t segment;
+    ECEFPoint point;
+    physics::Distance distance;
+  };
+
+private: // Aux Methods
+  bool isIndexOf(ECEFEdge const &edge) const;
+
+private:                                                // Constants
+  static constexpr std::size_t SEGMENTS_PER_CHUNK = 16u; ///< Maximum number of segments within a chunk.
+
+private:                                          // Data Members
+  bool valid_;                                    ///< All points of the edge are finite.
+  std::size_t point_count_;                       ///< Number of points of the edge.
+  std::vector<physics::Distance> running_offset_; ///< Offset of each segment start along the edge.
+  std::vector<Chunk> chunks_;                     ///< Bounding spheres of consecutive segments.
+  std::vector<std::size_t> para_segments_;        ///< Segments of non-zero length.
+  std::vector<physics::Distance> para_start_;     ///< Offset of each segment of non-zero length.
+  std::vector<physics::Distance> para_end_;       ///< End offset of each segment of non-zero length.
+  std::vector<physics::Distance> para_length_;    ///< Length of each segment of non-zero length.
+};
+
+} // namespace point
+} // namespace map
+} // namespace ad
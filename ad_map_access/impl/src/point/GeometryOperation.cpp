@@ -28,34 +28,40 @@ Geometry createGeometry(const ECEFEdge &points, bool closed)
   return geometry;
 }
 
-ENUEdge getCachedENUEdge(Geometry const &geometry)
+// the geometry is never modified, so concurrent readers don't need any synchronization
+static ENUEdge toENUEdge(Geometry const &geometry, ECEFEdge const &ecefEdge)
 {
+  ENUEdge enuEdge;
   auto coordinateTransform = access::getCoordinateTransform();
-  ENUEdgeCache &mutable_enuEdgeCache = const_cast<Geometry *>(&geometry)->private_enuEdgeCache;
-  if (!coordinateTransform || geometry.private_enuEdgeCache.enuVersion != coordinateTransform->getENURef())
+  if (coordinateTransform)
   {
-    mutable_enuEdgeCache.enuEdge.clear();
-  }
-  if (geometry.private_enuEdgeCache.enuEdge.empty())
-  {
-    if (coordinateTransform)
+    if (coordinateTransform->isENUValid())
     {
-      if (coordinateTransform->isENUValid())
+      if (geometry.isValid)
       {
-        mutable_enuEdgeCache.enuVersion = coordinateTransform->getENURef();
-        coordinateTransform->convert(geometry.ecefEdge, mutable_enuEdgeCache.enuEdge);
+        // the points of a valid geometry don't have to be checked again
+        enuEdge = coordinateTransform->ECEF2ENU(ecefEdge);
       }
       else
       {
-        access::getLogger()->error("Geometry::GetENU: ENU Reference Point not defined.");
+        coordinateTransform->convert(ecefEdge, enuEdge);
       }
     }
     else
     {
-      access::getLogger()->error("Geometry::GetENU: Coordinate transformations not defined.");
+      access::getLogger()->error("Geometry::GetENU: ENU Reference Point not defined.");
     }
   }
-  return geometry.private_enuEdgeCache.enuEdge;
+  else
+  {
+    access::getLogger()->error("Geometry::GetENU: Coordinate transformations not defined.");
+  }
+  return enuEdge;
+}
+
+ENUEdge getENUEdge(Geometry const &geometry)
+{
+  return toENUEdge(geometry, geometry.ecefEdge);
 }
 
 /////////////
@@ -160,7 +166,8 @@ void getParametricRange(Geometry const &geometry,
                         ENUEdge &outputEdge,
                         const bool revertOrder)
 {
-  outputEdge = point::getParametricRange(getCachedENUEdge(geometry), geometry.length, trange);
+  // ECEF to ENU is a rigid transformation, so only the points of the range have to be converted
+  outputEdge = toENUEdge(geometry, point::getParametricRange(geometry.ecefEdge, geometry.length, trange));
   if (revertOrder)
   {
     std::reverse(outputEdge.begin(), outputEdge.end());
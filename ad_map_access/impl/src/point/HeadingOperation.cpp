@@ -12,6 +12,7 @@
 #include <cmath>
 
 #include "ad/map/access/Operation.hpp"
+#include "ad/map/point/CoordinateTransform.hpp"
 #include "ad/map/point/ENUOperation.hpp"
 #include "ad/map/point/Transform.hpp"
 
@@ -31,9 +32,16 @@ ECEFHeading createECEFHeading(ECEFPoint const &start, ECEFPoint const &end)
 
 ECEFHeading createECEFHeading(ENUHeading const &yaw, GeoPoint const &enuReferencePoint)
 {
-  ECEFPoint const start = toECEF(enuReferencePoint);
+  CoordinateTransform coordinateTransform;
+  coordinateTransform.setENUReferencePoint(enuReferencePoint);
+  return createECEFHeading(yaw, coordinateTransform);
+}
+
+ECEFHeading createECEFHeading(ENUHeading const &yaw, CoordinateTransform const &coordinateTransform)
+{
+  ECEFPoint const start = coordinateTransform.ENU2ECEF(createENUPoint(0., 0., 0.));
   ENUPoint const enuEndPoint = getDirectionalVectorZPlane(yaw);
-  ECEFPoint const end = toECEF(enuEndPoint, enuReferencePoint);
+  ECEFPoint const end = coordinateTransform.ENU2ECEF(enuEndPoint);
   return createECEFHeading(start, end);
 }
 
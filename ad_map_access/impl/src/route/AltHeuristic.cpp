@@ -0,0 +1,344 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/route/AltHeuristic.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include "RouteAStarCost.hpp"
+#include "ad/map/access/Logging.hpp"
+#include "ad/map/serialize/SerializerFileCRC32.hpp"
+#include "ad/map/serialize/SerializerMemoryMappedCRC32.hpp"
+
+namespace ad {
+namespace map {
+namespace route {
+namespace planning {
+
+/**
+ * @brief Edge of the relaxed routing graph between the points at start and end of the lanes.
+ */
+struct BorderPointEdge
+{
+  std::size_t to;
+  double cost;
+};
+
+typedef std::vector<std::vector<BorderPointEdge>> BorderPointGraph;
+
+static void addBorderPointEdge(BorderPointGraph &graph, std::size_t const from, std::size_t const to, double const cost)
+{
+  graph[from].push_back({to, cost});
+  graph[to].push_back({from, cost});
+}
+
+static std::size_t findLateralRoot(std::vector<std::size_t> &roots, std::size_t index)
+{
+  while (roots[index] != index)
+  {
+    roots[index] = roots[roots[index]];
+    index = roots[index];
+  }
+  return index;
+}
+
+/**
+ * @brief Calculates the relaxed lane lengths.
+ *
+ * RouteAstar performs lateral lane changes at the current parametric offset, i.e. a route can switch between
+ * lateral neighbors at any position. Giving all lanes connected by lateral contacts the length of the shortest
+ * of them allows to move all lateral lane changes to the start or end of the lanes without increasing the cost.
+ */
+static std::vector<double> calcRelaxedLengths(lane::LaneGraph const &laneGraph)
+{
+  std::vector<std::size_t> roots(laneGraph.size());
+  for (std::size_t index = 0u; index < roots.size(); ++index)
+  {
+    roots[index] = index;
+  }
+  for (lane::LaneGraph::NodeIndex index = 0u; index < laneGraph.size(); ++index)
+  {
+    auto const &node = laneGraph.getNode(index);
+    for (auto const &edge : laneGraph.getEdges(node, lane::LaneGraph::RightEdges, lane::LaneGraph::LeftEdges))
+    {
+      if (edge.node != lane::LaneGraph::cInvalidNodeIndex)
+      {
+        roots[findLateralRoot(roots, edge.node)] = findLateralRoot(roots, index);
+      }
+    }
+  }
+
+  std::vector<double> rootLengths(laneGraph.size(), std::numeric_limits<double>::infinity());
+  for (lane::LaneGraph::NodeIndex index = 0u; index < laneGraph.size(); ++index)
+  {
+    auto const &node = laneGraph.getNode(index);
+    if (node.length.isValid())
+    {
+      auto &rootLength = rootLengths[findLateralRoot(roots, index)];
+      rootLength = std::min(rootLength, static_cast<double>(node.length));
+    }
+  }
+
+  std::vector<double> lengths(laneGraph.size(), -1.);
+  for (lane::LaneGraph::NodeIndex index = 0u; index < laneGraph.size(); ++index)
+  {
+    if (laneGraph.getNode(index).length.isValid())
+    {
+      lengths[index] = rootLengths[findLateralRoot(roots, index)];
+    }
+  }
+  return lengths;
+}
+
+/**
+ * @brief Creates the relaxed undirected graph of the points at start (2 * node index) and end
+ *        (2 * node index + 1) of the lanes, containing all transitions RouteAstar is able to perform.
+ */
+static BorderPointGraph createBorderPointGraph(lane::LaneGraph const &laneGraph, std::vector<double> const &lengths)
+{
+  BorderPointGraph graph(2u * laneGraph.size());
+  for (lane::LaneGraph::NodeIndex index = 0u; index < laneGraph.size(); ++index)
+  {
+    auto const &node = laneGraph.getNode(index);
+    std::size_t const start = 2u * index;
+    std::size_t const end = start + 1u;
+    if (lengths[index] >= 0.)
+    {
+      addBorderPointEdge(graph, start, end, lengths[index]);
+    }
+    for (auto const group : {lane::LaneGraph::SuccessorEdges, lane::LaneGraph::PredecessorEdges})
+    {
+      std::size_t const from = (group == lane::LaneGraph::SuccessorEdges) ? end : start;
+      for (auto const &edge : laneGraph.getEdges(node, group))
+      {
+        if (edge.node == lane::LaneGraph::cInvalidNodeIndex)
+        {
+          continue;
+        }
+        if (edge.reverseLocation == lane::ContactLocation::SUCCESSOR)
+        {
+          addBorderPointEdge(graph, from, 2u * edge.node + 1u, static_cast<double>(COST_LONGITUDINAL));
+        }
+        else if (edge.reverseLocation == lane::ContactLocation::PREDECESSOR)
+        {
+          addBorderPointEdge(graph, from, 2u * edge.node, static_cast<double>(COST_LONGITUDINAL));
+        }
+      }
+    }
+    for (auto const &edge : laneGraph.getEdges(node, lane::LaneGraph::RightEdges, lane::LaneGraph::LeftEdges))
+    {
+      if (edge.node != lane::LaneGraph::cInvalidNodeIndex)
+      {
+        addBorderPointEdge(graph, start, 2u * edge.node, static_cast<double>(COST_LATERAL));
+        addBorderPointEdge(graph, end, 2u * edge.node + 1u, static_cast<double>(COST_LATERAL));
+      }
+    }
+  }
+  return graph;
+}
+
+/**
+ * @brief Calculates the costs from the given point to all points of the graph, -1 if not connected.
+ */
+static std::vector<double> calcBorderPointCosts(BorderPointGraph const &graph, std::size_t const source)
+{
+  std::vector<double> costs(graph.size(), -1.);
+  typedef std::pair<double, std::size_t> QueueEntry;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+  std::vector<double> tentativeCosts(graph.size(), std::numeric_limits<double>::infinity());
+  tentativeCosts[source] = 0.;
+  queue.push({0., source});
+  while (!queue.empty())
+  {
+    auto const entry = queue.top();
+    queue.pop();
+    if (costs[entry.second] >= 0.)
+    {
+      continue;
+    }
+    costs[entry.second] = entry.first;
+    for (auto const &edge : graph[entry.second])
+    {
+      double const cost = entry.first + edge.cost;
+      if (cost < tentativeCosts[edge.to])
+      {
+        tentativeCosts[edge.to] = cost;
+        queue.push({cost, edge.to});
+      }
+    }
+  }
+  return costs;
+}
+
+bool AltHeuristic::build(lane::LaneGraph const &laneGraph, std::size_t const landmarkCount)
+{
+  landmarkCount_ = 0u;
+  landmarks_.clear();
+  costs_.clear();
+  lengths_.clear();
+  fingerprint_ = laneGraph.getFingerprint();
+  if ((laneGraph.size() == 0u) || (landmarkCount == 0u))
+  {
+    access::getLogger()->warn("AltHeuristic::build: no lanes or landmarks");
+    return false;
+  }
+
+  lengths_ = calcRelaxedLengths(laneGraph);
+  auto const graph = createBorderPointGraph(laneGraph, lengths_);
+
+  // Landmarks far away from each other provide the best lower bounds. Therefore, the first landmark is the point
+  // farthest away from an arbitrary start and the following ones are the points farthest away from all landmarks
+  // selected before. Points not connected to any landmark yet are preferred to cover all components of the graph.
+  std::vector<double> minCosts(graph.size(), std::numeric_limits<double>::infinity());
+  auto const initialCosts = calcBorderPointCosts(graph, 0u);
+  std::size_t nextLandmark = static_cast<std::size_t>(std::max_element(initialCosts.begin(), initialCosts.end())
+                                                      - initialCosts.begin());
+  std::vector<std::vector<double>> landmarkCosts;
+  while (landmarkCosts.size() < landmarkCount)
+  {
+    landmarks_.push_back(nextLandmark);
+    landmarkCosts.push_back(calcBorderPointCosts(graph, nextLandmark));
+    for (std::size_t i = 0u; i < graph.size(); ++i)
+    {
+      if (landmarkCosts.back()[i] >= 0.)
+      {
+        minCosts[i] = std::min(minCosts[i], landmarkCosts.back()[i]);
+      }
+    }
+    nextLandmark = static_cast<std::size_t>(std::max_element(minCosts.begin(), minCosts.end()) - minCosts.begin());
+    if (minCosts[nextLandmark] <= 0.)
+    {
+      // all points are landmarks already
+      break;
+    }
+  }
+
+  landmarkCount_ = landmarkCosts.size();
+  costs_.resize(graph.size() * landmarkCount_);
+  for (std::size_t i = 0u; i < graph.size(); ++i)
+  {
+    for (std::size_t landmark = 0u; landmark < landmarkCount_; ++landmark)
+    {
+      costs_[i * landmarkCount_ + landmark] = landmarkCosts[landmark][i];
+    }
+  }
+  return true;
+}
+
+bool AltHeuristic::serialize(serialize::ISerializer &serializer)
+{
+  return serializer.serialize(serialize::SerializeableMagic::AltHeuristic) && serializer.serialize(landmarkCount_)
+    && serializer.serialize(fingerprint_) && serializer.serializeVector(landmarks_)
+    && serializer.serializeVector(costs_) && serializer.serializeVector(lengths_);
+}
+
+bool AltHeuristic::save(std::string const &fileName)
+{
+  if (!isValid())
+  {
+    access::getLogger()->error("AltHeuristic::save: no landmark tables to save {}", fileName);
+    return false;
+  }
+  serialize::SerializerFileCRC32 serializer(true);
+  size_t version_major = 0;
+  size_t version_minor = 0;
+  if (!serializer.open(fileName, version_major, version_minor))
+  {
+    access::getLogger()->error("AltHeuristic::save: unable to open file for writing {}", fileName);
+    return false;
+  }
+  bool ok = serialize(serializer);
+  ok = serializer.close() && ok;
+  if (!ok)
+  {
+    access::getLogger()->error("AltHeuristic::save: unable to write file {}", fileName);
+  }
+  return ok;
+}
+
+bool AltHeuristic::load(std::string const &fileName)
+{
+  landmarkCount_ = 0u;
+  landmarks_.clear();
+  costs_.clear();
+  lengths_.clear();
+  serialize::SerializerMemoryMappedCRC32 serializer;
+  size_t version_major = 0;
+  size_t version_minor = 0;
+  if (!serializer.open(fileName, version_major, version_minor))
+  {
+    access::getLogger()->warn("AltHeuristic::load: unable to open file for reading {}", fileName);
+    return false;
+  }
+  bool ok = serialize(serializer);
+  ok = serializer.close() && ok;
+  ok = ok && (landmarks_.size() == landmarkCount_) && (landmarkCount_ > 0u)
+    && (costs_.size() == 2u * lengths_.size() * landmarkCount_);
+  if (!ok)
+  {
+    access::getLogger()->warn("AltHeuristic::load: file is corrupt {}", fileName);
+    landmarkCount_ = 0u;
+    landmarks_.clear();
+    costs_.clear();
+    lengths_.clear();
+  }
+  return ok;
+}
+
+std::string AltHeuristic::getFileName(std::string const &mapFileName)
+{
+  return mapFileName + ".alt";
+}
+
+bool AltHeuristic::isValidFor(lane::LaneGraph const &laneGraph) const
+{
+  return isValid() && (lengths_.size() == laneGraph.size())
+    && (fingerprint_ == laneGraph.getFingerprint());
+}
+
+std::vector<double> AltHeuristic::getDestinationCosts(lane::LaneGraph const &laneGraph,
+                                                      point::ParaPoint const &destination) const
+{
+  std::vector<double> destinationCosts(landmarkCount_, -1.);
+  auto const index = laneGraph.findNode(destination.laneId);
+  if (index == lane::LaneGraph::cInvalidNodeIndex)
+  {
+    return destinationCosts;
+  }
+  if (lengths_[index] < 0.)
+  {
+    return destinationCosts;
+  }
+  double const offset = static_cast<double>(destination.parametricOffset);
+  double const length = lengths_[index];
+  auto const startCosts = costs_.data() + (2u * index) * landmarkCount_;
+  auto const endCosts = startCosts + landmarkCount_;
+  for (std::size_t i = 0u; i < landmarkCount_; ++i)
+  {
+    if (startCosts[i] >= 0.)
+    {
+      destinationCosts[i] = startCosts[i] + offset * length;
+    }
+    if (endCosts[i] >= 0.)
+    {
+      double const endCost = endCosts[i] + (1. - offset) * length;
+      if ((destinationCosts[i] < 0.) || (endCost < destinationCosts[i]))
+      {
+        destinationCosts[i] = endCost;
+      }
+    }
+  }
+  return destinationCosts;
+}
+
+} // namespace planning
+} // namespace route
+} // namespace map
+} // namespace ad
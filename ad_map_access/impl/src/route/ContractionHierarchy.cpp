@@ -0,0 +1,662 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/route/ContractionHierarchy.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+#include "RouteAStarCost.hpp"
+#include "ad/map/access/Logging.hpp"
+#include "ad/map/serialize/SerializerFileCRC32.hpp"
+#include "ad/map/serialize/SerializerMemoryMappedCRC32.hpp"
+
+namespace ad {
+namespace map {
+namespace route {
+namespace planning {
+
+constexpr ContractionHierarchy::NodeIndex ContractionHierarchy::cInvalidNodeIndex;
+
+typedef ContractionHierarchy::NodeIndex NodeIndex;
+typedef ContractionHierarchy::Edge Edge;
+
+//! maximal number of nodes settled by a single witness search
+static std::size_t const WITNESS_SEARCH_SETTLE_LIMIT = 500u;
+
+/**
+ * @brief The graph while the nodes are contracted.
+ */
+struct ContractionGraph
+{
+  std::vector<std::vector<Edge>> outgoing;   ///< Outgoing edges of each node, Edge::node is the target.
+  std::vector<std::vector<Edge>> incoming;   ///< Incoming edges of each node, Edge::node is the source.
+  std::vector<bool> contracted;              ///< Flag for each node if it is already contracted.
+  std::vector<uint32_t> contractedNeighbors; ///< Number of contracted neighbors of each node.
+};
+
+static void addContractionEdge(
+  ContractionGraph &graph, NodeIndex const source, NodeIndex const target, NodeIndex const middle, double const cost)
+{
+  if (source == target)
+  {
+    return;
+  }
+  // keep only the cheapest edge between two nodes
+  for (auto &edge : graph.outgoing[source])
+  {
+    if (edge.node == target)
+    {
+      if (cost < edge.cost)
+      {
+        edge.cost = cost;
+        edge.middle = middle;
+        for (auto &reverseEdge : graph.incoming[target])
+        {
+          if (reverseEdge.node == source)
+          {
+            reverseEdge.cost = cost;
+            reverseEdge.middle = middle;
+          }
+        }
+      }
+      return;
+    }
+  }
+  graph.outgoing[source].push_back({target, middle, cost});
+  graph.incoming[target].push_back({source, middle, cost});
+}
+
+static void removeEdges(std::vector<Edge> &edges, NodeIndex const node)
+{
+  edges.erase(std::remove_if(edges.begin(), edges.end(), [node](Edge const &edge) { return edge.node == node; }),
+              edges.end());
+}
+
+static bool isPositiveMovement(lane::LaneGraph::Node const &lane, RoutingDirection const direction)
+{
+  return lane.positive && (direction != RoutingDirection::NEGATIVE);
+}
+
+static bool isNegativeMovement(lane::LaneGraph::Node const &lane, RoutingDirection const direction)
+{
+  return lane.negative && (direction != RoutingDirection::POSITIVE);
+}
+
+/**
+ * @brief Adds the transitions of RouteAstar starting at the given routing point at the start or end of a lane.
+ *
+ * This follows the rules of RouteExpander for routes of type Route::Type::SHORTEST.
+ */
+static void addRoutingEdges(ContractionGraph &graph,
+                            lane::LaneGraph const &laneGraph,
+                            lane::LaneGraph::NodeIndex const laneIndex,
+                            bool const atLaneEnd,
+                            RoutingDirection const direction)
+{
+  auto const &lane = laneGraph.getNode(laneIndex);
+  if (!lane.routeable || !lane.length.isValid())
+  {
+    return;
+  }
+  auto const source = ContractionHierarchy::getNodeIndex(laneIndex, atLaneEnd, direction);
+
+  // same lane neighbor
+  if ((!atLaneEnd && isPositiveMovement(lane, direction)) || (atLaneEnd && isNegativeMovement(lane, direction)))
+  {
+    addContractionEdge(graph,
+                       source,
+                       ContractionHierarchy::getNodeIndex(laneIndex, !atLaneEnd, direction),
+                       ContractionHierarchy::cInvalidNodeIndex,
+                       static_cast<double>(lane.length));
+  }
+
+  // longitudinal neighbors
+  lane::LaneGraph::EdgeRange contactLanes{nullptr, nullptr};
+  if (atLaneEnd && isPositiveMovement(lane, direction))
+  {
+    contactLanes = laneGraph.getEdges(lane, lane::LaneGraph::SuccessorEdges);
+  }
+  else if (!atLaneEnd && isNegativeMovement(lane, direction))
+  {
+    contactLanes = laneGraph.getEdges(lane, lane::LaneGraph::PredecessorEdges);
+  }
+  for (auto const &contactLane : contactLanes)
+  {
+    if ((contactLane.node == lane::LaneGraph::cInvalidNodeIndex) || !laneGraph.getNode(contactLane.node).routeable)
+    {
+      continue;
+    }
+    if (contactLane.reverseLocation == lane::ContactLocation::SUCCESSOR)
+    {
+      addContractionEdge(
+        graph,
+        source,
+        ContractionHierarchy::getNodeIndex(
+          contactLane.node,
+          true,
+          (direction == RoutingDirection::DONT_CARE) ? RoutingDirection::DONT_CARE : RoutingDirection::NEGATIVE),
+        ContractionHierarchy::cInvalidNodeIndex,
+        static_cast<double>(COST_LONGITUDINAL));
+    }
+    else if (contactLane.reverseLocation == lane::ContactLocation::PREDECESSOR)
+    {
+      addContractionEdge(
+        graph,
+        source,
+        ContractionHierarchy::getNodeIndex(
+          contactLane.node,
+          false,
+          (direction == RoutingDirection::DONT_CARE) ? RoutingDirection::DONT_CARE : RoutingDirection::POSITIVE),
+        ContractionHierarchy::cInvalidNodeIndex,
+        static_cast<double>(COST_LONGITUDINAL));
+    }
+  }
+
+  // lateral neighbors
+  if (lane.type != lane::LaneType::INTERSECTION)
+  {
+    for (auto const &contactLane : laneGraph.getEdges(lane, lane::LaneGraph::RightEdges, lane::LaneGraph::LeftEdges))
+    {
+      if (contactLane.node == lane::LaneGraph::cInvalidNodeIndex)
+      {
+        continue;
+      }
+      auto const &otherLane = laneGraph.getNode(contactLane.node);
+      if (otherLane.routeable && (lane.direction == otherLane.direction))
+      {
+        addContractionEdge(graph,
+                           source,
+                           ContractionHierarchy::getNodeIndex(contactLane.node, atLaneEnd, direction),
+                           ContractionHierarchy::cInvalidNodeIndex,
+                           static_cast<double>(COST_LATERAL));
+      }
+    }
+  }
+}
+
+/**
+ * @brief Bounded Dijkstra search on the nodes not contracted yet, used to find witness paths.
+ *
+ * A witness path is a path between two neighbors of the node to be contracted, which doesn't pass this node
+ * and is not more expensive than the path via this node. If a witness exists, no shortcut is required.
+ */
+class WitnessSearch
+{
+public:
+  explicit WitnessSearch(std::size_t const nodeCount)
+    : mCosts(nodeCount, std::numeric_limits<double>::infinity())
+  {
+  }
+
+  void run(ContractionGraph const &graph, NodeIndex const source, NodeIndex const ignoredNode, double const maximumCost)
+  {
+    for (auto const node : mTouchedNodes)
+    {
+      mCosts[node] = std::numeric_limits<double>::infinity();
+    }
+    mTouchedNodes.clear();
+
+    typedef std::pair<double, NodeIndex> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    mCosts[source] = 0.;
+    mTouchedNodes.push_back(source);
+    queue.push({0., source});
+    std::size_t settledNodes = 0u;
+    while (!queue.empty() && (settledNodes < WITNESS_SEARCH_SETTLE_LIMIT))
+    {
+      auto const entry = queue.top();
+      queue.pop();
+      if (entry.first > maximumCost)
+      {
+        break;
+      }
+      if (entry.first > mCosts[entry.second])
+      {
+        continue;
+      }
+      settledNodes++;
+      for (auto const &edge : graph.outgoing[entry.second])
+      {
+        if (graph.contracted[edge.node] || (edge.node == ignoredNode))
+        {
+          continue;
+        }
+        double const cost = entry.first + edge.cost;
+        if (cost < mCosts[edge.node])
+        {
+          if (std::isinf(mCosts[edge.node]))
+          {
+            mTouchedNodes.push_back(edge.node);
+          }
+          mCosts[edge.node] = cost;
+          queue.push({cost, edge.node});
+        }
+      }
+    }
+  }
+
+  double getCost(NodeIndex const node) const
+  {
+    return mCosts[node];
+  }
+
+private:
+  std::vector<double> mCosts;
+  std::vector<NodeIndex> mTouchedNodes;
+};
+
+/**
+ * @brief Contracts a node or simulates its contraction.
+ * @returns the number of shortcuts (to be) added.
+ */
+static std::size_t
+contractNode(ContractionGraph &graph, WitnessSearch &witnessSearch, NodeIndex const node, bool const simulate)
+{
+  std::vector<std::pair<NodeIndex, Edge>> shortcuts;
+  double maximumOutgoingCost = 0.;
+  for (auto const &outgoingEdge : graph.outgoing[node])
+  {
+    if (!graph.contracted[outgoingEdge.node])
+    {
+      maximumOutgoingCost = std::max(maximumOutgoingCost, outgoingEdge.cost);
+    }
+  }
+  for (auto const &incomingEdge : graph.incoming[node])
+  {
+    if (graph.contracted[incomingEdge.node])
+    {
+      continue;
+    }
+    witnessSearch.run(graph, incomingEdge.node, node, incomingEdge.cost + maximumOutgoingCost);
+    for (auto const &outgoingEdge : graph.outgoing[node])
+    {
+      if (graph.contracted[outgoingEdge.node] || (outgoingEdge.node == incomingEdge.node))
+      {
+        continue;
+      }
+      double const cost = incomingEdge.cost + outgoingEdge.cost;
+      if (witnessSearch.getCost(outgoingEdge.node) > cost)
+      {
+        shortcuts.push_back({incomingEdge.node, Edge{outgoingEdge.node, node, cost}});
+      }
+    }
+  }
+  if (!simulate)
+  {
+    for (auto const &shortcut : shortcuts)
+    {
+      addContractionEdge(graph, shortcut.first, shortcut.second.node, shortcut.second.middle, shortcut.second.cost);
+    }
+  }
+  return shortcuts.size();
+}
+
+static int64_t calcContractionPriority(ContractionGraph &graph, WitnessSearch &witnessSearch, NodeIndex const node)
+{
+  // prefer nodes whose contraction reduces the number of edges and which are located in sparsely contracted regions
+  int64_t removedEdges = 0;
+  for (auto const &edge : graph.outgoing[node])
+  {
+    removedEdges += graph.contracted[edge.node] ? 0 : 1;
+  }
+  for (auto const &edge : graph.incoming[node])
+  {
+    removedEdges += graph.contracted[edge.node] ? 0 : 1;
+  }
+  auto const shortcuts = static_cast<int64_t>(contractNode(graph, witnessSearch, node, true));
+  return shortcuts - removedEdges + static_cast<int64_t>(graph.contractedNeighbors[node]);
+}
+
+bool ContractionHierarchy::build(lane::LaneGraph const &laneGraph)
+{
+  fingerprint_ = laneGraph.getFingerprint();
+  rank_.clear();
+  upwardEdgeBegin_.clear();
+  upwardEdges_.clear();
+  downwardEdgeBegin_.clear();
+  downwardEdges_.clear();
+  if (laneGraph.size() == 0u)
+  {
+    access::getLogger()->warn("ContractionHierarchy::build: no lanes");
+    return false;
+  }
+
+  std::size_t const nodeCount = 6u * laneGraph.size();
+  ContractionGraph graph;
+  graph.outgoing.resize(nodeCount);
+  graph.incoming.resize(nodeCount);
+  graph.contracted.resize(nodeCount, false);
+  graph.contractedNeighbors.resize(nodeCount, 0u);
+  for (lane::LaneGraph::NodeIndex laneIndex = 0u; laneIndex < laneGraph.size(); ++laneIndex)
+  {
+    for (auto const atLaneEnd : {false, true})
+    {
+      for (auto const direction : {RoutingDirection::DONT_CARE, RoutingDirection::POSITIVE, RoutingDirection::NEGATIVE})
+      {
+        addRoutingEdges(graph, laneGraph, laneIndex, atLaneEnd, direction);
+      }
+    }
+  }
+
+  WitnessSearch witnessSearch(nodeCount);
+  typedef std::pair<int64_t, NodeIndex> QueueEntry;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+  for (NodeIndex node = 0u; node < nodeCount; ++node)
+  {
+    queue.push({calcContractionPriority(graph, witnessSearch, node), node});
+  }
+
+  std::vector<std::vector<Edge>> upwardEdges(nodeCount);
+  std::vector<std::vector<Edge>> downwardEdges(nodeCount);
+  rank_.resize(nodeCount);
+  uint32_t rank = 0u;
+  while (!queue.empty())
+  {
+    auto const node = queue.top().second;
+    queue.pop();
+    if (graph.contracted[node])
+    {
+      continue;
+    }
+    // lazy update: the priority might have changed by the contraction of other nodes
+    auto const priority = calcContractionPriority(graph, witnessSearch, node);
+    if (!queue.empty() && (priority > queue.top().first))
+    {
+      queue.push({priority, node});
+      continue;
+    }
+
+    rank_[node] = rank++;
+    for (auto const &edge : graph.outgoing[node])
+    {
+      if (!graph.contracted[edge.node])
+      {
+        upwardEdges[node].push_back(edge);
+      }
+    }
+    for (auto const &edge : graph.incoming[node])
+    {
+      if (!graph.contracted[edge.node])
+      {
+        downwardEdges[node].push_back(edge);
+      }
+    }
+    contractNode(graph, witnessSearch, node, false);
+    graph.contracted[node] = true;
+
+    // the edges of the contracted node are not required anymore by its neighbors
+    for (auto const &edge : graph.outgoing[node])
+    {
+      removeEdges(graph.incoming[edge.node], node);
+      graph.contractedNeighbors[edge.node]++;
+    }
+    for (auto const &edge : graph.incoming[node])
+    {
+      removeEdges(graph.outgoing[edge.node], node);
+      graph.contractedNeighbors[edge.node]++;
+    }
+    graph.outgoing[node].clear();
+    graph.incoming[node].clear();
+  }
+
+  upwardEdgeBegin_.reserve(nodeCount + 1u);
+  downwardEdgeBegin_.reserve(nodeCount + 1u);
+  for (NodeIndex node = 0u; node < nodeCount; ++node)
+  {
+    upwardEdgeBegin_.push_back(static_cast<uint32_t>(upwardEdges_.size()));
+    upwardEdges_.insert(upwardEdges_.end(), upwardEdges[node].begin(), upwardEdges[node].end());
+    downwardEdgeBegin_.push_back(static_cast<uint32_t>(downwardEdges_.size()));
+    downwardEdges_.insert(downwardEdges_.end(), downwardEdges[node].begin(), downwardEdges[node].end());
+  }
+  upwardEdgeBegin_.push_back(static_cast<uint32_t>(upwardEdges_.size()));
+  downwardEdgeBegin_.push_back(static_cast<uint32_t>(downwardEdges_.size()));
+  return true;
+}
+
+static bool doSerialize(serialize::ISerializer &serializer, Edge &edge)
+{
+  return serializer.serialize(edge.node) && serializer.serialize(edge.middle) && serializer.serialize(edge.cost);
+}
+
+bool ContractionHierarchy::serialize(serialize::ISerializer &serializer)
+{
+  return serializer.serialize(serialize::SerializeableMagic::ContractionHierarchy)
+    && serializer.serialize(fingerprint_) && serializer.serializeVector(rank_)
+    && serializer.serializeVector(upwardEdgeBegin_) && serializer.serializeObjectVector(upwardEdges_)
+    && serializer.serializeVector(downwardEdgeBegin_) && serializer.serializeObjectVector(downwardEdges_);
+}
+
+bool ContractionHierarchy::save(std::string const &fileName)
+{
+  if (!isValid())
+  {
+    access::getLogger()->error("ContractionHierarchy::save: no hierarchy to save {}", fileName);
+    return false;
+  }
+  serialize::SerializerFileCRC32 serializer(true);
+  size_t version_major = 0;
+  size_t version_minor = 0;
+  if (!serializer.open(fileName, version_major, version_minor))
+  {
+    access::getLogger()->error("ContractionHierarchy::save: unable to open file for writing {}", fileName);
+    return false;
+  }
+  bool ok = serialize(serializer);
+  ok = serializer.close() && ok;
+  if (!ok)
+  {
+    access::getLogger()->error("ContractionHierarchy::save: unable to write file {}", fileName);
+  }
+  return ok;
+}
+
+bool ContractionHierarchy::load(std::string const &fileName)
+{
+  serialize::SerializerMemoryMappedCRC32 serializer;
+  size_t version_major = 0;
+  size_t version_minor = 0;
+  bool ok = serializer.open(fileName, version_major, version_minor);
+  if (!ok)
+  {
+    access::getLogger()->warn("ContractionHierarchy::load: unable to open file for reading {}", fileName);
+  }
+  else
+  {
+    ok = serialize(serializer);
+    ok = serializer.close() && ok;
+    ok = ok && (rank_.size() % 6u == 0u) && (upwardEdgeBegin_.size() == rank_.size() + 1u)
+      && (downwardEdgeBegin_.size() == rank_.size() + 1u) && (upwardEdgeBegin_.back() == upwardEdges_.size())
+      && (downwardEdgeBegin_.back() == downwardEdges_.size());
+    for (auto const &edges : {std::cref(upwardEdges_), std::cref(downwardEdges_)})
+    {
+      for (auto const &edge : edges.get())
+      {
+        ok = ok && (edge.node < rank_.size()) && ((edge.middle < rank_.size()) || (edge.middle == cInvalidNodeIndex));
+      }
+    }
+    if (!ok)
+    {
+      access::getLogger()->warn("ContractionHierarchy::load: file is corrupt {}", fileName);
+    }
+  }
+  if (!ok)
+  {
+    rank_.clear();
+    upwardEdgeBegin_.clear();
+    upwardEdges_.clear();
+    downwardEdgeBegin_.clear();
+    downwardEdges_.clear();
+  }
+  return ok;
+}
+
+std::string ContractionHierarchy::getFileName(std::string const &mapFileName)
+{
+  return mapFileName + ".ch";
+}
+
+bool ContractionHierarchy::isValidFor(lane::LaneGraph const &laneGraph) const
+{
+  return isValid() && (rank_.size() == 6u * laneGraph.size()) && (fingerprint_ == laneGraph.getFingerprint());
+}
+
+Edge const &ContractionHierarchy::findEdge(NodeIndex const source, NodeIndex const target) const
+{
+  if (rank_[target] > rank_[source])
+  {
+    for (auto index = upwardEdgeBegin_[source]; index < upwardEdgeBegin_[source + 1u]; ++index)
+    {
+      if (upwardEdges_[index].node == target)
+      {
+        return upwardEdges_[index];
+      }
+    }
+  }
+  else
+  {
+    for (auto index = downwardEdgeBegin_[target]; index < downwardEdgeBegin_[target + 1u]; ++index)
+    {
+      if (downwardEdges_[index].node == source)
+      {
+        return downwardEdges_[index];
+      }
+    }
+  }
+  throw std::runtime_error("ContractionHierarchy: edge of shortcut not found");
+}
+
+void ContractionHierarchy::unpackEdge(NodeIndex const source,
+                                      NodeIndex const target,
+                                      std::vector<NodeIndex> &path) const
+{
+  auto const &edge = findEdge(source, target);
+  if (edge.middle == cInvalidNodeIndex)
+  {
+    path.push_back(target);
+  }
+  else
+  {
+    unpackEdge(source, edge.middle, path);
+    unpackEdge(edge.middle, target, path);
+  }
+}
+
+/**
+ * @brief State of one direction of the bidirectional search.
+ */
+struct HierarchySearch
+{
+  typedef std::pair<double, NodeIndex> QueueEntry;
+
+  struct Label
+  {
+    double cost;
+    NodeIndex parent;
+  };
+
+  explicit HierarchySearch(std::vector<ContractionHierarchy::SearchSeed> const &seeds)
+  {
+    for (auto const &seed : seeds)
+    {
+      auto insertResult = labels.insert({seed.node, Label{seed.cost, ContractionHierarchy::cInvalidNodeIndex}});
+      if (insertResult.second || (seed.cost < insertResult.first->second.cost))
+      {
+        insertResult.first->second.cost = seed.cost;
+        queue.push({seed.cost, seed.node});
+      }
+    }
+  }
+
+  double getMinimumCost() const
+  {
+    return queue.empty() ? std::numeric_limits<double>::infinity() : queue.top().first;
+  }
+
+  std::unordered_map<NodeIndex, Label> labels;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+};
+
+double ContractionHierarchy::findPath(std::vector<SearchSeed> const &sources,
+                                      std::vector<SearchSeed> const &targets,
+                                      double const maximumCost,
+                                      std::vector<NodeIndex> &path) const
+{
+  path.clear();
+  if (!isValid())
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  // both searches only follow edges to nodes of higher rank, the backward search on the reversed edges
+  HierarchySearch forward(sources);
+  HierarchySearch backward(targets);
+  double bestCost = maximumCost;
+  NodeIndex meetingNode = cInvalidNodeIndex;
+  while (std::min(forward.getMinimumCost(), backward.getMinimumCost()) < bestCost)
+  {
+    bool const isForward = forward.getMinimumCost() <= backward.getMinimumCost();
+    auto &search = isForward ? forward : backward;
+    auto const &otherSearch = isForward ? backward : forward;
+    auto const entry = search.queue.top();
+    search.queue.pop();
+    if (entry.first > search.labels[entry.second].cost)
+    {
+      continue;
+    }
+    auto const otherLabel = otherSearch.labels.find(entry.second);
+    if ((otherLabel != otherSearch.labels.end()) && (entry.first + otherLabel->second.cost < bestCost))
+    {
+      bestCost = entry.first + otherLabel->second.cost;
+      meetingNode = entry.second;
+    }
+    auto const &edgeBegin = isForward ? upwardEdgeBegin_ : downwardEdgeBegin_;
+    auto const &edges = isForward ? upwardEdges_ : downwardEdges_;
+    for (auto index = edgeBegin[entry.second]; index < edgeBegin[entry.second + 1u]; ++index)
+    {
+      auto const &edge = edges[index];
+      double const cost = entry.first + edge.cost;
+      auto insertResult = search.labels.insert({edge.node, HierarchySearch::Label{cost, entry.second}});
+      if (insertResult.second || (cost < insertResult.first->second.cost))
+      {
+        insertResult.first->second = HierarchySearch::Label{cost, entry.second};
+        search.queue.push({cost, edge.node});
+      }
+    }
+  }
+
+  if (meetingNode == cInvalidNodeIndex)
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  std::vector<NodeIndex> forwardNodes;
+  for (auto node = meetingNode; node != cInvalidNodeIndex; node = forward.labels[node].parent)
+  {
+    forwardNodes.push_back(node);
+  }
+  std::reverse(forwardNodes.begin(), forwardNodes.end());
+  path.push_back(forwardNodes.front());
+  for (std::size_t i = 1u; i < forwardNodes.size(); ++i)
+  {
+    unpackEdge(forwardNodes[i - 1u], forwardNodes[i], path);
+  }
+  for (auto node = meetingNode; backward.labels[node].parent != cInvalidNodeIndex; node = backward.labels[node].parent)
+  {
+    unpackEdge(node, backward.labels[node].parent, path);
+  }
+  return bestCost;
+}
+
+} // namespace planning
+} // namespace route
+} // namespace map
+} // namespace ad
@@ -103,6 +103,7 @@ physics::ParametricValue getProjectedParametricOffsetOnNeighborLane(LaneInterval
                                                                     LaneInterval const &neighborInterval,
                                                                     physics::ParametricValue const &parametricOffset)
 {
+  access::QueryScope queryScope;
   if (!lane::isSameOrDirectNeighbor(currentInterval.laneId, neighborInterval.laneId))
   {
     throw std::invalid_argument("ad::map::route::getProjectedParametricOffsetOnNeighborLane: lanes are not neighbors");
@@ -114,8 +115,8 @@ physics::ParametricValue getProjectedParametricOffsetOnNeighborLane(LaneInterval
   }
 
   // real neighbors
-  auto currentLane = lane::getLane(currentInterval.laneId);
-  auto neighborLane = lane::getLane(neighborInterval.laneId);
+  auto const &currentLane = lane::getLane(currentInterval.laneId);
+  auto const &neighborLane = lane::getLane(neighborInterval.laneId);
   auto leftNeighbors = lane::getContactLanes(currentLane, lane::ContactLocation::LEFT);
   auto rightNeighbors = lane::getContactLanes(currentLane, lane::ContactLocation::RIGHT);
 
@@ -146,14 +147,16 @@ physics::ParametricValue getProjectedParametricOffsetOnNeighborLane(LaneInterval
 
 physics::Distance calcLength(LaneInterval const &laneInterval)
 {
-  auto currentLane = lane::getLane(laneInterval.laneId);
+  access::QueryScope queryScope;
+  auto const &currentLane = lane::getLane(laneInterval.laneId);
   auto const resultDistance = currentLane.length * calcParametricLength(laneInterval);
   return resultDistance;
 }
 
 physics::Duration calcDuration(LaneInterval const &laneInterval)
 {
-  auto currentLane = lane::getLane(laneInterval.laneId);
+  access::QueryScope queryScope;
+  auto const &currentLane = lane::getLane(laneInterval.laneId);
   return lane::getDuration(currentLane, toParametricRange(laneInterval));
 }
 
@@ -165,7 +168,7 @@ enum class EdgeType
 
 template <typename LaneEdge> void getEdge(LaneInterval const &laneInterval, EdgeType edgeType, LaneEdge &outputEdge)
 {
-  auto currentLane = lane::getLane(laneInterval.laneId);
+  auto const &currentLane = lane::getLane(laneInterval.laneId);
 
   auto range = toParametricRange(laneInterval);
 
@@ -267,9 +270,10 @@ point::GeoEdge getLeftGeoEdge(LaneInterval const &laneInterval)
 
 point::ENUEdge getLeftProjectedENUEdge(LaneInterval const &laneInterval)
 {
+  access::QueryScope queryScope;
   point::ENUEdge enuEdge;
   auto leftInterval = laneInterval;
-  auto lane = lane::getLane(laneInterval.laneId);
+  auto const &lane = lane::getLane(laneInterval.laneId);
 
   const auto startOffset = laneInterval.start;
   const auto endOffset = laneInterval.end;
@@ -298,9 +302,10 @@ point::ENUEdge getLeftProjectedENUEdge(LaneInterval const &laneInterval)
 
 point::ENUEdge getRightProjectedENUEdge(LaneInterval const &laneInterval)
 {
+  access::QueryScope queryScope;
   point::ENUEdge enuEdge;
   auto rightInterval = laneInterval;
-  auto lane = lane::getLane(laneInterval.laneId);
+  auto const &lane = lane::getLane(laneInterval.laneId);
 
   const auto startOffset = laneInterval.start;
   const auto endOffset = laneInterval.end;
@@ -352,11 +357,12 @@ lane::ENUBorder getENUBorder(LaneInterval const &laneInterval)
 
 lane::ENUBorder getENUProjectedBorder(LaneInterval const &laneInterval)
 {
+  access::QueryScope queryScope;
   lane::ENUBorder enuBorder;
   auto leftInterval = laneInterval;
   auto rightInterval = laneInterval;
 
-  auto lane = lane::getLane(laneInterval.laneId);
+  auto const &lane = lane::getLane(laneInterval.laneId);
 
   const auto startOffset = laneInterval.start;
   const auto endOffset = laneInterval.end;
@@ -539,6 +545,7 @@ LaneInterval cutIntervalAtEnd(LaneInterval const &laneInterval, physics::Paramet
 
 restriction::SpeedLimitList getSpeedLimits(LaneInterval const &laneInterval)
 {
+  access::QueryScope queryScope;
   auto lanePtr = lane::getLanePtr(laneInterval.laneId);
   return getSpeedLimits(*lanePtr, toParametricRange(laneInterval));
 }
@@ -9,12 +9,16 @@
 #include "ad/map/route/Planning.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include "../access/ParallelFor.hpp"
 #include "ad/map/access/Logging.hpp"
 #include "ad/map/access/Operation.hpp"
 #include "ad/map/lane/LaneOperation.hpp"
 #include "ad/map/match/AdMapMatching.hpp"
 #include "ad/map/match/MapMatchedOperation.hpp"
 #include "ad/map/route/RouteAStar.hpp"
+#include "ad/map/route/RouteContractionHierarchy.hpp"
+#include "ad/map/route/RouteDijkstra.hpp"
 #include "ad/map/route/RouteOperation.hpp"
 #include "ad/map/route/RoutePrediction.hpp"
 
@@ -23,6 +27,8 @@ namespace map {
 namespace route {
 namespace planning {
 
+// the planning functions pin the store by an access::QueryScope, so each of them plans on one map as a whole
+
 RoutingParaPoint createRoutingPoint(lane::LaneId const &laneId,
                                     physics::ParametricValue const &parametricOffset,
                                     RoutingDirection const &routingDirection)
@@ -82,6 +88,7 @@ RoutingParaPoint createRoutingPoint(match::LaneOccupiedRegion const &occupiedReg
 
 void addParaPointToRouteDestList(point::ParaPoint const &paraPoint, std::vector<RoutingParaPoint> &routingDestList)
 {
+  access::QueryScope queryScope;
   if (routingDestList.empty())
   {
     routingDestList.push_back(createRoutingPoint(paraPoint));
@@ -99,7 +106,7 @@ void addParaPointToRouteDestList(point::ParaPoint const &paraPoint, std::vector<
   // driving direction. If this is the case, we *add* the new paraPoint, otherwise, we
   // *replace* the last point with the new paraPoint.
 
-  auto lane = lane::getLane(paraPoint.laneId);
+  auto const &lane = lane::getLane(paraPoint.laneId);
 
   // positive lane direction means increasing TParam
   if (lane.direction == lane::LaneDirection::POSITIVE)
@@ -128,7 +135,7 @@ void addParaPointToRouteDestList(point::ParaPoint const &paraPoint, std::vector<
 
 FullRoute createFullRoute(const point::ParaPointList rawRoute)
 {
-  static RoutePlanningCounter routePlanningCounter = 0u;
+  static std::atomic<RoutePlanningCounter> routePlanningCounter{0u};
 
   FullRoute resultRoute;
 
@@ -160,8 +167,7 @@ FullRoute createFullRoute(const point::ParaPointList rawRoute)
   }
 
   // post process the route counters
-  routePlanningCounter++;
-  resultRoute.routePlanningCounter = routePlanningCounter;
+  resultRoute.routePlanningCounter = ++routePlanningCounter;
   resultRoute.fullRouteSegmentCount = resultRoute.roadSegments.size();
   for (size_t i = 0; i < resultRoute.roadSegments.size(); ++i)
   {
@@ -174,6 +180,7 @@ FullRoute createFullRoute(const point::ParaPointList rawRoute)
 
 FullRoute planRoute(const RoutingParaPoint &routingStart, const RoutingParaPoint &routingDest)
 {
+  access::QueryScope queryScope;
   RouteAstar routePlanning(routingStart, routingDest, Route::Type::SHORTEST);
   point::ParaPointList rawRoute;
   if (routePlanning.calculate())
@@ -183,8 +190,37 @@ FullRoute planRoute(const RoutingParaPoint &routingStart, const RoutingParaPoint
   return createFullRoute(rawRoute);
 }
 
+FullRoute planRoute(const RoutingParaPoint &routingStart,
+                    const RoutingParaPoint &routingDest,
+                    AltHeuristic::ConstPtr const &altHeuristic)
+{
+  access::QueryScope queryScope;
+  RouteAstar routePlanning(routingStart, routingDest, Route::Type::SHORTEST, altHeuristic);
+  point::ParaPointList rawRoute;
+  if (routePlanning.calculate())
+  {
+    rawRoute = routePlanning.getRawRoute();
+  }
+  return createFullRoute(rawRoute);
+}
+
+FullRoute planRoute(const RoutingParaPoint &routingStart,
+                    const RoutingParaPoint &routingDest,
+                    ContractionHierarchy::ConstPtr const &contractionHierarchy)
+{
+  access::QueryScope queryScope;
+  RouteContractionHierarchy routePlanning(routingStart, routingDest, contractionHierarchy);
+  point::ParaPointList rawRoute;
+  if (routePlanning.calculate())
+  {
+    rawRoute = routePlanning.getRawRoute();
+  }
+  return createFullRoute(rawRoute);
+}
+
 FullRoute planRoute(const RoutingParaPoint &routingStart, const point::GeoPoint &dest)
 {
+  access::QueryScope queryScope;
   FullRoute resultRoute;
   physics::Distance resultDistance = std::numeric_limits<physics::Distance>::max();
   match::AdMapMatching mapMatching;
@@ -205,6 +241,7 @@ FullRoute planRoute(const RoutingParaPoint &routingStart, const point::GeoPoint
 
 FullRoute planRoute(const RoutingParaPoint &start, const std::vector<point::GeoPoint> &dest)
 {
+  access::QueryScope queryScope;
   match::AdMapMatching mapMatching;
   std::vector<RoutingParaPoint> routingDestList;
   for (auto destIter = dest.begin(); destIter != dest.end(); destIter++)
@@ -242,6 +279,7 @@ FullRoute planRoute(const RoutingParaPoint &start, const std::vector<point::GeoP
 
 FullRoute planRoute(const RoutingParaPoint &start, std::vector<RoutingParaPoint> const &dest)
 {
+  access::QueryScope queryScope;
   auto routingStart = start;
   point::ParaPointList mergedRawRoute;
   for (auto &routingDest : dest)
@@ -263,6 +301,42 @@ FullRoute planRoute(const RoutingParaPoint &start, std::vector<RoutingParaPoint>
   return createFullRoute(mergedRawRoute);
 }
 
+std::vector<FullRoute> planRoutes(const RoutingParaPoint &start, std::vector<RoutingParaPoint> const &dest)
+{
+  access::QueryScope queryScope;
+  std::vector<FullRoute> resultRoutes;
+  resultRoutes.reserve(dest.size());
+  RouteDijkstra routePlanning(start, dest, Route::Type::SHORTEST);
+  routePlanning.calculate();
+  for (std::size_t destIndex = 0u; destIndex < dest.size(); ++destIndex)
+  {
+    resultRoutes.push_back(createFullRoute(routePlanning.getRawRoute(destIndex)));
+  }
+  return resultRoutes;
+}
+
+RouteDistanceMatrix calculateRouteDistanceMatrix(std::vector<RoutingParaPoint> const &start,
+                                                 std::vector<RoutingParaPoint> const &dest,
+                                                 std::size_t const threadCount)
+{
+  access::QueryScope queryScope;
+  RouteDistanceMatrix resultMatrix(start.size(), std::vector<RouteDistance>(dest.size()));
+  access::parallelFor(start.size(), threadCount, [&](std::size_t const startIndex) {
+    auto const routes = planRoutes(start[startIndex], dest);
+    for (std::size_t destIndex = 0u; destIndex < dest.size(); ++destIndex)
+    {
+      auto &entry = resultMatrix[startIndex][destIndex];
+      entry.routeFound = !routes[destIndex].roadSegments.empty();
+      if (entry.routeFound)
+      {
+        entry.routeLength = calcLength(routes[destIndex]);
+        entry.routeDuration = calcDuration(routes[destIndex]);
+      }
+    }
+  });
+  return resultMatrix;
+}
+
 enum class CompareRouteResult
 {
   Equal,
@@ -349,6 +423,7 @@ std::vector<FullRoute> filterDuplicatedRoutes(const std::vector<FullRoute> fullR
 std::vector<FullRoute> predictRoutesOnDuration(const RoutingParaPoint &start,
                                                physics::Duration const &predictionDuration)
 {
+  access::QueryScope queryScope;
   std::vector<FullRoute> resultRoutes;
   RoutePrediction routePrediction(start, predictionDuration);
   if (routePrediction.calculate())
@@ -364,6 +439,7 @@ std::vector<FullRoute> predictRoutesOnDuration(const RoutingParaPoint &start,
 std::vector<FullRoute> predictRoutesOnDistance(const RoutingParaPoint &start,
                                                physics::Distance const &predictionDistance)
 {
+  access::QueryScope queryScope;
   std::vector<FullRoute> resultRoutes;
   RoutePrediction routePrediction(start, predictionDistance);
   if (routePrediction.calculate())
@@ -380,6 +456,7 @@ std::vector<FullRoute> predictRoutes(const RoutingParaPoint &start,
                                      physics::Distance const &predictionDistance,
                                      physics::Duration const &predictionDuration)
 {
+  access::QueryScope queryScope;
   std::vector<FullRoute> resultRoutes;
   RoutePrediction routePrediction(start, predictionDistance, predictionDuration);
   if (routePrediction.calculate())
@@ -395,6 +472,7 @@ std::vector<FullRoute> predictRoutes(const RoutingParaPoint &start,
 std::vector<FullRoute> predictRoutesOnDuration(const match::MapMatchedObjectBoundingBox &startObject,
                                                physics::Duration const &predictionDuration)
 {
+  access::QueryScope queryScope;
   std::vector<FullRoute> resultRoutes;
   auto const enuHeading = match::getObjectENUHeading(startObject);
   for (auto const &startMatchingResult : startObject.laneOccupiedRegions)
@@ -409,6 +487,7 @@ std::vector<FullRoute> predictRoutesOnDuration(const match::MapMatchedObjectBoun
 std::vector<FullRoute> predictRoutesOnDistance(const match::MapMatchedObjectBoundingBox &startObject,
                                                physics::Distance const &predictionDistance)
 {
+  access::QueryScope queryScope;
   std::vector<FullRoute> resultRoutes;
   auto const enuHeading = match::getObjectENUHeading(startObject);
   for (auto const &startMatchingResult : startObject.laneOccupiedRegions)
@@ -420,17 +499,17 @@ std::vector<FullRoute> predictRoutesOnDistance(const match::MapMatchedObjectBoun
   return filterDuplicatedRoutes(resultRoutes);
 }
 
-ConnectingRoute calculateConnectingBasicRoute(const RoutingParaPoint &routingStart, const RoutingParaPoint &routingDest)
+ConnectingRoute createConnectingBasicRoute(point::ParaPointList const &rawRoute)
 {
+  access::QueryScope queryScope;
   ConnectingRoute route;
   route.connectingRouteLength = physics::Distance(0.);
   route.minLaneOffset = 0;
   route.maxLaneOffset = 0;
-  RouteAstar routePlanning(routingStart, routingDest, Route::Type::SHORTEST_IGNORE_DIRECTION);
-  if (routePlanning.calculate())
+  if (!rawRoute.empty())
   {
     int32_t currentLaneOffset = 0;
-    auto rawRoute = routePlanning.getRawRoute();
+    auto const laneGraph = lane::getLaneGraph();
 
     for (size_t i = 0u; i < rawRoute.size();)
     {
@@ -448,7 +527,7 @@ ConnectingRoute calculateConnectingBasicRoute(const RoutingParaPoint &routingSta
       for (++i; i < rawRoute.size(); ++i)
       {
         auto const neighborhood
-          = lane::getDirectNeighborhoodRelation(newInterval.laneInterval.laneId, rawRoute[i].laneId);
+          = laneGraph->getDirectNeighborhoodRelation(newInterval.laneInterval.laneId, rawRoute[i].laneId);
         if ((neighborhood == lane::ContactLocation::OVERLAP) || (neighborhood == lane::ContactLocation::LEFT)
             || (neighborhood == lane::ContactLocation::RIGHT))
         {
@@ -481,7 +560,8 @@ ConnectingRoute calculateConnectingBasicRoute(const RoutingParaPoint &routingSta
       ConnectingSegment routeSegment;
       routeSegment.push_back(newInterval);
       route.connectingSegments.push_back(routeSegment);
-      route.connectingRouteLength += calcLength(newInterval.laneInterval);
+      route.connectingRouteLength
+        += laneGraph->getNode(newInterval.laneInterval.laneId).length * calcParametricLength(newInterval.laneInterval);
     }
     route.destinationLaneOffset = currentLaneOffset;
   }
@@ -498,18 +578,26 @@ inline void addWrongWayFlag(lane::Lane const &lane, ConnectingInterval &connecti
 ConnectingRoute calculateConnectingRoute(const match::MapMatchedObjectBoundingBox &startObject,
                                          const match::MapMatchedObjectBoundingBox &destObject)
 {
+  access::QueryScope queryScope;
   ConnectingRoute resultRoute;
   resultRoute.connectingRouteLength = std::numeric_limits<physics::Distance>::max();
 
+  std::vector<RoutingParaPoint> routingDests;
+  for (auto const &destMatchingResult : destObject.laneOccupiedRegions)
+  {
+    routingDests.push_back(createRoutingPoint(destMatchingResult));
+  }
+
   auto const enuHeading = match::getObjectENUHeading(startObject);
   for (auto const &startMatchingResult : startObject.laneOccupiedRegions)
   {
-    for (auto const &destMatchingResult : destObject.laneOccupiedRegions)
+    // a single search provides the routes to all destination regions
+    auto const routingStart = createRoutingPoint(startMatchingResult, enuHeading);
+    RouteDijkstra routePlanning(routingStart, routingDests, Route::Type::SHORTEST_IGNORE_DIRECTION);
+    routePlanning.calculate();
+    for (std::size_t destIndex = 0u; destIndex < routingDests.size(); ++destIndex)
     {
-      auto const routingStart = createRoutingPoint(startMatchingResult, enuHeading);
-      auto const routingDest = createRoutingPoint(destMatchingResult);
-
-      auto const route = calculateConnectingBasicRoute(routingStart, routingDest);
+      auto const route = createConnectingBasicRoute(routePlanning.getRawRoute(destIndex));
       if ((!route.connectingSegments.empty()) && (route.connectingRouteLength < resultRoute.connectingRouteLength))
       {
         resultRoute = route;
@@ -534,7 +622,7 @@ ConnectingRoute calculateConnectingRoute(const match::MapMatchedObjectBoundingBo
     }
 
     // handle current interval
-    auto rawLane = lane::getLane(connectingSegment.front().laneInterval.laneId);
+    auto const &rawLane = lane::getLane(connectingSegment.front().laneInterval.laneId);
     addWrongWayFlag(rawLane, connectingSegment.front());
     auto const rawIntervalOffset = connectingSegment.front().laneOffset;
 
@@ -542,10 +630,10 @@ ConnectingRoute calculateConnectingRoute(const match::MapMatchedObjectBoundingBo
     connectingSegment.reserve(numberOfLanesPerSegment);
 
     // add right neighbors
-    auto lane = rawLane;
+    auto lane = &rawLane;
     for (int32_t offset = rawIntervalOffset + 1; offset <= resultRoute.maxLaneOffset; offset++)
     {
-      lane::ContactLaneList contactLanes = getContactLanes(lane, lane::ContactLocation::RIGHT);
+      lane::ContactLaneList contactLanes = getContactLanes(*lane, lane::ContactLocation::RIGHT);
       // we expect that per map model only one contact lane is possible in one direction
       if (contactLanes.size() == 1u)
       {
@@ -555,8 +643,8 @@ ConnectingRoute calculateConnectingRoute(const match::MapMatchedObjectBoundingBo
         newInterval.laneInterval.end = connectingSegment.front().laneInterval.end;
         newInterval.laneOffset = offset;
 
-        lane = lane::getLane(newInterval.laneInterval.laneId);
-        addWrongWayFlag(lane, newInterval);
+        lane = &lane::getLane(newInterval.laneInterval.laneId);
+        addWrongWayFlag(*lane, newInterval);
         // sorting: right lanes are added at front, left lanes at back
         connectingSegment.insert(connectingSegment.begin(), newInterval);
       }
@@ -566,10 +654,10 @@ ConnectingRoute calculateConnectingRoute(const match::MapMatchedObjectBoundingBo
       }
     }
     // add left neighbors
-    lane = rawLane;
+    lane = &rawLane;
     for (int32_t offset = rawIntervalOffset - 1; offset >= resultRoute.minLaneOffset; offset--)
     {
-      lane::ContactLaneList contactLanes = getContactLanes(lane, lane::ContactLocation::LEFT);
+      lane::ContactLaneList contactLanes = getContactLanes(*lane, lane::ContactLocation::LEFT);
       // we expect that per map model only one contact lane is possible in one direction
       if (contactLanes.size() == 1u)
       {
@@ -579,8 +667,8 @@ ConnectingRoute calculateConnectingRoute(const match::MapMatchedObjectBoundingBo
         newInterval.laneInterval.end = connectingSegment.front().laneInterval.end;
         newInterval.laneOffset = offset;
 
-        lane = lane::getLane(newInterval.laneInterval.laneId);
-        addWrongWayFlag(lane, newInterval);
+        lane = &lane::getLane(newInterval.laneInterval.laneId);
+        addWrongWayFlag(*lane, newInterval);
         // sorting: left lanes are added at back
         connectingSegment.insert(connectingSegment.end(), newInterval);
       }
@@ -7,6 +7,7 @@
 // ----------------- END LICENSE BLOCK -----------------------------------
 
 #include "ad/map/route/Route.hpp"
+#include "ad/map/access/Operation.hpp"
 #include "ad/map/lane/LaneOperation.hpp"
 
 namespace ad {
@@ -50,6 +51,7 @@ const point::ParaPointList &Route::getRawRoute(size_t const routeIndex) const
 
 Route::FullRoute Route::getFullRoute(size_t const routeIndex) const
 {
+  access::QueryScope queryScope;
   auto rawRoute = getRawRoute(routeIndex);
   FullRoute fr;
   for (size_t i = 0; i < rawRoute.size(); i++)
@@ -9,6 +9,8 @@
 #include "ad/map/route/RouteAStar.hpp"
 
 #include <algorithm>
+#include "RouteAStarCost.hpp"
+#include "ad/map/access/Logging.hpp"
 
 #define DEBUG_OUTPUT 0
 
@@ -33,22 +35,35 @@ namespace map {
 namespace route {
 namespace planning {
 
-static const physics::Distance COST_LONGITUDINAL(1.); ///< Cost of longitudinal lane change.
-static const physics::Distance COST_LATERAL(5.);      ///< Cost of lateral lane change.
-
 RouteAstar::RouteAstar(const RoutingParaPoint &start, const RoutingParaPoint &dest, Type typ)
   : RouteExpander(start, dest, typ)
 {
-  mDestLane = lane::getLanePtr(dest.point.laneId);
-  if (!mDestLane)
+  if (mLaneGraph->findNode(dest.point.laneId) == lane::LaneGraph::cInvalidNodeIndex)
   {
     throw std::runtime_error("Dest lane not found!");
   }
-  mStartLane = lane::getLanePtr(start.point.laneId);
-  if (!mStartLane)
+  if (mLaneGraph->findNode(start.point.laneId) == lane::LaneGraph::cInvalidNodeIndex)
   {
     throw std::runtime_error("Start lane not found!");
   }
+  mDestLane = &mLaneGraph->getNode(dest.point.laneId);
+  mStartLane = &mLaneGraph->getNode(start.point.laneId);
+}
+
+RouteAstar::RouteAstar(const RoutingParaPoint &start,
+                       const RoutingParaPoint &dest,
+                       Type typ,
+                       AltHeuristic::ConstPtr const &altHeuristic)
+  : RouteAstar(start, dest, typ)
+{
+  if (altHeuristic && altHeuristic->isValidFor(*mLaneGraph))
+  {
+    mAltHeuristic = altHeuristic;
+  }
+  else if (altHeuristic)
+  {
+    access::getLogger()->warn("RouteAstar: landmark tables don't match the map, ignoring them");
+  }
 }
 
 // https://en.wikipedia.org/wiki/A*_search_algorithm
@@ -58,11 +73,24 @@ bool RouteAstar::calculate()
   mProcessingMap.clear();
   mCameFrom.clear();
 
+  // the destination point is required by every cost estimate
+  auto const destLane = mLaneGraph->getLane(*mDestLane);
+  if (!destLane)
+  {
+    return false;
+  }
+  mDestPoint = getParametricPoint(*destLane, getDest().parametricOffset, physics::ParametricValue(0.5));
+  if (mAltHeuristic)
+  {
+    mDestLandmarkCosts = mAltHeuristic->getDestinationCosts(*mLaneGraph, getDest());
+  }
+  mExpandedPointCount = 0u;
+
   // A* working structures.
   // Initial values.
   RouteAstarScore cost;
-  cost.f_score = costEstimate(mStartLane, start_.point);
-  mProcessingMap.insert({start_, cost});
+  cost.f_score = costEstimate(*mStartLane, start_.point);
+  mProcessingMap.insert(start_, cost);
   // Run
   bool path_found = false;
 #if DEBUG_OUTPUT
@@ -71,15 +99,7 @@ bool RouteAstar::calculate()
 #endif
   while (!mProcessingMap.empty())
   {
-    // sort the routing points by the smallest total cost
-    struct FScoreCompare
-    {
-      bool operator()(RoutingPoint const &left, RoutingPoint const &right)
-      {
-        return left.second.f_score < right.second.f_score;
-      }
-    };
-    auto minimum_cost_iterator = std::min_element(mProcessingMap.begin(), mProcessingMap.end(), FScoreCompare());
+    auto minimum_cost_iterator = getMinimumCostElement();
     if (((dest_.direction == RoutingDirection::DONT_CARE)
          || (dest_.direction == minimum_cost_iterator->first.direction))
         && (minimum_cost_iterator->first.point == dest_.point))
@@ -87,7 +107,8 @@ bool RouteAstar::calculate()
       reconstructPath(minimum_cost_iterator->first);
       path_found = true;
 #if DEBUG_OUTPUT
-      std::cout << "Target reached " << *minimum_cost_iterator << std::endl;
+      std::cout << "Target reached " << RoutingPoint(minimum_cost_iterator->first, minimum_cost_iterator->second.value)
+                << std::endl;
       for (auto const &point : getRawRoute())
       {
         std::cout << " " << point << std::endl;
@@ -98,9 +119,10 @@ bool RouteAstar::calculate()
     }
     else
     {
-      RoutingPoint const minimum_value = *minimum_cost_iterator;
+      RoutingPoint const minimum_value(minimum_cost_iterator->first, minimum_cost_iterator->second.value);
       mProcessingMap.erase(minimum_cost_iterator);
       mProcessedPoints.insert(minimum_value.first);
+      mExpandedPointCount++;
 #if DEBUG_OUTPUT
       std::cout << "Expanding: " << minimum_value << std::endl;
 #endif
@@ -109,7 +131,7 @@ bool RouteAstar::calculate()
       std::cout << "Results in " << std::endl;
       for (auto &element : mProcessingMap)
       {
-        std::cout << " " << element << std::endl;
+        std::cout << " " << RoutingPoint(element.first, element.second.value) << std::endl;
       }
       std::cout << "----------" << std::endl;
 #endif
@@ -123,17 +145,58 @@ bool RouteAstar::calculate()
   return path_found;
 }
 
-physics::Distance RouteAstar::costEstimate(lane::Lane::ConstPtr neighborLane, point::ParaPoint const &neighbor)
+physics::Distance RouteAstar::costEstimate(lane::LaneGraph::Node const &neighborLane, point::ParaPoint const &neighbor)
 {
-  point::ECEFPoint pt_a = getParametricPoint(*neighborLane, neighbor.parametricOffset, physics::ParametricValue(0.5));
-  point::ECEFPoint pt_b = getParametricPoint(*mDestLane, getDest().parametricOffset, physics::ParametricValue(0.5));
-  physics::Distance d = distance(pt_a, pt_b);
+  // the center point at the offset is at most the driven distance away from the lane ends, so the distances of
+  // the lane ends to the destination provide a lower bound without evaluating the lane geometry
+  physics::Distance const fromStart
+    = distance(neighborLane.startPoint, mDestPoint) - neighbor.parametricOffset * neighborLane.length;
+  physics::Distance const fromEnd = distance(neighborLane.endPoint, mDestPoint)
+    - (physics::ParametricValue(1.) - neighbor.parametricOffset) * neighborLane.length;
+  physics::Distance d = std::max(physics::Distance(0.), std::max(fromStart, fromEnd));
+  if ((neighbor.parametricOffset == physics::ParametricValue(0.))
+      || (neighbor.parametricOffset == physics::ParametricValue(1.)))
+  {
+    d = landmarkCostEstimate(neighborLane, neighbor, d);
+  }
   return d;
 }
 
-void RouteAstar::addNeighbor(lane::Lane::ConstPtr originLane,
+physics::Distance RouteAstar::costEstimateAtLaneBorder(lane::LaneGraph::Node const &neighborLane,
+                                                       point::ParaPoint const &neighbor)
+{
+  if (neighbor.parametricOffset == physics::ParametricValue(0.))
+  {
+    return landmarkCostEstimate(neighborLane, neighbor, distance(neighborLane.startPoint, mDestPoint));
+  }
+  return landmarkCostEstimate(neighborLane, neighbor, distance(neighborLane.endPoint, mDestPoint));
+}
+
+physics::Distance RouteAstar::landmarkCostEstimate(lane::LaneGraph::Node const &neighborLane,
+                                                   point::ParaPoint const &neighbor,
+                                                   physics::Distance const &estimate) const
+{
+  if (!mAltHeuristic)
+  {
+    return estimate;
+  }
+  // the lower bound refers to the exact border point, but the offset of the neighbor might differ within precision
+  double const offset = static_cast<double>(neighbor.parametricOffset);
+  bool const atLaneEnd = offset > 0.5;
+  double const offsetError = std::fabs(offset - (atLaneEnd ? 1. : 0.)) * static_cast<double>(neighborLane.length);
+  double const lowerBound
+    = mAltHeuristic->getLowerBound(mLaneGraph->getNodeIndex(neighborLane), atLaneEnd, mDestLandmarkCosts)
+    - offsetError;
+  if (static_cast<double>(estimate) < lowerBound)
+  {
+    return physics::Distance(lowerBound);
+  }
+  return estimate;
+}
+
+void RouteAstar::addNeighbor(lane::LaneGraph::Node const &originLane,
                              RoutingPoint const &origin,
-                             lane::Lane::ConstPtr neighborLane,
+                             lane::LaneGraph::Node const &neighborLane,
                              RoutingParaPoint const &neighbor,
                              ExpandReason const &expandReason)
 {
@@ -145,12 +208,12 @@ void RouteAstar::addNeighbor(lane::Lane::ConstPtr originLane,
       case ExpandReason::Destination:
       case ExpandReason::SameLaneNeighbor:
       {
-        if (originLane != neighborLane)
+        if (&originLane != &neighborLane)
         {
           throw std::runtime_error("Expected same lanes!");
         }
         auto const deltaTParam = std::fabs(origin.first.point.parametricOffset - neighbor.point.parametricOffset);
-        physics::Distance const laneLength = originLane->length;
+        physics::Distance const laneLength = originLane.length;
         expand_g_score = deltaTParam * laneLength;
         break;
       }
@@ -171,22 +234,85 @@ void RouteAstar::addNeighbor(lane::Lane::ConstPtr originLane,
 
     RouteAstarScore cost;
     cost.g_score = origin.second.g_score + expand_g_score;
-    auto insert_result = mProcessingMap.insert({neighbor, cost});
+    auto insert_result = mProcessingMap.insert(neighbor, cost);
     if ( // insertion succeeded
       insert_result.second ||
       // g_score of new neighbor is smaller than the found duplicate
-      (cost.g_score < insert_result.first->second.g_score))
+      (cost.g_score < insert_result.first->second.value.g_score))
     {
-      cost.f_score = cost.g_score + costEstimate(neighborLane, neighbor.point);
-      insert_result.first->second = cost;
+      if ((expandReason == ExpandReason::SameLaneNeighbor) || (expandReason == ExpandReason::LongitudinalNeighbor))
+      {
+        // these neighbors are always located exactly at the start or end of their lane
+        cost.f_score = cost.g_score + costEstimateAtLaneBorder(neighborLane, neighbor.point);
+      }
+      else
+      {
+        cost.f_score = cost.g_score + costEstimate(neighborLane, neighbor.point);
+      }
+      insert_result.first->second.value = cost;
+      mProcessingMap.update(insert_result.first);
       mCameFrom[neighbor] = origin.first;
 #if DEBUG_OUTPUT
-      std::cout << "Inserted: " << *insert_result.first << std::endl;
+      std::cout << "Inserted: " << RoutingPoint(neighbor, cost) << std::endl;
 #endif
     }
   }
 }
 
+RouteAstar::RoutingParaPointCostQueue::iterator RouteAstar::getMinimumCostElement()
+{
+  // The elements are compared by their f_score considering the precision of physics::Distance. Therefore, the
+  // selected element is the first one in order of the routing points, which is not larger than any element
+  // visited before, starting with the first one. Only the elements near to the smallest f_score take part in
+  // this decision, as long as no element has an f_score in the range (smallest f_score + [2, 4] * precision).
+  double const precision = static_cast<double>(physics::Distance::getPrecision());
+  double const minimum = static_cast<double>(mProcessingMap.top()->second.value.f_score);
+  std::vector<RoutingParaPointCostQueue::iterator> candidates;
+  bool ambiguous = false;
+  mProcessingMap.visit(
+    [minimum, precision](RouteAstarScore const &value) {
+      return static_cast<double>(value.f_score) < minimum + 4. * precision;
+    },
+    [&candidates, &ambiguous, minimum, precision](RoutingParaPointCostQueue::iterator const &element) {
+      if (static_cast<double>(element->second.value.f_score) < minimum + 2. * precision)
+      {
+        candidates.push_back(element);
+      }
+      else
+      {
+        ambiguous = true;
+      }
+    });
+
+  auto result = mProcessingMap.begin();
+  if (ambiguous)
+  {
+    for (auto element = mProcessingMap.begin(); element != mProcessingMap.end(); ++element)
+    {
+      if (element->second.value.f_score < result->second.value.f_score)
+      {
+        result = element;
+      }
+    }
+  }
+  else
+  {
+    std::sort(candidates.begin(),
+              candidates.end(),
+              [](RoutingParaPointCostQueue::iterator const &left, RoutingParaPointCostQueue::iterator const &right) {
+                return left->first < right->first;
+              });
+    for (auto const &element : candidates)
+    {
+      if (element->second.value.f_score < result->second.value.f_score)
+      {
+        result = element;
+      }
+    }
+  }
+  return result;
+}
+
 void RouteAstar::reconstructPath(RoutingParaPoint const &dest)
 {
   raw_routes.clear();
@@ -0,0 +1,24 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#pragma once
+
+#include "ad/physics/Distance.hpp"
+
+namespace ad {
+namespace map {
+namespace route {
+namespace planning {
+
+static const physics::Distance COST_LONGITUDINAL(1.); ///< Cost of longitudinal lane change.
+static const physics::Distance COST_LATERAL(5.);      ///< Cost of lateral lane change.
+
+} // namespace planning
+} // namespace route
+} // namespace map
+} // namespace ad
@@ -0,0 +1,219 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/route/RouteContractionHierarchy.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "RouteAStarCost.hpp"
+#include "ad/map/access/Logging.hpp"
+#include "ad/map/route/RouteAStar.hpp"
+
+namespace ad {
+namespace map {
+namespace route {
+namespace planning {
+
+RouteContractionHierarchy::RouteContractionHierarchy(const RoutingParaPoint &start,
+                                                     const RoutingParaPoint &dest,
+                                                     ContractionHierarchy::ConstPtr const &contractionHierarchy)
+  : RouteExpander(start, dest, Type::SHORTEST)
+{
+  // ensure the lanes are present like RouteAstar does
+  if (mLaneGraph->findNode(dest.point.laneId) == lane::LaneGraph::cInvalidNodeIndex)
+  {
+    throw std::runtime_error("Dest lane not found!");
+  }
+  if (mLaneGraph->findNode(start.point.laneId) == lane::LaneGraph::cInvalidNodeIndex)
+  {
+    throw std::runtime_error("Start lane not found!");
+  }
+
+  if (contractionHierarchy && contractionHierarchy->isValidFor(*mLaneGraph))
+  {
+    mContractionHierarchy = contractionHierarchy;
+  }
+  else
+  {
+    access::getLogger()->warn("RouteContractionHierarchy: hierarchy doesn't match the map, using RouteAstar");
+  }
+}
+
+bool RouteContractionHierarchy::calculate()
+{
+  raw_routes.clear();
+  valid_ = false;
+
+  if (!mContractionHierarchy)
+  {
+    RouteAstar routePlanning(start_, dest_, type_);
+    if (routePlanning.calculate())
+    {
+      raw_routes = routePlanning.getRawRoutes();
+      valid_ = true;
+    }
+    return valid_;
+  }
+
+  if (((dest_.direction == RoutingDirection::DONT_CARE) || (dest_.direction == start_.direction))
+      && (start_.point == dest_.point))
+  {
+    raw_routes.push_back({start_.point});
+    valid_ = true;
+    return valid_;
+  }
+
+  // expand the start and all points reachable from there by lateral lane changes (i.e. at the same offset)
+  mLocalQueue.clear();
+  mLocalCameFrom.clear();
+  mSources.clear();
+  mDirectDest = RoutingPoint(start_, std::numeric_limits<double>::infinity());
+  mLocalCameFrom[start_] = start_;
+  mLocalQueue.push_back(RoutingPoint(start_, 0.));
+  while (!mLocalQueue.empty())
+  {
+    auto const origin = mLocalQueue.front();
+    mLocalQueue.pop_front();
+    expandNeighbors(origin);
+  }
+
+  std::vector<ContractionHierarchy::SearchSeed> sources;
+  for (auto const &source : mSources)
+  {
+    sources.push_back({source.first, source.second.second});
+  }
+  std::vector<ContractionHierarchy::NodeIndex> path;
+  mContractionHierarchy->findPath(sources, getTargets(), mDirectDest.second, path);
+  if (!path.empty())
+  {
+    createRawRoute(mSources[path.front()].first, path);
+  }
+  else if (!std::isinf(mDirectDest.second))
+  {
+    createRawRoute(mDirectDest.first, path);
+  }
+
+  mLocalQueue.clear();
+  mLocalCameFrom.clear();
+  mSources.clear();
+  valid_ = !raw_routes.empty();
+  return valid_;
+}
+
+void RouteContractionHierarchy::addNeighbor(lane::LaneGraph::Node const &originLane,
+                                            RoutingPoint const &origin,
+                                            lane::LaneGraph::Node const &neighborLane,
+                                            RoutingParaPoint const &neighbor,
+                                            ExpandReason const &expandReason)
+{
+  double cost = origin.second;
+  switch (expandReason)
+  {
+    case ExpandReason::Destination:
+    case ExpandReason::SameLaneNeighbor:
+    {
+      auto const deltaTParam = std::fabs(origin.first.point.parametricOffset - neighbor.point.parametricOffset);
+      cost += static_cast<double>(deltaTParam * originLane.length);
+      break;
+    }
+    case ExpandReason::LongitudinalNeighbor:
+    {
+      cost += static_cast<double>(COST_LONGITUDINAL);
+      break;
+    }
+    case ExpandReason::LateralNeighbor:
+    {
+      cost += static_cast<double>(COST_LATERAL);
+      break;
+    }
+    default:
+      throw std::runtime_error("RouteContractionHierarchy::AddNeighbor>> Unsupported expand reason!");
+      break;
+  }
+
+  if (expandReason == ExpandReason::Destination)
+  {
+    if (cost < mDirectDest.second)
+    {
+      mDirectDest = RoutingPoint(origin.first, cost);
+    }
+  }
+  else if ((neighbor.point.parametricOffset == physics::ParametricValue(0.))
+           || (neighbor.point.parametricOffset == physics::ParametricValue(1.)))
+  {
+    bool const atLaneEnd = neighbor.point.parametricOffset > physics::ParametricValue(0.5);
+    auto const node
+      = ContractionHierarchy::getNodeIndex(mLaneGraph->getNodeIndex(neighborLane), atLaneEnd, neighbor.direction);
+    auto insertResult = mSources.insert({node, RoutingPoint(origin.first, cost)});
+    if (!insertResult.second && (cost < insertResult.first->second.second))
+    {
+      insertResult.first->second = RoutingPoint(origin.first, cost);
+    }
+  }
+  else if (mLocalCameFrom.insert({neighbor, origin.first}).second)
+  {
+    // all lateral lane changes have the same cost, so the first visit is the cheapest one
+    mLocalQueue.push_back(RoutingPoint(neighbor, cost));
+  }
+}
+
+std::vector<ContractionHierarchy::SearchSeed> RouteContractionHierarchy::getTargets()
+{
+  std::vector<ContractionHierarchy::SearchSeed> targets;
+  auto const laneIndex = mLaneGraph->findNode(getDest().laneId);
+  auto const &lane = mLaneGraph->getNode(laneIndex);
+  if (!lane.routeable)
+  {
+    return targets;
+  }
+  for (auto const atLaneEnd : {false, true})
+  {
+    physics::ParametricValue const parametricOffset(atLaneEnd ? 1. : 0.);
+    for (auto const direction : {RoutingDirection::DONT_CARE, RoutingDirection::POSITIVE, RoutingDirection::NEGATIVE})
+    {
+      // same conditions as within RouteExpander::expandSameLaneNeighbors()
+      RoutingPoint const origin(createRoutingParaPoint(lane.id, parametricOffset, direction), 0.);
+      if ((isPositiveMovement(lane, origin) && (parametricOffset <= getDest().parametricOffset))
+          || (isNegativeMovement(lane, origin) && (parametricOffset >= getDest().parametricOffset)))
+      {
+        auto const deltaTParam = std::fabs(parametricOffset - getDest().parametricOffset);
+        targets.push_back({ContractionHierarchy::getNodeIndex(laneIndex, atLaneEnd, direction),
+                           static_cast<double>(deltaTParam * lane.length)});
+      }
+    }
+  }
+  return targets;
+}
+
+void RouteContractionHierarchy::createRawRoute(RoutingParaPoint const &origin,
+                                               std::vector<ContractionHierarchy::NodeIndex> const &path)
+{
+  point::ParaPointList rawRoute;
+  for (auto current = origin; current != start_; current = mLocalCameFrom[current])
+  {
+    rawRoute.insert(rawRoute.begin(), current.point);
+  }
+  rawRoute.insert(rawRoute.begin(), start_.point);
+  for (auto const node : path)
+  {
+    auto const &lane = mLaneGraph->getNode(ContractionHierarchy::getLaneIndex(node));
+    rawRoute.push_back(
+      point::createParaPoint(lane.id, physics::ParametricValue(ContractionHierarchy::isAtLaneEnd(node) ? 1. : 0.)));
+  }
+  if (rawRoute.back() != dest_.point)
+  {
+    rawRoute.push_back(dest_.point);
+  }
+  raw_routes.push_back(rawRoute);
+}
+
+} // namespace planning
+} // namespace route
+} // namespace map
+} // namespace ad
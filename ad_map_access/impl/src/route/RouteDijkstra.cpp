@@ -0,0 +1,211 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/route/RouteDijkstra.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "RouteAStarCost.hpp"
+
+namespace ad {
+namespace map {
+namespace route {
+namespace planning {
+
+RouteDijkstra::RouteDijkstra(const RoutingParaPoint &start, std::vector<RoutingParaPoint> const &dest, Type typ)
+  : RouteExpander(start, dest.empty() ? start : dest.front(), typ)
+  , mDestinations(dest)
+{
+  // ensure the lanes are present like RouteAstar does
+  if (mLaneGraph->findNode(start.point.laneId) == lane::LaneGraph::cInvalidNodeIndex)
+  {
+    throw std::runtime_error("Start lane not found!");
+  }
+  for (std::size_t destIndex = 0u; destIndex < mDestinations.size(); ++destIndex)
+  {
+    if (mLaneGraph->findNode(mDestinations[destIndex].point.laneId) == lane::LaneGraph::cInvalidNodeIndex)
+    {
+      throw std::runtime_error("Dest lane not found!");
+    }
+    mDestinationsOnLane.insert({mDestinations[destIndex].point.laneId, destIndex});
+  }
+}
+
+bool RouteDijkstra::calculate()
+{
+  mProcessedPoints.clear();
+  mProcessingMap.clear();
+  mCameFrom.clear();
+  raw_routes.assign(mDestinations.size(), point::ParaPointList());
+  mDestinationCosts.assign(mDestinations.size(), std::numeric_limits<physics::Distance>::max());
+  mDestinationPredecessors.assign(mDestinations.size(), start_);
+
+  mDestinationQueue = DestinationQueue();
+  std::vector<bool> destinationReached(mDestinations.size(), false);
+  std::size_t openDestinations = mDestinations.size();
+
+  mProcessingMap.insert(start_, physics::Distance(0.));
+  while (!mProcessingMap.empty() && (openDestinations > 0u))
+  {
+    auto minimum_cost_iterator = mProcessingMap.top();
+    RoutingPoint const minimum_value(minimum_cost_iterator->first, minimum_cost_iterator->second.value);
+
+    // all destinations not more expensive than the cheapest point left are final
+    while (!mDestinationQueue.empty()
+           && (mDestinationQueue.top().first <= static_cast<double>(minimum_value.second)))
+    {
+      auto const destIndex = mDestinationQueue.top().second;
+      mDestinationQueue.pop();
+      if (!destinationReached[destIndex])
+      {
+        destinationReached[destIndex] = true;
+        openDestinations--;
+      }
+    }
+    if (openDestinations == 0u)
+    {
+      break;
+    }
+
+    mProcessingMap.erase(minimum_cost_iterator);
+    mProcessedPoints.insert(minimum_value.first);
+    expandNeighbors(minimum_value);
+    addDestinations(minimum_value);
+  }
+
+  valid_ = false;
+  for (std::size_t destIndex = 0u; destIndex < mDestinations.size(); ++destIndex)
+  {
+    if (mDestinationCosts[destIndex] != std::numeric_limits<physics::Distance>::max())
+    {
+      reconstructPath(destIndex);
+      valid_ = true;
+    }
+  }
+
+  mProcessedPoints.clear();
+  mProcessingMap.clear();
+  mCameFrom.clear();
+  mDestinationQueue = DestinationQueue();
+
+  return valid_;
+}
+
+void RouteDijkstra::addNeighbor(lane::LaneGraph::Node const &originLane,
+                                RoutingPoint const &origin,
+                                lane::LaneGraph::Node const &neighborLane,
+                                RoutingParaPoint const &neighbor,
+                                ExpandReason const &expandReason)
+{
+  (void)neighborLane;
+  if (mProcessedPoints.find(neighbor) != mProcessedPoints.end())
+  {
+    return;
+  }
+
+  physics::Distance cost = origin.second;
+  switch (expandReason)
+  {
+    case ExpandReason::Destination:
+    {
+      // the destinations are handled by addDestinations()
+      return;
+    }
+    case ExpandReason::SameLaneNeighbor:
+    {
+      auto const deltaTParam = std::fabs(origin.first.point.parametricOffset - neighbor.point.parametricOffset);
+      cost += deltaTParam * originLane.length;
+      break;
+    }
+    case ExpandReason::LongitudinalNeighbor:
+    {
+      cost += COST_LONGITUDINAL;
+      break;
+    }
+    case ExpandReason::LateralNeighbor:
+    {
+      cost += COST_LATERAL;
+      break;
+    }
+    default:
+      throw std::runtime_error("RouteDijkstra::AddNeighbor>> Unsupported expand reason!");
+      break;
+  }
+
+  auto insert_result = mProcessingMap.insert(neighbor, cost);
+  if (insert_result.second || (static_cast<double>(cost) < static_cast<double>(insert_result.first->second.value)))
+  {
+    insert_result.first->second.value = cost;
+    mProcessingMap.update(insert_result.first);
+    mCameFrom[neighbor] = origin.first;
+  }
+}
+
+void RouteDijkstra::addDestinations(RoutingPoint const &origin)
+{
+  auto const destinations = mDestinationsOnLane.equal_range(origin.first.point.laneId);
+  if (destinations.first == destinations.second)
+  {
+    return;
+  }
+  auto const &lane = mLaneGraph->getNode(origin.first.point.laneId);
+  for (auto it = destinations.first; it != destinations.second; ++it)
+  {
+    auto const destIndex = it->second;
+    auto const &dest = mDestinations[destIndex];
+    physics::Distance cost = std::numeric_limits<physics::Distance>::max();
+    if (((dest.direction == RoutingDirection::DONT_CARE) || (dest.direction == origin.first.direction))
+        && (dest.point == origin.first.point))
+    {
+      cost = origin.second;
+    }
+    else if (lane.routeable
+             && ((isPositiveMovement(lane, origin)
+                  && (origin.first.point.parametricOffset <= dest.point.parametricOffset))
+                 || (isNegativeMovement(lane, origin)
+                     && (origin.first.point.parametricOffset >= dest.point.parametricOffset))))
+    {
+      auto const deltaTParam = std::fabs(origin.first.point.parametricOffset - dest.point.parametricOffset);
+      cost = origin.second + deltaTParam * lane.length;
+    }
+    if (static_cast<double>(cost) < static_cast<double>(mDestinationCosts[destIndex]))
+    {
+      mDestinationCosts[destIndex] = cost;
+      mDestinationPredecessors[destIndex] = origin.first;
+      mDestinationQueue.push({static_cast<double>(cost), destIndex});
+    }
+  }
+}
+
+void RouteDijkstra::reconstructPath(std::size_t const destIndex)
+{
+  point::ParaPointList &raw_route = raw_routes[destIndex];
+  for (auto current = mDestinationPredecessors[destIndex];;)
+  {
+    raw_route.insert(raw_route.begin(), current.point);
+    auto it = mCameFrom.find(current);
+    if (it == mCameFrom.end())
+    {
+      break;
+    }
+    else
+    {
+      current = it->second;
+    }
+  }
+  if (raw_route.back() != mDestinations[destIndex].point)
+  {
+    raw_route.push_back(mDestinations[destIndex].point);
+  }
+}
+
+} // namespace planning
+} // namespace route
+} // namespace map
+} // namespace ad
@@ -758,6 +758,7 @@ bool intersectionOnConnectedRoute(route::ConnectingRoute const &connectingRoute)
 
 bool shortenRoute(point::ParaPointList const &currentPositions, route::FullRoute &route)
 {
+  access::QueryScope queryScope;
   if (route.roadSegments.empty())
   {
     return false;
@@ -802,7 +803,7 @@ bool shortenRoute(point::ParaPointList const &currentPositions, route::FullRoute
       {
         if (laneSegmentIter->laneInterval.laneId != findWaypointResult.queryPosition.laneId)
         {
-          auto lane = lane::getLane(laneSegmentIter->laneInterval.laneId);
+          auto const &lane = lane::getLane(laneSegmentIter->laneInterval.laneId);
 
           const auto startOffset = findWaypointResult.queryPosition.parametricOffset;
           laneSegmentIter->laneInterval.start = point::findNearestPointOnEdge(
@@ -1498,7 +1499,8 @@ void appendLaneSegmentToRoute(route::LaneInterval const &laneInterval,
                               route::RoadSegmentList &roadSegmentList,
                               route::SegmentCounter const segmentCountFromDestination)
 {
-  auto lane = lane::getLane(laneInterval.laneId);
+  access::QueryScope queryScope;
+  auto const &lane = lane::getLane(laneInterval.laneId);
 
   route::RoadSegment roadSegment;
   roadSegment.boundingSphere = lane.boundingSphere;
@@ -1538,7 +1540,8 @@ void appendRoadSegmentToRoute(route::LaneInterval const &laneInterval,
                               route::SegmentCounter const segmentCountFromDestination,
                               RouteCreationMode const routeCreationMode)
 {
-  auto lane = lane::getLane(laneInterval.laneId);
+  access::QueryScope queryScope;
+  auto const &lane = lane::getLane(laneInterval.laneId);
 
   route::RoadSegment roadSegment;
   roadSegment.boundingSphere = lane.boundingSphere;
@@ -1719,6 +1722,7 @@ bool addOpposingLaneToRoute(point::ParaPoint const &pointOnOppositeLane,
                             route::FullRoute &route,
                             physics::Distance &coveredDistance)
 {
+  access::QueryScope queryScope;
   coveredDistance = physics::Distance(0.);
   uint32_t segmentCounter = 0;
   point::ParaPoint startPoint = pointOnOppositeLane;
@@ -1821,6 +1825,7 @@ route::FullRoute getRouteExpandedToAllNeighborLanes(route::FullRoute const &rout
 
 bool calculateBypassingRoute(route::FullRoute const &route, route::FullRoute &bypassingRoute)
 {
+  access::QueryScope queryScope;
   bypassingRoute = route::FullRoute();
 
   for (const auto &segment : route.roadSegments)
@@ -1850,7 +1855,7 @@ bool calculateBypassingRoute(route::FullRoute const &route, route::FullRoute &by
     bool useLeftNeighbor = isRouteDirectionPositive(laneSegment.laneInterval);
     useLeftNeighbor = useLeftNeighbor ^ access::isLeftHandedTraffic();
 
-    auto lane = lane::getLane(laneSegment.laneInterval.laneId);
+    auto const &lane = lane::getLane(laneSegment.laneInterval.laneId);
     lane::ContactLaneList contactLanes;
     if (useLeftNeighbor)
     {
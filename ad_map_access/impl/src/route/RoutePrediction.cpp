@@ -42,6 +42,24 @@ namespace map {
 namespace route {
 namespace planning {
 
+/**
+ * @returns the center point of the lane at the given offset; the points at the lane ends are taken from the graph
+ */
+static point::ECEFPoint getCenterPoint(lane::LaneGraph const &laneGraph,
+                                       lane::LaneGraph::Node const &lane,
+                                       physics::ParametricValue const &offset)
+{
+  if (offset == physics::ParametricValue(0.))
+  {
+    return lane.startPoint;
+  }
+  if (offset == physics::ParametricValue(1.))
+  {
+    return lane.endPoint;
+  }
+  return getParametricPoint(*laneGraph.getLane(lane), offset, physics::ParametricValue(0.5));
+}
+
 RoutePrediction::RoutePrediction(const RoutingParaPoint &start,
                                  physics::Distance const &predictionDistance,
                                  physics::Duration const &predictionDuration)
@@ -84,9 +102,9 @@ bool RoutePrediction::calculate()
   return isValid();
 }
 
-void RoutePrediction::addNeighbor(lane::Lane::ConstPtr originLane,
+void RoutePrediction::addNeighbor(lane::LaneGraph::Node const &originLane,
                                   RoutingPoint const &origin,
-                                  lane::Lane::ConstPtr neighborLane,
+                                  lane::LaneGraph::Node const &neighborLane,
                                   RoutingParaPoint const &neighbor,
                                   ExpandReason const &expandReason)
 {
@@ -112,10 +130,8 @@ void RoutePrediction::addNeighbor(lane::Lane::ConstPtr originLane,
   physics::Duration neighborDuration{0.};
   if ((expandReason == ExpandReason::SameLaneNeighbor) || (expandReason == ExpandReason::LateralNeighbor))
   {
-    point::ECEFPoint pt_origin
-      = getParametricPoint(*originLane, origin.first.point.parametricOffset, physics::ParametricValue(0.5));
-    point::ECEFPoint pt_neighbor
-      = getParametricPoint(*neighborLane, neighbor.point.parametricOffset, physics::ParametricValue(0.5));
+    point::ECEFPoint pt_origin = getCenterPoint(*mLaneGraph, originLane, origin.first.point.parametricOffset);
+    point::ECEFPoint pt_neighbor = getCenterPoint(*mLaneGraph, neighborLane, neighbor.point.parametricOffset);
     neighborDistance = point::distance(pt_neighbor, pt_origin);
     physics::ParametricRange drivingRange;
     if (origin.first.point.parametricOffset < neighbor.point.parametricOffset)
@@ -129,13 +145,19 @@ void RoutePrediction::addNeighbor(lane::Lane::ConstPtr originLane,
       drivingRange.maximum = origin.first.point.parametricOffset;
     }
 
-    if (expandReason == ExpandReason::SameLaneNeighbor)
+    if ((expandReason == ExpandReason::SameLaneNeighbor) && (drivingRange.minimum == physics::ParametricValue(0.))
+        && (drivingRange.maximum == physics::ParametricValue(1.)))
+    {
+      // passing the whole lane, as for all lanes entered at their start or end
+      neighborDuration = originLane.duration;
+    }
+    else if (expandReason == ExpandReason::SameLaneNeighbor)
     {
-      neighborDuration = getDuration(*originLane, drivingRange);
+      neighborDuration = getDuration(*mLaneGraph->getLane(originLane), drivingRange);
     }
     else
     {
-      neighborDuration = neighborDistance / getMaxSpeed(*originLane, drivingRange);
+      neighborDuration = neighborDistance / getMaxSpeed(*mLaneGraph->getLane(originLane), drivingRange);
     }
   }
   if (neighborDistance < physics::Distance(0.1))
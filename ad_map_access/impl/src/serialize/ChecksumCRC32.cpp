@@ -7,12 +7,28 @@
 // ----------------- END LICENSE BLOCK -----------------------------------
 
 #include "ad/map/serialize/ChecksumCRC32.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "../access/WorkerPool.hpp"
 #include "ad/map/access/Logging.hpp"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AD_MAP_CRC32_PCLMUL 1
+#include <immintrin.h>
+#else
+#define AD_MAP_CRC32_PCLMUL 0
+#endif
+
 namespace ad {
 namespace map {
 namespace serialize {
 
+constexpr size_t ChecksumCRC32::PARALLEL_CHUNK_BYTES;
+
 /////////////////////////
 // Constructor/Destructor
 
@@ -59,6 +75,273 @@ static uint32_t crc32_tab[]
      0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
      0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d};
 
+// Tables for processing eight bytes at once: crc32_slices[k][n] is the CRC of byte n followed by k zero bytes
+struct CRC32Slices
+{
+  CRC32Slices()
+  {
+    for (size_t n = 0; n < 256u; ++n)
+    {
+      table[0][n] = crc32_tab[n];
+    }
+    for (size_t k = 1; k < 8u; ++k)
+    {
+      for (size_t n = 0; n < 256u; ++n)
+      {
+        table[k][n] = (table[k - 1][n] >> 8) ^ crc32_tab[table[k - 1][n] & 0xFF];
+      }
+    }
+  }
+
+  uint32_t table[8][256];
+};
+
+static CRC32Slices const &crc32Slices()
+{
+  static CRC32Slices const slices;
+  return slices;
+}
+
+/////////////////
+// Implementation
+
+// All implementations work on the inverted CRC and deliver identical results.
+typedef uint32_t (*CRC32Function)(uint32_t crc, const uint8_t *p, size_t bytes);
+
+static uint32_t crc32SliceBy8(uint32_t crc, const uint8_t *p, size_t bytes)
+{
+  if (bytes >= 8u)
+  {
+    auto const &t = crc32Slices().table;
+    do
+    {
+      uint64_t word;
+      std::memcpy(&word, p, sizeof(word));
+      word ^= crc;
+      crc = t[7][word & 0xFF] ^ t[6][(word >> 8) & 0xFF] ^ t[5][(word >> 16) & 0xFF] ^ t[4][(word >> 24) & 0xFF]
+        ^ t[3][(word >> 32) & 0xFF] ^ t[2][(word >> 40) & 0xFF] ^ t[1][(word >> 48) & 0xFF] ^ t[0][word >> 56];
+      p += 8;
+      bytes -= 8u;
+    } while (bytes >= 8u);
+  }
+  while (bytes--)
+  {
+    crc = crc32_tab[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if AD_MAP_CRC32_PCLMUL
+
+// fold the 128 bits of x into the next 128 bits of data
+__attribute__((target("pclmul,sse4.1"))) static inline __m128i crc32Fold(__m128i x, __m128i next, __m128i k)
+{
+  return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), next), _mm_clmulepi64_si128(x, k, 0x00));
+}
+
+// Folding with carry-less multiplication, see Intel: "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+// Instruction". Processes 64 bytes or more; the remainder which doesn't fill 16 bytes is handled by slice-by-8.
+__attribute__((target("pclmul,sse4.1"))) static uint32_t crc32Pclmul(uint32_t crc, const uint8_t *p, size_t bytes)
+{
+  if (bytes < 64u)
+  {
+    return crc32SliceBy8(crc, p, bytes);
+  }
+
+  alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+  alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+  alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+  alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+  size_t const remainder = bytes & 15u;
+  bytes -= remainder;
+
+  auto load = [](const uint8_t *data) { return _mm_loadu_si128(reinterpret_cast<__m128i const *>(data)); };
+
+  __m128i x1 = _mm_xor_si128(load(p), _mm_cvtsi32_si128(static_cast<int>(crc)));
+  __m128i x2 = load(p + 16);
+  __m128i x3 = load(p + 32);
+  __m128i x4 = load(p + 48);
+  __m128i x0 = _mm_load_si128(reinterpret_cast<__m128i const *>(k1k2));
+  p += 64;
+  bytes -= 64u;
+
+  // fold four 128 bit lanes in parallel
+  while (bytes >= 64u)
+  {
+    x1 = crc32Fold(x1, load(p), x0);
+    x2 = crc32Fold(x2, load(p + 16), x0);
+    x3 = crc32Fold(x3, load(p + 32), x0);
+    x4 = crc32Fold(x4, load(p + 48), x0);
+    p += 64;
+    bytes -= 64u;
+  }
+
+  // fold the four lanes and the remaining 16 byte blocks into a single lane
+  x0 = _mm_load_si128(reinterpret_cast<__m128i const *>(k3k4));
+  x1 = crc32Fold(x1, x2, x0);
+  x1 = crc32Fold(x1, x3, x0);
+  x1 = crc32Fold(x1, x4, x0);
+  while (bytes >= 16u)
+  {
+    x1 = crc32Fold(x1, load(p), x0);
+    p += 16;
+    bytes -= 16u;
+  }
+
+  // fold 128 bits to 64 bits
+  __m128i const mask = _mm_setr_epi32(~0, 0, ~0, 0);
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x0 = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(k5k0));
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), x0, 0x00), x2);
+
+  // Barrett reduction to 32 bits
+  x0 = _mm_load_si128(reinterpret_cast<__m128i const *>(poly));
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), x0, 0x10);
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return crc32SliceBy8(static_cast<uint32_t>(_mm_extract_epi32(x1, 1)), p, remainder);
+}
+
+#endif
+
+static CRC32Function selectCRC32Function()
+{
+#if AD_MAP_CRC32_PCLMUL
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+  {
+    return crc32Pclmul;
+  }
+#endif
+  return crc32SliceBy8;
+}
+
+// GF(2) matrix helpers for combining CRCs, see zlib crc32_combine()
+static uint32_t gf2MatrixTimes(uint32_t const *matrix, uint32_t vector)
+{
+  uint32_t sum = 0;
+  while (vector != 0u)
+  {
+    if ((vector & 1u) != 0u)
+    {
+      sum ^= *matrix;
+    }
+    vector >>= 1;
+    matrix++;
+  }
+  return sum;
+}
+
+static void gf2MatrixSquare(uint32_t *square, uint32_t const *matrix)
+{
+  for (size_t n = 0; n < 32u; ++n)
+  {
+    square[n] = gf2MatrixTimes(matrix, matrix[n]);
+  }
+}
+
+////////////
+// Operations
+
+uint32_t ChecksumCRC32::calculate(uint32_t crc, const void *x, size_t bytes)
+{
+  auto const p = reinterpret_cast<const uint8_t *>(x);
+  // most updates are single values, for which the dispatch doesn't pay off
+  if (bytes < 64u)
+  {
+    return ~crc32SliceBy8(~crc, p, bytes);
+  }
+  static CRC32Function const crc32Function = selectCRC32Function();
+  return ~crc32Function(~crc, p, bytes);
+}
+
+uint32_t ChecksumCRC32::calculateParallel(uint32_t crc, const void *x, size_t bytes, size_t maxThreads)
+{
+  if (bytes < 2u * PARALLEL_CHUNK_BYTES)
+  {
+    return calculate(crc, x, bytes);
+  }
+  if (maxThreads == 0u)
+  {
+    static size_t const hardwareThreads = std::thread::hardware_concurrency();
+    maxThreads = hardwareThreads;
+  }
+  size_t const chunkCount = std::min(maxThreads, bytes / PARALLEL_CHUNK_BYTES);
+  if (chunkCount < 2u)
+  {
+    return calculate(crc, x, bytes);
+  }
+
+  const uint8_t *p = reinterpret_cast<const uint8_t *>(x);
+  size_t const chunkBytes = bytes / chunkCount;
+  auto const getChunkSize = [bytes, chunkBytes, chunkCount](size_t const i) {
+    return (i + 1u == chunkCount) ? bytes - i * chunkBytes : chunkBytes;
+  };
+  std::vector<uint32_t> chunkCrcs(chunkCount, 0u);
+  std::atomic<size_t> nextChunk{0u};
+  access::WorkerPool::getInstance().run(chunkCount - 1u, [&]() {
+    for (auto i = nextChunk++; i < chunkCount; i = nextChunk++)
+    {
+      chunkCrcs[i] = calculate(0u, p + i * chunkBytes, getChunkSize(i));
+    }
+  });
+  crc = combine(crc, chunkCrcs[0], chunkBytes);
+  for (size_t i = 1u; i < chunkCount; ++i)
+  {
+    crc = combine(crc, chunkCrcs[i], getChunkSize(i));
+  }
+  return crc;
+}
+
+uint32_t ChecksumCRC32::combine(uint32_t crc1, uint32_t crc2, size_t bytes2)
+{
+  if (bytes2 == 0u)
+  {
+    return crc1;
+  }
+
+  // operator for one zero bit
+  uint32_t odd[32];
+  odd[0] = 0xedb88320;
+  uint32_t row = 1;
+  for (size_t n = 1; n < 32u; ++n)
+  {
+    odd[n] = row;
+    row <<= 1;
+  }
+  // operators for two and four zero bits
+  uint32_t even[32];
+  gf2MatrixSquare(even, odd);
+  gf2MatrixSquare(odd, even);
+
+  // apply the operator for one zero byte first, then square it for each further bit of bytes2
+  do
+  {
+    gf2MatrixSquare(even, odd);
+    if ((bytes2 & 1u) != 0u)
+    {
+      crc1 = gf2MatrixTimes(even, crc1);
+    }
+    bytes2 >>= 1;
+    if (bytes2 == 0u)
+    {
+      break;
+    }
+    gf2MatrixSquare(odd, even);
+    if ((bytes2 & 1u) != 0u)
+    {
+      crc1 = gf2MatrixTimes(odd, crc1);
+    }
+    bytes2 >>= 1;
+  } while (bytes2 != 0u);
+
+  return crc1 ^ crc2;
+}
+
 //////////////////////
 // Overriden IChecksum
 
@@ -69,13 +352,7 @@ void ChecksumCRC32::initChecksum()
 
 void ChecksumCRC32::updateChecksum(const void *x, size_t bytes)
 {
-  const uint8_t *p = reinterpret_cast<const uint8_t *>(x);
-  mCrc ^= ~0U;
-  while (bytes--)
-  {
-    mCrc = crc32_tab[(mCrc ^ *p++) & 0xFF] ^ (mCrc >> 8);
-  }
-  mCrc ^= ~0U;
+  mCrc = calculateParallel(mCrc, x, bytes);
 }
 
 bool ChecksumCRC32::writeChecksum()
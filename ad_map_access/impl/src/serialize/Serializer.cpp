@@ -18,7 +18,10 @@ namespace serialize {
 
 size_t Serializer::MAGIC = 0x03082018;
 size_t Serializer::VERSION_MAJOR = 0;
-size_t Serializer::VERSION_MINOR = 4;
+size_t Serializer::VERSION_MINOR = 7;
+size_t Serializer::VERSION_MINOR_UNSECTIONED = 4;
+
+constexpr size_t ISerializer::MAX_BLOCK_BYTES;
 
 /////////////////////////
 // Constructor/Destructor
@@ -86,15 +89,20 @@ bool Serializer::openForRead(std::string const &config, size_t &version_major, s
     {
       if (magic == MAGIC)
       {
-        if (version_major == VERSION_MAJOR && version_minor == VERSION_MINOR)
+        if (version_major == VERSION_MAJOR
+            && (version_minor == VERSION_MINOR || version_minor == VERSION_MINOR_UNSECTIONED))
         {
+          setUseSections(version_minor != VERSION_MINOR_UNSECTIONED);
           open_ = true;
           return true;
         }
         else
         {
-          access::getLogger()->error(
-            "Serializer: Version mismatch: Expected {}, Found {}", VERSION_MAJOR, version_major);
+          access::getLogger()->error("Serializer: Version mismatch: Expected {}.{}, Found {}.{}",
+                                     VERSION_MAJOR,
+                                     VERSION_MINOR,
+                                     version_major,
+                                     version_minor);
           throw std::runtime_error("Wrong map version!");
         }
       }
@@ -123,6 +131,7 @@ bool Serializer::openForWrite(std::string const &config)
     initChecksum();
     if (ISerializer::serialize(MAGIC) && ISerializer::serialize(VERSION_MAJOR) && ISerializer::serialize(VERSION_MINOR))
     {
+      setUseSections(true);
       open_ = true;
       return true;
     }
@@ -204,6 +213,16 @@ bool Serializer::read(void *x, size_t bytes)
   }
 }
 
+uint8_t const *Serializer::readInPlace(size_t bytes)
+{
+  auto const data = doReadInPlace(bytes);
+  if ((data != nullptr) && calc_checksum_)
+  {
+    updateChecksum(data, bytes);
+  }
+  return data;
+}
+
 } // namespace serialize
 } // namespace map
 } // namespace ad
@@ -0,0 +1,77 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/serialize/SerializerBuffer.hpp"
+
+#include <cstring>
+#include "ad/map/access/Logging.hpp"
+
+namespace ad {
+namespace map {
+namespace serialize {
+
+/////////////////////////
+// Constructor/Destructor
+
+SerializerBuffer::SerializerBuffer()
+  : ISerializer(true)
+  , data_(nullptr)
+  , size_(0)
+  , position_(0)
+{
+}
+
+SerializerBuffer::SerializerBuffer(uint8_t const *data, size_t bytes)
+  : ISerializer(false)
+  , data_(data)
+  , size_(bytes)
+  , position_(0)
+{
+}
+
+//////////////
+// Aux Methods
+
+bool SerializerBuffer::write(const void *x, size_t bytes)
+{
+  if (!isStoring())
+  {
+    access::getLogger()->error("SerializerBuffer: Cannot write to read-only buffer.");
+    return false;
+  }
+  auto const p = reinterpret_cast<uint8_t const *>(x);
+  buffer_.insert(buffer_.end(), p, p + bytes);
+  return true;
+}
+
+bool SerializerBuffer::read(void *x, size_t bytes)
+{
+  if (isStoring() || (bytes > size_ - position_))
+  {
+    access::getLogger()->error("SerializerBuffer: Unable to read {} bytes", bytes);
+    return false;
+  }
+  std::memcpy(x, data_ + position_, bytes);
+  position_ += bytes;
+  return true;
+}
+
+uint8_t const *SerializerBuffer::readInPlace(size_t bytes)
+{
+  if (isStoring() || (bytes > size_ - position_))
+  {
+    return nullptr;
+  }
+  auto const data = data_ + position_;
+  position_ += bytes;
+  return data;
+}
+
+} // namespace serialize
+} // namespace map
+} // namespace ad
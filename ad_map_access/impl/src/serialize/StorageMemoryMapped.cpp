@@ -0,0 +1,148 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include "ad/map/serialize/StorageMemoryMapped.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ad/map/access/Logging.hpp"
+
+namespace ad {
+namespace map {
+namespace serialize {
+
+StorageMemoryMapped::StorageMemoryMapped()
+{
+  data_ = nullptr;
+  size_ = 0;
+  position_ = 0;
+}
+
+StorageMemoryMapped::~StorageMemoryMapped()
+{
+  if (data_ != nullptr)
+  {
+    access::getLogger()->error("StorageMemoryMapped::dtor: File is not closed!");
+    doCloseForRead();
+  }
+}
+
+//////////////////////////
+// IStorage Implementation
+
+bool StorageMemoryMapped::doOpenForRead(std::string const &config)
+{
+  if (data_ != nullptr)
+  {
+    access::getLogger()->error("StorageMemoryMapped::DoOpen: File already open! {}", config);
+    return false;
+  }
+  int const fd = open(config.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat fileStat;
+  if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0))
+  {
+    close(fd);
+    return false;
+  }
+  auto const size = static_cast<std::size_t>(fileStat.st_size);
+  void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after closing the file descriptor
+  close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    access::getLogger()->error("StorageMemoryMapped::DoOpen: Unable to map file {}", config);
+    return false;
+  }
+  // the map is read once from start to end; madvise() takes a single advice per call
+  // the advice only affects the performance, so failing calls don't fail the opening
+  if (madvise(mapping, size, MADV_SEQUENTIAL) != 0)
+  {
+    access::getLogger()->warn("StorageMemoryMapped::DoOpen: madvise(MADV_SEQUENTIAL) failed for {}", config);
+  }
+  if (madvise(mapping, size, MADV_WILLNEED) != 0)
+  {
+    access::getLogger()->warn("StorageMemoryMapped::DoOpen: madvise(MADV_WILLNEED) failed for {}", config);
+  }
+  data_ = static_cast<uint8_t const *>(mapping);
+  size_ = size;
+  position_ = 0;
+  return true;
+}
+
+bool StorageMemoryMapped::doOpenForWrite(std::string const &config)
+{
+  access::getLogger()->error("StorageMemoryMapped::DoOpen: Storage is read-only! {}", config);
+  return false;
+}
+
+bool StorageMemoryMapped::doCloseForRead()
+{
+  if (data_ != nullptr)
+  {
+    munmap(const_cast<uint8_t *>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    position_ = 0;
+    return true;
+  }
+  else
+  {
+    access::getLogger()->error("StorageMemoryMapped: Attempt to close already closed file!");
+    return false;
+  }
+}
+
+bool StorageMemoryMapped::doCloseForWrite()
+{
+  access::getLogger()->error("StorageMemoryMapped: Storage is read-only!");
+  return false;
+}
+
+bool StorageMemoryMapped::doWrite(const void *, size_t)
+{
+  access::getLogger()->error("StorageMemoryMapped::DoWrite: Storage is read-only!");
+  return false;
+}
+
+bool StorageMemoryMapped::doRead(void *x, size_t bytes)
+{
+  if (data_ == nullptr)
+  {
+    access::getLogger()->error("StorageMemoryMapped::DoRead: File not open.");
+    return false;
+  }
+  if (bytes > size_ - position_)
+  {
+    return false;
+  }
+  std::memcpy(x, data_ + position_, bytes);
+  position_ += bytes;
+  return true;
+}
+
+uint8_t const *StorageMemoryMapped::doReadInPlace(size_t bytes)
+{
+  if ((data_ == nullptr) || (bytes > size_ - position_))
+  {
+    return nullptr;
+  }
+  auto const data = data_ + position_;
+  position_ += bytes;
+  return data;
+}
+
+} // namespace serialize
+} // namespace map
+} // namespace ad
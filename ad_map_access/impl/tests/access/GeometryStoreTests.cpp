@@ -11,6 +11,7 @@
 #include <ad/map/lane/LaneOperation.hpp>
 #include <ad/map/point/Operation.hpp>
 #include <ad/map/serialize/SerializerFileCRC32.hpp>
+#include <ad/map/serialize/SerializerBuffer.hpp>
 #include <gtest/gtest.h>
 #include "../src/access/GeometryStore.hpp"
 
@@ -90,3 +91,55 @@ TEST_F(GeometryStoreTest, StoreSerialization)
   ASSERT_TRUE(storeRead2->load(serializer_r2));
   ASSERT_TRUE(serializer_r2.close());
 }
+
+TEST_F(GeometryStoreTest, QuantizedGeometry)
+{
+  ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  physics::Distance const maxError(0.001);
+  access::GeometryStore losslessStore;
+  access::GeometryStore quantizedStore(maxError);
+  auto const lanes = lane::getLanes();
+  ASSERT_GT(lanes.size(), 0u);
+  for (auto const &laneId : lanes)
+  {
+    auto lanePtr = lane::getLanePtr(laneId);
+    ASSERT_TRUE(losslessStore.store(lanePtr));
+    ASSERT_TRUE(quantizedStore.store(lanePtr));
+  }
+  serialize::SerializerBuffer losslessBuffer;
+  ASSERT_TRUE(losslessStore.serialize(losslessBuffer));
+  serialize::SerializerBuffer quantizedBuffer;
+  ASSERT_TRUE(quantizedStore.serialize(quantizedBuffer));
+  EXPECT_GT(losslessBuffer.getBuffer().size(), 3u * quantizedBuffer.getBuffer().size());
+
+  access::GeometryStore readStore;
+  serialize::SerializerBuffer readBuffer(quantizedBuffer.getBuffer().data(), quantizedBuffer.getBuffer().size());
+  ASSERT_TRUE(readStore.serialize(readBuffer));
+  ASSERT_TRUE(readBuffer.atEnd());
+  for (auto const &laneId : lanes)
+  {
+    auto lanePtr = lane::getLanePtr(laneId);
+    ASSERT_TRUE(readStore.check(lanePtr));
+    lane::Lane::Ptr restoredLane(new lane::Lane());
+    restoredLane->id = laneId;
+    ASSERT_TRUE(readStore.restore(restoredLane));
+    ASSERT_EQ(lanePtr->edgeLeft.ecefEdge.size(), restoredLane->edgeLeft.ecefEdge.size());
+    for (size_t i = 0u; i < lanePtr->edgeLeft.ecefEdge.size(); ++i)
+    {
+      EXPECT_LE(distance(lanePtr->edgeLeft.ecefEdge[i], restoredLane->edgeLeft.ecefEdge[i]), maxError);
+    }
+    ASSERT_EQ(lanePtr->edgeRight.ecefEdge.size(), restoredLane->edgeRight.ecefEdge.size());
+    for (size_t i = 0u; i < lanePtr->edgeRight.ecefEdge.size(); ++i)
+    {
+      EXPECT_LE(distance(lanePtr->edgeRight.ecefEdge[i], restoredLane->edgeRight.ecefEdge[i]), maxError);
+    }
+  }
+
+  // a store with embedded geometry checks the geometry against the quantized one
+  serialize::SerializerBuffer storeBuffer;
+  ASSERT_TRUE(access::getStore().save(storeBuffer, true, true, true, maxError));
+  serialize::SerializerBuffer storeReadBuffer(storeBuffer.getBuffer().data(), storeBuffer.getBuffer().size());
+  access::Store readStoreWithGeometry;
+  ASSERT_TRUE(readStoreWithGeometry.load(storeReadBuffer));
+  EXPECT_EQ(lanes.size(), readStoreWithGeometry.getLanes().size());
+}
@@ -0,0 +1,131 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Factory.hpp>
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/test_support/NoLogTestMacros.hpp>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "../../src/access/LaneHandleMap.hpp"
+
+using namespace ::ad;
+using namespace ::ad::map;
+
+struct LaneHandleMapTest : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+  }
+  virtual void TearDown()
+  {
+    access::cleanup();
+  }
+};
+
+TEST_F(LaneHandleMapTest, lanes_are_compacted_after_loading)
+{
+  ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  auto const &store = access::getStore();
+  auto laneIds = store.getLanes();
+  ASSERT_GT(laneIds.size(), 1u);
+  std::sort(laneIds.begin(), laneIds.end());
+
+  lane::Lane const *previousLane = nullptr;
+  for (auto const &laneId : laneIds)
+  {
+    auto const laneHandle = store.getLaneHandle(laneId);
+    ASSERT_NE(laneHandle, nullptr);
+    ASSERT_EQ(laneHandle, store.getLanePtr(laneId).get());
+    ASSERT_EQ(laneHandle, &lane::getLane(laneId));
+    ASSERT_EQ(laneId, laneHandle->id);
+    if (previousLane != nullptr)
+    {
+      ASSERT_EQ(previousLane + 1, laneHandle);
+    }
+    previousLane = laneHandle;
+  }
+
+  EXPECT_TRUE_NO_LOG(store.getLaneHandle(lane::LaneId(123456789u)) == nullptr);
+}
+
+TEST_F(LaneHandleMapTest, update_on_store_changes)
+{
+  access::Store store;
+  access::Factory factory(store);
+  lane::LaneId x1(1), x2(2), x3(3);
+  access::PartitionId p1(1), p2(2);
+
+  ASSERT_TRUE(factory.add(p1, x1, lane::LaneType::NORMAL, lane::LaneDirection::POSITIVE));
+  ASSERT_TRUE(factory.add(p2, x2, lane::LaneType::NORMAL, lane::LaneDirection::POSITIVE));
+  ASSERT_NE(store.getLaneHandle(x1), nullptr);
+  ASSERT_NE(store.getLaneHandle(x2), nullptr);
+  EXPECT_TRUE_NO_LOG(store.getLaneHandle(x3) == nullptr);
+
+  auto const lane1BeforeCompaction = store.getLanePtr(x1);
+  store.compactLanes();
+  ASSERT_NE(lane1BeforeCompaction.get(), store.getLaneHandle(x1));
+  ASSERT_EQ(store.getLaneHandle(x1) + 1, store.getLaneHandle(x2));
+  ASSERT_EQ(x1, lane1BeforeCompaction->id);
+
+  // changes by the factory are visible through the compacted lanes
+  ASSERT_FALSE(factory.add(p1, x1, lane::LaneType::SHOULDER, lane::LaneDirection::NEGATIVE));
+  ASSERT_EQ(lane::LaneType::SHOULDER, store.getLaneHandle(x1)->type);
+
+  ASSERT_TRUE(factory.add(p1, x3, lane::LaneType::NORMAL, lane::LaneDirection::POSITIVE));
+  ASSERT_NE(store.getLaneHandle(x3), nullptr);
+  ASSERT_EQ(x3, store.getLaneHandle(x3)->id);
+
+  ASSERT_TRUE(factory.deleteLane(x1));
+  EXPECT_TRUE_NO_LOG(store.getLaneHandle(x1) == nullptr);
+
+  store.removePartition(p2);
+  EXPECT_TRUE_NO_LOG(store.getLaneHandle(x2) == nullptr);
+  ASSERT_NE(store.getLaneHandle(x3), nullptr);
+}
+
+TEST_F(LaneHandleMapTest, insert_and_erase)
+{
+  std::map<lane::LaneId, lane::Lane::Ptr> laneMap;
+  for (uint64_t id = 1u; id <= 100u; ++id)
+  {
+    laneMap[lane::LaneId(id)] = std::make_shared<lane::Lane>();
+  }
+  access::LaneHandleMap handles;
+  handles.build(std::map<lane::LaneId, lane::Lane::Ptr>());
+  EXPECT_EQ(nullptr, handles.find(lane::LaneId(1u)));
+
+  // grows while inserting
+  for (auto const &id_and_lane : laneMap)
+  {
+    handles.insert(id_and_lane.first, id_and_lane.second);
+  }
+  for (auto const &id_and_lane : laneMap)
+  {
+    ASSERT_EQ(&id_and_lane.second, handles.find(id_and_lane.first));
+  }
+
+  // the remaining lanes are still found after erasing lanes within their probe sequences
+  for (uint64_t id = 1u; id <= 100u; id += 3u)
+  {
+    handles.erase(lane::LaneId(id));
+  }
+  handles.erase(lane::LaneId(1000u));
+  for (auto const &id_and_lane : laneMap)
+  {
+    if ((static_cast<uint64_t>(id_and_lane.first) - 1u) % 3u == 0u)
+    {
+      ASSERT_EQ(nullptr, handles.find(id_and_lane.first));
+    }
+    else
+    {
+      ASSERT_EQ(&id_and_lane.second, handles.find(id_and_lane.first));
+    }
+  }
+}
@@ -0,0 +1,103 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Factory.hpp>
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/point/Operation.hpp>
+#include <gtest/gtest.h>
+#include "../point/RandomGeometry.hpp"
+
+using namespace ::ad;
+using namespace ::ad::map;
+
+struct LaneSpatialIndexTest : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+  }
+  virtual void TearDown()
+  {
+    access::cleanup();
+  }
+
+  lane::LaneIdList getLanesNearBruteForce(access::Store const &store, point::BoundingSphere const &sphere)
+  {
+    lane::LaneIdList result;
+    for (auto laneId : store.getLanes())
+    {
+      auto lane = store.getLanePtr(laneId);
+      if (lane && lane::isNear(*lane, sphere))
+      {
+        result.push_back(laneId);
+      }
+    }
+    return result;
+  }
+};
+
+TEST_F(LaneSpatialIndexTest, compare_with_brute_force)
+{
+  ASSERT_TRUE(access::init("test_files/TPK_PFZ.adm.txt"));
+  auto const &store = access::getStore();
+  auto const laneIds = store.getLanes();
+  ASSERT_GT(laneIds.size(), 0u);
+
+  std::srand(42);
+  for (auto laneId : laneIds)
+  {
+    auto lane = store.getLanePtr(laneId);
+    ASSERT_TRUE(bool(lane));
+    for (auto const radius : {0., 0.5, 5., 50., 500.})
+    {
+      point::BoundingSphere sphere;
+      sphere.center = lane->boundingSphere.center
+        + point::createECEFPoint(std::rand() % 100 - 50, std::rand() % 100 - 50, std::rand() % 100 - 50);
+      sphere.radius = physics::Distance(radius);
+      ASSERT_EQ(getLanesNearBruteForce(store, sphere), store.getLanesNear(sphere));
+    }
+  }
+}
+
+TEST_F(LaneSpatialIndexTest, update_on_store_changes)
+{
+  access::Store store;
+  access::Factory factory(store);
+  lane::LaneId x1(1), x2(2);
+  access::PartitionId p1(1), p2(2);
+
+  ASSERT_TRUE(factory.add(p1, x1, lane::LaneType::NORMAL, lane::LaneDirection::POSITIVE));
+  ASSERT_TRUE(factory.add(p2, x2, lane::LaneType::NORMAL, lane::LaneDirection::POSITIVE));
+  auto edgeLeft1 = randGeometry(point::createECEFPoint(4000000, 600000, 4800000), 10, 1);
+  auto edgeRight1 = randGeometry(edgeLeft1.ecefEdge.front(), 10, 2);
+  ASSERT_TRUE(factory.set(x1, edgeLeft1, edgeRight1));
+  auto edgeLeft2 = randGeometry(point::createECEFPoint(4001000, 600000, 4800000), 10, 3);
+  auto edgeRight2 = randGeometry(edgeLeft2.ecefEdge.front(), 10, 4);
+  ASSERT_TRUE(factory.set(x2, edgeLeft2, edgeRight2));
+
+  auto sphere1 = store.getLanePtr(x1)->boundingSphere;
+  auto sphere2 = store.getLanePtr(x2)->boundingSphere;
+  ASSERT_EQ(lane::LaneIdList({x1}), store.getLanesNear(sphere1));
+  ASSERT_EQ(lane::LaneIdList({x2}), store.getLanesNear(sphere2));
+
+  // move lane 2 to the location of lane 1
+  ASSERT_TRUE(factory.set(x2, edgeLeft1, edgeRight1));
+  ASSERT_EQ(lane::LaneIdList({x1, x2}), store.getLanesNear(sphere1));
+  ASSERT_EQ(lane::LaneIdList(), store.getLanesNear(sphere2));
+
+  ASSERT_TRUE(factory.deleteLane(x1));
+  ASSERT_EQ(lane::LaneIdList({x2}), store.getLanesNear(sphere1));
+
+  store.removePartition(p2);
+  ASSERT_EQ(lane::LaneIdList(), store.getLanesNear(sphere1));
+
+  ASSERT_TRUE(factory.add(p1, x1, lane::LaneType::NORMAL, lane::LaneDirection::POSITIVE));
+  ASSERT_TRUE(factory.set(x1, edgeLeft2, edgeRight2));
+  ASSERT_EQ(lane::LaneIdList({x1}), store.getLanesNear(sphere2));
+}
@@ -0,0 +1,151 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/MapContext.hpp>
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/point/Operation.hpp>
+#include <ad/map/route/Planning.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace ::ad;
+using namespace ::ad::map;
+
+struct MapContextTest : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+  }
+  virtual void TearDown()
+  {
+    access::cleanup();
+  }
+};
+
+TEST_F(MapContextTest, context_keeps_store_alive)
+{
+  ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  auto const laneIds = lane::getLanes();
+  ASSERT_GT(laneIds.size(), 1u);
+  auto const start = route::planning::createRoutingPoint(laneIds.front(), physics::ParametricValue(0.5));
+  auto const dest = route::planning::createRoutingPoint(laneIds.back(), physics::ParametricValue(0.5));
+  auto const expectedRoute = route::planning::planRoute(start, dest);
+
+  auto context = access::createMapContext();
+  access::cleanup();
+  EXPECT_THROW(access::getStore(), std::runtime_error);
+
+  {
+    access::MapContext::Scope scope(context);
+    EXPECT_EQ(&context->getStore(), &access::getStore());
+    EXPECT_EQ(laneIds, lane::getLanes());
+    auto const route = route::planning::planRoute(start, dest);
+    EXPECT_EQ(expectedRoute.roadSegments.size(), route.roadSegments.size());
+  }
+  EXPECT_THROW(access::getStore(), std::runtime_error);
+}
+
+TEST_F(MapContextTest, nested_scopes)
+{
+  ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  auto const globalTransform = access::getCoordinateTransform();
+  auto outerContext = access::createMapContext();
+  auto innerContext = access::createMapContext();
+  EXPECT_EQ(nullptr, access::MapContext::getCurrent());
+  {
+    access::MapContext::Scope outerScope(outerContext);
+    EXPECT_EQ(outerContext.get(), access::MapContext::getCurrent());
+    {
+      access::MapContext::Scope innerScope(innerContext);
+      EXPECT_EQ(innerContext.get(), access::MapContext::getCurrent());
+      EXPECT_EQ(innerContext->getCoordinateTransform(), access::getCoordinateTransform());
+    }
+    EXPECT_EQ(outerContext.get(), access::MapContext::getCurrent());
+    EXPECT_EQ(outerContext->getCoordinateTransform(), access::getCoordinateTransform());
+  }
+  EXPECT_EQ(nullptr, access::MapContext::getCurrent());
+  EXPECT_EQ(globalTransform, access::getCoordinateTransform());
+}
+
+TEST_F(MapContextTest, enu_reference_per_thread)
+{
+  ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  auto const globalReference = access::getENUReferencePoint();
+  auto const laneIds = lane::getLanes();
+  auto const &lane = lane::getLane(laneIds.front());
+  auto const ecefPoint = lane.edgeLeft.ecefEdge.front();
+
+  std::vector<point::GeoPoint> const references
+    = {point::toGeo(ecefPoint), point::toGeo(lane::getLane(laneIds.back()).edgeRight.ecefEdge.back())};
+  std::vector<point::ENUPoint> results(references.size());
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0u; i < references.size(); ++i)
+  {
+    auto context = access::createMapContext();
+    workers.emplace_back([context, &references, &results, &ecefPoint, i] {
+      access::MapContext::Scope scope(context);
+      for (auto round = 0u; round < 100u; ++round)
+      {
+        access::setENUReferencePoint(references[round % references.size()]);
+        access::setENUReferencePoint(references[i]);
+        results[i] = point::toENU(ecefPoint);
+      }
+    });
+  }
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+
+  EXPECT_EQ(globalReference, access::getENUReferencePoint());
+  for (std::size_t i = 0u; i < references.size(); ++i)
+  {
+    point::CoordinateTransform coordinateTransform;
+    coordinateTransform.setENUReferencePoint(references[i]);
+    EXPECT_EQ(coordinateTransform.ECEF2ENU(ecefPoint), results[i]);
+  }
+}
+
+TEST_F(MapContextTest, worker_threads_use_context)
+{
+  ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  auto const laneIds = lane::getLanes();
+  ASSERT_GT(laneIds.size(), 1u);
+  std::vector<route::planning::RoutingParaPoint> start;
+  std::vector<route::planning::RoutingParaPoint> dest;
+  for (std::size_t i = 0u; i < 4u; ++i)
+  {
+    start.push_back(
+      route::planning::createRoutingPoint(laneIds[i * laneIds.size() / 4u], physics::ParametricValue(0.5)));
+    dest.push_back(
+      route::planning::createRoutingPoint(laneIds[laneIds.size() - 1u - i], physics::ParametricValue(0.5)));
+  }
+  auto const expectedMatrix = route::planning::calculateRouteDistanceMatrix(start, dest);
+  auto context = access::createMapContext();
+
+  // the global map differs from the one of the context
+  access::cleanup();
+  ASSERT_TRUE(access::init("test_files/LaneChange.adm.txt"));
+  ASSERT_THROW(route::planning::calculateRouteDistanceMatrix(start, dest, 4u), std::runtime_error);
+
+  access::MapContext::Scope scope(context);
+  auto const matrix = route::planning::calculateRouteDistanceMatrix(start, dest, 4u);
+  ASSERT_EQ(expectedMatrix.size(), matrix.size());
+  for (std::size_t startIndex = 0u; startIndex < start.size(); ++startIndex)
+  {
+    ASSERT_EQ(expectedMatrix[startIndex].size(), matrix[startIndex].size());
+    for (std::size_t destIndex = 0u; destIndex < dest.size(); ++destIndex)
+    {
+      EXPECT_EQ(expectedMatrix[startIndex][destIndex].routeFound, matrix[startIndex][destIndex].routeFound);
+      EXPECT_EQ(expectedMatrix[startIndex][destIndex].routeLength, matrix[startIndex][destIndex].routeLength);
+      EXPECT_EQ(expectedMatrix[startIndex][destIndex].routeDuration, matrix[startIndex][destIndex].routeDuration);
+    }
+  }
+}
@@ -0,0 +1,238 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/MapPatch.hpp>
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/serialize/SerializerFileCRC32.hpp>
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace ::ad;
+using namespace ::ad::map;
+
+struct MapPatchTest : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+    ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+    laneIds = lane::getLanes();
+    ASSERT_GT(laneIds.size(), 2u);
+  }
+
+  virtual void TearDown()
+  {
+    access::cleanup();
+  }
+
+  lane::Lane::Ptr copyLane(lane::LaneId const &laneId)
+  {
+    return std::make_shared<lane::Lane>(lane::getLane(laneId));
+  }
+
+  lane::LaneId newLaneId()
+  {
+    return lane::LaneId(static_cast<uint64_t>(*std::max_element(laneIds.begin(), laneIds.end())) + 1u);
+  }
+
+  lane::LaneIdList laneIds;
+};
+
+TEST_F(MapPatchTest, apply_patch)
+{
+  auto const unchangedLane = access::getStore().getLanePtr(laneIds[0]);
+  auto const modifiedLaneId = laneIds[1];
+  auto const oldContext = access::createMapContext();
+
+  access::MapPatch patch;
+  patch.partitionId = access::PartitionId(77);
+  auto modifiedLane = copyLane(modifiedLaneId);
+  modifiedLane->complianceVersion = lane::ComplianceVersion(42);
+  patch.modifiedLanes[modifiedLaneId] = modifiedLane;
+  auto addedLane = copyLane(laneIds[2]);
+  addedLane->id = newLaneId();
+  addedLane->contactLanes.clear();
+  patch.addedLanes[addedLane->id] = addedLane;
+  ASSERT_FALSE(patch.empty());
+  ASSERT_TRUE(access::applyPatch(patch));
+
+  EXPECT_EQ(laneIds.size() + 1u, lane::getLanes().size());
+  EXPECT_EQ(lane::ComplianceVersion(42), lane::getLane(modifiedLaneId).complianceVersion);
+  EXPECT_EQ(lane::LaneIdList({addedLane->id}), access::getStore().getLanes(access::PartitionId(77)));
+  EXPECT_EQ(unchangedLane, access::getStore().getLanePtr(laneIds[0]));
+  auto const lanesNear = access::getStore().getLanesNear(addedLane->boundingSphere);
+  EXPECT_NE(lanesNear.end(), std::find(lanesNear.begin(), lanesNear.end(), addedLane->id));
+
+  {
+    // queries within a context created before the patch see the old map
+    access::MapContext::Scope scope(oldContext);
+    EXPECT_EQ(laneIds, lane::getLanes());
+    EXPECT_NE(lane::ComplianceVersion(42), lane::getLane(modifiedLaneId).complianceVersion);
+    EXPECT_EQ(nullptr, access::getStore().getLanePtr(addedLane->id));
+  }
+
+  access::MapPatch removal;
+  removal.removedLanes.push_back(addedLane->id);
+  ASSERT_TRUE(access::applyPatch(removal));
+  EXPECT_EQ(laneIds, lane::getLanes());
+  EXPECT_TRUE(access::getStore().getLanes(access::PartitionId(77)).empty());
+}
+
+TEST_F(MapPatchTest, reject_unfitting_patch)
+{
+  auto const store = &access::getStore();
+
+  access::MapPatch existingLane;
+  existingLane.addedLanes[laneIds[0]] = copyLane(laneIds[0]);
+  EXPECT_FALSE(access::applyPatch(existingLane));
+
+  access::MapPatch missingLane;
+  auto lane = copyLane(laneIds[0]);
+  lane->id = newLaneId();
+  missingLane.modifiedLanes[lane->id] = lane;
+  EXPECT_FALSE(access::applyPatch(missingLane));
+
+  access::MapPatch mismatchingId;
+  mismatchingId.modifiedLanes[laneIds[1]] = copyLane(laneIds[0]);
+  EXPECT_FALSE(access::applyPatch(mismatchingId));
+
+  access::MapPatch referencedLane;
+  auto const &contactLanes = lane::getLane(laneIds[0]).contactLanes;
+  ASSERT_FALSE(contactLanes.empty());
+  referencedLane.removedLanes.push_back(contactLanes.front().toLane);
+  EXPECT_FALSE(access::applyPatch(referencedLane));
+
+  access::MapPatch twice;
+  twice.modifiedLanes[laneIds[0]] = copyLane(laneIds[0]);
+  twice.removedLanes.push_back(laneIds[0]);
+  EXPECT_FALSE(access::applyPatch(twice));
+
+  EXPECT_EQ(store, &access::getStore());
+  EXPECT_EQ(laneIds, lane::getLanes());
+}
+
+TEST_F(MapPatchTest, patch_file)
+{
+  access::MapPatch patch;
+  auto modifiedLane = copyLane(laneIds[0]);
+  modifiedLane->complianceVersion = lane::ComplianceVersion(42);
+  patch.modifiedLanes[laneIds[0]] = modifiedLane;
+  auto addedLane = copyLane(laneIds[1]);
+  addedLane->id = newLaneId();
+  addedLane->contactLanes.clear();
+  patch.addedLanes[addedLane->id] = addedLane;
+
+  std::string const fileName("test_files/test_map_patch.patch");
+  size_t versionMajor = serialize::SerializerFileCRC32::VERSION_MAJOR;
+  size_t versionMinor = serialize::SerializerFileCRC32::VERSION_MINOR;
+  serialize::SerializerFileCRC32 serializer(true);
+  ASSERT_TRUE(serializer.open(fileName, versionMajor, versionMinor));
+  ASSERT_TRUE(patch.serialize(serializer));
+  ASSERT_TRUE(serializer.close());
+
+  ASSERT_TRUE(access::applyPatch(fileName));
+  EXPECT_EQ(*modifiedLane, lane::getLane(laneIds[0]));
+  EXPECT_EQ(*addedLane, lane::getLane(addedLane->id));
+  EXPECT_FALSE(access::applyPatch(std::string("test_files/test_missing_map_patch.patch")));
+}
+
+TEST_F(MapPatchTest, query_scope_keeps_replaced_stores)
+{
+  auto const oldVersion = lane::getLane(laneIds[0]).complianceVersion;
+  std::weak_ptr<access::Store> replacedStore;
+  {
+    access::QueryScope queryScope;
+    auto const &oldLane = lane::getLane(laneIds[0]);
+    replacedStore = access::QueryScope::getPinnedStore();
+    for (auto round = 1u; round <= 2u; ++round)
+    {
+      access::MapPatch patch;
+      auto modifiedLane = copyLane(laneIds[0]);
+      modifiedLane->complianceVersion = oldVersion + round;
+      patch.modifiedLanes[laneIds[0]] = modifiedLane;
+      ASSERT_TRUE(access::applyPatch(patch));
+    }
+
+    // the scope keeps querying the store pinned before the patches, so its references stay valid
+    EXPECT_EQ(replacedStore.lock().get(), &access::getStore());
+    EXPECT_EQ(&oldLane, &lane::getLane(laneIds[0]));
+    EXPECT_EQ(oldVersion, oldLane.complianceVersion);
+  }
+  EXPECT_TRUE(replacedStore.expired());
+  EXPECT_EQ(oldVersion + 2u, lane::getLane(laneIds[0]).complianceVersion);
+}
+
+TEST_F(MapPatchTest, nested_query_scopes)
+{
+  auto const otherStore = std::make_shared<access::Store>();
+  access::QueryScope queryScope;
+  auto const pinnedStore = &access::getStore();
+  {
+    access::QueryScope nestedScope;
+    EXPECT_EQ(pinnedStore, &access::getStore());
+    {
+      access::QueryScope storeScope(otherStore);
+      EXPECT_EQ(otherStore.get(), &access::getStore());
+    }
+    EXPECT_EQ(pinnedStore, &access::getStore());
+  }
+  access::MapPatch patch;
+  patch.modifiedLanes[laneIds[0]] = copyLane(laneIds[0]);
+  ASSERT_TRUE(access::applyPatch(patch));
+  // lane operations open nested scopes, so they keep querying the pinned store
+  EXPECT_EQ(pinnedStore, &access::getStore());
+  EXPECT_EQ(pinnedStore->getLanePtr(laneIds[0])->length, lane::calcLength(laneIds[0]));
+  EXPECT_EQ(pinnedStore, &access::getStore());
+}
+
+TEST_F(MapPatchTest, concurrent_queries)
+{
+  auto const originalVersions = std::make_pair(lane::getLane(laneIds[0]).complianceVersion,
+                                               lane::getLane(laneIds[1]).complianceVersion);
+  std::atomic<bool> patching{true};
+  std::atomic<std::size_t> inconsistencies{0u};
+  std::vector<std::thread> readers;
+  for (auto i = 0u; i < 2u; ++i)
+  {
+    readers.emplace_back([&, i] {
+      while (patching)
+      {
+        // the first reader queries within a context, the second one within a query scope
+        access::MapContext::Scope scope((i == 0u) ? access::createMapContext() : nullptr);
+        access::QueryScope queryScope;
+        // both lanes are changed by the same patch, so their changes always have to match within a scope
+        if (lane::getLane(laneIds[0]).complianceVersion - originalVersions.first
+            != lane::getLane(laneIds[1]).complianceVersion - originalVersions.second)
+        {
+          ++inconsistencies;
+        }
+      }
+    });
+  }
+  for (auto round = 1u; round <= 20u; ++round)
+  {
+    access::MapPatch patch;
+    auto firstLane = copyLane(laneIds[0]);
+    firstLane->complianceVersion = originalVersions.first + round;
+    patch.modifiedLanes[laneIds[0]] = firstLane;
+    auto secondLane = copyLane(laneIds[1]);
+    secondLane->complianceVersion = originalVersions.second + round;
+    patch.modifiedLanes[laneIds[1]] = secondLane;
+    EXPECT_TRUE(access::applyPatch(patch));
+  }
+  patching = false;
+  for (auto &reader : readers)
+  {
+    reader.join();
+  }
+  EXPECT_EQ(0u, inconsistencies);
+  EXPECT_EQ(originalVersions.first + 20u, lane::getLane(laneIds[0]).complianceVersion);
+}
@@ -0,0 +1,262 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Factory.hpp>
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneGraph.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/point/Operation.hpp>
+#include <ad/map/serialize/SerializerFileCRC32.hpp>
+#include <gtest/gtest.h>
+#include "../point/RandomGeometry.hpp"
+
+using namespace ::ad;
+using namespace ::ad::map;
+
+struct StorePagingTest : ::testing::Test
+{
+  static constexpr uint64_t PARTITIONS = 8u;
+  static constexpr uint64_t LANES_PER_PARTITION = 80u;
+
+  virtual void SetUp()
+  {
+    // partitions 1km apart from each other, each of them spread over several sections
+    access::Factory factory(store);
+    for (uint64_t p = 0u; p < PARTITIONS; ++p)
+    {
+      for (uint64_t l = 0u; l < LANES_PER_PARTITION; ++l)
+      {
+        auto const laneId = getLaneId(p, l);
+        ASSERT_TRUE(factory.add(access::PartitionId(p), laneId, lane::LaneType::NORMAL, lane::LaneDirection::POSITIVE));
+        auto const start = point::createECEFPoint(
+          4000000. + 1000. * static_cast<double>(p), 600000. + 5. * static_cast<double>(l), 4800000.);
+        auto const seed = static_cast<uint32_t>(p * 1000u + l);
+        auto edgeLeft = randGeometry(start, 10, seed);
+        auto edgeRight = randGeometry(edgeLeft.ecefEdge.front(), 10, seed + PARTITIONS * 1000u);
+        ASSERT_TRUE(factory.set(laneId, edgeLeft, edgeRight));
+      }
+    }
+    size_t versionMajor = 0u;
+    size_t versionMinor = 0u;
+    serialize::SerializerFileCRC32 serializer(true);
+    ASSERT_TRUE(serializer.open(fileName, versionMajor, versionMinor));
+    ASSERT_TRUE(store.save(serializer));
+    ASSERT_TRUE(serializer.close());
+  }
+
+  lane::LaneId getLaneId(uint64_t partition, uint64_t lane)
+  {
+    return lane::LaneId(partition * 1000u + lane + 1u);
+  }
+
+  void expectLane(access::Store const &pagedStore, lane::LaneId const &laneId)
+  {
+    auto expected = store.getLanePtr(laneId);
+    auto actual = pagedStore.getLanePtr(laneId);
+    ASSERT_TRUE(bool(actual));
+    EXPECT_EQ(expected->boundingSphere, actual->boundingSphere);
+    EXPECT_EQ(expected->edgeLeft.ecefEdge, actual->edgeLeft.ecefEdge);
+    EXPECT_EQ(expected->edgeRight.ecefEdge, actual->edgeRight.ecefEdge);
+  }
+
+  access::Store store;
+  char const *fileName = "test_files/test_paging.adm";
+};
+
+constexpr uint64_t StorePagingTest::PARTITIONS;
+constexpr uint64_t StorePagingTest::LANES_PER_PARTITION;
+
+TEST_F(StorePagingTest, load_on_demand)
+{
+  access::Store pagedStore;
+  ASSERT_TRUE(pagedStore.openPaged(fileName, std::numeric_limits<std::size_t>::max()));
+  ASSERT_TRUE(pagedStore.isPaged());
+  EXPECT_FALSE(pagedStore.empty());
+  EXPECT_EQ(store.isValid(), pagedStore.isValid());
+  EXPECT_EQ(store.getLanes(), pagedStore.getLanes());
+  EXPECT_EQ(PARTITIONS, pagedStore.getPartitions().size());
+  EXPECT_EQ(0u, pagedStore.getPagingStatistics().loads);
+  // filtering covers all partitions without making them resident
+  EXPECT_EQ(store.getLanes("NORMAL", false), pagedStore.getLanes("NORMAL", false));
+  EXPECT_EQ(0u, pagedStore.getPagingStatistics().loads);
+
+  expectLane(pagedStore, getLaneId(2u, 3u));
+  expectLane(pagedStore, getLaneId(2u, 70u));
+  auto statistics = pagedStore.getPagingStatistics();
+  EXPECT_EQ(1u, statistics.hits);
+  EXPECT_EQ(1u, statistics.misses);
+  EXPECT_EQ(1u, statistics.loads);
+  EXPECT_EQ(0u, statistics.evictions);
+  EXPECT_GT(statistics.residentBytes, 0u);
+  EXPECT_EQ(PARTITIONS * LANES_PER_PARTITION, pagedStore.getLanes("NORMAL", false).size());
+
+  // spatial search only loads the partitions touched
+  auto const sphere = store.getLanePtr(getLaneId(5u, 10u))->boundingSphere;
+  EXPECT_EQ(store.getLanesNear(sphere), pagedStore.getLanesNear(sphere));
+  EXPECT_EQ(2u, pagedStore.getPagingStatistics().loads);
+
+  EXPECT_EQ(store.getLanes(), pagedStore.getLanesNear(pagedStore.getBoundingSphere()));
+  statistics = pagedStore.getPagingStatistics();
+  EXPECT_EQ(PARTITIONS, statistics.loads);
+  EXPECT_EQ(0u, statistics.evictions);
+
+  EXPECT_EQ(LANES_PER_PARTITION, pagedStore.getLanes(access::PartitionId(1), "NORMAL", false).size());
+  pagedStore.removePartition(access::PartitionId(1));
+  EXPECT_EQ(PARTITIONS - 1u, pagedStore.getPartitions().size());
+  EXPECT_FALSE(bool(pagedStore.getLanePtr(getLaneId(1u, 0u))));
+  EXPECT_LT(pagedStore.getPagingStatistics().residentBytes, statistics.residentBytes);
+}
+
+TEST_F(StorePagingTest, evict_least_recently_used)
+{
+  std::size_t partitionBytes = 0u;
+  {
+    access::Store pagedStore;
+    ASSERT_TRUE(pagedStore.openPaged(fileName, std::numeric_limits<std::size_t>::max()));
+    pagedStore.getLanePtr(getLaneId(0u, 0u));
+    partitionBytes = pagedStore.getPagingStatistics().residentBytes;
+  }
+
+  // keep two partitions resident
+  std::size_t const budget = 2u * partitionBytes + partitionBytes / 2u;
+  access::Store pagedStore;
+  ASSERT_TRUE(pagedStore.openPaged(fileName, budget));
+  auto const query = [this, &pagedStore](lane::LaneId const &laneId) {
+    access::Store::PagingScope scope(pagedStore);
+    expectLane(pagedStore, laneId);
+  };
+  for (uint64_t p = 0u; p < PARTITIONS; ++p)
+  {
+    query(getLaneId(p, p));
+  }
+  auto statistics = pagedStore.getPagingStatistics();
+  EXPECT_EQ(PARTITIONS, statistics.misses);
+  EXPECT_EQ(PARTITIONS, statistics.loads);
+  EXPECT_EQ(PARTITIONS - 2u, statistics.evictions);
+  EXPECT_LE(statistics.residentBytes, budget);
+
+  // partition 6 is the least recently used one
+  query(getLaneId(7u, 0u));
+  query(getLaneId(0u, 0u));
+  query(getLaneId(7u, 1u));
+  statistics = pagedStore.getPagingStatistics();
+  EXPECT_EQ(2u, statistics.hits);
+  EXPECT_EQ(PARTITIONS + 1u, statistics.loads);
+  EXPECT_EQ(PARTITIONS - 1u, statistics.evictions);
+
+  // a single query may exceed the budget until its scope ends
+  auto const everything = store.getBoundingSphere();
+  {
+    access::Store::PagingScope scope(pagedStore);
+    EXPECT_EQ(store.getLanesNear(everything), pagedStore.getLanesNear(everything));
+    EXPECT_GT(pagedStore.getPagingStatistics().residentBytes, budget);
+  }
+  EXPECT_LE(pagedStore.getPagingStatistics().residentBytes, budget);
+}
+
+TEST_F(StorePagingTest, defer_eviction_within_scope)
+{
+  access::Store pagedStore;
+  ASSERT_TRUE(pagedStore.openPaged(fileName, 1u));
+  {
+    access::Store::PagingScope scope(pagedStore);
+    auto const &lane = *pagedStore.getLaneHandle(getLaneId(0u, 0u));
+    {
+      access::Store::PagingScope nestedScope(pagedStore);
+      for (uint64_t p = 1u; p < PARTITIONS; ++p)
+      {
+        expectLane(pagedStore, getLaneId(p, 0u));
+      }
+    }
+    // the lanes of all partitions are still resident, so the reference is still valid
+    EXPECT_EQ(0u, pagedStore.getPagingStatistics().evictions);
+    EXPECT_EQ(store.getLanePtr(getLaneId(0u, 0u))->edgeLeft.ecefEdge, lane.edgeLeft.ecefEdge);
+  }
+  auto const statistics = pagedStore.getPagingStatistics();
+  EXPECT_EQ(PARTITIONS, statistics.evictions);
+  EXPECT_EQ(0u, statistics.residentBytes);
+
+  // without any scope, only the partition requested last stays resident
+  expectLane(pagedStore, getLaneId(0u, 0u));
+  EXPECT_EQ(PARTITIONS, pagedStore.getPagingStatistics().evictions);
+  expectLane(pagedStore, getLaneId(1u, 0u));
+  EXPECT_EQ(PARTITIONS + 1u, pagedStore.getPagingStatistics().evictions);
+  EXPECT_FALSE(pagedStore.getLanesNear(store.getLanePtr(getLaneId(2u, 0u))->boundingSphere).empty());
+  EXPECT_EQ(0u, pagedStore.getPagingStatistics().residentBytes);
+}
+
+TEST_F(StorePagingTest, lane_graph_covers_all_partitions)
+{
+  access::Store pagedStore;
+  ASSERT_TRUE(pagedStore.openPaged(fileName, 1u));
+  auto const laneGraph = pagedStore.getLaneGraph();
+  EXPECT_EQ(PARTITIONS * LANES_PER_PARTITION, laneGraph->size());
+  EXPECT_EQ(store.getLaneGraph()->getFingerprint(), laneGraph->getFingerprint());
+  EXPECT_EQ(0u, pagedStore.getPagingStatistics().loads);
+
+  // the lanes are paged in on demand
+  auto const &node = laneGraph->getNode(getLaneId(4u, 7u));
+  EXPECT_FALSE(bool(node.lane));
+  auto const lane = laneGraph->getLane(node);
+  ASSERT_TRUE(bool(lane));
+  EXPECT_EQ(store.getLanePtr(getLaneId(4u, 7u))->edgeLeft.ecefEdge, lane->edgeLeft.ecefEdge);
+  EXPECT_EQ(1u, pagedStore.getPagingStatistics().loads);
+
+  // loading and evicting partitions keeps the graph
+  expectLane(pagedStore, getLaneId(5u, 0u));
+  EXPECT_EQ(1u, pagedStore.getPagingStatistics().evictions);
+  EXPECT_EQ(laneGraph, pagedStore.getLaneGraph());
+}
+
+TEST_F(StorePagingTest, query_scope_defers_eviction)
+{
+  auto pagedStore = std::make_shared<access::Store>();
+  ASSERT_TRUE(pagedStore->openPaged(fileName, 1u));
+  {
+    access::QueryScope queryScope(pagedStore);
+    for (uint64_t p = 0u; p < PARTITIONS; ++p)
+    {
+      auto const &lane = lane::getLane(getLaneId(p, 0u));
+      EXPECT_EQ(getLaneId(p, 0u), lane.id);
+    }
+    EXPECT_EQ(0u, pagedStore->getPagingStatistics().evictions);
+  }
+  EXPECT_EQ(PARTITIONS, pagedStore->getPagingStatistics().evictions);
+}
+
+TEST_F(StorePagingTest, open_paged_from_config)
+{
+  access::cleanup();
+  ASSERT_TRUE(access::init("test_files/map_config_paging.txt"));
+  EXPECT_TRUE(access::getStore().isPaged());
+  {
+    access::Store::PagingScope scope(access::getStore());
+    expectLane(access::getStore(), getLaneId(3u, 5u));
+  }
+  EXPECT_EQ(1u, access::getStore().getPagingStatistics().loads);
+  access::cleanup();
+}
+
+TEST_F(StorePagingTest, reject_unsupported_maps)
+{
+  access::Store pagedStore;
+  ASSERT_FALSE(pagedStore.openPaged("test_files/TPK.adm", 1000000u));
+  EXPECT_FALSE(pagedStore.isPaged());
+  EXPECT_TRUE(pagedStore.empty());
+  ASSERT_FALSE(pagedStore.openPaged("test_files/not_existing.adm", 1000000u));
+  EXPECT_TRUE(pagedStore.empty());
+
+  ASSERT_FALSE(store.openPaged(fileName, 1000000u));
+  ASSERT_TRUE(pagedStore.openPaged(fileName, 1000000u));
+  serialize::SerializerFileCRC32 serializer(false);
+  size_t versionMajor = 0u;
+  size_t versionMinor = 0u;
+  ASSERT_TRUE(serializer.open(fileName, versionMajor, versionMinor));
+  EXPECT_FALSE(pagedStore.load(serializer));
+  serializer.close();
+}
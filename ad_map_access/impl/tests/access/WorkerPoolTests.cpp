@@ -0,0 +1,64 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "../../src/access/WorkerPool.hpp"
+
+using namespace ::ad;
+using namespace ::ad::map;
+
+TEST(WorkerPoolTest, threads_are_reused)
+{
+  auto &workerPool = access::WorkerPool::getInstance();
+  std::mutex threadIdsMutex;
+  std::set<std::thread::id> threadIds;
+  for (std::size_t round = 0u; round < 50u; ++round)
+  {
+    std::atomic<std::size_t> nextItem{0u};
+    std::vector<std::size_t> items(100u, 0u);
+    workerPool.run(3u, [&]() {
+      for (auto item = nextItem++; item < items.size(); item = nextItem++)
+      {
+        ++items[item];
+      }
+      std::lock_guard<std::mutex> guard(threadIdsMutex);
+      threadIds.insert(std::this_thread::get_id());
+    });
+    EXPECT_EQ(std::vector<std::size_t>(100u, 1u), items);
+  }
+  // the calling thread and the threads of the pool, no new threads per run
+  EXPECT_LE(3u, workerPool.size());
+  EXPECT_LE(threadIds.size(), workerPool.size() + 1u);
+  EXPECT_EQ(1u, threadIds.count(std::this_thread::get_id()));
+}
+
+TEST(WorkerPoolTest, nested_runs_complete)
+{
+  auto &workerPool = access::WorkerPool::getInstance();
+  std::atomic<std::size_t> processedItems{0u};
+  std::atomic<std::size_t> nextOuterItem{0u};
+  // the outer tasks occupy all threads of the pool, so the inner tasks are run by their calling threads alone
+  workerPool.run(4u, [&]() {
+    for (auto outerItem = nextOuterItem++; outerItem < 16u; outerItem = nextOuterItem++)
+    {
+      std::atomic<std::size_t> nextInnerItem{0u};
+      workerPool.run(4u, [&]() {
+        for (auto innerItem = nextInnerItem++; innerItem < 16u; innerItem = nextInnerItem++)
+        {
+          ++processedItems;
+        }
+      });
+    }
+  });
+  EXPECT_EQ(256u, processedItems);
+}
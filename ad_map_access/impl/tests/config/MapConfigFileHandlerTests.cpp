@@ -8,6 +8,7 @@
 
 #include <ad/map/config/MapConfigFileHandler.hpp>
 #include <ad/map/test_support/NoLogTestMacros.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 
 #include <gtest/gtest.h>
 
@@ -71,6 +72,22 @@ TEST(MapConfigFileHandler, valid_default_enu_reference_config)
   EXPECT_EQ(ad::map::point::Altitude(0.), configHandler.defaultEnuReference().altitude);
 }
 
+TEST(MapConfigFileHandler, opendrive_cache_config)
+{
+  ad::map::config::MapConfigFileHandler configHandler{};
+  ASSERT_TRUE(configHandler.readConfig("test_files/TPK.adm.txt"));
+  EXPECT_TRUE(configHandler.openDriveCacheDirectory().empty());
+  EXPECT_EQ(0u, configHandler.openDriveCacheMaxSize());
+
+  ASSERT_TRUE(configHandler.readConfig("test_files/map_config_opendrive_cache.txt"));
+  EXPECT_TRUE(boost::ends_with(configHandler.openDriveCacheDirectory(), "/test_files/opendrive_cache"));
+  EXPECT_EQ(16u * 1024u * 1024u, configHandler.openDriveCacheMaxSize());
+
+  configHandler.reset();
+  EXPECT_TRUE(configHandler.openDriveCacheDirectory().empty());
+  EXPECT_EQ(0u, configHandler.openDriveCacheMaxSize());
+}
+
 TEST(MapConfigFileHandler, reset)
 {
   ad::map::config::MapConfigFileHandler configHandler{};
@@ -0,0 +1,144 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Factory.hpp>
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneGraph.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <gtest/gtest.h>
+
+using namespace ::ad;
+using namespace ::ad::map;
+using namespace ::ad::map::lane;
+
+struct LaneGraphTest : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+  }
+  virtual void TearDown()
+  {
+    access::cleanup();
+  }
+
+  void expectEdges(LaneGraph const &graph,
+                   LaneGraph::Node const &node,
+                   LaneGraph::EdgeRange const &edges,
+                   ContactLaneList const &contactLanes)
+  {
+    ASSERT_EQ(contactLanes.size(), static_cast<std::size_t>(edges.end() - edges.begin()));
+    auto edge = edges.begin();
+    for (auto const &contactLane : contactLanes)
+    {
+      ASSERT_EQ(contactLane.toLane, edge->toLane);
+      ASSERT_NE(LaneGraph::cInvalidNodeIndex, edge->node);
+      auto const &otherNode = graph.getNode(edge->node);
+      ASSERT_EQ(contactLane.toLane, otherNode.id);
+      ASSERT_EQ(getContactLocation(*otherNode.lane, node.id), edge->reverseLocation);
+      ++edge;
+    }
+  }
+};
+
+TEST_F(LaneGraphTest, graph_matches_lanes)
+{
+  ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  auto const graph = getLaneGraph();
+  ASSERT_NE(graph, nullptr);
+  ASSERT_EQ(graph, getLaneGraph());
+
+  auto const laneIds = getLanes();
+  ASSERT_EQ(laneIds.size(), graph->size());
+  for (auto const &laneId : laneIds)
+  {
+    auto const &lane = getLane(laneId);
+    auto const nodeIndex = graph->findNode(laneId);
+    ASSERT_NE(LaneGraph::cInvalidNodeIndex, nodeIndex);
+    auto const &node = graph->getNode(nodeIndex);
+    ASSERT_EQ(&node, &graph->getNode(laneId));
+    ASSERT_EQ(&lane, node.lane.get());
+    ASSERT_EQ(lane.type, node.type);
+    ASSERT_EQ(lane.direction, node.direction);
+    ASSERT_EQ(isRouteable(lane), node.routeable);
+    ASSERT_EQ(isLaneDirectionPositive(lane), node.positive);
+    ASSERT_EQ(isLaneDirectionNegative(lane), node.negative);
+    ASSERT_EQ(lane.length, node.length);
+    ASSERT_EQ(getDuration(lane, physics::ParametricRange()), node.duration);
+    ASSERT_EQ(getParametricPoint(lane, physics::ParametricValue(0.), physics::ParametricValue(0.5)), node.startPoint);
+    ASSERT_EQ(getParametricPoint(lane, physics::ParametricValue(1.), physics::ParametricValue(0.5)), node.endPoint);
+
+    expectEdges(*graph,
+                node,
+                graph->getEdges(node, LaneGraph::SuccessorEdges),
+                getContactLanes(lane, ContactLocation::SUCCESSOR));
+    expectEdges(*graph,
+                node,
+                graph->getEdges(node, LaneGraph::PredecessorEdges),
+                getContactLanes(lane, ContactLocation::PREDECESSOR));
+    expectEdges(*graph,
+                node,
+                graph->getEdges(node, LaneGraph::RightEdges, LaneGraph::LeftEdges),
+                getContactLanes(lane, {ContactLocation::LEFT, ContactLocation::RIGHT}));
+
+    for (auto const &otherLaneId : laneIds)
+    {
+      ASSERT_EQ(getDirectNeighborhoodRelation(laneId, otherLaneId),
+                graph->getDirectNeighborhoodRelation(laneId, otherLaneId));
+    }
+  }
+
+  EXPECT_EQ(LaneGraph::cInvalidNodeIndex, graph->findNode(LaneId(123456789u)));
+  EXPECT_THROW(graph->getNode(LaneId(123456789u)), std::invalid_argument);
+}
+
+TEST_F(LaneGraphTest, update_on_store_changes)
+{
+  access::Store store;
+  access::Factory factory(store);
+  LaneId x1(1), x2(2), x3(3);
+  access::PartitionId p1(1), p2(2);
+
+  ASSERT_TRUE(factory.add(p1, x1, LaneType::NORMAL, LaneDirection::POSITIVE));
+  ASSERT_TRUE(factory.add(p2, x2, LaneType::NORMAL, LaneDirection::POSITIVE));
+  ASSERT_TRUE(factory.add(x1, x2, ContactLocation::SUCCESSOR, {ContactType::FREE}, restriction::Restrictions()));
+  ASSERT_TRUE(factory.add(x1, x3, ContactLocation::LEFT, {ContactType::LANE_CHANGE}, restriction::Restrictions()));
+
+  auto const graph = store.getLaneGraph();
+  ASSERT_EQ(2u, graph->size());
+  auto const &node1 = graph->getNode(x1);
+  auto const successors = graph->getEdges(node1, LaneGraph::SuccessorEdges);
+  ASSERT_EQ(1, successors.end() - successors.begin());
+  EXPECT_EQ(graph->findNode(x2), successors.begin()->node);
+  EXPECT_EQ(ContactLocation::INVALID, successors.begin()->reverseLocation);
+  auto const lateral = graph->getEdges(node1, LaneGraph::RightEdges, LaneGraph::LeftEdges);
+  ASSERT_EQ(1, lateral.end() - lateral.begin());
+  EXPECT_EQ(LaneGraph::cInvalidNodeIndex, lateral.begin()->node);
+  EXPECT_EQ(ContactLocation::LEFT, graph->getDirectNeighborhoodRelation(x1, x3));
+  ASSERT_EQ(graph, store.getLaneGraph());
+
+  ASSERT_TRUE(factory.add(x2, x1, ContactLocation::PREDECESSOR, {ContactType::FREE}, restriction::Restrictions()));
+  auto const graphWithContact = store.getLaneGraph();
+  ASSERT_NE(graph, graphWithContact);
+  EXPECT_EQ(ContactLocation::PREDECESSOR,
+            graphWithContact->getEdges(graphWithContact->getNode(x1), LaneGraph::SuccessorEdges).begin()->reverseLocation);
+  // previously provided graphs are not changed
+  EXPECT_EQ(ContactLocation::INVALID, successors.begin()->reverseLocation);
+
+  ASSERT_TRUE(factory.set(x2, LaneType::SHOULDER));
+  EXPECT_FALSE(store.getLaneGraph()->getNode(x2).routeable);
+
+  ASSERT_TRUE(factory.add(p1, x3, LaneType::NORMAL, LaneDirection::POSITIVE));
+  EXPECT_EQ(3u, store.getLaneGraph()->size());
+  EXPECT_NE(LaneGraph::cInvalidNodeIndex,
+            store.getLaneGraph()->getEdges(store.getLaneGraph()->getNode(x1), LaneGraph::LeftEdges).begin()->node);
+
+  store.removePartition(p2);
+  EXPECT_EQ(LaneGraph::cInvalidNodeIndex, store.getLaneGraph()->findNode(x2));
+  EXPECT_EQ(2u, store.getLaneGraph()->size());
+}
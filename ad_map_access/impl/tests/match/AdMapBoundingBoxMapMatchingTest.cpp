@@ -6,10 +6,12 @@
 //
 // ----------------- END LICENSE BLOCK -----------------------------------
 
+#include <ad/map/access/MapContext.hpp>
 #include <ad/map/access/Operation.hpp>
 #include <ad/map/lane/LaneOperation.hpp>
 #include <ad/map/match/AdMapMatching.hpp>
 #include <ad/map/point/Operation.hpp>
+#include <ad/physics/RangeOperation.hpp>
 #include <algorithm>
 #include <gtest/gtest.h>
 #include "ad/map/match/MapMatchedOperation.hpp"
@@ -197,3 +199,244 @@ TEST_F(AdMapBoundingBoxMapMatchingTest, rotate_box_within_lane)
                         });
   ASSERT_TRUE(search != std::end(result.laneOccupiedRegions));
 }
+
+TEST_F(AdMapBoundingBoxMapMatchingTest, footprint_covers_sampling)
+{
+  match::AdMapMatching mapMatching;
+  EXPECT_EQ(BoundingBoxMatchingMode::Sampling, mapMatching.getBoundingBoxMatchingMode());
+  auto centerMapMatched = mapMatching.getMapMatchedPositions(mObjectPosition, mDistance, mMinProbabilty);
+  ASSERT_FALSE(centerMapMatched.empty());
+  auto const laneHeading = static_cast<double>(mapMatching.getLaneENUHeading(centerMapMatched.front()));
+
+  // a truck crossing the lanes in different angles
+  mObjectPosition.dimension.width = physics::Distance(2.5);
+  mObjectPosition.dimension.length = physics::Distance(12.);
+  for (auto const angle : {0., M_PI_4, M_PI_2, 3. * M_PI_4})
+  {
+    mObjectPosition.heading = point::createENUHeading(laneHeading + angle);
+    mapMatching.setBoundingBoxMatchingMode(BoundingBoxMatchingMode::Sampling);
+    auto const samplingResult
+      = mapMatching.getMapMatchedBoundingBox(mObjectPosition, mDistance, mMinProbabilty, physics::Distance(0.1));
+    mapMatching.setBoundingBoxMatchingMode(BoundingBoxMatchingMode::Footprint);
+    auto const footprintResult = mapMatching.getMapMatchedBoundingBox(mObjectPosition, mDistance, mMinProbabilty);
+
+    ASSERT_FALSE(samplingResult.laneOccupiedRegions.empty());
+    for (auto const &samplingRegion : samplingResult.laneOccupiedRegions)
+    {
+      auto footprintRegion = std::find_if(footprintResult.laneOccupiedRegions.begin(),
+                                          footprintResult.laneOccupiedRegions.end(),
+                                          [&samplingRegion](match::LaneOccupiedRegion const &other) {
+                                            return other.laneId == samplingRegion.laneId;
+                                          });
+      ASSERT_TRUE(footprintRegion != footprintResult.laneOccupiedRegions.end()) << samplingRegion.laneId;
+
+      // the footprint contains all samples; the samples cover the footprint up to a few sampling distances
+      auto const laneLength = static_cast<double>(lane::calcLength(samplingRegion.laneId));
+      auto const laneWidth
+        = static_cast<double>(lane::calcWidth(samplingRegion.laneId, physics::ParametricValue(0.5)));
+      auto const longitudinalMin = static_cast<double>(footprintRegion->longitudinalRange.minimum);
+      auto const longitudinalMax = static_cast<double>(footprintRegion->longitudinalRange.maximum);
+      auto const lateralMin = static_cast<double>(footprintRegion->lateralRange.minimum);
+      auto const lateralMax = static_cast<double>(footprintRegion->lateralRange.maximum);
+      EXPECT_LE(longitudinalMin - 0.01 / laneLength, static_cast<double>(samplingRegion.longitudinalRange.minimum));
+      EXPECT_GE(longitudinalMax + 0.01 / laneLength, static_cast<double>(samplingRegion.longitudinalRange.maximum));
+      EXPECT_LE(lateralMin - 0.01 / laneWidth, static_cast<double>(samplingRegion.lateralRange.minimum));
+      EXPECT_GE(lateralMax + 0.01 / laneWidth, static_cast<double>(samplingRegion.lateralRange.maximum));
+      EXPECT_NEAR(longitudinalMin, static_cast<double>(samplingRegion.longitudinalRange.minimum), 0.5 / laneLength);
+      EXPECT_NEAR(longitudinalMax, static_cast<double>(samplingRegion.longitudinalRange.maximum), 0.5 / laneLength);
+      EXPECT_NEAR(lateralMin, static_cast<double>(samplingRegion.lateralRange.minimum), 0.5 / laneWidth);
+      EXPECT_NEAR(lateralMax, static_cast<double>(samplingRegion.lateralRange.maximum), 0.5 / laneWidth);
+    }
+  }
+}
+
+TEST_F(AdMapBoundingBoxMapMatchingTest, footprint_ignores_min_probability)
+{
+  match::AdMapMatching mapMatching;
+  auto centerMapMatched = mapMatching.getMapMatchedPositions(mObjectPosition, mDistance, mMinProbabilty);
+  ASSERT_FALSE(centerMapMatched.empty());
+  auto const laneHeading = static_cast<double>(mapMatching.getLaneENUHeading(centerMapMatched.front()));
+
+  // a truck crossing both lanes, moved until its end covers the outer lane only close to the lane border
+  // where the samples match the neighboring lane as well
+  mObjectPosition.dimension.width = physics::Distance(2.5);
+  mObjectPosition.dimension.length = physics::Distance(12.);
+  mObjectPosition.heading = point::createENUHeading(laneHeading + M_PI_2);
+  point::ENUPoint directionalVector;
+  point::ENUPoint orthogonalVector;
+  point::getDirectionVectorsZPlane(mObjectPosition.heading, directionalVector, orthogonalVector);
+  auto const centerPoint = mObjectPosition.centerPoint;
+  physics::Probability const highMinProbability(0.6);
+
+  auto const containsLane = [](LaneOccupiedRegionList const &regions, lane::LaneId const &laneId) {
+    return std::any_of(regions.begin(), regions.end(), [&laneId](LaneOccupiedRegion const &region) {
+      return region.laneId == laneId;
+    });
+  };
+  std::size_t filteredLanes = 0u;
+  for (auto offset = 4.; offset < 5.5; offset += 0.25)
+  {
+    mObjectPosition.centerPoint = centerPoint + directionalVector * offset;
+    mapMatching.setBoundingBoxMatchingMode(BoundingBoxMatchingMode::Sampling);
+    auto const allSamples
+      = mapMatching.getMapMatchedBoundingBox(mObjectPosition, mDistance, mMinProbabilty, physics::Distance(0.25));
+    auto const probableSamples
+      = mapMatching.getMapMatchedBoundingBox(mObjectPosition, mDistance, highMinProbability, physics::Distance(0.25));
+    mapMatching.setBoundingBoxMatchingMode(BoundingBoxMatchingMode::Footprint);
+    auto const footprint = mapMatching.getMapMatchedBoundingBox(mObjectPosition, mDistance, highMinProbability);
+
+    for (auto const &region : allSamples.laneOccupiedRegions)
+    {
+      if (!containsLane(probableSamples.laneOccupiedRegions, region.laneId))
+      {
+        // minProbability only filters the reference points in footprint mode, so the covered lane is kept
+        ++filteredLanes;
+        EXPECT_TRUE(containsLane(footprint.laneOccupiedRegions, region.laneId)) << region.laneId << " " << offset;
+      }
+    }
+  }
+  EXPECT_LT(0u, filteredLanes);
+}
+
+TEST_F(AdMapBoundingBoxMapMatchingTest, batch_matching_independent_of_thread_count)
+{
+  match::AdMapMatching mapMatching;
+  ENUObjectPositionList objects;
+  for (auto x = -30.; x <= 30.; x += 7.5)
+  {
+    for (auto y = -30.; y <= 30.; y += 7.5)
+    {
+      auto object = mObjectPosition;
+      object.centerPoint = point::createENUPoint(x, y, 0.);
+      object.heading = point::createENUHeading(x + y);
+      objects.push_back(object);
+    }
+  }
+
+  auto const boundingBoxes = mapMatching.getMapMatchedBoundingBoxes(objects, mDistance, mMinProbabilty);
+  ASSERT_EQ(objects.size(), boundingBoxes.size());
+  LaneOccupiedRegionList expectedRegions;
+  for (std::size_t i = 0u; i < objects.size(); ++i)
+  {
+    EXPECT_EQ(mapMatching.getMapMatchedBoundingBox(objects[i], mDistance, mMinProbabilty), boundingBoxes[i]);
+    for (auto const &region : boundingBoxes[i].laneOccupiedRegions)
+    {
+      auto expectedRegion = std::find_if(
+        expectedRegions.begin(), expectedRegions.end(), [&region](match::LaneOccupiedRegion const &other) {
+          return other.laneId == region.laneId;
+        });
+      if (expectedRegion == expectedRegions.end())
+      {
+        expectedRegions.push_back(region);
+      }
+      else
+      {
+        physics::unionRangeWith(expectedRegion->longitudinalRange, region.longitudinalRange);
+        physics::unionRangeWith(expectedRegion->lateralRange, region.lateralRange);
+      }
+    }
+  }
+  ASSERT_FALSE(expectedRegions.empty());
+
+  for (std::size_t threadCount : {2u, 4u, 200u})
+  {
+    EXPECT_EQ(boundingBoxes,
+              mapMatching.getMapMatchedBoundingBoxes(
+                objects, mDistance, mMinProbabilty, physics::Distance(1.), threadCount));
+    EXPECT_EQ(
+      expectedRegions,
+      mapMatching.getLaneOccupiedRegions(objects, mDistance, mMinProbabilty, physics::Distance(1.), threadCount));
+  }
+  EXPECT_TRUE(mapMatching.getMapMatchedBoundingBoxes(ENUObjectPositionList(), mDistance, mMinProbabilty).empty());
+}
+
+TEST_F(AdMapBoundingBoxMapMatchingTest, batch_matching_within_context)
+{
+  match::AdMapMatching mapMatching;
+  ENUObjectPositionList objects;
+  for (auto x = -30.; x <= 30.; x += 15.)
+  {
+    auto object = mObjectPosition;
+    object.centerPoint = point::createENUPoint(x, x, 0.);
+    objects.push_back(object);
+  }
+  auto const expectedBoundingBoxes = mapMatching.getMapMatchedBoundingBoxes(objects, mDistance, mMinProbabilty);
+  ASSERT_TRUE(std::any_of(
+    expectedBoundingBoxes.begin(), expectedBoundingBoxes.end(), [](MapMatchedObjectBoundingBox const &boundingBox) {
+      return !boundingBox.laneOccupiedRegions.empty();
+    }));
+  auto context = access::createMapContext();
+
+  // the worker threads have to match against the map of the context, not against the global one
+  access::cleanup();
+  ASSERT_TRUE(access::init("test_files/LaneChange.adm.txt"));
+  access::MapContext::Scope scope(context);
+  EXPECT_EQ(expectedBoundingBoxes,
+            mapMatching.getMapMatchedBoundingBoxes(objects, mDistance, mMinProbabilty, physics::Distance(1.), 4u));
+}
+
+TEST_F(AdMapBoundingBoxMapMatchingTest, footprint_on_curved_lanes)
+{
+  match::AdMapMatching mapMatching;
+  mapMatching.setBoundingBoxMatchingMode(BoundingBoxMatchingMode::Footprint);
+  mObjectPosition.dimension.width = physics::Distance(2.5);
+  mObjectPosition.dimension.length = physics::Distance(12.);
+
+  std::size_t curvedLanes = 0u;
+  for (auto const &laneId : lane::getLanes())
+  {
+    auto const &lane = lane::getLane(laneId);
+    auto const laneLength = static_cast<double>(lane.length);
+    auto const chordLength = static_cast<double>(point::distance(lane::getStartPoint(lane), lane::getEndPoint(lane)));
+    if ((laneLength < 20.) || (laneLength < 1.05 * chordLength))
+    {
+      continue;
+    }
+    ++curvedLanes;
+
+    // a truck crossing the curved lane at its center
+    auto const center = lane::getParametricPoint(lane, physics::ParametricValue(0.5), physics::ParametricValue(0.5));
+    mObjectPosition.enuReferencePoint = point::toGeo(center);
+    auto const centerMapMatched = mapMatching.getMapMatchedPositions(mObjectPosition, mDistance, mMinProbabilty);
+    auto const centerOnLane = std::find_if(
+      centerMapMatched.begin(), centerMapMatched.end(), [&laneId](MapMatchedPosition const &mapMatchedPosition) {
+        return mapMatchedPosition.lanePoint.paraPoint.laneId == laneId;
+      });
+    ASSERT_TRUE(centerOnLane != centerMapMatched.end());
+    auto const laneHeading = static_cast<double>(mapMatching.getLaneENUHeading(*centerOnLane));
+    for (auto const angle : {0., M_PI_4, M_PI_2})
+    {
+      mObjectPosition.heading = point::createENUHeading(laneHeading + angle);
+      auto const footprintResult = mapMatching.getMapMatchedBoundingBox(mObjectPosition, mDistance, mMinProbabilty);
+      mapMatching.setBoundingBoxMatchingMode(BoundingBoxMatchingMode::Sampling);
+      auto const samplingResult
+        = mapMatching.getMapMatchedBoundingBox(mObjectPosition, mDistance, mMinProbabilty, physics::Distance(0.1));
+      mapMatching.setBoundingBoxMatchingMode(BoundingBoxMatchingMode::Footprint);
+
+      auto const isLaneRegion = [&laneId](LaneOccupiedRegion const &region) { return region.laneId == laneId; };
+      auto const footprintRegion = std::find_if(
+        footprintResult.laneOccupiedRegions.begin(), footprintResult.laneOccupiedRegions.end(), isLaneRegion);
+      auto const samplingRegion = std::find_if(
+        samplingResult.laneOccupiedRegions.begin(), samplingResult.laneOccupiedRegions.end(), isLaneRegion);
+      ASSERT_TRUE(footprintRegion != footprintResult.laneOccupiedRegions.end()) << laneId;
+      ASSERT_TRUE(samplingRegion != samplingResult.laneOccupiedRegions.end()) << laneId;
+
+      // on curved lanes the parametric offsets along the footprint sides are not linear, so the ranges are not spanned
+      // by the vertices of the intersection; all samples still have to be contained
+      auto const laneWidth = static_cast<double>(lane::calcWidth(laneId, physics::ParametricValue(0.5)));
+      EXPECT_LE(static_cast<double>(footprintRegion->longitudinalRange.minimum) - 0.01 / laneLength,
+                static_cast<double>(samplingRegion->longitudinalRange.minimum))
+        << laneId << " " << angle;
+      EXPECT_GE(static_cast<double>(footprintRegion->longitudinalRange.maximum) + 0.01 / laneLength,
+                static_cast<double>(samplingRegion->longitudinalRange.maximum))
+        << laneId << " " << angle;
+      EXPECT_LE(static_cast<double>(footprintRegion->lateralRange.minimum) - 0.01 / laneWidth,
+                static_cast<double>(samplingRegion->lateralRange.minimum))
+        << laneId << " " << angle;
+      EXPECT_GE(static_cast<double>(footprintRegion->lateralRange.maximum) + 0.01 / laneWidth,
+                static_cast<double>(samplingRegion->lateralRange.maximum))
+        << laneId << " " << angle;
+    }
+  }
+  EXPECT_LT(0u, curvedLanes);
+}
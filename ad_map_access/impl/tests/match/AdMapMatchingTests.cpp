@@ -9,6 +9,8 @@
 #include <ad/map/access/Operation.hpp>
 #include <ad/map/lane/LaneOperation.hpp>
 #include <ad/map/match/AdMapMatching.hpp>
+#include <ad/map/route/Planning.hpp>
+#include <ad/map/route/RouteOperation.hpp>
 #include <ad/map/test_support/NoLogTestMacros.hpp>
 #include <gtest/gtest.h>
 
@@ -160,6 +162,47 @@ TEST_F(AdMapMatchingTest, isLanePartOfRouteHints)
     mRouteHint.roadSegments.front().drivableLaneSegments.front().laneInterval.laneId + lane::LaneId(1)));
 }
 
+TEST_F(AdMapMatchingTest, shortenRouteHints)
+{
+  auto const startLaneId = lane::uniqueLaneId(
+    point::createGeoPoint(point::Longitude(8.4404755), point::Latitude(49.0195732), point::Altitude(0.)));
+  auto const endLaneId = lane::uniqueLaneId(
+    point::createGeoPoint(point::Longitude(8.4422283), point::Latitude(49.0192052), point::Altitude(0.)));
+  auto const route = route::planning::planRoute(point::createParaPoint(startLaneId, physics::ParametricValue(0.2)),
+                                                point::createParaPoint(endLaneId, physics::ParametricValue(0.7)));
+  ASSERT_LT(3u, route.roadSegments.size());
+
+  mMapMatching->addRouteHint(route);
+  mMapMatching->addRouteHint(route);
+  route::FullRoute shortenedRoute = route;
+  for (std::size_t i = 0u; i + 1u < route.roadSegments.size(); ++i)
+  {
+    auto const &roadSegment = route.roadSegments[i];
+    auto const &laneInterval = roadSegment.drivableLaneSegments.front().laneInterval;
+    point::ParaPointList const currentPositions
+      = {point::createParaPoint(laneInterval.laneId, (laneInterval.start + laneInterval.end) * 0.5)};
+    ASSERT_TRUE(route::shortenRoute(currentPositions, shortenedRoute));
+    mMapMatching->shortenRouteHints(currentPositions);
+
+    ASSERT_EQ(2u, mMapMatching->mRouteHints.size());
+    EXPECT_EQ(shortenedRoute, mMapMatching->mRouteHints.front());
+
+    // the hashed lanes have to match the ones of the shortened route
+    match::AdMapMatching expectedMapMatching;
+    expectedMapMatching.addRouteHint(shortenedRoute);
+    expectedMapMatching.addRouteHint(shortenedRoute);
+    EXPECT_EQ(expectedMapMatching.mRouteHintLanes, mMapMatching->mRouteHintLanes);
+    EXPECT_TRUE(mMapMatching->isLanePartOfRouteHints(endLaneId));
+    EXPECT_EQ(i > 0u, !mMapMatching->isLanePartOfRouteHints(startLaneId));
+  }
+
+  // leaving the route removes the route hints
+  mMapMatching->shortenRouteHints({point::createParaPoint(startLaneId, physics::ParametricValue(0.5))});
+  EXPECT_TRUE(mMapMatching->mRouteHints.empty());
+  EXPECT_TRUE(mMapMatching->mRouteHintLanes.empty());
+  EXPECT_FALSE(mMapMatching->isLanePartOfRouteHints(endLaneId));
+}
+
 TEST_F(AdMapMatchingTest, perform_map_matching_with_route_hints)
 {
   addRouteHint();
@@ -186,6 +229,58 @@ TEST_F(AdMapMatchingTest, perform_map_matching_with_heading_hints)
   }
 }
 
+void expectEqualMapMatching(int line,
+                            MapMatchedPositionConfidenceList const &expected,
+                            MapMatchedPositionConfidenceList const &actual)
+{
+  ASSERT_EQ(expected.size(), actual.size()) << " expectEqualMapMatching called from " << line << "\n";
+  for (std::size_t i = 0u; i < expected.size(); ++i)
+  {
+    EXPECT_EQ(expected[i].lanePoint.paraPoint.laneId, actual[i].lanePoint.paraPoint.laneId)
+      << " expectEqualMapMatching called from " << line << "\n";
+    EXPECT_EQ(expected[i].type, actual[i].type) << " expectEqualMapMatching called from " << line << "\n";
+    EXPECT_NEAR(static_cast<double>(expected[i].lanePoint.paraPoint.parametricOffset),
+                static_cast<double>(actual[i].lanePoint.paraPoint.parametricOffset),
+                1e-6)
+      << " expectEqualMapMatching called from " << line << "\n";
+    EXPECT_NEAR(static_cast<double>(expected[i].probability), static_cast<double>(actual[i].probability), 1e-6)
+      << " expectEqualMapMatching called from " << line << "\n";
+    EXPECT_NEAR(0., static_cast<double>(point::distance(expected[i].matchedPoint, actual[i].matchedPoint)), 1e-6)
+      << " expectEqualMapMatching called from " << line << "\n";
+  }
+}
+
+TEST_F(AdMapMatchingTest, ecef_and_enu_match_like_geo)
+{
+  physics::Distance const searchDist(1.);
+  auto const enuReferencePoint = mTestPoints.front().first;
+  for (auto testElement : mTestPoints)
+  {
+    auto const geoResults = mMapMatching->getMapMatchedPositions(testElement.first, searchDist, mMinProbabilty);
+    ASSERT_EQ(testElement.second, geoResults.size());
+
+    auto const ecefResults
+      = mMapMatching->getMapMatchedPositions(point::toECEF(testElement.first), searchDist, mMinProbabilty);
+    expectEqualMapMatching(__LINE__, geoResults, ecefResults);
+
+    auto const enuPoint = point::toENU(testElement.first, enuReferencePoint);
+    auto const enuResults
+      = mMapMatching->getMapMatchedPositions(enuPoint, enuReferencePoint, searchDist, mMinProbabilty);
+    expectEqualMapMatching(__LINE__, geoResults, enuResults);
+
+    ENUObjectPosition objectPosition;
+    objectPosition.centerPoint = enuPoint;
+    objectPosition.heading = point::createENUHeading(point::degree2radians(70));
+    objectPosition.enuReferencePoint = enuReferencePoint;
+    mMapMatching->addHeadingHint(objectPosition.heading, enuReferencePoint);
+    auto const geoHeadingResults
+      = mMapMatching->getMapMatchedPositions(testElement.first, searchDist, mMinProbabilty);
+    mMapMatching->clearHeadingHints();
+    auto const objectResults = mMapMatching->getMapMatchedPositions(objectPosition, searchDist, mMinProbabilty);
+    expectEqualMapMatching(__LINE__, geoHeadingResults, objectResults);
+  }
+}
+
 TEST_F(AdMapMatchingTest, laneOperation)
 {
   addRouteHint();
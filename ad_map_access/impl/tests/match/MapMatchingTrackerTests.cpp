@@ -0,0 +1,236 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/MapPatch.hpp>
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/match/MapMatchingTracker.hpp>
+#include <ad/map/point/Operation.hpp>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace ::ad;
+using namespace ::ad::map;
+using namespace ::ad::map::match;
+
+struct MapMatchingTrackerTest : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+    ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  }
+
+  virtual void TearDown()
+  {
+    access::cleanup();
+  }
+
+  /**
+   * @returns points along the lane of the given point and its successors
+   */
+  std::vector<point::ECEFPoint> createTrajectory(point::GeoPoint const &start) const
+  {
+    std::vector<point::ECEFPoint> trajectory;
+    auto const startPositions = mMapMatching.getMapMatchedPositions(start, mDistance, mMinProbability);
+    auto startPosition = std::find_if(
+      startPositions.begin(), startPositions.end(), [](MapMatchedPosition const &mapMatchedPosition) {
+        return mapMatchedPosition.type == MapMatchedPositionType::LANE_IN;
+      });
+    if (startPosition == startPositions.end())
+    {
+      return trajectory;
+    }
+    auto laneId = startPosition->lanePoint.paraPoint.laneId;
+    for (std::size_t laneCount = 0u; laneCount < 3u; ++laneCount)
+    {
+      for (auto offset = 0.05; offset < 1.; offset += 0.1)
+      {
+        trajectory.push_back(lane::getParametricPoint(
+          lane::getLane(laneId), physics::ParametricValue(offset), physics::ParametricValue(0.5)));
+      }
+      auto const successors = lane::getContactLanes(lane::getLane(laneId), lane::ContactLocation::SUCCESSOR);
+      if (successors.empty())
+      {
+        break;
+      }
+      laneId = successors.front().toLane;
+    }
+    return trajectory;
+  }
+
+  static lane::LaneIdList getLaneIds(MapMatchedPositionConfidenceList const &mapMatchedPositions)
+  {
+    lane::LaneIdList laneIds;
+    for (auto const &mapMatchedPosition : mapMatchedPositions)
+    {
+      if (mapMatchedPosition.type == MapMatchedPositionType::LANE_IN)
+      {
+        laneIds.push_back(mapMatchedPosition.lanePoint.paraPoint.laneId);
+      }
+    }
+    std::sort(laneIds.begin(), laneIds.end());
+    return laneIds;
+  }
+
+  mutable AdMapMatching mMapMatching;
+  physics::Distance const mDistance{1.};
+  physics::Probability const mMinProbability{0.05};
+  point::GeoPoint const mStart{
+    point::createGeoPoint(point::Longitude(8.4401803), point::Latitude(49.0191987), point::Altitude(0.))};
+};
+
+TEST_F(MapMatchingTrackerTest, follows_lanes)
+{
+  auto const trajectory = createTrajectory(mStart);
+  ASSERT_LT(10u, trajectory.size());
+
+  MapMatchingTracker tracker;
+  EXPECT_EQ(0., tracker.getHitRate());
+  for (auto const &point : trajectory)
+  {
+    auto const trackerResult = tracker.getMapMatchedPositions(1u, point, mDistance, mMinProbability);
+    auto const globalResult = mMapMatching.getMapMatchedPositions(point, mDistance, mMinProbability);
+    ASSERT_FALSE(getLaneIds(globalResult).empty());
+    EXPECT_EQ(getLaneIds(globalResult), getLaneIds(trackerResult));
+    EXPECT_EQ(globalResult.size(), trackerResult.size());
+  }
+  auto const &statistics = tracker.getStatistics();
+  EXPECT_EQ(1u, tracker.size());
+  EXPECT_LT(0u, statistics.localHits);
+  EXPECT_EQ(statistics.localMisses + 1u, statistics.globalSearches);
+  EXPECT_EQ(trajectory.size(), statistics.localHits + statistics.globalSearches);
+  EXPECT_NEAR(static_cast<double>(statistics.localHits) / static_cast<double>(trajectory.size()),
+              tracker.getHitRate(),
+              1e-9);
+}
+
+TEST_F(MapMatchingTrackerTest, search_margin)
+{
+  auto const trajectory = createTrajectory(mStart);
+  ASSERT_LT(10u, trajectory.size());
+
+  MapMatchingTracker noMarginTracker(physics::Distance(0.));
+  MapMatchingTracker largeMarginTracker(physics::Distance(1000.));
+  for (auto const &point : trajectory)
+  {
+    auto const globalLaneIds = getLaneIds(mMapMatching.getMapMatchedPositions(point, mDistance, mMinProbability));
+    EXPECT_EQ(globalLaneIds,
+              getLaneIds(noMarginTracker.getMapMatchedPositions(1u, point, mDistance, mMinProbability)));
+    EXPECT_EQ(globalLaneIds,
+              getLaneIds(largeMarginTracker.getMapMatchedPositions(1u, point, mDistance, mMinProbability)));
+  }
+  EXPECT_EQ(0u, noMarginTracker.getStatistics().localHits);
+  EXPECT_EQ(trajectory.size(), noMarginTracker.getStatistics().globalSearches);
+  EXPECT_EQ(1u, largeMarginTracker.getStatistics().globalSearches);
+  EXPECT_EQ(trajectory.size() - 1u, largeMarginTracker.getStatistics().localHits);
+}
+
+TEST_F(MapMatchingTrackerTest, falls_back_to_global_search)
+{
+  auto const trajectory = createTrajectory(mStart);
+  ASSERT_LT(1u, trajectory.size());
+
+  MapMatchingTracker tracker;
+  tracker.getMapMatchedPositions(1u, trajectory.front(), mDistance, mMinProbability);
+  tracker.getMapMatchedPositions(2u, trajectory.front(), mDistance, mMinProbability);
+  EXPECT_EQ(2u, tracker.size());
+  EXPECT_EQ(2u, tracker.getStatistics().globalSearches);
+
+  // an object jumping to a lane far away
+  auto const otherLaneId = lane::getLanes().back();
+  auto const otherPoint = lane::getParametricPoint(
+    lane::getLane(otherLaneId), physics::ParametricValue(0.5), physics::ParametricValue(0.5));
+  ASSERT_LT(physics::Distance(100.), point::distance(otherPoint, trajectory.front()));
+  auto const trackerResult = tracker.getMapMatchedPositions(1u, otherPoint, mDistance, mMinProbability);
+  EXPECT_EQ(getLaneIds(mMapMatching.getMapMatchedPositions(otherPoint, mDistance, mMinProbability)),
+            getLaneIds(trackerResult));
+  EXPECT_EQ(1u, tracker.getStatistics().localMisses);
+  EXPECT_EQ(3u, tracker.getStatistics().globalSearches);
+
+  // a removed object is searched without a miss
+  tracker.removeObject(2u);
+  EXPECT_EQ(1u, tracker.size());
+  tracker.getMapMatchedPositions(2u, trajectory.front(), mDistance, mMinProbability);
+  EXPECT_EQ(1u, tracker.getStatistics().localMisses);
+  EXPECT_EQ(4u, tracker.getStatistics().globalSearches);
+
+  tracker.resetStatistics();
+  EXPECT_EQ(0u, tracker.getStatistics().globalSearches);
+  tracker.clear();
+  EXPECT_EQ(0u, tracker.size());
+}
+
+TEST_F(MapMatchingTrackerTest, object_position_with_heading_hint)
+{
+  auto const trajectory = createTrajectory(mStart);
+  ASSERT_LT(1u, trajectory.size());
+
+  MapMatchingTracker tracker;
+  for (auto const &point : trajectory)
+  {
+    ENUObjectPosition objectPosition;
+    objectPosition.enuReferencePoint = mStart;
+    objectPosition.centerPoint = point::toENU(point, mStart);
+    objectPosition.heading = point::createENUHeading(1.);
+    auto const trackerResult = tracker.getMapMatchedPositions(1u, objectPosition, mDistance, mMinProbability);
+    auto const globalResult = mMapMatching.getMapMatchedPositions(objectPosition, mDistance, mMinProbability);
+    ASSERT_EQ(globalResult.size(), trackerResult.size());
+    for (auto const &globalPosition : globalResult)
+    {
+      auto const trackerPosition = std::find_if(
+        trackerResult.begin(), trackerResult.end(), [&globalPosition](MapMatchedPosition const &mapMatchedPosition) {
+          return mapMatchedPosition.lanePoint.paraPoint == globalPosition.lanePoint.paraPoint;
+        });
+      ASSERT_NE(trackerResult.end(), trackerPosition);
+      EXPECT_NEAR(static_cast<double>(globalPosition.probability),
+                  static_cast<double>(trackerPosition->probability),
+                  1e-9);
+    }
+  }
+  EXPECT_LT(0u, tracker.getStatistics().localHits);
+}
+
+TEST_F(MapMatchingTrackerTest, forgets_lanes_of_replaced_store)
+{
+  auto const trajectory = createTrajectory(mStart);
+  ASSERT_LT(1u, trajectory.size());
+  auto const &point = trajectory.front();
+  auto const laneIds = getLaneIds(mMapMatching.getMapMatchedPositions(point, mDistance, mMinProbability));
+  ASSERT_FALSE(laneIds.empty());
+
+  MapMatchingTracker tracker(physics::Distance(1000.));
+  tracker.getMapMatchedPositions(1u, point, mDistance, mMinProbability);
+  EXPECT_EQ(1u, tracker.getStatistics().globalSearches);
+
+  // a patch adds a copy of the lane the object is on
+  auto const allLaneIds = lane::getLanes();
+  auto addedLane = std::make_shared<lane::Lane>(lane::getLane(laneIds.front()));
+  addedLane->id = lane::LaneId(static_cast<uint64_t>(*std::max_element(allLaneIds.begin(), allLaneIds.end())) + 1u);
+  addedLane->contactLanes.clear();
+  access::MapPatch patch;
+  patch.addedLanes[addedLane->id] = addedLane;
+  ASSERT_TRUE(access::applyPatch(patch));
+
+  auto const patchedLaneIds = getLaneIds(mMapMatching.getMapMatchedPositions(point, mDistance, mMinProbability));
+  ASSERT_NE(patchedLaneIds.end(), std::find(patchedLaneIds.begin(), patchedLaneIds.end(), addedLane->id));
+  EXPECT_EQ(patchedLaneIds, getLaneIds(tracker.getMapMatchedPositions(1u, point, mDistance, mMinProbability)));
+  EXPECT_EQ(2u, tracker.getStatistics().globalSearches);
+  EXPECT_EQ(0u, tracker.getStatistics().localHits);
+
+  // the object is found in the remembered lanes while the store stays the same
+  tracker.getMapMatchedPositions(1u, point, mDistance, mMinProbability);
+  EXPECT_EQ(1u, tracker.getStatistics().localHits);
+
+  // the map is initialized again
+  access::cleanup();
+  ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  EXPECT_EQ(laneIds, getLaneIds(tracker.getMapMatchedPositions(1u, point, mDistance, mMinProbability)));
+  EXPECT_EQ(3u, tracker.getStatistics().globalSearches);
+  EXPECT_EQ(1u, tracker.size());
+}
@@ -0,0 +1,228 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/opendrive/AdMapCache.hpp>
+#include <ad/map/point/GeoOperation.hpp>
+#include <ctime>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <utime.h>
+
+using namespace ::ad;
+using namespace ::ad::map;
+using namespace ::ad::map::opendrive;
+
+struct AdMapCacheTests : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+    AdMapCache(cacheDirectory).clear();
+    ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  }
+
+  virtual void TearDown()
+  {
+    AdMapCache(cacheDirectory).clear();
+    access::setOpenDriveCache("");
+    access::cleanup();
+  }
+
+  std::string entryFileName(std::string const &entryName) const
+  {
+    return cacheDirectory + "/" + entryName + ".adm";
+  }
+
+  void setLastUse(std::string const &entryName, std::time_t lastUse) const
+  {
+    struct utimbuf times;
+    times.actime = lastUse;
+    times.modtime = lastUse;
+    ASSERT_EQ(0, utime(entryFileName(entryName).c_str(), &times));
+  }
+
+  std::time_t getLastUse(std::string const &entryName) const
+  {
+    struct stat fileStat;
+    if (stat(entryFileName(entryName).c_str(), &fileStat) != 0)
+    {
+      return 0;
+    }
+    return fileStat.st_mtime;
+  }
+
+  std::string readOpenDriveContent() const
+  {
+    std::ifstream mapFile("test_files/Town01.xodr");
+    std::stringstream openDriveContentStream;
+    openDriveContentStream << mapFile.rdbuf();
+    return openDriveContentStream.str();
+  }
+
+  std::string const cacheDirectory{"test_files/opendrive_cache"};
+};
+
+TEST_F(AdMapCacheTests, entry_name)
+{
+  AdMapCache cache(cacheDirectory);
+  ASSERT_TRUE(cache.isEnabled());
+  auto const entryName = cache.getEntryName("<OpenDRIVE/>", 0.1, intersection::IntersectionType::Unknown);
+  EXPECT_EQ(40u, entryName.size());
+  EXPECT_EQ(entryName, cache.getEntryName("<OpenDRIVE/>", 0.1, intersection::IntersectionType::Unknown));
+  EXPECT_NE(entryName, cache.getEntryName("<OpenDRIVE />", 0.1, intersection::IntersectionType::Unknown));
+  EXPECT_NE(entryName, cache.getEntryName("<OpenDRIVE/>", 0.2, intersection::IntersectionType::Unknown));
+  EXPECT_NE(entryName, cache.getEntryName("<OpenDRIVE/>", 0.1, intersection::IntersectionType::Stop));
+
+  // without geo reference in the content, the conversion depends on the current ENU reference point
+  access::setENUReferencePoint(
+    point::createGeoPoint(point::Longitude(8.44), point::Latitude(49.01), point::Altitude(0.)));
+  EXPECT_NE(entryName, cache.getEntryName("<OpenDRIVE/>", 0.1, intersection::IntersectionType::Unknown));
+}
+
+TEST_F(AdMapCacheTests, save_and_load)
+{
+  AdMapCache cache(cacheDirectory);
+  auto const laneIds = lane::getLanes();
+  auto const enuReferencePoint = access::getENUReferencePoint();
+  auto const entryName = cache.getEntryName("content", 0.1, intersection::IntersectionType::Unknown);
+  EXPECT_EQ(nullptr, cache.load(entryName));
+  ASSERT_TRUE(cache.save(entryName, access::getStore()));
+  EXPECT_LT(0u, cache.size());
+  access::cleanup();
+
+  auto const store = cache.load(entryName);
+  ASSERT_NE(nullptr, store);
+  EXPECT_EQ(enuReferencePoint, access::getENUReferencePoint());
+  ASSERT_TRUE(access::init(store));
+  ASSERT_EQ(laneIds, lane::getLanes());
+
+  // another entry name in the file invalidates the entry
+  auto const otherEntryName = cache.getEntryName("content", 0.2, intersection::IntersectionType::Unknown);
+  std::ifstream source(entryFileName(entryName), std::ios::binary);
+  std::ofstream target(entryFileName(otherEntryName), std::ios::binary);
+  target << source.rdbuf();
+  target.close();
+  EXPECT_EQ(nullptr, cache.load(otherEntryName));
+
+  // corrupt entries are ignored
+  std::ofstream corrupt(entryFileName(entryName), std::ios::binary | std::ios::in | std::ios::out);
+  corrupt.seekp(100);
+  corrupt << "corrupt";
+  corrupt.close();
+  EXPECT_EQ(nullptr, cache.load(entryName));
+
+  cache.clear();
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(AdMapCacheTests, size_limit)
+{
+  AdMapCache unlimitedCache(cacheDirectory);
+  ASSERT_TRUE(unlimitedCache.save("entry1", access::getStore()));
+  auto const entrySize = unlimitedCache.size();
+  ASSERT_TRUE(unlimitedCache.save("entry2", access::getStore()));
+  EXPECT_EQ(2u * entrySize, unlimitedCache.size());
+
+  auto const now = std::time(nullptr);
+  setLastUse("entry1", now - 200);
+  setLastUse("entry2", now - 100);
+
+  AdMapCache cache(cacheDirectory, 2u * entrySize + entrySize / 2u);
+  // loading an entry marks it as used
+  ASSERT_NE(nullptr, cache.load("entry1"));
+  ASSERT_TRUE(cache.save("entry3", access::getStore()));
+  EXPECT_EQ(2u * entrySize, cache.size());
+  EXPECT_NE(nullptr, cache.load("entry1"));
+  EXPECT_EQ(nullptr, cache.load("entry2"));
+  EXPECT_NE(nullptr, cache.load("entry3"));
+
+  // the entry just written is kept in any case
+  AdMapCache tinyCache(cacheDirectory, 1u);
+  ASSERT_TRUE(tinyCache.save("entry4", access::getStore()));
+  EXPECT_EQ(entrySize, tinyCache.size());
+  EXPECT_NE(nullptr, tinyCache.load("entry4"));
+}
+
+TEST_F(AdMapCacheTests, invalid_content)
+{
+  ASSERT_TRUE(access::setOpenDriveCache(cacheDirectory));
+  access::cleanup();
+  EXPECT_FALSE(access::initFromOpenDriveContent("invalid", 0.1, intersection::IntersectionType::Unknown));
+  EXPECT_EQ(0u, AdMapCache(cacheDirectory).size());
+  EXPECT_TRUE(access::setOpenDriveCache(""));
+}
+
+TEST_F(AdMapCacheTests, disabled)
+{
+  AdMapCache cache;
+  EXPECT_FALSE(cache.isEnabled());
+  EXPECT_FALSE(cache.save("entry1", access::getStore()));
+  EXPECT_EQ(nullptr, cache.load("entry1"));
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(AdMapCacheTests, convert_opendrive_map_twice)
+{
+  auto const openDriveContent = readOpenDriveContent();
+  ASSERT_FALSE(openDriveContent.empty());
+  ASSERT_TRUE(access::setOpenDriveCache(cacheDirectory));
+  access::cleanup();
+  AdMapCache cache(cacheDirectory);
+  auto const entryName = cache.getEntryName(openDriveContent, 0.2, intersection::IntersectionType::TrafficLight);
+
+  ASSERT_TRUE(access::initFromOpenDriveContent(openDriveContent, 0.2, intersection::IntersectionType::TrafficLight));
+  auto const convertedStore = access::createMapContext()->getStorePtr();
+  auto const enuReferencePoint = access::getENUReferencePoint();
+  // the conversion creates a single entry
+  auto const entrySize = cache.size();
+  ASSERT_LT(0u, entrySize);
+  struct stat entryStat;
+  ASSERT_EQ(0, stat(entryFileName(entryName).c_str(), &entryStat));
+  EXPECT_EQ(entrySize, static_cast<std::size_t>(entryStat.st_size));
+
+  auto const now = std::time(nullptr);
+  setLastUse(entryName, now - 100);
+  access::cleanup();
+  ASSERT_TRUE(access::initFromOpenDriveContent(openDriveContent, 0.2, intersection::IntersectionType::TrafficLight));
+
+  // the second conversion is loaded from the entry, which marks it as used
+  EXPECT_LE(now, getLastUse(entryName));
+  EXPECT_EQ(entrySize, cache.size());
+  EXPECT_EQ(enuReferencePoint, access::getENUReferencePoint());
+  auto const &loadedStore = access::getStore();
+  ASSERT_NE(convertedStore.get(), &loadedStore);
+  auto const laneIds = convertedStore->getLanes();
+  ASSERT_FALSE(laneIds.empty());
+  ASSERT_EQ(laneIds, loadedStore.getLanes());
+  for (auto const &laneId : laneIds)
+  {
+    EXPECT_EQ(*convertedStore->getLanePtr(laneId), *loadedStore.getLanePtr(laneId));
+  }
+}
+
+TEST_F(AdMapCacheTests, configured_cache_applies_while_initialized)
+{
+  std::string const apiCacheDirectory("test_files/opendrive_api_cache");
+  auto const openDriveContent = readOpenDriveContent();
+  ASSERT_TRUE(access::setOpenDriveCache(apiCacheDirectory));
+  access::cleanup();
+
+  // the configuration file gives test_files/opendrive_cache as cache directory
+  ASSERT_TRUE(access::init("test_files/map_config_opendrive_cache.txt"));
+  access::cleanup();
+
+  // the cache set by the API survives the cleanup, the configured one doesn't
+  ASSERT_TRUE(access::initFromOpenDriveContent(openDriveContent, 0.2, intersection::IntersectionType::TrafficLight));
+  EXPECT_LT(0u, AdMapCache(apiCacheDirectory).size());
+  EXPECT_EQ(0u, AdMapCache(cacheDirectory).size());
+  AdMapCache(apiCacheDirectory).clear();
+}
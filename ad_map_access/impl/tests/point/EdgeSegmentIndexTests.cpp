@@ -0,0 +1,175 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/match/AdMapMatching.hpp>
+#include <ad/map/point/Operation.hpp>
+#include <cmath>
+#include <gtest/gtest.h>
+#include "../../src/lane/LaneOperationPrivate.hpp"
+#include "../../src/point/EdgeSegmentIndex.hpp"
+#include "RandomGeometry.hpp"
+
+using namespace ::ad;
+using namespace ::ad::map;
+using namespace ::ad::map::point;
+
+struct EdgeSegmentIndexTest : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+  }
+
+  virtual void TearDown()
+  {
+    access::cleanup();
+  }
+
+  void expectIdentical(ECEFPoint const &expected, ECEFPoint const &actual)
+  {
+    EXPECT_EQ(static_cast<double>(expected.x), static_cast<double>(actual.x));
+    EXPECT_EQ(static_cast<double>(expected.y), static_cast<double>(actual.y));
+    EXPECT_EQ(static_cast<double>(expected.z), static_cast<double>(actual.z));
+  }
+
+  void checkEdge(Geometry const &geometry, ECEFPoint const &queryCenter, int queryRange)
+  {
+    EdgeSegmentIndex const index(geometry.ecefEdge);
+    for (int i = 0; i < 200; ++i)
+    {
+      auto const pt = queryCenter
+        + createECEFPoint(std::rand() % queryRange - queryRange / 2,
+                          std::rand() % queryRange - queryRange / 2,
+                          std::rand() % 3);
+      auto const expected = findNearestPointOnEdge(geometry.ecefEdge, geometry.length, pt);
+      auto const actual = index.findNearestPointOnEdge(geometry.ecefEdge, geometry.length, pt);
+      ASSERT_EQ(static_cast<double>(expected), static_cast<double>(actual));
+    }
+    for (int i = 0; i <= 100; ++i)
+    {
+      physics::ParametricValue const t(i / 100.);
+      expectIdentical(getParametricPoint(geometry.ecefEdge, geometry.length, t),
+                      index.getParametricPoint(geometry.ecefEdge, geometry.length, t));
+    }
+  }
+};
+
+TEST_F(EdgeSegmentIndexTest, random_edges)
+{
+  for (uint32_t seed = 1u; seed < 20u; ++seed)
+  {
+    auto const geometry = randGeometry(createECEFPoint(4000000, 600000, 4800000), 300u, seed);
+    checkEdge(geometry, geometry.ecefEdge[150], 2000);
+    checkEdge(geometry, geometry.ecefEdge[150], 20);
+  }
+}
+
+TEST_F(EdgeSegmentIndexTest, equidistant_segments)
+{
+  // all segments have the same distance to the center of the circle
+  ECEFEdge circle;
+  auto const center = createECEFPoint(4000000, 600000, 4800000);
+  for (int i = 0; i <= 200; ++i)
+  {
+    double const angle = i * M_PI / 100.;
+    circle.push_back(center + createECEFPoint(50. * std::cos(angle), 50. * std::sin(angle), 0.));
+  }
+  auto const geometry = createGeometry(circle, false);
+  EdgeSegmentIndex const index(geometry.ecefEdge);
+  EXPECT_EQ(static_cast<double>(findNearestPointOnEdge(geometry.ecefEdge, geometry.length, center)),
+            static_cast<double>(index.findNearestPointOnEdge(geometry.ecefEdge, geometry.length, center)));
+  checkEdge(geometry, center, 10);
+}
+
+TEST_F(EdgeSegmentIndexTest, degenerated_edges)
+{
+  auto const pt = createECEFPoint(4000000, 600000, 4800000);
+  ECEFEdge edge;
+  EdgeSegmentIndex const emptyIndex(edge);
+  EXPECT_FALSE(emptyIndex.findNearestPointOnEdge(edge, physics::Distance(0.), pt).isValid());
+
+  edge.push_back(pt);
+  EdgeSegmentIndex const singlePointIndex(edge);
+  EXPECT_EQ(physics::ParametricValue(0.), singlePointIndex.findNearestPointOnEdge(edge, physics::Distance(0.), pt));
+  expectIdentical(pt, singlePointIndex.getParametricPoint(edge, physics::Distance(0.), physics::ParametricValue(0.5)));
+
+  edge.push_back(pt);
+  edge.push_back(pt + createECEFPoint(10, 0, 0));
+  edge.push_back(pt + createECEFPoint(10, 0, 0));
+  auto const geometry = createGeometry(edge, false);
+  checkEdge(geometry, pt, 20);
+}
+
+TEST_F(EdgeSegmentIndexTest, nearest_point_on_lane)
+{
+  ASSERT_TRUE(access::init("test_files/TPK_PFZ.adm.txt"));
+  std::srand(7);
+  for (auto laneId : lane::getLanes())
+  {
+    auto const lanePtr = lane::getLanePtr(laneId);
+    lane::LaneSegmentIndex const laneSegmentIndex(lanePtr);
+    for (int i = 0; i < 10; ++i)
+    {
+      auto const pt = lanePtr->boundingSphere.center
+        + createECEFPoint(std::rand() % 40 - 20, std::rand() % 40 - 20, std::rand() % 4 - 2);
+      match::MapMatchedPosition expected;
+      match::MapMatchedPosition actual;
+      ASSERT_EQ(lane::findNearestPointOnLane(*lanePtr, pt, expected),
+                lane::findNearestPointOnLane(laneSegmentIndex, pt, actual));
+      EXPECT_EQ(static_cast<double>(expected.lanePoint.paraPoint.parametricOffset),
+                static_cast<double>(actual.lanePoint.paraPoint.parametricOffset));
+      EXPECT_EQ(static_cast<double>(expected.lanePoint.lateralT), static_cast<double>(actual.lanePoint.lateralT));
+      expectIdentical(expected.matchedPoint, actual.matchedPoint);
+    }
+  }
+}
+
+TEST_F(EdgeSegmentIndexTest, map_matching_without_segment_index)
+{
+  ASSERT_TRUE(access::init("test_files/TPK_PFZ.adm.txt"));
+  std::vector<ECEFPoint> points;
+  std::srand(11);
+  for (auto laneId : lane::getLanes())
+  {
+    points.push_back(lane::getLanePtr(laneId)->boundingSphere.center
+                     + createECEFPoint(std::rand() % 10 - 5, std::rand() % 10 - 5, 0));
+  }
+
+  match::AdMapMatching mapMatching;
+  auto matchAll = [&]() {
+    std::vector<match::MapMatchedPositionConfidenceList> results;
+    for (auto const &pt : points)
+    {
+      results.push_back(mapMatching.getMapMatchedPositions(pt, physics::Distance(2.), physics::Probability(0.05)));
+    }
+    return results;
+  };
+
+  auto &store = access::getStore();
+  EXPECT_TRUE(store.isLaneSegmentIndexEnabled());
+  auto const indexedResults = matchAll();
+  store.setLaneSegmentIndexEnabled(false);
+  EXPECT_FALSE(store.isLaneSegmentIndexEnabled());
+  auto const genericResults = matchAll();
+  store.setLaneSegmentIndexEnabled(true);
+
+  ASSERT_EQ(indexedResults.size(), genericResults.size());
+  for (std::size_t i = 0u; i < indexedResults.size(); ++i)
+  {
+    ASSERT_EQ(indexedResults[i].size(), genericResults[i].size());
+    for (std::size_t j = 0u; j < indexedResults[i].size(); ++j)
+    {
+      EXPECT_EQ(indexedResults[i][j].lanePoint.paraPoint, genericResults[i][j].lanePoint.paraPoint);
+      EXPECT_EQ(static_cast<double>(indexedResults[i][j].lanePoint.lateralT),
+                static_cast<double>(genericResults[i][j].lanePoint.lateralT));
+      expectIdentical(indexedResults[i][j].matchedPoint, genericResults[i][j].matchedPoint);
+    }
+  }
+}
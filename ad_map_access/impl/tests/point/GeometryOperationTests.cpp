@@ -7,8 +7,11 @@
 // ----------------- END LICENSE BLOCK -----------------------------------
 
 #include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
 #include <ad/map/point/Operation.hpp>
 #include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
 
 using namespace ::ad;
 using namespace ::ad::map;
@@ -256,3 +259,65 @@ TEST_F(GeometryOperationTest, ParametricRangeENU)
   enu_edge_length = calcLength(edge_enu);
   EXPECT_EQ(ecef_edge_length, enu_edge_length);
 }
+
+TEST_F(GeometryOperationTest, ParametricRangeENUConcurrent)
+{
+  ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+  std::vector<lane::Lane::ConstPtr> lanes;
+  for (auto const &laneId : lane::getLanes())
+  {
+    lanes.push_back(lane::getLanePtr(laneId));
+  }
+  ASSERT_FALSE(lanes.empty());
+
+  physics::ParametricRange trange;
+  trange.minimum = physics::ParametricValue(0.1);
+  trange.maximum = physics::ParametricValue(0.9);
+  std::vector<GeoPoint> const enuReferences
+    = {toGeo(lanes.front()->edgeLeft.ecefEdge.front()), toGeo(lanes.back()->edgeRight.ecefEdge.back())};
+
+  for (auto const &enuReference : enuReferences)
+  {
+    access::setENUReferencePoint(enuReference);
+
+    // the expected edges are calculated without touching the geometries of the store
+    CoordinateTransform coordinateTransform;
+    coordinateTransform.setENUReferencePoint(enuReference);
+    std::vector<ENUEdge> expectedEdges;
+    for (auto const &lane : lanes)
+    {
+      ECEFEdge ecefEdge;
+      getParametricRange(lane->edgeLeft, trange, ecefEdge);
+      ENUEdge expectedEdge;
+      coordinateTransform.convert(ecefEdge, expectedEdge);
+      expectedEdges.push_back(expectedEdge);
+    }
+
+    std::atomic<std::size_t> mismatches{0u};
+    std::vector<std::thread> workers;
+    for (auto workerIndex = 0u; workerIndex < 4u; ++workerIndex)
+    {
+      workers.emplace_back([&lanes, &expectedEdges, &trange, &mismatches, workerIndex] {
+        for (auto round = 0u; round < 20u; ++round)
+        {
+          for (std::size_t i = 0u; i < lanes.size(); ++i)
+          {
+            // each worker runs through the lanes in another order
+            auto const laneIndex = (i * (workerIndex + 1u) + round) % lanes.size();
+            ENUEdge enuEdge;
+            getParametricRange(lanes[laneIndex]->edgeLeft, trange, enuEdge);
+            if (enuEdge != expectedEdges[laneIndex])
+            {
+              mismatches++;
+            }
+          }
+        }
+      });
+    }
+    for (auto &worker : workers)
+    {
+      worker.join();
+    }
+    EXPECT_EQ(0u, mismatches);
+  }
+}
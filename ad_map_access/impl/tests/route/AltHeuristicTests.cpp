@@ -0,0 +1,152 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/route/AltHeuristic.hpp>
+#include <ad/map/route/Planning.hpp>
+#include <ad/map/route/RouteAStar.hpp>
+#include <cmath>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace ::ad;
+using namespace ::ad::map;
+using namespace ::ad::map::route::planning;
+
+struct AltHeuristicTest : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+    ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+    laneIds = lane::getLanes();
+    ASSERT_FALSE(laneIds.empty());
+  }
+  virtual void TearDown()
+  {
+    access::cleanup();
+  }
+
+  RoutingParaPoint randomRoutingPoint(std::mt19937 &generator)
+  {
+    std::uniform_int_distribution<std::size_t> laneDistribution(0u, laneIds.size() - 1u);
+    std::uniform_real_distribution<double> offsetDistribution(0., 1.);
+    return createRoutingPoint(laneIds[laneDistribution(generator)],
+                              physics::ParametricValue(offsetDistribution(generator)));
+  }
+
+  physics::Distance routingCost(point::ParaPointList const &rawRoute)
+  {
+    physics::Distance cost(0.);
+    for (std::size_t i = 1u; i < rawRoute.size(); ++i)
+    {
+      if (rawRoute[i].laneId == rawRoute[i - 1u].laneId)
+      {
+        cost += std::fabs(rawRoute[i].parametricOffset - rawRoute[i - 1u].parametricOffset)
+          * lane::getLane(rawRoute[i].laneId).length;
+      }
+      else if (lane::isSuccessorOrPredecessor(rawRoute[i - 1u].laneId, rawRoute[i].laneId))
+      {
+        cost += physics::Distance(1.);
+      }
+      else
+      {
+        cost += physics::Distance(5.);
+      }
+    }
+    return cost;
+  }
+
+  lane::LaneIdList laneIds;
+};
+
+TEST_F(AltHeuristicTest, build_save_load)
+{
+  AltHeuristic invalid;
+  ASSERT_FALSE(invalid.isValid());
+  ASSERT_FALSE(invalid.save("AltHeuristicTest.alt"));
+
+  auto const laneGraph = lane::getLaneGraph();
+  AltHeuristic altHeuristic;
+  ASSERT_TRUE(altHeuristic.build(*laneGraph, 4u));
+  ASSERT_TRUE(altHeuristic.isValid());
+  ASSERT_TRUE(altHeuristic.isValidFor(*laneGraph));
+  ASSERT_EQ(4u, altHeuristic.getLandmarkCount());
+
+  ASSERT_EQ("test_files/TPK.adm.alt", AltHeuristic::getFileName("test_files/TPK.adm"));
+  ASSERT_TRUE(altHeuristic.save("AltHeuristicTest.alt"));
+  AltHeuristic loaded;
+  ASSERT_TRUE(loaded.load("AltHeuristicTest.alt"));
+  ASSERT_TRUE(loaded.isValidFor(*laneGraph));
+  ASSERT_EQ(altHeuristic.getLandmarkCount(), loaded.getLandmarkCount());
+
+  auto const destination = point::createParaPoint(laneIds.front(), physics::ParametricValue(0.3));
+  auto const destinationCosts = altHeuristic.getDestinationCosts(*laneGraph, destination);
+  ASSERT_EQ(destinationCosts, loaded.getDestinationCosts(*laneGraph, destination));
+  for (lane::LaneGraph::NodeIndex node = 0u; node < laneGraph->size(); ++node)
+  {
+    ASSERT_EQ(altHeuristic.getLowerBound(node, false, destinationCosts),
+              loaded.getLowerBound(node, false, destinationCosts));
+    ASSERT_EQ(altHeuristic.getLowerBound(node, true, destinationCosts),
+              loaded.getLowerBound(node, true, destinationCosts));
+  }
+  ASSERT_EQ(0, std::remove("AltHeuristicTest.alt"));
+
+  ASSERT_FALSE(loaded.load("AltHeuristicTest.alt"));
+  ASSERT_FALSE(loaded.isValid());
+}
+
+TEST_F(AltHeuristicTest, routes_are_equally_short)
+{
+  auto altHeuristic = std::make_shared<AltHeuristic>();
+  ASSERT_TRUE(altHeuristic->build(*lane::getLaneGraph()));
+
+  std::mt19937 generator(42u);
+  std::size_t expandedPoints = 0u;
+  std::size_t expandedPointsAlt = 0u;
+  for (auto i = 0u; i < 200u; ++i)
+  {
+    auto const start = randomRoutingPoint(generator);
+    auto const dest = randomRoutingPoint(generator);
+
+    RouteAstar routePlanning(start, dest, Route::Type::SHORTEST);
+    RouteAstar routePlanningAlt(start, dest, Route::Type::SHORTEST, altHeuristic);
+    auto const found = routePlanning.calculate();
+    ASSERT_EQ(found, routePlanningAlt.calculate());
+    if (found)
+    {
+      ASSERT_EQ(routePlanning.getRawRoute().front(), routePlanningAlt.getRawRoute().front());
+      ASSERT_EQ(routePlanning.getRawRoute().back(), routePlanningAlt.getRawRoute().back());
+      ASSERT_EQ(routingCost(routePlanning.getRawRoute()), routingCost(routePlanningAlt.getRawRoute()));
+    }
+    expandedPoints += routePlanning.getExpandedPointCount();
+    expandedPointsAlt += routePlanningAlt.getExpandedPointCount();
+  }
+  ASSERT_LT(expandedPointsAlt, expandedPoints);
+}
+
+TEST_F(AltHeuristicTest, tables_of_other_map_are_ignored)
+{
+  auto altHeuristic = std::make_shared<AltHeuristic>();
+  ASSERT_TRUE(altHeuristic->build(*lane::getLaneGraph()));
+
+  access::cleanup();
+  ASSERT_TRUE(access::init("test_files/LaneChange.adm.txt"));
+  laneIds = lane::getLanes();
+  ASSERT_FALSE(altHeuristic->isValidFor(*lane::getLaneGraph()));
+
+  std::mt19937 generator(7u);
+  for (auto i = 0u; i < 10u; ++i)
+  {
+    auto const start = randomRoutingPoint(generator);
+    auto const dest = randomRoutingPoint(generator);
+    ASSERT_EQ(planRoute(start, dest).roadSegments, planRoute(start, dest, altHeuristic).roadSegments);
+  }
+}
@@ -0,0 +1,158 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/route/ContractionHierarchy.hpp>
+#include <ad/map/route/Planning.hpp>
+#include <ad/map/route/RouteAStar.hpp>
+#include <ad/map/route/RouteContractionHierarchy.hpp>
+#include <cmath>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace ::ad;
+using namespace ::ad::map;
+using namespace ::ad::map::route::planning;
+
+struct ContractionHierarchyTest : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+    ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+    laneIds = lane::getLanes();
+    ASSERT_FALSE(laneIds.empty());
+  }
+  virtual void TearDown()
+  {
+    access::cleanup();
+  }
+
+  RoutingParaPoint randomRoutingPoint(std::mt19937 &generator)
+  {
+    std::uniform_int_distribution<std::size_t> laneDistribution(0u, laneIds.size() - 1u);
+    std::uniform_int_distribution<int> offsetDistribution(0, 4);
+    std::uniform_int_distribution<int> directionDistribution(0, 2);
+    // also cover the start and end of the lanes, which are nodes of the hierarchy
+    return createRoutingPoint(laneIds[laneDistribution(generator)],
+                              physics::ParametricValue(0.25 * offsetDistribution(generator)),
+                              static_cast<RoutingDirection>(directionDistribution(generator)));
+  }
+
+  physics::Distance routingCost(point::ParaPointList const &rawRoute)
+  {
+    physics::Distance cost(0.);
+    for (std::size_t i = 1u; i < rawRoute.size(); ++i)
+    {
+      if (rawRoute[i].laneId == rawRoute[i - 1u].laneId)
+      {
+        cost += std::fabs(rawRoute[i].parametricOffset - rawRoute[i - 1u].parametricOffset)
+          * lane::getLane(rawRoute[i].laneId).length;
+      }
+      else if (lane::isSuccessorOrPredecessor(rawRoute[i - 1u].laneId, rawRoute[i].laneId))
+      {
+        cost += physics::Distance(1.);
+      }
+      else
+      {
+        cost += physics::Distance(5.);
+      }
+    }
+    return cost;
+  }
+
+  lane::LaneIdList laneIds;
+};
+
+TEST_F(ContractionHierarchyTest, build_save_load)
+{
+  ContractionHierarchy invalid;
+  ASSERT_FALSE(invalid.isValid());
+  ASSERT_FALSE(invalid.save("ContractionHierarchyTest.ch"));
+
+  auto const laneGraph = lane::getLaneGraph();
+  ContractionHierarchy contractionHierarchy;
+  ASSERT_TRUE(contractionHierarchy.build(*laneGraph));
+  ASSERT_TRUE(contractionHierarchy.isValid());
+  ASSERT_TRUE(contractionHierarchy.isValidFor(*laneGraph));
+  ASSERT_EQ(6u * laneGraph->size(), contractionHierarchy.size());
+
+  ASSERT_EQ("test_files/TPK.adm.ch", ContractionHierarchy::getFileName("test_files/TPK.adm"));
+  ASSERT_TRUE(contractionHierarchy.save("ContractionHierarchyTest.ch"));
+  ContractionHierarchy loaded;
+  ASSERT_TRUE(loaded.load("ContractionHierarchyTest.ch"));
+  ASSERT_TRUE(loaded.isValidFor(*laneGraph));
+  ASSERT_EQ(contractionHierarchy.size(), loaded.size());
+  ASSERT_EQ(contractionHierarchy.getEdgeCount(), loaded.getEdgeCount());
+  ASSERT_EQ(0, std::remove("ContractionHierarchyTest.ch"));
+
+  ASSERT_FALSE(loaded.load("ContractionHierarchyTest.ch"));
+  ASSERT_FALSE(loaded.isValid());
+}
+
+TEST_F(ContractionHierarchyTest, node_index)
+{
+  for (lane::LaneGraph::NodeIndex lane = 0u; lane < 3u; ++lane)
+  {
+    for (auto const atLaneEnd : {false, true})
+    {
+      for (auto const direction : {RoutingDirection::DONT_CARE, RoutingDirection::POSITIVE, RoutingDirection::NEGATIVE})
+      {
+        auto const node = ContractionHierarchy::getNodeIndex(lane, atLaneEnd, direction);
+        ASSERT_EQ(lane, ContractionHierarchy::getLaneIndex(node));
+        ASSERT_EQ(atLaneEnd, ContractionHierarchy::isAtLaneEnd(node));
+        ASSERT_EQ(direction, ContractionHierarchy::getRoutingDirection(node));
+      }
+    }
+  }
+}
+
+TEST_F(ContractionHierarchyTest, routes_are_equally_short)
+{
+  auto contractionHierarchy = std::make_shared<ContractionHierarchy>();
+  ASSERT_TRUE(contractionHierarchy->build(*lane::getLaneGraph()));
+
+  std::mt19937 generator(42u);
+  for (auto i = 0u; i < 500u; ++i)
+  {
+    auto const start = randomRoutingPoint(generator);
+    auto const dest = randomRoutingPoint(generator);
+
+    RouteAstar routePlanning(start, dest, Route::Type::SHORTEST);
+    RouteContractionHierarchy routePlanningCh(start, dest, contractionHierarchy);
+    auto const found = routePlanning.calculate();
+    ASSERT_EQ(found, routePlanningCh.calculate());
+    if (found)
+    {
+      ASSERT_EQ(routePlanning.getRawRoute().front(), routePlanningCh.getRawRoute().front());
+      ASSERT_EQ(routePlanning.getRawRoute().back(), routePlanningCh.getRawRoute().back());
+      ASSERT_EQ(routingCost(routePlanning.getRawRoute()), routingCost(routePlanningCh.getRawRoute()));
+    }
+  }
+}
+
+TEST_F(ContractionHierarchyTest, hierarchy_of_other_map_is_ignored)
+{
+  auto contractionHierarchy = std::make_shared<ContractionHierarchy>();
+  ASSERT_TRUE(contractionHierarchy->build(*lane::getLaneGraph()));
+
+  access::cleanup();
+  ASSERT_TRUE(access::init("test_files/LaneChange.adm.txt"));
+  laneIds = lane::getLanes();
+  ASSERT_FALSE(contractionHierarchy->isValidFor(*lane::getLaneGraph()));
+
+  std::mt19937 generator(7u);
+  for (auto i = 0u; i < 10u; ++i)
+  {
+    auto const start = randomRoutingPoint(generator);
+    auto const dest = randomRoutingPoint(generator);
+    ASSERT_EQ(planRoute(start, dest).roadSegments, planRoute(start, dest, contractionHierarchy).roadSegments);
+  }
+}
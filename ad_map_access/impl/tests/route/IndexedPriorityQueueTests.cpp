@@ -0,0 +1,121 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/route/IndexedPriorityQueue.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <gtest/gtest.h>
+#include <map>
+
+using namespace ::ad::map::route::planning;
+
+typedef IndexedPriorityQueue<int, int, std::less<int>> IntQueue;
+
+struct IndexedPriorityQueueTest : ::testing::Test
+{
+  void expectConsistent(IntQueue &queue, std::map<int, int> const &reference)
+  {
+    ASSERT_EQ(reference.size(), queue.size());
+    ASSERT_EQ(reference.empty(), queue.empty());
+    auto referenceElement = reference.begin();
+    for (auto const &element : queue)
+    {
+      ASSERT_EQ(referenceElement->first, element.first);
+      ASSERT_EQ(referenceElement->second, element.second.value);
+      ++referenceElement;
+    }
+    if (!reference.empty())
+    {
+      auto minimum = std::min_element(
+        reference.begin(), reference.end(), [](std::pair<int const, int> const &left, std::pair<int const, int> const &right) {
+          return left.second < right.second;
+        });
+      ASSERT_EQ(minimum->second, queue.top()->second.value);
+    }
+  }
+};
+
+TEST_F(IndexedPriorityQueueTest, random_operations)
+{
+  std::srand(42);
+  IntQueue queue;
+  std::map<int, int> reference;
+  for (int i = 0; i < 5000; ++i)
+  {
+    auto const key = std::rand() % 200;
+    auto const value = std::rand() % 1000;
+    switch (std::rand() % 4)
+    {
+      case 0:
+      case 1:
+      {
+        auto const insertResult = queue.insert(key, value);
+        ASSERT_EQ(reference.insert({key, value}).second, insertResult.second);
+        ASSERT_EQ(key, insertResult.first->first);
+        break;
+      }
+      case 2:
+      {
+        auto element = std::find_if(queue.begin(), queue.end(), [key](IntQueue::ElementMap::value_type const &entry) {
+          return entry.first >= key;
+        });
+        if (element != queue.end())
+        {
+          reference[element->first] = value;
+          element->second.value = value;
+          queue.update(element);
+        }
+        break;
+      }
+      default:
+      {
+        if (!queue.empty())
+        {
+          auto const top = queue.top();
+          reference.erase(top->first);
+          queue.erase(top);
+        }
+        break;
+      }
+    }
+    expectConsistent(queue, reference);
+  }
+
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.begin(), queue.end());
+}
+
+TEST_F(IndexedPriorityQueueTest, visit)
+{
+  IntQueue queue;
+  queue.visit([](int) { return true; }, [](IntQueue::iterator const &) { FAIL(); });
+
+  for (int key = 0; key < 100; ++key)
+  {
+    queue.insert(key, (key * 37) % 100);
+  }
+  queue.erase(queue.begin());
+
+  std::vector<int> visitedKeys;
+  queue.visit([](int value) { return value < 30; },
+              [&visitedKeys](IntQueue::iterator const &element) { visitedKeys.push_back(element->first); });
+  std::sort(visitedKeys.begin(), visitedKeys.end());
+
+  std::vector<int> expectedKeys;
+  for (auto const &element : queue)
+  {
+    if (element.second.value < 30)
+    {
+      expectedKeys.push_back(element.first);
+    }
+  }
+  EXPECT_EQ(expectedKeys, visitedKeys);
+  EXPECT_EQ(29u, visitedKeys.size());
+}
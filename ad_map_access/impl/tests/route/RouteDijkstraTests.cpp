@@ -0,0 +1,204 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/route/Planning.hpp>
+#include <ad/map/route/RouteAStar.hpp>
+#include <ad/map/route/RouteDijkstra.hpp>
+#include <ad/map/route/RouteOperation.hpp>
+#include <cmath>
+#include <functional>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace ::ad;
+using namespace ::ad::map;
+using namespace ::ad::map::route::planning;
+
+struct RouteDijkstraTest : ::testing::Test
+{
+  virtual void SetUp()
+  {
+    access::cleanup();
+    ASSERT_TRUE(access::init("test_files/TPK.adm.txt"));
+    laneIds = lane::getLanes();
+    ASSERT_FALSE(laneIds.empty());
+  }
+  virtual void TearDown()
+  {
+    access::cleanup();
+  }
+
+  RoutingParaPoint randomRoutingPoint(std::mt19937 &generator)
+  {
+    std::uniform_int_distribution<std::size_t> laneDistribution(0u, laneIds.size() - 1u);
+    std::uniform_real_distribution<double> offsetDistribution(0., 1.);
+    std::uniform_int_distribution<int> directionDistribution(0, 2);
+    return createRoutingPoint(laneIds[laneDistribution(generator)],
+                              physics::ParametricValue(offsetDistribution(generator)),
+                              static_cast<RoutingDirection>(directionDistribution(generator)));
+  }
+
+  physics::Distance routingCost(point::ParaPointList const &rawRoute)
+  {
+    physics::Distance cost(0.);
+    for (std::size_t i = 1u; i < rawRoute.size(); ++i)
+    {
+      if (rawRoute[i].laneId == rawRoute[i - 1u].laneId)
+      {
+        cost += std::fabs(rawRoute[i].parametricOffset - rawRoute[i - 1u].parametricOffset)
+          * lane::getLane(rawRoute[i].laneId).length;
+      }
+      else if (lane::isSuccessorOrPredecessor(rawRoute[i - 1u].laneId, rawRoute[i].laneId))
+      {
+        cost += physics::Distance(1.);
+      }
+      else
+      {
+        cost += physics::Distance(5.);
+      }
+    }
+    return cost;
+  }
+
+  std::vector<RoutingParaPoint> randomRoutingPoints(std::mt19937 &generator, std::size_t const count)
+  {
+    std::vector<RoutingParaPoint> routingPoints;
+    for (auto i = 0u; i < count; ++i)
+    {
+      routingPoints.push_back(randomRoutingPoint(generator));
+    }
+    return routingPoints;
+  }
+
+  lane::LaneIdList laneIds;
+};
+
+TEST_F(RouteDijkstraTest, routes_are_equally_short)
+{
+  std::mt19937 generator(42u);
+  for (auto const type : {Route::Type::SHORTEST, Route::Type::SHORTEST_IGNORE_DIRECTION})
+  {
+    for (auto i = 0u; i < 10u; ++i)
+    {
+      auto const start = randomRoutingPoint(generator);
+      auto dest = randomRoutingPoints(generator, 20u);
+      // the start itself and a point on the start lane are destinations as well
+      dest.push_back(start);
+      dest.push_back(createRoutingPoint(start.point.laneId, physics::ParametricValue(0.5)));
+
+      RouteDijkstra routePlanning(start, dest, type);
+      routePlanning.calculate();
+      ASSERT_EQ(dest.size(), routePlanning.getDestinationCount());
+      for (std::size_t destIndex = 0u; destIndex < dest.size(); ++destIndex)
+      {
+        RouteAstar routePlanningAstar(start, dest[destIndex], type);
+        auto const found = routePlanningAstar.calculate();
+        ASSERT_EQ(found, routePlanning.isDestinationReached(destIndex));
+        if (found)
+        {
+          auto const &rawRoute = routePlanning.getRawRoute(destIndex);
+          ASSERT_EQ(start.point, rawRoute.front());
+          ASSERT_EQ(dest[destIndex].point, rawRoute.back());
+          // the cost estimate of RouteAstar isn't a lower bound on every map, so the route might be even shorter
+          ASSERT_LE(routingCost(rawRoute), routingCost(routePlanningAstar.getRawRoute()));
+          ASSERT_EQ(routingCost(rawRoute), routePlanning.getRoutingCost(destIndex));
+        }
+      }
+    }
+  }
+}
+
+TEST_F(RouteDijkstraTest, no_destinations)
+{
+  std::mt19937 generator(3u);
+  RouteDijkstra routePlanning(randomRoutingPoint(generator), std::vector<RoutingParaPoint>(), Route::Type::SHORTEST);
+  ASSERT_FALSE(routePlanning.calculate());
+  ASSERT_EQ(0u, routePlanning.getDestinationCount());
+  ASSERT_TRUE(planRoutes(randomRoutingPoint(generator), std::vector<RoutingParaPoint>()).empty());
+}
+
+TEST_F(RouteDijkstraTest, unknown_lanes)
+{
+  std::mt19937 generator(4u);
+  auto const knownPoint = randomRoutingPoint(generator);
+  auto const unknownPoint = createRoutingPoint(lane::LaneId(123456789u), physics::ParametricValue(0.5));
+  auto expectError = [](std::function<void()> const &planning, std::string const &expectedMessage) {
+    try
+    {
+      planning();
+      FAIL() << "expected " << expectedMessage;
+    }
+    catch (std::runtime_error const &error)
+    {
+      EXPECT_EQ(expectedMessage, error.what());
+    }
+  };
+  expectError([&] { RouteAstar(unknownPoint, knownPoint, Route::Type::SHORTEST); }, "Start lane not found!");
+  expectError([&] { RouteAstar(knownPoint, unknownPoint, Route::Type::SHORTEST); }, "Dest lane not found!");
+  expectError([&] { RouteDijkstra(unknownPoint, {knownPoint}, Route::Type::SHORTEST); }, "Start lane not found!");
+  expectError([&] { RouteDijkstra(knownPoint, {unknownPoint}, Route::Type::SHORTEST); }, "Dest lane not found!");
+}
+
+TEST_F(RouteDijkstraTest, plan_routes)
+{
+  std::mt19937 generator(5u);
+  auto const start = randomRoutingPoint(generator);
+  auto const dest = randomRoutingPoints(generator, 10u);
+  auto const routes = planRoutes(start, dest);
+  ASSERT_EQ(dest.size(), routes.size());
+  for (std::size_t destIndex = 0u; destIndex < dest.size(); ++destIndex)
+  {
+    auto const route = planRoute(start, dest[destIndex]);
+    ASSERT_EQ(route.roadSegments.empty(), routes[destIndex].roadSegments.empty());
+  }
+}
+
+TEST_F(RouteDijkstraTest, route_distance_matrix)
+{
+  std::mt19937 generator(11u);
+  auto const start = randomRoutingPoints(generator, 7u);
+  auto const dest = randomRoutingPoints(generator, 9u);
+
+  auto const matrix = calculateRouteDistanceMatrix(start, dest);
+  ASSERT_EQ(start.size(), matrix.size());
+  std::size_t routesFound = 0u;
+  for (std::size_t startIndex = 0u; startIndex < start.size(); ++startIndex)
+  {
+    ASSERT_EQ(dest.size(), matrix[startIndex].size());
+    auto const routes = planRoutes(start[startIndex], dest);
+    for (std::size_t destIndex = 0u; destIndex < dest.size(); ++destIndex)
+    {
+      auto const &entry = matrix[startIndex][destIndex];
+      ASSERT_EQ(!routes[destIndex].roadSegments.empty(), entry.routeFound);
+      if (entry.routeFound)
+      {
+        routesFound++;
+        ASSERT_EQ(calcLength(routes[destIndex]), entry.routeLength);
+        ASSERT_EQ(calcDuration(routes[destIndex]), entry.routeDuration);
+      }
+    }
+  }
+  ASSERT_LT(0u, routesFound);
+
+  // the result doesn't depend on the number of threads
+  auto const parallelMatrix = calculateRouteDistanceMatrix(start, dest, 4u);
+  ASSERT_EQ(matrix.size(), parallelMatrix.size());
+  for (std::size_t startIndex = 0u; startIndex < start.size(); ++startIndex)
+  {
+    for (std::size_t destIndex = 0u; destIndex < dest.size(); ++destIndex)
+    {
+      ASSERT_EQ(matrix[startIndex][destIndex].routeFound, parallelMatrix[startIndex][destIndex].routeFound);
+      ASSERT_EQ(matrix[startIndex][destIndex].routeLength, parallelMatrix[startIndex][destIndex].routeLength);
+      ASSERT_EQ(matrix[startIndex][destIndex].routeDuration, parallelMatrix[startIndex][destIndex].routeDuration);
+    }
+  }
+}
@@ -6,8 +6,14 @@
 //
 // ----------------- END LICENSE BLOCK -----------------------------------
 
+#include <ad/map/route/Planning.hpp>
+#include <ad/map/serialize/SerializerBuffer.hpp>
 #include <ad/map/serialize/SerializerFileCRC32.hpp>
+#include <ad/map/serialize/SerializeGeneratedTypes.hpp>
+#include <ad/map/serialize/SerializerMemoryMappedCRC32.hpp>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <iterator>
 
 #include "../access/FactoryTests.hpp"
 
@@ -72,6 +78,312 @@ TEST_F(SerializationTest, TestSerializationFileCRC32)
   TestSerializationFile<SerializerFileCRC32>("test_files/test_serialization_crc32.adm");
 }
 
+TEST_F(SerializationTest, TestSerializationMemoryMappedCRC32)
+{
+  char const *testFileName = "test_files/test_serialization_mmap.adm";
+  size_t versionMajor = SerializerFileCRC32::VERSION_MAJOR;
+  size_t versionMinor = SerializerFileCRC32::VERSION_MINOR;
+  SerializerFileCRC32 serializer(true);
+  ASSERT_TRUE(serializer.open(testFileName, versionMajor, versionMinor));
+  ASSERT_TRUE(mStorePtr->save(serializer));
+  ASSERT_TRUE(serializer.close());
+
+  SerializerMemoryMappedCRC32 deserializer;
+  ASSERT_STREQ("MemoryMapped", deserializer.getStorageType());
+  ASSERT_FALSE(deserializer.close());
+  ASSERT_TRUE(deserializer.open(testFileName, versionMajor, versionMinor));
+  ASSERT_FALSE(deserializer.open(testFileName, versionMajor, versionMinor));
+  ASSERT_EQ(SerializerFileCRC32::VERSION_MAJOR, versionMajor);
+  ASSERT_EQ(SerializerFileCRC32::VERSION_MINOR, versionMinor);
+  access::Store::Ptr readStore(new access::Store());
+  ASSERT_TRUE(readStore->load(deserializer));
+  ASSERT_TRUE(deserializer.close());
+  ASSERT_FALSE(deserializer.close());
+  ASSERT_TRUE(compareStores(*mStorePtr, *readStore));
+
+  SerializerMemoryMappedCRC32 missingFileDeserializer;
+  ASSERT_FALSE(missingFileDeserializer.open("test_files/not_existing.adm", versionMajor, versionMinor));
+}
+
+TEST_F(SerializationTest, TestMemoryMappedCorruptFile)
+{
+  char const *testFileName = "test_files/test_serialization_mmap.adm";
+  size_t versionMajor = SerializerFileCRC32::VERSION_MAJOR;
+  size_t versionMinor = SerializerFileCRC32::VERSION_MINOR;
+  SerializerFileCRC32 serializer(true);
+  ASSERT_TRUE(serializer.open(testFileName, versionMajor, versionMinor));
+  ASSERT_TRUE(mStorePtr->save(serializer));
+  ASSERT_TRUE(serializer.close());
+
+  std::ifstream input(testFileName, std::ios::binary);
+  std::vector<char> content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+  input.close();
+  ASSERT_GT(content.size(), 100u);
+
+  // truncated file: reading fails at the end of the mapping
+  char const *truncatedFileName = "test_files/test_serialization_mmap_truncated.adm";
+  std::ofstream(truncatedFileName, std::ios::binary).write(content.data(), std::streamsize(content.size() / 2u));
+  SerializerMemoryMappedCRC32 truncatedDeserializer;
+  ASSERT_TRUE(truncatedDeserializer.open(truncatedFileName, versionMajor, versionMinor));
+  access::Store::Ptr truncatedStore(new access::Store());
+  ASSERT_FALSE(truncatedStore->load(truncatedDeserializer));
+  ASSERT_FALSE(truncatedDeserializer.close());
+
+  // modified content: checksum doesn't match
+  char const *modifiedFileName = "test_files/test_serialization_mmap_modified.adm";
+  content[content.size() - 8u] = static_cast<char>(content[content.size() - 8u] ^ 0x1);
+  std::ofstream(modifiedFileName, std::ios::binary).write(content.data(), std::streamsize(content.size()));
+  SerializerMemoryMappedCRC32 modifiedDeserializer;
+  ASSERT_TRUE(modifiedDeserializer.open(modifiedFileName, versionMajor, versionMinor));
+  access::Store::Ptr modifiedStore(new access::Store());
+  modifiedStore->load(modifiedDeserializer);
+  ASSERT_FALSE(modifiedDeserializer.close());
+}
+
+TEST_F(SerializationTest, TestVectorBlocks)
+{
+  char const *testFileName = "test_files/test_serialization_vectors.adm";
+  std::vector<uint64_t> values;
+  for (uint64_t i = 0u; i < 3u * ISerializer::MAX_BLOCK_BYTES / sizeof(uint64_t) + 17u; ++i)
+  {
+    values.push_back(i * i);
+  }
+  std::vector<lane::ContactType> types = {lane::ContactType::FREE, lane::ContactType::LANE_CHANGE};
+  point::ECEFEdge edge;
+  for (auto i = 0u; i < 5000u; ++i)
+  {
+    edge.push_back(point::createECEFPoint(6378137. + i, 0.5 * i, -1. * i));
+  }
+  size_t tooLong = std::numeric_limits<size_t>::max() / 2u;
+
+  size_t versionMajor = SerializerFileCRC32::VERSION_MAJOR;
+  size_t versionMinor = SerializerFileCRC32::VERSION_MINOR;
+  SerializerFileCRC32 serializer(true);
+  ASSERT_TRUE(serializer.open(testFileName, versionMajor, versionMinor));
+  ASSERT_TRUE(serializer.serializeVector(values));
+  ASSERT_TRUE(serializer.serializeVector(types));
+  ASSERT_TRUE(doSerialize(serializer, edge));
+  serializer.setUseMagic(false);
+  ASSERT_TRUE(doSerialize(serializer, edge));
+  serializer.setUseMagic(true);
+  ASSERT_TRUE(serializer.serialize(SerializeableMagic::VectorType) && serializer.serialize(tooLong));
+  ASSERT_TRUE(serializer.close());
+
+  SerializerMemoryMappedCRC32 deserializer;
+  ASSERT_TRUE(deserializer.open(testFileName, versionMajor, versionMinor));
+  std::vector<uint64_t> readValues;
+  ASSERT_TRUE(deserializer.serializeVector(readValues));
+  EXPECT_EQ(values, readValues);
+  std::vector<lane::ContactType> readTypes;
+  ASSERT_TRUE(deserializer.serializeVector(readTypes));
+  EXPECT_EQ(types, readTypes);
+  point::ECEFEdge readEdge;
+  ASSERT_TRUE(doSerialize(deserializer, readEdge));
+  EXPECT_EQ(edge, readEdge);
+  deserializer.setUseMagic(false);
+  readEdge.clear();
+  ASSERT_TRUE(doSerialize(deserializer, readEdge));
+  EXPECT_EQ(edge, readEdge);
+  deserializer.setUseMagic(true);
+  // the length is read from the stream, so reading fails at the end of the stream
+  std::vector<uint64_t> tooLongValues;
+  ASSERT_FALSE(deserializer.serializeVector(tooLongValues));
+  EXPECT_LE(tooLongValues.size() * sizeof(uint64_t), ISerializer::MAX_BLOCK_BYTES);
+  deserializer.close();
+}
+
+// bit by bit reference implementation of the CRC-32
+static uint32_t referenceCRC32(uint8_t const *p, size_t bytes)
+{
+  uint32_t crc = ~0u;
+  while (bytes--)
+  {
+    crc ^= *p++;
+    for (auto bit = 0; bit < 8; ++bit)
+    {
+      crc = (crc >> 1) ^ ((crc & 1u) != 0u ? 0xedb88320u : 0u);
+    }
+  }
+  return ~crc;
+}
+
+TEST_F(SerializationTest, TestChecksumCRC32)
+{
+  char const check[] = "123456789";
+  EXPECT_EQ(0xcbf43926u, ChecksumCRC32::calculate(0u, check, 9u));
+  EXPECT_EQ(0u, ChecksumCRC32::calculate(0u, check, 0u));
+
+  std::vector<uint8_t> data(3u * ChecksumCRC32::PARALLEL_CHUNK_BYTES + 1001u);
+  uint32_t random = 12345u;
+  for (auto &byte : data)
+  {
+    random = random * 1103515245u + 12345u;
+    byte = static_cast<uint8_t>(random >> 16);
+  }
+
+  for (size_t offset = 0u; offset < 8u; ++offset)
+  {
+    for (size_t bytes = 0u; bytes < 300u; ++bytes)
+    {
+      uint32_t const expected = referenceCRC32(&data[offset], bytes);
+      ASSERT_EQ(expected, ChecksumCRC32::calculate(0u, &data[offset], bytes)) << offset << " " << bytes;
+      size_t const split = bytes / 3u;
+      uint32_t const first = ChecksumCRC32::calculate(0u, &data[offset], split);
+      EXPECT_EQ(expected, ChecksumCRC32::calculate(first, &data[offset + split], bytes - split));
+      EXPECT_EQ(expected,
+                ChecksumCRC32::combine(
+                  first, ChecksumCRC32::calculate(0u, &data[offset + split], bytes - split), bytes - split));
+    }
+  }
+
+  uint32_t const expected = referenceCRC32(data.data(), data.size());
+  EXPECT_EQ(expected, ChecksumCRC32::calculate(0u, data.data(), data.size()));
+  for (size_t threads = 0u; threads < 5u; ++threads)
+  {
+    EXPECT_EQ(expected, ChecksumCRC32::calculateParallel(0u, data.data(), data.size(), threads));
+  }
+  uint32_t const head = ChecksumCRC32::calculate(0u, data.data(), 5u);
+  EXPECT_EQ(expected, ChecksumCRC32::calculateParallel(head, data.data() + 5u, data.size() - 5u, 3u));
+}
+
+TEST_F(SerializationTest, TestSectionedStore)
+{
+  // the test map is stored without sections
+  size_t versionMajor = 0u;
+  size_t versionMinor = 0u;
+  SerializerFileCRC32 unsectionedDeserializer(false);
+  ASSERT_TRUE(unsectionedDeserializer.open("test_files/TPK.adm", versionMajor, versionMinor));
+  ASSERT_EQ(SerializerFileCRC32::VERSION_MINOR_UNSECTIONED, versionMinor);
+  ASSERT_FALSE(unsectionedDeserializer.useSections());
+  access::Store::Ptr store(new access::Store());
+  ASSERT_TRUE(store->load(unsectionedDeserializer));
+  ASSERT_TRUE(unsectionedDeserializer.close());
+  ASSERT_GT(store->getLanes().size(), 64u);
+
+  char const *testFileName = "test_files/test_serialization_sections.adm";
+  versionMinor = SerializerFileCRC32::VERSION_MINOR;
+  SerializerFileCRC32 serializer(true);
+  ASSERT_TRUE(serializer.open(testFileName, versionMajor, versionMinor));
+  ASSERT_TRUE(store->save(serializer));
+  ASSERT_TRUE(serializer.close());
+
+  for (size_t threadCount = 1u; threadCount <= 4u; threadCount += 3u)
+  {
+    SerializerMemoryMappedCRC32 deserializer;
+    ASSERT_TRUE(deserializer.open(testFileName, versionMajor, versionMinor));
+    ASSERT_TRUE(deserializer.useSections());
+    access::Store::Ptr readStore(new access::Store());
+    ASSERT_TRUE(readStore->load(deserializer, threadCount));
+    ASSERT_TRUE(deserializer.close());
+    // lanes of the test map contain values which can't be compared, so compare the serialized stores
+    SerializerBuffer expected;
+    ASSERT_TRUE(store->save(expected));
+    SerializerBuffer actual;
+    ASSERT_TRUE(readStore->save(actual));
+    ASSERT_EQ(expected.getBuffer(), actual.getBuffer());
+  }
+
+  // a modified section is detected by its own checksum
+  std::ifstream input(testFileName, std::ios::binary);
+  std::vector<char> content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+  input.close();
+  char const *modifiedFileName = "test_files/test_serialization_sections_modified.adm";
+  content[content.size() / 2u] = static_cast<char>(content[content.size() / 2u] ^ 0x1);
+  std::ofstream(modifiedFileName, std::ios::binary).write(content.data(), std::streamsize(content.size()));
+  SerializerMemoryMappedCRC32 modifiedDeserializer;
+  ASSERT_TRUE(modifiedDeserializer.open(modifiedFileName, versionMajor, versionMinor));
+  access::Store::Ptr modifiedStore(new access::Store());
+  ASSERT_FALSE(modifiedStore->load(modifiedDeserializer, 4u));
+  modifiedDeserializer.close();
+}
+
+// bounding spheres of route segments are calculated from the lane geometry, the planning counter differs anyway
+static route::FullRoute comparableRoute(route::FullRoute route)
+{
+  route.routePlanningCounter = route::RoutePlanningCounter(0u);
+  for (auto &roadSegment : route.roadSegments)
+  {
+    roadSegment.boundingSphere.center = point::createECEFPoint(0., 0., 0.);
+    roadSegment.boundingSphere.radius = physics::Distance(0.);
+  }
+  return route;
+}
+
+TEST_F(SerializationTest, TestTopologyOnly)
+{
+  size_t versionMajor = 0u;
+  size_t versionMinor = 0u;
+  SerializerFileCRC32 unsectionedDeserializer(false);
+  ASSERT_TRUE(unsectionedDeserializer.open("test_files/TPK.adm", versionMajor, versionMinor));
+  access::Store::Ptr store(new access::Store());
+  ASSERT_TRUE(store->load(unsectionedDeserializer));
+  ASSERT_TRUE(unsectionedDeserializer.close());
+  ASSERT_TRUE(store->hasGeometry());
+
+  char const *sectionedFileName = "test_files/test_serialization_topology.adm";
+  versionMinor = SerializerFileCRC32::VERSION_MINOR;
+  SerializerFileCRC32 serializer(true);
+  ASSERT_TRUE(serializer.open(sectionedFileName, versionMajor, versionMinor));
+  ASSERT_TRUE(store->save(serializer));
+  ASSERT_TRUE(serializer.close());
+
+  auto const laneIds = store->getLanes();
+  ASSERT_GT(laneIds.size(), 1u);
+  auto const start = route::planning::createRoutingPoint(laneIds.front(), physics::ParametricValue(0.5));
+  auto const dest = route::planning::createRoutingPoint(laneIds.back(), physics::ParametricValue(0.5));
+  access::cleanup();
+  ASSERT_TRUE(access::init(store));
+  auto const expectedRoute = comparableRoute(route::planning::planRoute(start, dest));
+  auto const expectedPrediction = route::planning::predictRoutesOnDistance(start, physics::Distance(200.));
+  ASSERT_FALSE(expectedPrediction.empty());
+  access::cleanup();
+
+  for (auto fileName : {"test_files/TPK.adm", sectionedFileName})
+  {
+    SerializerMemoryMappedCRC32 deserializer;
+    ASSERT_TRUE(deserializer.open(fileName, versionMajor, versionMinor));
+    access::Store::Ptr topologyStore(new access::Store());
+    ASSERT_TRUE(topologyStore->load(deserializer, 0u, false));
+    ASSERT_TRUE(deserializer.close());
+    ASSERT_FALSE(topologyStore->hasGeometry());
+
+    ASSERT_EQ(laneIds, topologyStore->getLanes());
+    for (auto const &laneId : laneIds)
+    {
+      auto const &lane = *store->getLanePtr(laneId);
+      auto const &topologyLane = *topologyStore->getLanePtr(laneId);
+      EXPECT_EQ(std::min(lane.edgeLeft.ecefEdge.size(), std::size_t(2u)), topologyLane.edgeLeft.ecefEdge.size());
+      EXPECT_EQ(lane.edgeLeft.ecefEdge.front(), topologyLane.edgeLeft.ecefEdge.front());
+      EXPECT_EQ(lane.edgeRight.ecefEdge.back(), topologyLane.edgeRight.ecefEdge.back());
+      EXPECT_EQ(lane.edgeLeft.length, topologyLane.edgeLeft.length);
+      EXPECT_EQ(lane.length, topologyLane.length);
+      EXPECT_EQ(lane.width, topologyLane.width);
+      if (std::string(fileName) == sectionedFileName)
+      {
+        // the old map file doesn't provide bounding spheres, these are calculated from the remaining end points
+        EXPECT_EQ(lane.boundingSphere, topologyLane.boundingSphere);
+      }
+      EXPECT_EQ(lane.contactLanes, topologyLane.contactLanes);
+      EXPECT_EQ(lane.speedLimits, topologyLane.speedLimits);
+      EXPECT_EQ(lane.restrictions, topologyLane.restrictions);
+    }
+
+    ASSERT_TRUE(access::init(topologyStore));
+    EXPECT_EQ(expectedRoute, comparableRoute(route::planning::planRoute(start, dest)));
+    auto const prediction = route::planning::predictRoutesOnDistance(start, physics::Distance(200.));
+    ASSERT_EQ(expectedPrediction.size(), prediction.size());
+    for (auto i = 0u; i < prediction.size(); ++i)
+    {
+      EXPECT_EQ(comparableRoute(expectedPrediction[i]), comparableRoute(prediction[i]));
+    }
+    access::cleanup();
+
+    // the missing geometry must not end up in a map file
+    SerializerBuffer buffer;
+    EXPECT_FALSE(topologyStore->save(buffer));
+  }
+}
+
 TEST_F(SerializationTest, TestMapVersion)
 {
   size_t version_major = 0;
@@ -0,0 +1,192 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/point/GeometryOperation.hpp>
+#include <ad/map/point/Operation.hpp>
+#include <ad/map/serialize/SerializerMemoryMappedCRC32.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono> /* for std::chrono::steady_clock */
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ::ad;
+using namespace ::ad::map;
+
+static void printUsage(char const *programName)
+{
+  std::cerr << "Usage: " << programName << " <map.adm> [--rounds <count>] [--threads <count>] [--switch-reference]\n"
+            << "Measures the throughput of getting the ENU edges of all lanes of the given map with 1, 2, 4, ...\n"
+            << "threads reading the map concurrently:\n"
+            << "  --rounds <count>       number of rounds over all lanes per thread (default: 100)\n"
+            << "  --threads <count>      maximum number of threads (default: number of hardware threads)\n"
+            << "  --switch-reference     switches the ENU reference point continuously while the threads read\n";
+}
+
+static bool readAdMap(std::string const &mapName, access::Store &store)
+{
+  serialize::SerializerMemoryMappedCRC32 serializer;
+  size_t versionMajor = 0;
+  size_t versionMinor = 0;
+  if (!serializer.open(mapName.c_str(), versionMajor, versionMinor) || !store.load(serializer)
+      || !serializer.close())
+  {
+    std::cerr << "Unable to read map " << mapName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @returns the number of ENU edges got per second by threadCount threads, each getting the ENU edges of both
+ * borders of all lanes rounds times
+ */
+static double measureThroughput(std::vector<lane::Lane::ConstPtr> const &lanes,
+                                std::size_t rounds,
+                                std::size_t threadCount,
+                                std::vector<point::GeoPoint> const &switchReferencePoints)
+{
+  physics::ParametricRange range;
+  range.minimum = physics::ParametricValue(0.);
+  range.maximum = physics::ParametricValue(1.);
+  std::atomic<std::size_t> runningThreads{threadCount};
+  std::atomic<std::size_t> pointCount{0u};
+
+  auto const start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0u; i < threadCount; ++i)
+  {
+    threads.emplace_back([&]() {
+      std::size_t threadPointCount = 0u;
+      point::ENUEdge enuEdge;
+      for (std::size_t round = 0u; round < rounds; ++round)
+      {
+        for (auto const &lane : lanes)
+        {
+          point::getParametricRange(lane->edgeLeft, range, enuEdge);
+          threadPointCount += enuEdge.size();
+          point::getParametricRange(lane->edgeRight, range, enuEdge);
+          threadPointCount += enuEdge.size();
+        }
+      }
+      pointCount += threadPointCount;
+      runningThreads--;
+    });
+  }
+  for (std::size_t i = 0u; !switchReferencePoints.empty() && (runningThreads > 0u); ++i)
+  {
+    access::setENUReferencePoint(switchReferencePoints[i % switchReferencePoints.size()]);
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start;
+  if (pointCount == 0u)
+  {
+    std::cerr << "No ENU edge points got" << std::endl;
+  }
+  return static_cast<double>(2u * lanes.size() * rounds * threadCount) / duration.count();
+}
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    std::string mapName;
+    std::size_t rounds = 100u;
+    std::size_t threadCount = std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), std::size_t(1u));
+    bool switchReference = false;
+    for (int i = 1; i < argc; ++i)
+    {
+      std::string const argument(argv[i]);
+      if ((argument == "--rounds") && (i + 1 < argc))
+      {
+        rounds = std::max(static_cast<std::size_t>(std::stoul(argv[++i])), std::size_t(1u));
+      }
+      else if ((argument == "--threads") && (i + 1 < argc))
+      {
+        threadCount = std::max(static_cast<std::size_t>(std::stoul(argv[++i])), std::size_t(1u));
+      }
+      else if (argument == "--switch-reference")
+      {
+        switchReference = true;
+      }
+      else if (mapName.empty() && (argument.compare(0, 1, "-") != 0))
+      {
+        mapName = argument;
+      }
+      else
+      {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    if (mapName.empty())
+    {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    access::Store::Ptr store(new access::Store());
+    if (!readAdMap(mapName, *store) || !access::init(store))
+    {
+      return EXIT_FAILURE;
+    }
+    std::vector<lane::Lane::ConstPtr> lanes;
+    for (auto const &laneId : lane::getLanes())
+    {
+      lanes.push_back(lane::getLanePtr(laneId));
+    }
+    if (lanes.empty())
+    {
+      std::cerr << "No lanes in map " << mapName << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::vector<point::GeoPoint> switchReferencePoints;
+    if (switchReference)
+    {
+      switchReferencePoints.push_back(access::getENUReferencePoint());
+      switchReferencePoints.push_back(point::toGeo(lanes[lanes.size() / 2u]->edgeLeft.ecefEdge.front()));
+    }
+
+    std::cout << "ENU edges per second of " << mapName << " with " << lanes.size() << " lanes over " << rounds
+              << " rounds" << (switchReference ? ", switching the ENU reference point" : "") << ":\n";
+    for (std::size_t threads = 1u; threads <= threadCount;)
+    {
+      auto const throughput = measureThroughput(lanes, rounds, threads, switchReferencePoints);
+      std::cout << "  " << threads << " threads: " << throughput / 1e6 << "M ("
+                << throughput / 1e6 / static_cast<double>(threads) << "M per thread)\n";
+      if (threads == threadCount)
+      {
+        break;
+      }
+      threads = std::min(threads * 2u, threadCount);
+    }
+  }
+  catch (std::exception &e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (...)
+  {
+    std::cerr << "Unhandled unknown exception" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
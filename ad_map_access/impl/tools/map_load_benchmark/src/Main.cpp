@@ -0,0 +1,322 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/access/Store.hpp>
+#include <ad/map/serialize/SerializeGeneratedPointTypes.hpp>
+#include <ad/map/serialize/SerializerBuffer.hpp>
+#include <ad/map/serialize/SerializerFileCRC32.hpp>
+#include <ad/map/serialize/SerializerMemoryMappedCRC32.hpp>
+
+#include <algorithm>
+#include <chrono> /* for std::chrono::steady_clock */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ::ad::map;
+
+static void printUsage(char const *programName)
+{
+  std::cerr << "Usage: " << programName << " <map.adm> [--rounds <count>] [--threads <count>] [--convert <out.adm>]\n"
+            << "         [--geometry-error <m>] [--topology-only]\n"
+            << "Measures the time to load the given map single-threaded and with the given number of threads\n"
+            << "(default: number of hardware threads) and the throughput of serializing the lane edges of the map.\n"
+            << "Only maps with sections are decoded in parallel:\n"
+            << "  --convert <out.adm>    stores the map in the current format with sections and measures that one\n"
+            << "  --geometry-error <m>   on conversion, stores the geometry quantized and delta-encoded in a\n"
+            << "                         separate section, deviating by the given distance at most; this only\n"
+            << "                         shrinks the file, the loaded lane edges take the same memory\n"
+            << "  --topology-only        measures loading the map without the geometry points\n";
+}
+
+static bool readAdMap(std::string const &mapName,
+                      access::Store &store,
+                      std::size_t threadCount,
+                      bool loadGeometry = true)
+{
+  serialize::SerializerMemoryMappedCRC32 serializer;
+  size_t versionMajor = 0;
+  size_t versionMinor = 0;
+  if (!serializer.open(mapName.c_str(), versionMajor, versionMinor))
+  {
+    std::cerr << "Unable to open map for reading " << mapName << std::endl;
+    return false;
+  }
+  if (!store.load(serializer, threadCount, loadGeometry))
+  {
+    std::cerr << "Unable to read map " << mapName << std::endl;
+    return false;
+  }
+  if (!serializer.close())
+  {
+    std::cerr << "Map file is corrupt " << mapName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+static bool writeAdMap(std::string const &mapName, access::Store &store, double geometryError)
+{
+  serialize::SerializerFileCRC32 serializer(true);
+  size_t versionMajor = serialize::SerializerFileCRC32::VERSION_MAJOR;
+  size_t versionMinor = serialize::SerializerFileCRC32::VERSION_MINOR;
+  bool const quantizeGeometry = (geometryError > 0.);
+  if (!serializer.open(mapName.c_str(), versionMajor, versionMinor)
+      || !store.save(serializer, true, !quantizeGeometry, quantizeGeometry, ::ad::physics::Distance(geometryError))
+      || !serializer.close())
+  {
+    std::cerr << "Unable to write map " << mapName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+static std::streamoff getFileSize(std::string const &fileName)
+{
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  return file.tellg();
+}
+
+/**
+ * @returns the memory held by the points of the lane edges of the store
+ *
+ * The lanes own their edges as double precision ECEF points, so this doesn't depend on the geometry error the map was
+ * stored with.
+ */
+static std::size_t getEdgeBytes(access::Store const &store)
+{
+  std::size_t points = 0u;
+  for (auto const &laneId : store.getLanes())
+  {
+    auto const lane = store.getLanePtr(laneId);
+    points += lane->edgeLeft.ecefEdge.size() + lane->edgeRight.ecefEdge.size();
+  }
+  return points * sizeof(point::ECEFPoint);
+}
+
+/**
+ * @returns the average time in milliseconds to load the map, a negative value on failure
+ */
+static double measureLoading(std::string const &mapName, std::size_t rounds, std::size_t threadCount, bool loadGeometry)
+{
+  std::chrono::steady_clock::duration total{0};
+  for (std::size_t round = 0u; round < rounds; ++round)
+  {
+    auto const start = std::chrono::steady_clock::now();
+    access::Store store;
+    if (!readAdMap(mapName, store, threadCount, loadGeometry))
+    {
+      return -1.;
+    }
+    total += std::chrono::steady_clock::now() - start;
+  }
+  return std::chrono::duration<double, std::milli>(total).count() / static_cast<double>(rounds);
+}
+
+/**
+ * @returns throughput in MB/s
+ */
+static double toMegabytesPerSecond(std::size_t bytes, double milliseconds)
+{
+  return (milliseconds > 0.) ? static_cast<double>(bytes) / (milliseconds * 1000.) : 0.;
+}
+
+/**
+ * @brief Measures writing and reading the lane edges of the store to and from memory.
+ *
+ * The edges are serialized as ECEF edges and as plain vectors of coordinates, so both bulk paths of the
+ * serializer are covered without any file access or checksum.
+ */
+static bool measureEdgeSerialization(access::Store const &store, std::size_t rounds)
+{
+  std::vector<point::ECEFEdge> edges;
+  std::vector<double> coordinates;
+  for (auto const &laneId : store.getLanes())
+  {
+    auto const lane = store.getLanePtr(laneId);
+    for (auto const *edge : {&lane->edgeLeft.ecefEdge, &lane->edgeRight.ecefEdge})
+    {
+      edges.push_back(*edge);
+      for (auto const &ecefPoint : *edge)
+      {
+        coordinates.push_back(static_cast<double>(ecefPoint.x));
+        coordinates.push_back(static_cast<double>(ecefPoint.y));
+        coordinates.push_back(static_cast<double>(ecefPoint.z));
+      }
+    }
+  }
+
+  serialize::SerializerBuffer edgeWriter;
+  serialize::SerializerBuffer vectorWriter;
+  auto const writeStart = std::chrono::steady_clock::now();
+  for (auto &edge : edges)
+  {
+    if (!serialize::doSerialize(edgeWriter, edge))
+    {
+      std::cerr << "Unable to serialize the lane edges" << std::endl;
+      return false;
+    }
+  }
+  std::chrono::duration<double, std::milli> const edgeWriteTime = std::chrono::steady_clock::now() - writeStart;
+  if (!vectorWriter.serializeVector(coordinates))
+  {
+    std::cerr << "Unable to serialize the edge coordinates" << std::endl;
+    return false;
+  }
+
+  std::chrono::steady_clock::duration edgeReadTime{0};
+  std::chrono::steady_clock::duration vectorReadTime{0};
+  for (std::size_t round = 0u; round < rounds; ++round)
+  {
+    auto const edgeStart = std::chrono::steady_clock::now();
+    serialize::SerializerBuffer edgeReader(edgeWriter.getBuffer().data(), edgeWriter.getBuffer().size());
+    for (std::size_t i = 0u; i < edges.size(); ++i)
+    {
+      point::ECEFEdge edge;
+      if (!serialize::doSerialize(edgeReader, edge) || (edge.size() != edges[i].size()))
+      {
+        std::cerr << "Unable to deserialize the lane edges" << std::endl;
+        return false;
+      }
+    }
+    auto const vectorStart = std::chrono::steady_clock::now();
+    serialize::SerializerBuffer vectorReader(vectorWriter.getBuffer().data(), vectorWriter.getBuffer().size());
+    std::vector<double> readCoordinates;
+    if (!vectorReader.serializeVector(readCoordinates) || (readCoordinates.size() != coordinates.size()))
+    {
+      std::cerr << "Unable to deserialize the edge coordinates" << std::endl;
+      return false;
+    }
+    auto const end = std::chrono::steady_clock::now();
+    edgeReadTime += vectorStart - edgeStart;
+    vectorReadTime += end - vectorStart;
+  }
+
+  auto const edgeBytes = edgeWriter.getBuffer().size();
+  auto const vectorBytes = vectorWriter.getBuffer().size();
+  auto const averageMilliseconds = [rounds](std::chrono::steady_clock::duration const &duration) {
+    return std::chrono::duration<double, std::milli>(duration).count() / static_cast<double>(rounds);
+  };
+  std::cout << "Serialization throughput of " << edges.size() << " lane edges over " << rounds << " rounds:\n"
+            << "  ECEF edges:  write " << toMegabytesPerSecond(edgeBytes, edgeWriteTime.count()) << "MB/s, read "
+            << toMegabytesPerSecond(edgeBytes, averageMilliseconds(edgeReadTime)) << "MB/s (" << edgeBytes
+            << " bytes)\n"
+            << "  coordinates: read " << toMegabytesPerSecond(vectorBytes, averageMilliseconds(vectorReadTime))
+            << "MB/s (" << vectorBytes << " bytes)\n";
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    std::string mapName;
+    std::string convertedMapName;
+    std::size_t rounds = 20u;
+    double geometryError = 0.;
+    bool loadGeometry = true;
+    std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; ++i)
+    {
+      std::string const argument(argv[i]);
+      if ((argument == "--rounds") && (i + 1 < argc))
+      {
+        rounds = std::max(static_cast<std::size_t>(std::stoul(argv[++i])), std::size_t(1u));
+      }
+      else if ((argument == "--threads") && (i + 1 < argc))
+      {
+        threadCount = std::max(static_cast<std::size_t>(std::stoul(argv[++i])), std::size_t(1u));
+      }
+      else if ((argument == "--convert") && (i + 1 < argc))
+      {
+        convertedMapName = argv[++i];
+      }
+      else if ((argument == "--geometry-error") && (i + 1 < argc))
+      {
+        geometryError = std::stod(argv[++i]);
+      }
+      else if (argument == "--topology-only")
+      {
+        loadGeometry = false;
+      }
+      else if (mapName.empty() && (argument.compare(0, 1, "-") != 0))
+      {
+        mapName = argument;
+      }
+      else
+      {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    if (mapName.empty())
+    {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (!convertedMapName.empty())
+    {
+      access::Store::Ptr store(new access::Store());
+      // the geometry section shares the geometry of neighbouring lanes, which are looked up in the global map
+      if (!readAdMap(mapName, *store, threadCount) || !access::init(store)
+          || !writeAdMap(convertedMapName, *store, geometryError))
+      {
+        return EXIT_FAILURE;
+      }
+      access::cleanup();
+      std::cout << "Converted " << mapName << " (" << getFileSize(mapName) << " bytes) to " << convertedMapName << " ("
+                << getFileSize(convertedMapName) << " bytes)\n";
+      mapName = convertedMapName;
+    }
+
+    auto const singleThreaded = measureLoading(mapName, rounds, 1u, loadGeometry);
+    auto const multiThreaded = measureLoading(mapName, rounds, threadCount, loadGeometry);
+    if ((singleThreaded < 0.) || (multiThreaded < 0.))
+    {
+      return EXIT_FAILURE;
+    }
+    auto const fileSize = static_cast<std::size_t>(getFileSize(mapName));
+    std::cout << "Average load time of " << mapName << (loadGeometry ? "" : " without geometry") << " over " << rounds
+              << " rounds:\n"
+              << "  1 thread:  " << singleThreaded << "ms (" << toMegabytesPerSecond(fileSize, singleThreaded)
+              << "MB/s)\n"
+              << "  " << threadCount << " threads: " << multiThreaded << "ms ("
+              << toMegabytesPerSecond(fileSize, multiThreaded) << "MB/s)\n";
+
+    if (loadGeometry)
+    {
+      access::Store store;
+      if (!readAdMap(mapName, store, threadCount))
+      {
+        return EXIT_FAILURE;
+      }
+      std::cout << "Lane edges in memory: " << getEdgeBytes(store) << " bytes\n";
+      if (!measureEdgeSerialization(store, rounds))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  catch (std::exception &e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (...)
+  {
+    std::cerr << "Unhandled unknown exception" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
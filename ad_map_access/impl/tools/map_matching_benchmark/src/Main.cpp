@@ -0,0 +1,445 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Factory.hpp>
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/match/AdMapMatching.hpp>
+#include <ad/map/match/MapMatchingTracker.hpp>
+#include <ad/map/point/Operation.hpp>
+#include <ad/map/point/GeometryOperation.hpp>
+#include <ad/map/point/ParaPointOperation.hpp>
+#include <ad/map/point/Transform.hpp>
+#include <ad/map/serialize/SerializerMemoryMappedCRC32.hpp>
+
+#include <algorithm>
+#include <chrono> /* for std::chrono::steady_clock */
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ::ad;
+using namespace ::ad::map;
+
+static void printUsage(char const *programName)
+{
+  std::cerr << "Usage: " << programName << " [<map.adm>] [--rounds <count>] [--objects <count>] [--sampling <m>]"
+            << " [--threads <count>] [--frames <count>] [--sweep <lanes>]\n"
+            << "Measures the time to search the lanes near objects placed on the lanes of the given map and to map\n"
+            << "match these objects:\n"
+            << "  --rounds <count>       number of matching rounds over all objects (default: 5)\n"
+            << "  --objects <count>      number of objects, distributed over the lanes (default: 200)\n"
+            << "  --sampling <m>         sampling distance within the bounding boxes of the objects in sampling mode\n"
+            << "                         (default: 0.5)\n"
+            << "  --threads <count>      number of threads matching the whole object list (default: 1)\n"
+            << "  --frames <count>       number of frames of the objects driving along the lanes (default: 100)\n"
+            << "  --sweep <lanes>        measures the search of the lanes near the objects also on synthetic maps\n"
+            << "                         with 1000, 4000, 16000, ... lanes up to the given count\n";
+}
+
+static bool readAdMap(std::string const &mapName, access::Store &store)
+{
+  serialize::SerializerMemoryMappedCRC32 serializer;
+  size_t versionMajor = 0;
+  size_t versionMinor = 0;
+  if (!serializer.open(mapName.c_str(), versionMajor, versionMinor) || !store.load(serializer)
+      || !serializer.close())
+  {
+    std::cerr << "Unable to read map " << mapName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @returns a car in the middle of each selected lane, heading in lane direction
+ */
+static std::vector<match::ENUObjectPosition> createObjects(std::size_t objectCount)
+{
+  std::vector<match::ENUObjectPosition> objects;
+  auto const laneIds = lane::getLanes();
+  std::size_t const step = std::max(std::size_t(1u), laneIds.size() / std::max(std::size_t(1u), objectCount));
+  for (std::size_t i = 0u; (i < laneIds.size()) && (objects.size() < objectCount); i += step)
+  {
+    auto const paraPoint = point::createParaPoint(laneIds[i], physics::ParametricValue(0.5));
+    match::ENUObjectPosition object;
+    object.centerPoint = lane::getENULanePoint(paraPoint);
+    object.heading = lane::getLaneENUHeading(paraPoint);
+    object.enuReferencePoint = access::getENUReferencePoint();
+    object.dimension.length = physics::Distance(4.5);
+    object.dimension.width = physics::Distance(2.);
+    object.dimension.height = physics::Distance(1.5);
+    objects.push_back(object);
+  }
+  return objects;
+}
+
+/**
+ * @returns the positions of the objects per frame, driving 0.5m per frame along their lanes and successor lanes
+ *
+ * The objects start at the same lanes as the ones of createObjects().
+ */
+static std::vector<std::vector<point::ECEFPoint>> createTrajectories(std::size_t objectCount, std::size_t frameCount)
+{
+  std::vector<point::ParaPoint> paraPoints;
+  auto const laneIds = lane::getLanes();
+  std::size_t const step = std::max(std::size_t(1u), laneIds.size() / std::max(std::size_t(1u), objectCount));
+  for (std::size_t i = 0u; (i < laneIds.size()) && (paraPoints.size() < objectCount); i += step)
+  {
+    paraPoints.push_back(point::createParaPoint(laneIds[i], physics::ParametricValue(0.5)));
+  }
+  std::vector<std::vector<point::ECEFPoint>> frames;
+  for (std::size_t frame = 0u; frame < frameCount; ++frame)
+  {
+    std::vector<point::ECEFPoint> positions;
+    for (auto &paraPoint : paraPoints)
+    {
+      auto const &lane = lane::getLane(paraPoint.laneId);
+      positions.push_back(lane::getParametricPoint(lane, paraPoint.parametricOffset, physics::ParametricValue(0.5)));
+      auto const parametricStep = 0.5 / std::max(static_cast<double>(lane.length), 0.5);
+      auto const offset = static_cast<double>(paraPoint.parametricOffset) + parametricStep;
+      if (offset <= 1.)
+      {
+        paraPoint.parametricOffset = physics::ParametricValue(offset);
+        continue;
+      }
+      auto const successors = lane::getContactLanes(lane, lane::ContactLocation::SUCCESSOR);
+      if (!successors.empty())
+      {
+        paraPoint.laneId = successors.front().toLane;
+      }
+      paraPoint.parametricOffset = physics::ParametricValue(0.);
+    }
+    frames.push_back(positions);
+  }
+  return frames;
+}
+
+/**
+ * @returns the average time in microseconds to match a single object
+ */
+template <typename Matching>
+static double measureMatching(std::vector<match::ENUObjectPosition> const &objects,
+                              std::size_t rounds,
+                              Matching matching)
+{
+  auto const start = std::chrono::steady_clock::now();
+  for (std::size_t round = 0u; round < rounds; ++round)
+  {
+    for (auto const &object : objects)
+    {
+      matching(object);
+    }
+  }
+  std::chrono::duration<double, std::micro> const total = std::chrono::steady_clock::now() - start;
+  return total.count() / static_cast<double>(rounds * objects.size());
+}
+
+/**
+ * @returns the average time in microseconds to match a single object of a frame
+ */
+template <typename Matching>
+static double measureFrames(std::vector<std::vector<point::ECEFPoint>> const &frames, Matching matching)
+{
+  std::size_t matchCount = 0u;
+  auto const start = std::chrono::steady_clock::now();
+  for (auto const &positions : frames)
+  {
+    for (std::size_t object = 0u; object < positions.size(); ++object)
+    {
+      matching(object, positions[object]);
+    }
+    matchCount += positions.size();
+  }
+  std::chrono::duration<double, std::micro> const total = std::chrono::steady_clock::now() - start;
+  return total.count() / static_cast<double>(std::max(matchCount, std::size_t(1u)));
+}
+
+/**
+ * @returns a synthetic map of straight lanes of 20m length and 3.5m width, arranged in a square grid
+ */
+static access::Store::Ptr createSyntheticStore(std::size_t laneCount)
+{
+  access::Store::Ptr store(new access::Store());
+  access::Factory factory(*store);
+  auto const enuReferencePoint
+    = point::createGeoPoint(point::Longitude(8.44), point::Latitude(49.02), point::Altitude(0.));
+  auto const columnCount = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(laneCount))));
+  for (std::size_t i = 0u; i < laneCount; ++i)
+  {
+    auto const x = 20. * static_cast<double>(i % columnCount);
+    auto const y = 3.5 * static_cast<double>(i / columnCount);
+    point::ENUEdge const leftEdge{point::createENUPoint(x, y + 3.5, 0.),
+                                  point::createENUPoint(x + 10., y + 3.5, 0.),
+                                  point::createENUPoint(x + 20., y + 3.5, 0.)};
+    point::ENUEdge const rightEdge{
+      point::createENUPoint(x, y, 0.), point::createENUPoint(x + 10., y, 0.), point::createENUPoint(x + 20., y, 0.)};
+    lane::LaneId const laneId(i + 1u);
+    if (!factory.add(access::PartitionId(1), laneId, lane::LaneType::NORMAL, lane::LaneDirection::POSITIVE)
+        || !factory.set(laneId,
+                        point::createGeometry(point::toECEF(leftEdge, enuReferencePoint), false),
+                        point::createGeometry(point::toECEF(rightEdge, enuReferencePoint), false)))
+    {
+      return nullptr;
+    }
+  }
+  return store;
+}
+
+/**
+ * @returns search spheres around the centers of up to queryCount lanes of the store
+ */
+static std::vector<point::BoundingSphere>
+createLanesNearQueries(access::Store const &store, std::size_t queryCount, physics::Distance const &distance)
+{
+  std::vector<point::BoundingSphere> queries;
+  auto const laneIds = store.getLanes();
+  std::size_t const step = std::max(std::size_t(1u), laneIds.size() / std::max(std::size_t(1u), queryCount));
+  for (std::size_t i = 0u; (i < laneIds.size()) && (queries.size() < queryCount); i += step)
+  {
+    point::BoundingSphere query;
+    query.center = store.getLanePtr(laneIds[i])->boundingSphere.center;
+    query.radius = distance;
+    queries.push_back(query);
+  }
+  return queries;
+}
+
+/**
+ * @returns the average time in microseconds to find the lanes near a single query with the lane index of the
+ * store, compared to a linear scan over the bounding spheres of all lanes
+ */
+static std::pair<double, double>
+measureLanesNear(access::Store const &store, std::vector<point::BoundingSphere> const &queries, std::size_t rounds)
+{
+  std::vector<lane::Lane::ConstPtr> lanes;
+  for (auto const &laneId : store.getLanes())
+  {
+    lanes.push_back(store.getLanePtr(laneId));
+  }
+
+  // the lane index is built on first use, which is not part of the search time
+  store.getLanesNear(point::BoundingSphere());
+
+  std::size_t indexCount = 0u;
+  auto const indexStart = std::chrono::steady_clock::now();
+  for (std::size_t round = 0u; round < rounds; ++round)
+  {
+    for (auto const &query : queries)
+    {
+      indexCount += store.getLanesNear(query).size();
+    }
+  }
+  std::size_t scanCount = 0u;
+  auto const scanStart = std::chrono::steady_clock::now();
+  for (std::size_t round = 0u; round < rounds; ++round)
+  {
+    for (auto const &query : queries)
+    {
+      lane::LaneIdList laneIds;
+      for (auto const &lane : lanes)
+      {
+        if (point::distance(lane->boundingSphere, query) == physics::Distance(0.))
+        {
+          laneIds.push_back(lane->id);
+        }
+      }
+      scanCount += laneIds.size();
+    }
+  }
+  auto const end = std::chrono::steady_clock::now();
+  if (indexCount != scanCount)
+  {
+    std::cerr << "Lane index found " << indexCount << " lanes, the linear scan " << scanCount << std::endl;
+  }
+  auto const queryCount = static_cast<double>(std::max(rounds * queries.size(), std::size_t(1u)));
+  return {std::chrono::duration<double, std::micro>(scanStart - indexStart).count() / queryCount,
+          std::chrono::duration<double, std::micro>(end - scanStart).count() / queryCount};
+}
+
+/**
+ * @brief prints the time to search the lanes near objects over synthetic maps of growing lane count
+ */
+static bool measureLanesNearSweep(std::size_t maxLaneCount,
+                                  std::size_t objectCount,
+                                  std::size_t rounds,
+                                  physics::Distance const &distance)
+{
+  std::cout << "Average time to search the lanes near an object of synthetic maps over " << objectCount
+            << " objects and " << rounds << " rounds:\n";
+  for (std::size_t laneCount = std::min(std::size_t(1000u), maxLaneCount); laneCount <= maxLaneCount;)
+  {
+    auto const store = createSyntheticStore(laneCount);
+    if (!store)
+    {
+      std::cerr << "Unable to create a synthetic map with " << laneCount << " lanes" << std::endl;
+      return false;
+    }
+    auto const lanesNearTime
+      = measureLanesNear(*store, createLanesNearQueries(*store, objectCount, distance), rounds);
+    std::cout << "  " << laneCount << " lanes: lane index " << lanesNearTime.first << "us, linear scan "
+              << lanesNearTime.second << "us\n";
+    if (laneCount == maxLaneCount)
+    {
+      break;
+    }
+    laneCount = std::min(laneCount * 4u, maxLaneCount);
+  }
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    std::string mapName;
+    std::size_t rounds = 5u;
+    std::size_t objectCount = 200u;
+    double samplingDistance = 0.5;
+    std::size_t threadCount = 1u;
+    std::size_t frameCount = 100u;
+    std::size_t sweepLaneCount = 0u;
+    for (int i = 1; i < argc; ++i)
+    {
+      std::string const argument(argv[i]);
+      if ((argument == "--rounds") && (i + 1 < argc))
+      {
+        rounds = std::max(static_cast<std::size_t>(std::stoul(argv[++i])), std::size_t(1u));
+      }
+      else if ((argument == "--objects") && (i + 1 < argc))
+      {
+        objectCount = std::max(static_cast<std::size_t>(std::stoul(argv[++i])), std::size_t(1u));
+      }
+      else if ((argument == "--sampling") && (i + 1 < argc))
+      {
+        samplingDistance = std::stod(argv[++i]);
+      }
+      else if ((argument == "--threads") && (i + 1 < argc))
+      {
+        threadCount = std::max(static_cast<std::size_t>(std::stoul(argv[++i])), std::size_t(1u));
+      }
+      else if ((argument == "--frames") && (i + 1 < argc))
+      {
+        frameCount = std::max(static_cast<std::size_t>(std::stoul(argv[++i])), std::size_t(1u));
+      }
+      else if ((argument == "--sweep") && (i + 1 < argc))
+      {
+        sweepLaneCount = static_cast<std::size_t>(std::stoul(argv[++i]));
+      }
+      else if (mapName.empty() && (argument.compare(0, 1, "-") != 0))
+      {
+        mapName = argument;
+      }
+      else
+      {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    if (mapName.empty() && (sweepLaneCount == 0u))
+    {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    physics::Distance const distance(2.);
+    if ((sweepLaneCount > 0u) && !measureLanesNearSweep(sweepLaneCount, objectCount, rounds, distance))
+    {
+      return EXIT_FAILURE;
+    }
+    if (mapName.empty())
+    {
+      return EXIT_SUCCESS;
+    }
+
+    access::Store::Ptr store(new access::Store());
+    if (!readAdMap(mapName, *store) || !access::init(store))
+    {
+      return EXIT_FAILURE;
+    }
+    auto const objects = createObjects(objectCount);
+    if (objects.empty())
+    {
+      std::cerr << "No lanes in map " << mapName << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    match::AdMapMatching mapMatching;
+    physics::Probability const minProbability(0.05);
+    std::vector<point::BoundingSphere> queries;
+    for (auto const &object : objects)
+    {
+      point::BoundingSphere query;
+      query.center = point::toECEF(object.centerPoint);
+      query.radius = distance;
+      queries.push_back(query);
+    }
+    auto const lanesNearTime = measureLanesNear(*store, queries, rounds);
+    auto const positionTime = measureMatching(objects, rounds, [&](match::ENUObjectPosition const &object) {
+      mapMatching.getMapMatchedPositions(object, distance, minProbability);
+    });
+    auto const boundingBoxTime = measureMatching(objects, rounds, [&](match::ENUObjectPosition const &object) {
+      mapMatching.getMapMatchedBoundingBox(object, distance, minProbability);
+    });
+    auto const start = std::chrono::steady_clock::now();
+    for (std::size_t round = 0u; round < rounds; ++round)
+    {
+      mapMatching.getLaneOccupiedRegions(objects, distance, minProbability, physics::Distance(1.), threadCount);
+    }
+    std::chrono::duration<double, std::micro> const objectListDuration = std::chrono::steady_clock::now() - start;
+    auto const objectListTime = objectListDuration.count() / static_cast<double>(rounds * objects.size());
+    mapMatching.setBoundingBoxMatchingMode(match::BoundingBoxMatchingMode::Sampling);
+    auto const samplingBoundingBoxTime
+      = measureMatching(objects, rounds, [&](match::ENUObjectPosition const &object) {
+          mapMatching.getMapMatchedBoundingBox(
+            object, distance, minProbability, physics::Distance(samplingDistance));
+        });
+
+    auto const frames = createTrajectories(objects.size(), frameCount);
+    mapMatching.setBoundingBoxMatchingMode(match::BoundingBoxMatchingMode::Footprint);
+    auto const trajectoryTime = measureFrames(frames, [&](std::size_t, point::ECEFPoint const &position) {
+      mapMatching.getMapMatchedPositions(position, distance, minProbability);
+    });
+    match::MapMatchingTracker tracker;
+    auto const trackerTime = measureFrames(frames, [&](std::size_t object, point::ECEFPoint const &position) {
+      tracker.getMapMatchedPositions(object, position, distance, minProbability);
+    });
+
+    std::cout << "Average time to search the lanes near an object of " << mapName << " with "
+              << lane::getLanes().size() << " lanes over " << objects.size() << " objects and " << rounds
+              << " rounds:\n"
+              << "  lane index:   " << lanesNearTime.first << "us\n"
+              << "  linear scan:  " << lanesNearTime.second << "us\n"
+              << "Average map matching time per object of " << mapName << " over " << objects.size() << " objects and "
+              << rounds << " rounds:\n"
+              << "  position:     " << positionTime << "us\n"
+              << "  bounding box: " << boundingBoxTime << "us (footprint)\n"
+              << "  object list:  " << objectListTime << "us (" << threadCount << " threads)\n"
+              << "  bounding box: " << samplingBoundingBoxTime << "us (sampling distance " << samplingDistance
+              << "m)\n"
+              << "Average map matching time per object of " << objects.size() << " objects driving over " << frameCount
+              << " frames:\n"
+              << "  position:     " << trajectoryTime << "us\n"
+              << "  tracker:      " << trackerTime << "us (hit rate " << tracker.getHitRate() << ")\n";
+  }
+  catch (std::exception &e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (...)
+  {
+    std::cerr << "Unhandled unknown exception" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
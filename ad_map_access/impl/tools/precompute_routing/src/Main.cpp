@@ -0,0 +1,131 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2018-2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/access/Store.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/route/AltHeuristic.hpp>
+#include <ad/map/route/ContractionHierarchy.hpp>
+#include <ad/map/serialize/SerializerFileCRC32.hpp>
+
+#include <chrono> /* for std::chrono::system_clock::time_point */
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace ::ad::map;
+
+static void printUsage(char const *programName)
+{
+  std::cerr << "Usage: " << programName << " <map.adm> [--landmarks <count>]\n"
+            << "Precomputes the routing indices of the given map and stores them next to it:\n"
+            << "  <map.adm>.ch   the contraction hierarchy, see route::planning::ContractionHierarchy\n"
+            << "  <map.adm>.alt  the landmark tables, if --landmarks is given, see route::planning::AltHeuristic\n";
+}
+
+static bool readAdMap(std::string const &mapName, access::Store &store)
+{
+  serialize::SerializerFileCRC32 serializer(false);
+  size_t versionMajor = 0;
+  size_t versionMinor = 0;
+  if (!serializer.open(mapName.c_str(), versionMajor, versionMinor))
+  {
+    std::cerr << "Unable to open map for reading " << mapName << std::endl;
+    return false;
+  }
+  if (!store.load(serializer))
+  {
+    std::cerr << "Unable to read map " << mapName << std::endl;
+    return false;
+  }
+  if (!serializer.close())
+  {
+    std::cerr << "Map file is corrupt " << mapName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    std::string mapName;
+    std::size_t landmarkCount = 0u;
+    for (int i = 1; i < argc; ++i)
+    {
+      std::string const argument(argv[i]);
+      if ((argument == "--landmarks") && (i + 1 < argc))
+      {
+        landmarkCount = static_cast<std::size_t>(std::stoul(argv[++i]));
+      }
+      else if (mapName.empty() && (argument.compare(0, 1, "-") != 0))
+      {
+        mapName = argument;
+      }
+      else
+      {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    if (mapName.empty())
+    {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    auto const startOfProcessing = std::chrono::system_clock::now();
+    auto store = std::make_shared<access::Store>();
+    if (!readAdMap(mapName, *store) || !access::init(store))
+    {
+      return EXIT_FAILURE;
+    }
+    auto const laneGraph = lane::getLaneGraph();
+
+    route::planning::ContractionHierarchy contractionHierarchy;
+    auto const contractionHierarchyFileName = route::planning::ContractionHierarchy::getFileName(mapName);
+    if (!contractionHierarchy.build(*laneGraph) || !contractionHierarchy.save(contractionHierarchyFileName))
+    {
+      std::cerr << "Unable to store contraction hierarchy " << contractionHierarchyFileName << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "Stored contraction hierarchy " << contractionHierarchyFileName << " with "
+              << contractionHierarchy.size() << " nodes and " << contractionHierarchy.getEdgeCount() << " edges\n";
+
+    if (landmarkCount > 0u)
+    {
+      route::planning::AltHeuristic altHeuristic;
+      auto const altHeuristicFileName = route::planning::AltHeuristic::getFileName(mapName);
+      if (!altHeuristic.build(*laneGraph, landmarkCount) || !altHeuristic.save(altHeuristicFileName))
+      {
+        std::cerr << "Unable to store landmark tables " << altHeuristicFileName << std::endl;
+        return EXIT_FAILURE;
+      }
+      std::cout << "Stored landmark tables " << altHeuristicFileName << " with " << altHeuristic.getLandmarkCount()
+                << " landmarks\n";
+    }
+
+    access::cleanup();
+    auto const endOfProcessing = std::chrono::system_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(endOfProcessing - startOfProcessing);
+    std::cout << "Total time: " << elapsed.count() << "ms\n";
+  }
+  catch (std::exception &e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (...)
+  {
+    std::cerr << "Unhandled unknown exception" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,294 @@
+// ----------------- BEGIN LICENSE BLOCK ---------------------------------
+//
+// Copyright (C) 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+//
+// ----------------- END LICENSE BLOCK -----------------------------------
+
+#include <ad/map/access/Operation.hpp>
+#include <ad/map/lane/LaneOperation.hpp>
+#include <ad/map/route/Planning.hpp>
+#include <ad/map/route/RouteAStar.hpp>
+#include <ad/map/route/RouteOperation.hpp>
+#include <ad/map/serialize/SerializerMemoryMappedCRC32.hpp>
+
+#include <algorithm>
+#include <chrono> /* for std::chrono::steady_clock */
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ::ad;
+using namespace ::ad::map;
+
+static void printUsage(char const *programName)
+{
+  std::cerr << "Usage: " << programName
+            << " <map.adm> [--rounds <count>] [--routes <count>] [--landmarks <count>] [--seed <value>]\n"
+            << "Measures the lane lookup throughput and the route planning latency of the given map:\n"
+            << "  --rounds <count>       number of lookups of each lane of the map (default: 100)\n"
+            << "  --routes <count>       number of random lane to lane routes planned with A* (default: 1000)\n"
+            << "  --landmarks <count>    number of landmarks to plan the same routes with ALT, 0 to skip (default: 8)\n"
+            << "  --seed <value>         seed of the random lookup order and the random routes (default: 1)\n";
+}
+
+static bool readAdMap(std::string const &mapName, access::Store &store)
+{
+  serialize::SerializerMemoryMappedCRC32 serializer;
+  size_t versionMajor = 0;
+  size_t versionMinor = 0;
+  if (!serializer.open(mapName.c_str(), versionMajor, versionMinor) || !store.load(serializer)
+      || !serializer.close())
+  {
+    std::cerr << "Unable to read map " << mapName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @returns the number of lookups per second
+ *
+ * The lookup returns the length of the lane, which is summed up, so the lookups can't be optimized away.
+ */
+template <typename Lookup>
+static double measureLookups(lane::LaneIdList const &laneIds, std::size_t rounds, Lookup lookup)
+{
+  double lengthSum = 0.;
+  auto const start = std::chrono::steady_clock::now();
+  for (std::size_t round = 0u; round < rounds; ++round)
+  {
+    for (auto const &laneId : laneIds)
+    {
+      lengthSum += lookup(laneId);
+    }
+  }
+  std::chrono::duration<double> const total = std::chrono::steady_clock::now() - start;
+  if (lengthSum < 0.)
+  {
+    std::cerr << "Invalid lane lengths" << std::endl;
+  }
+  return static_cast<double>(rounds * laneIds.size()) / std::max(total.count(), 1e-9);
+}
+
+/**
+ * @returns the given percentile of the sorted durations
+ */
+static double getPercentile(std::vector<double> const &sortedDurations, double percentile)
+{
+  auto const index = static_cast<std::size_t>(percentile * static_cast<double>(sortedDurations.size() - 1u) + 0.5);
+  return sortedDurations[index];
+}
+
+/**
+ * @brief Result of planning the same routes with one configuration of RouteAstar.
+ */
+struct RoutePlanningResult
+{
+  std::vector<double> durations;               ///< Sorted latencies in microseconds.
+  std::size_t expandedPoints{0u};              ///< Sum of the expanded points of all routes.
+  std::vector<point::ParaPointList> rawRoutes; ///< The routes found, empty if none.
+};
+
+/**
+ * @brief Plans the given routes and reports the latency percentiles in microseconds.
+ */
+static RoutePlanningResult planRoutes(
+  std::vector<std::pair<route::planning::RoutingParaPoint, route::planning::RoutingParaPoint>> const &routes,
+  route::planning::AltHeuristic::ConstPtr const &altHeuristic,
+  std::string const &name)
+{
+  RoutePlanningResult result;
+  std::size_t routesFound = 0u;
+  for (auto const &route : routes)
+  {
+    auto const routeStart = std::chrono::steady_clock::now();
+    route::planning::RouteAstar routeAstar(
+      route.first, route.second, route::planning::RouteAstar::Type::SHORTEST, altHeuristic);
+    bool const found = routeAstar.calculate();
+    std::chrono::duration<double, std::micro> const duration = std::chrono::steady_clock::now() - routeStart;
+    result.durations.push_back(duration.count());
+    result.expandedPoints += routeAstar.getExpandedPointCount();
+    if (found)
+    {
+      routesFound++;
+      result.rawRoutes.push_back(routeAstar.getRawRoute());
+    }
+    else
+    {
+      result.rawRoutes.push_back(point::ParaPointList());
+    }
+  }
+  std::sort(result.durations.begin(), result.durations.end());
+  std::cout << "Route planning latency with " << name << " over " << routes.size() << " random routes ("
+            << routesFound << " found, "
+            << static_cast<double>(result.expandedPoints) / static_cast<double>(routes.size())
+            << " expanded points per route):\n"
+            << "  p50: " << getPercentile(result.durations, 0.5) << "us\n"
+            << "  p99: " << getPercentile(result.durations, 0.99) << "us\n"
+            << "  max: " << result.durations.back() << "us\n";
+  return result;
+}
+
+/**
+ * @brief Plans routes between random lanes of the map with plain A* and with landmark lower bounds (ALT).
+ *
+ * Both searches return routes of the same cost, but routes of equal cost may be broken differently. So the
+ * number of differing routes is reported together with the number of routes of different length, which has to be 0.
+ */
+static void measureRoutes(lane::LaneIdList const &laneIds,
+                          std::size_t routeCount,
+                          std::size_t landmarkCount,
+                          std::mt19937 &generator)
+{
+  std::uniform_int_distribution<std::size_t> laneDistribution(0u, laneIds.size() - 1u);
+  std::vector<std::pair<route::planning::RoutingParaPoint, route::planning::RoutingParaPoint>> routes;
+  for (std::size_t i = 0u; i < routeCount; ++i)
+  {
+    auto const start
+      = route::planning::createRoutingPoint(laneIds[laneDistribution(generator)], physics::ParametricValue(0.5));
+    auto const dest
+      = route::planning::createRoutingPoint(laneIds[laneDistribution(generator)], physics::ParametricValue(0.5));
+    routes.push_back({start, dest});
+  }
+
+  auto const plainResult = planRoutes(routes, nullptr, "A*");
+  if (landmarkCount == 0u)
+  {
+    return;
+  }
+
+  auto const buildStart = std::chrono::steady_clock::now();
+  auto altHeuristic = std::make_shared<route::planning::AltHeuristic>();
+  if (!altHeuristic->build(*lane::getLaneGraph(), landmarkCount))
+  {
+    std::cerr << "Unable to build the landmark tables" << std::endl;
+    return;
+  }
+  std::chrono::duration<double, std::milli> const buildDuration = std::chrono::steady_clock::now() - buildStart;
+  std::cout << "Landmark tables with " << altHeuristic->getLandmarkCount() << " landmarks built in "
+            << buildDuration.count() << "ms\n";
+
+  auto const altResult = planRoutes(routes, altHeuristic, "ALT");
+  std::size_t differentRoutes = 0u;
+  std::size_t differentLengths = 0u;
+  for (std::size_t i = 0u; i < routes.size(); ++i)
+  {
+    if (plainResult.rawRoutes[i] != altResult.rawRoutes[i])
+    {
+      differentRoutes++;
+      auto const plainLength = route::calcLength(route::planning::planRoute(routes[i].first, routes[i].second));
+      auto const altLength
+        = route::calcLength(route::planning::planRoute(routes[i].first, routes[i].second, altHeuristic));
+      if (std::fabs(static_cast<double>(plainLength - altLength)) > 1e-6)
+      {
+        differentLengths++;
+      }
+    }
+  }
+  auto const expandedRatio = static_cast<double>(altResult.expandedPoints)
+    / static_cast<double>(std::max(plainResult.expandedPoints, std::size_t(1u)));
+  auto const latencyRatio
+    = getPercentile(altResult.durations, 0.5) / std::max(getPercentile(plainResult.durations, 0.5), 1e-9);
+  std::cout << "ALT compared to A*:\n"
+            << "  expanded points: " << 100. * expandedRatio << "%\n"
+            << "  p50 latency:     " << 100. * latencyRatio << "%\n"
+            << "  other routes of equal length: " << differentRoutes - differentLengths << "\n"
+            << "  routes of different length:   " << differentLengths << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    std::string mapName;
+    std::size_t rounds = 100u;
+    std::size_t routeCount = 1000u;
+    std::size_t landmarkCount = 8u;
+    unsigned long seed = 1u;
+    for (int i = 1; i < argc; ++i)
+    {
+      std::string const argument(argv[i]);
+      if ((argument == "--rounds") && (i + 1 < argc))
+      {
+        rounds = std::max(static_cast<std::size_t>(std::stoul(argv[++i])), std::size_t(1u));
+      }
+      else if ((argument == "--routes") && (i + 1 < argc))
+      {
+        routeCount = std::max(static_cast<std::size_t>(std::stoul(argv[++i])), std::size_t(1u));
+      }
+      else if ((argument == "--landmarks") && (i + 1 < argc))
+      {
+        landmarkCount = static_cast<std::size_t>(std::stoul(argv[++i]));
+      }
+      else if ((argument == "--seed") && (i + 1 < argc))
+      {
+        seed = std::stoul(argv[++i]);
+      }
+      else if (mapName.empty() && (argument.compare(0, 1, "-") != 0))
+      {
+        mapName = argument;
+      }
+      else
+      {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    if (mapName.empty())
+    {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    access::Store::Ptr store(new access::Store());
+    if (!readAdMap(mapName, *store) || !access::init(store))
+    {
+      return EXIT_FAILURE;
+    }
+    auto laneIds = lane::getLanes();
+    if (laneIds.empty())
+    {
+      std::cerr << "No lanes in map " << mapName << std::endl;
+      return EXIT_FAILURE;
+    }
+    // routing and matching look up the lanes in the order of the topology, not in the order of the ids
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(seed));
+    std::shuffle(laneIds.begin(), laneIds.end(), generator);
+
+    auto const handleLookups = measureLookups(laneIds, rounds, [&store](lane::LaneId const &laneId) {
+      return static_cast<double>(store->getLaneHandle(laneId)->length);
+    });
+    auto const laneLookups = measureLookups(
+      laneIds, rounds, [](lane::LaneId const &laneId) { return static_cast<double>(lane::getLane(laneId).length); });
+    auto const pointerLookups = measureLookups(laneIds, rounds, [](lane::LaneId const &laneId) {
+      return static_cast<double>(lane::getLanePtr(laneId)->length);
+    });
+
+    std::cout << "Lane lookups per second of " << mapName << " with " << laneIds.size() << " lanes over " << rounds
+              << " rounds:\n"
+              << "  Store::getLaneHandle(): " << handleLookups << "\n"
+              << "  lane::getLane():        " << laneLookups << "\n"
+              << "  lane::getLanePtr():     " << pointerLookups << "\n";
+
+    measureRoutes(laneIds, routeCount, landmarkCount, generator);
+  }
+  catch (std::exception &e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (...)
+  {
+    std::cerr << "Unhandled unknown exception" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -345,7 +345,7 @@ PyObject *GetLaneEdge(PyObject *py_lane_id, bool left, CoordSys cs)
       case CoordSys::ENU:
         if (access::isENUReferencePointSet())
         {
-          return Py(point::getCachedENUEdge(geom));
+          return Py(point::getENUEdge(geom));
         }
         else
         {